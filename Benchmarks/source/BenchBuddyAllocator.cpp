@@ -0,0 +1,96 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Graphics/GraphicsAllocator/BuddyAllocator.h"
+
+
+namespace
+{
+	const uint32_t	POOL_SIZE = moe::BuddyAllocator::ms_MAX_POOL_SIZE;
+}
+
+
+MOE_BENCHMARK(BuddyAllocateFreeLeaves, "BuddyAllocator/AllocateFreeLeaves")
+{
+	moe::BuddyAllocator allocator(POOL_SIZE);
+	const uint32_t numLeaves = POOL_SIZE / moe::BuddyAllocator::ms_MIN_POOL_SIZE;
+
+	std::vector<uint32_t> offsets(numLeaves);
+
+	state.SetItemsPerIteration(numLeaves);
+	while (state.KeepRunning())
+	{
+		// Splits the whole tree down to the leaves, then merges everything back.
+		for (uint32_t& offset : offsets)
+		{
+			offset = allocator.TryAllocate(1);
+		}
+
+		for (uint32_t offset : offsets)
+		{
+			allocator.Free(offset);
+		}
+	}
+}
+
+
+MOE_BENCHMARK(BuddyMixedSizes, "BuddyAllocator/MixedSizes")
+{
+	// A mesh-upload-like pattern : allocations of random sizes, freed in random order.
+	const uint32_t numAllocations = 512;
+
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<uint32_t> sizeDistrib(1, 64 * 1024);
+
+	std::vector<uint32_t> sizes(numAllocations);
+	for (uint32_t& size : sizes)
+	{
+		size = sizeDistrib(rng);
+	}
+
+	std::vector<uint32_t> freeOrder(numAllocations);
+	for (uint32_t iAlloc = 0; iAlloc < numAllocations; ++iAlloc)
+	{
+		freeOrder[iAlloc] = iAlloc;
+	}
+	std::shuffle(freeOrder.begin(), freeOrder.end(), rng);
+
+	moe::BuddyAllocator allocator(POOL_SIZE);
+	std::vector<uint32_t> offsets(numAllocations);
+
+	state.SetItemsPerIteration(numAllocations);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iAlloc = 0; iAlloc < numAllocations; ++iAlloc)
+		{
+			offsets[iAlloc] = allocator.TryAllocate(sizes[iAlloc]);
+		}
+
+		for (uint32_t iAlloc : freeOrder)
+		{
+			if (offsets[iAlloc] != moe::BuddyAllocator::ms_INVALID_OFFSET)
+			{
+				allocator.Free(offsets[iAlloc]);
+			}
+		}
+	}
+}
+
+
+MOE_BENCHMARK(BuddyExhausted, "BuddyAllocator/FailWhenFull")
+{
+	moe::BuddyAllocator allocator(POOL_SIZE);
+	const uint32_t offset = allocator.TryAllocate(POOL_SIZE);
+
+	while (state.KeepRunning())
+	{
+		moe::DoNotOptimize(allocator.TryAllocate(1));
+	}
+
+	allocator.Free(offset);
+}
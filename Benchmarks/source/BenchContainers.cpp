@@ -0,0 +1,272 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Containers/FreeList/Freelist.h"
+#include "Core/Containers/HashMap/HashMap.h"
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Memory/ArenaAllocator.h"
+#include "Core/Memory/ScratchArena.h"
+
+
+namespace
+{
+	struct Particle
+	{
+		float	m_position[3]{};
+		float	m_velocity[3]{};
+		float	m_lifetime = 0.f;
+	};
+
+
+	const uint32_t	NUM_ELEMENTS = 4096;
+
+
+	// Shuffled keys, so that lookups are not accidentally sequential.
+	std::vector<uint32_t>	MakeShuffledKeys(uint32_t count, uint32_t seed)
+	{
+		std::vector<uint32_t> keys(count);
+		for (uint32_t iKey = 0; iKey < count; ++iKey)
+		{
+			keys[iKey] = iKey * 2654435761u; // spread the keys over the whole range
+		}
+
+		std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+		return keys;
+	}
+}
+
+
+MOE_BENCHMARK(FreelistAddRemove, "Freelist/AddRemove")
+{
+	moe::Freelist<Particle> freelist(NUM_ELEMENTS);
+	std::vector<moe::FreelistID> ids(NUM_ELEMENTS);
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iElem = 0; iElem < NUM_ELEMENTS; ++iElem)
+		{
+			ids[iElem] = freelist.Add();
+		}
+
+		// Remove every other element first, so that the free slots are not reused in order.
+		for (uint32_t iElem = 0; iElem < NUM_ELEMENTS; iElem += 2)
+		{
+			freelist.Remove(ids[iElem]);
+		}
+
+		for (uint32_t iElem = 1; iElem < NUM_ELEMENTS; iElem += 2)
+		{
+			freelist.Remove(ids[iElem]);
+		}
+
+		moe::ClobberMemory();
+	}
+}
+
+
+MOE_BENCHMARK(FreelistLookup, "Freelist/Lookup")
+{
+	moe::Freelist<Particle> freelist(NUM_ELEMENTS);
+	std::vector<moe::FreelistID> ids;
+
+	for (uint32_t iElem = 0; iElem < NUM_ELEMENTS; ++iElem)
+	{
+		ids.push_back(freelist.Add());
+	}
+
+	std::shuffle(ids.begin(), ids.end(), std::mt19937(42));
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		float total = 0.f;
+		for (moe::FreelistID id : ids)
+		{
+			total += freelist.Lookup(id).m_lifetime;
+		}
+		moe::DoNotOptimize(total);
+	}
+}
+
+
+MOE_BENCHMARK(HashMapInsert, "HashMap/Insert")
+{
+	const std::vector<uint32_t> keys = MakeShuffledKeys(NUM_ELEMENTS, 42);
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		// Growing from empty on purpose : rehashing is part of the cost.
+		moe::HashMap<uint32_t, uint32_t> map;
+		for (uint32_t key : keys)
+		{
+			map.Insert({ key, key });
+		}
+		moe::DoNotOptimize(map.Size());
+	}
+}
+
+
+MOE_BENCHMARK(HashMapFindHit, "HashMap/FindHit")
+{
+	const std::vector<uint32_t> keys = MakeShuffledKeys(NUM_ELEMENTS, 42);
+
+	moe::HashMap<uint32_t, uint32_t> map;
+	for (uint32_t key : keys)
+	{
+		map.Insert({ key, key });
+	}
+
+	const std::vector<uint32_t> lookups = MakeShuffledKeys(NUM_ELEMENTS, 1337);
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		uint32_t total = 0;
+		for (uint32_t key : lookups)
+		{
+			total += map.Find(key)->second;
+		}
+		moe::DoNotOptimize(total);
+	}
+}
+
+
+MOE_BENCHMARK(HashMapFindMiss, "HashMap/FindMiss")
+{
+	const std::vector<uint32_t> keys = MakeShuffledKeys(NUM_ELEMENTS, 42);
+
+	moe::HashMap<uint32_t, uint32_t> map;
+	for (uint32_t key : keys)
+	{
+		map.Insert({ key, key });
+	}
+
+	std::vector<uint32_t> missingKeys = keys;
+	for (uint32_t& key : missingKeys)
+	{
+		key += 1; // the inserted keys are all even
+	}
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		uint32_t numFound = 0;
+		for (uint32_t key : missingKeys)
+		{
+			numFound += (map.Find(key) != map.End());
+		}
+		moe::DoNotOptimize(numFound);
+	}
+}
+
+
+MOE_BENCHMARK(HashMapFindString, "HashMap/FindString")
+{
+	moe::HashMap<std::string, uint32_t> map;
+	std::vector<std::string> names;
+
+	for (uint32_t iElem = 0; iElem < NUM_ELEMENTS; ++iElem)
+	{
+		names.push_back("resource_" + std::to_string(iElem * 2654435761u));
+		map.Insert({ names.back(), iElem });
+	}
+
+	std::shuffle(names.begin(), names.end(), std::mt19937(42));
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		uint32_t total = 0;
+		for (const std::string& name : names)
+		{
+			total += map.Find(name)->second;
+		}
+		moe::DoNotOptimize(total);
+	}
+}
+
+
+MOE_BENCHMARK(HashMapErase, "HashMap/InsertErase")
+{
+	const std::vector<uint32_t> keys = MakeShuffledKeys(NUM_ELEMENTS, 42);
+
+	moe::HashMap<uint32_t, uint32_t> map;
+	map.Reserve(NUM_ELEMENTS);
+
+	state.SetItemsPerIteration(NUM_ELEMENTS);
+	while (state.KeepRunning())
+	{
+		for (uint32_t key : keys)
+		{
+			map.Insert({ key, key });
+		}
+
+		for (uint32_t key : keys)
+		{
+			map.Erase(key);
+		}
+		moe::DoNotOptimize(map.Size());
+	}
+}
+
+
+
+// Many small temporary lists (like per-object command payloads), allocated and thrown away every frame :
+// on the heap, then in the scratch arena, where an allocation is a pointer bump and everything is freed at once.
+
+namespace
+{
+	const uint32_t	NUM_SMALL_VECTORS = 256;
+	const uint32_t	SMALL_VECTOR_SIZE = 8;
+}
+
+
+MOE_BENCHMARK(VectorSmallTemporaryHeap, "Vector/SmallTemporaryHeap")
+{
+	state.SetItemsPerIteration(NUM_SMALL_VECTORS);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iVec = 0; iVec < NUM_SMALL_VECTORS; ++iVec)
+		{
+			moe::Vector<uint32_t> payload;
+			payload.Reserve(SMALL_VECTOR_SIZE);
+			for (uint32_t iElem = 0; iElem < SMALL_VECTOR_SIZE; ++iElem)
+			{
+				payload.PushBack(iElem);
+			}
+			moe::DoNotOptimize(payload.Data());
+		}
+	}
+}
+
+
+MOE_BENCHMARK(VectorSmallTemporaryScratch, "Vector/SmallTemporaryScratch")
+{
+	state.SetItemsPerIteration(NUM_SMALL_VECTORS);
+	while (state.KeepRunning())
+	{
+		moe::ScratchScope scratch;
+		for (uint32_t iVec = 0; iVec < NUM_SMALL_VECTORS; ++iVec)
+		{
+			moe::Vector<uint32_t, moe::ArenaAllocator<uint32_t>> payload{ moe::ArenaAllocator<uint32_t>(scratch.GetArena()) };
+			payload.Reserve(SMALL_VECTOR_SIZE);
+			for (uint32_t iElem = 0; iElem < SMALL_VECTOR_SIZE; ++iElem)
+			{
+				payload.PushBack(iElem);
+			}
+			moe::DoNotOptimize(payload.Data());
+		}
+	}
+}
@@ -0,0 +1,207 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Delegates/event.h"
+
+
+namespace
+{
+	const uint32_t	NUM_LISTENERS = 64;
+
+	// Gameplay events can have thousands of listeners, a few of them coming and going every frame.
+	const uint32_t	NUM_GAMEPLAY_LISTENERS = 4096;
+	const uint32_t	NUM_CHURNING_LISTENERS = NUM_GAMEPLAY_LISTENERS / 8;
+
+	const uint32_t	NUM_BATCH_PAYLOADS = 16;
+
+	int	gs_received = 0;
+
+	void	OnEventFree(int value)
+	{
+		gs_received += value;
+	}
+
+
+	struct Listener
+	{
+		void	OnEvent(int value)
+		{
+			m_received += value;
+		}
+
+		int	m_received = 0;
+	};
+}
+
+
+MOE_BENCHMARK(EventBroadcastFree, "Event/BroadcastFreeFunctions")
+{
+	moe::Event<void(int)> event;
+	for (uint32_t iListener = 0; iListener < NUM_LISTENERS; ++iListener)
+	{
+		event.Add<&OnEventFree>();
+	}
+
+	state.SetItemsPerIteration(NUM_LISTENERS);
+	while (state.KeepRunning())
+	{
+		event.Broadcast(1);
+	}
+
+	moe::DoNotOptimize(gs_received);
+}
+
+
+MOE_BENCHMARK(EventBroadcastMember, "Event/BroadcastMemberFunctions")
+{
+	std::vector<Listener> listeners(NUM_LISTENERS);
+
+	moe::Event<void(int)> event;
+	for (Listener& listener : listeners)
+	{
+		event.Add<Listener, &Listener::OnEvent>(&listener);
+	}
+
+	state.SetItemsPerIteration(NUM_LISTENERS);
+	while (state.KeepRunning())
+	{
+		event.Broadcast(1);
+	}
+
+	moe::DoNotOptimize(listeners[0].m_received);
+}
+
+
+MOE_BENCHMARK(EventBroadcastSingle, "Event/BroadcastSingleListener")
+{
+	Listener listener;
+
+	moe::Event<void(int)> event;
+	event.Add<Listener, &Listener::OnEvent>(&listener);
+
+	while (state.KeepRunning())
+	{
+		event.Broadcast(1);
+	}
+
+	moe::DoNotOptimize(listener.m_received);
+}
+
+
+MOE_BENCHMARK(EventAddRemove, "Event/AddRemove")
+{
+	std::vector<Listener> listeners(NUM_LISTENERS);
+	std::vector<moe::EventDelegateID> ids(NUM_LISTENERS);
+
+	moe::Event<void(int)> event;
+
+	state.SetItemsPerIteration(NUM_LISTENERS);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iListener = 0; iListener < NUM_LISTENERS; ++iListener)
+		{
+			ids[iListener] = event.Add<Listener, &Listener::OnEvent>(&listeners[iListener]);
+		}
+
+		// Unsubscribing in subscription order used to be the worst case of a linear search from the back.
+		for (moe::EventDelegateID id : ids)
+		{
+			event.Remove(id);
+		}
+	}
+}
+
+
+MOE_BENCHMARK(EventChurn, "Event/ChurnThousandsOfListeners")
+{
+	std::vector<Listener> listeners(NUM_GAMEPLAY_LISTENERS);
+	std::vector<moe::EventDelegateID> ids(NUM_GAMEPLAY_LISTENERS);
+
+	moe::Event<void(int)> event;
+	for (uint32_t iListener = 0; iListener < NUM_GAMEPLAY_LISTENERS; ++iListener)
+	{
+		ids[iListener] = event.Add<Listener, &Listener::OnEvent>(&listeners[iListener]);
+	}
+
+	// One "frame" : a slice of the listeners unsubscribes and subscribes back, then the event is broadcast.
+	uint32_t firstChurning = 0;
+	state.SetItemsPerIteration(NUM_GAMEPLAY_LISTENERS);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iListener = firstChurning; iListener < firstChurning + NUM_CHURNING_LISTENERS; ++iListener)
+		{
+			event.Remove(ids[iListener]);
+		}
+
+		for (uint32_t iListener = firstChurning; iListener < firstChurning + NUM_CHURNING_LISTENERS; ++iListener)
+		{
+			ids[iListener] = event.Add<Listener, &Listener::OnEvent>(&listeners[iListener]);
+		}
+
+		event.Broadcast(1);
+
+		firstChurning = (firstChurning + NUM_CHURNING_LISTENERS) % NUM_GAMEPLAY_LISTENERS;
+	}
+
+	moe::DoNotOptimize(listeners[0].m_received);
+}
+
+
+MOE_BENCHMARK(EventBroadcastLoop, "Event/BroadcastPayloadsOneByOne")
+{
+	std::vector<Listener> listeners(NUM_LISTENERS);
+	int payloads[NUM_BATCH_PAYLOADS];
+	for (uint32_t iPayload = 0; iPayload < NUM_BATCH_PAYLOADS; ++iPayload)
+	{
+		payloads[iPayload] = (int)iPayload;
+	}
+
+	moe::Event<void(int)> event;
+	for (Listener& listener : listeners)
+	{
+		event.Add<Listener, &Listener::OnEvent>(&listener);
+	}
+
+	state.SetItemsPerIteration(NUM_LISTENERS * NUM_BATCH_PAYLOADS);
+	while (state.KeepRunning())
+	{
+		for (int payload : payloads)
+		{
+			event.Broadcast(payload);
+		}
+	}
+
+	moe::DoNotOptimize(listeners[0].m_received);
+}
+
+
+MOE_BENCHMARK(EventBroadcastBatch, "Event/BroadcastPayloadsBatch")
+{
+	std::vector<Listener> listeners(NUM_LISTENERS);
+	int payloads[NUM_BATCH_PAYLOADS];
+	for (uint32_t iPayload = 0; iPayload < NUM_BATCH_PAYLOADS; ++iPayload)
+	{
+		payloads[iPayload] = (int)iPayload;
+	}
+
+	moe::Event<void(int)> event;
+	for (Listener& listener : listeners)
+	{
+		event.Add<Listener, &Listener::OnEvent>(&listener);
+	}
+
+	state.SetItemsPerIteration(NUM_LISTENERS * NUM_BATCH_PAYLOADS);
+	while (state.KeepRunning())
+	{
+		event.BroadcastBatch(payloads, NUM_BATCH_PAYLOADS);
+	}
+
+	moe::DoNotOptimize(listeners[0].m_received);
+}
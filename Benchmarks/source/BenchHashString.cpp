@@ -0,0 +1,65 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <string>
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/HashString/HashString.h"
+
+
+namespace
+{
+	// The length of a typical action, binding or asset name
+	const char*	ACTION_NAME = "Gameplay.Player.PrimaryFire";
+}
+
+
+MOE_BENCHMARK(HashStringRuntime, "HashString/RuntimeString")
+{
+	while (state.KeepRunning())
+	{
+		moe::HashString name(ACTION_NAME);
+		moe::DoNotOptimize(name);
+	}
+}
+
+
+MOE_BENCHMARK(HashStringRuntimeStdHash, "HashString/RuntimeStringStdHash")
+{
+	using StdHashString = moe::HashStringT<std::string, moe::StdHashPolicy<std::string>>;
+
+	while (state.KeepRunning())
+	{
+		StdHashString name(ACTION_NAME);
+		moe::DoNotOptimize(name);
+	}
+}
+
+
+// In "not shipping" modes, this still interns the string : in Shipping, it is only a constant.
+MOE_BENCHMARK(HashStringLiteral, "HashString/Literal")
+{
+	using namespace moe::literals;
+
+	while (state.KeepRunning())
+	{
+		moe::HashString name = "Gameplay.Player.PrimaryFire"_hs;
+		moe::DoNotOptimize(name);
+	}
+}
+
+
+MOE_BENCHMARK(HashStringLiteralID, "HashString/LiteralID")
+{
+	using namespace moe::literals;
+
+	while (state.KeepRunning())
+	{
+		moe::HashString name(moe::HashID("Gameplay.Player.PrimaryFire"_hs));
+		moe::DoNotOptimize(name);
+	}
+}
@@ -0,0 +1,62 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Log/moeLog.h"
+#include "Core/Log/Policies/NoWritePolicy.h"
+
+
+// The write policy discards everything : these measure the cost of logging itself, not of the disk or the console.
+
+MOE_BENCHMARK(LogUnformatted, "Log/Unformatted")
+{
+	moe::StdLogger<moe::NoFilterPolicy, moe::NoFormatPolicy, moe::NoWritePolicy> logger;
+
+	while (state.KeepRunning())
+	{
+		MOE_LOGGER_INFO(logger, moe::ChanDefault, "Frame %d took %.3f ms", 1234, 16.667f);
+	}
+}
+
+
+MOE_BENCHMARK(LogFormatted, "Log/DebuggerFormat")
+{
+	moe::StdLogger<moe::NoFilterPolicy, moe::DebuggerFormatPolicy, moe::NoWritePolicy> logger;
+
+	while (state.KeepRunning())
+	{
+		MOE_LOGGER_INFO(logger, moe::ChanDefault, "Frame %d took %.3f ms", 1234, 16.667f);
+	}
+}
+
+
+MOE_BENCHMARK(LogFilteredOut, "Log/FilteredOut")
+{
+	moe::StdLogger<moe::SeverityFilterPolicy, moe::DebuggerFormatPolicy, moe::NoWritePolicy> logger;
+	logger.GetFilterPolicy().SetFilterSeverity(moe::SevError);
+
+	while (state.KeepRunning())
+	{
+		MOE_LOGGER_INFO(logger, moe::ChanDefault, "Frame %d took %.3f ms", 1234, 16.667f);
+	}
+}
+
+
+MOE_BENCHMARK(LogAsync, "Log/Async")
+{
+	moe::AsyncLoggerConfig config;
+	config.m_fullPolicy = moe::AsyncLogFullPolicy::Block; // measure the sustained throughput, not how fast messages are dropped
+
+	moe::AsyncLogger<moe::NoFilterPolicy, moe::DebuggerFormatPolicy, moe::NoWritePolicy> logger(config);
+
+	while (state.KeepRunning())
+	{
+		MOE_LOGGER_INFO(logger, moe::ChanDefault, "Frame %d took %.3f ms", 1234, 16.667f);
+	}
+
+	logger.Flush();
+}
@@ -0,0 +1,110 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <random>
+#include <vector>
+
+#include "Math/Matrix.h"
+#include "Math/Vec3.h"
+#include "Math/Vec4.h"
+
+
+namespace
+{
+	const uint32_t	NUM_MATRICES = 1024;
+
+
+	std::vector<moe::Mat4>	MakeRandomMatrices(uint32_t count)
+	{
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> posDist(-100.f, 100.f);
+		std::uniform_real_distribution<float> angleDist(-180.f, 180.f);
+
+		std::vector<moe::Mat4> matrices;
+		matrices.reserve(count);
+
+		for (uint32_t iMat = 0; iMat < count; ++iMat)
+		{
+			matrices.push_back(moe::Mat4::Translation(posDist(rng), posDist(rng), posDist(rng))
+				* moe::Mat4::Rotation(moe::Degs_f(angleDist(rng)), moe::Vec3(0.f, 1.f, 0.f))
+				* moe::Mat4::Scaling(2.f, 2.f, 2.f));
+		}
+
+		return matrices;
+	}
+}
+
+
+MOE_BENCHMARK(MathMat4Multiply, "Math/Mat4Multiply")
+{
+	const std::vector<moe::Mat4> lhs = MakeRandomMatrices(NUM_MATRICES);
+	const std::vector<moe::Mat4> rhs = MakeRandomMatrices(NUM_MATRICES);
+	std::vector<moe::Mat4> results(NUM_MATRICES);
+
+	state.SetItemsPerIteration(NUM_MATRICES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iMat = 0; iMat < NUM_MATRICES; ++iMat)
+		{
+			results[iMat] = lhs[iMat] * rhs[iMat];
+		}
+		moe::ClobberMemory();
+	}
+}
+
+
+MOE_BENCHMARK(MathMat4Inverse, "Math/Mat4Inverse")
+{
+	const std::vector<moe::Mat4> matrices = MakeRandomMatrices(NUM_MATRICES);
+	std::vector<moe::Mat4> results(NUM_MATRICES);
+
+	state.SetItemsPerIteration(NUM_MATRICES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iMat = 0; iMat < NUM_MATRICES; ++iMat)
+		{
+			results[iMat] = matrices[iMat].GetInverse();
+		}
+		moe::ClobberMemory();
+	}
+}
+
+
+MOE_BENCHMARK(MathMat4TransformPoints, "Math/Mat4TransformPoints")
+{
+	moe::Mat4 transform = MakeRandomMatrices(1)[0];
+
+	std::vector<moe::Vec4> points(NUM_MATRICES, moe::Vec4(1.f, 2.f, 3.f, 1.f));
+	std::vector<moe::Vec4> results(NUM_MATRICES);
+
+	state.SetItemsPerIteration(NUM_MATRICES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iPoint = 0; iPoint < NUM_MATRICES; ++iPoint)
+		{
+			results[iPoint] = transform * points[iPoint];
+		}
+		moe::ClobberMemory();
+	}
+}
+
+
+MOE_BENCHMARK(MathMat4Build, "Math/Mat4TranslateRotateScale")
+{
+	std::vector<moe::Mat4> results(NUM_MATRICES);
+	float angle = 0.f;
+
+	state.SetItemsPerIteration(NUM_MATRICES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iMat = 0; iMat < NUM_MATRICES; ++iMat)
+		{
+			angle += 0.1f;
+			results[iMat] = moe::Mat4::Translation(angle, 0.f, -angle)
+				* moe::Mat4::Rotation(moe::Degs_f(angle), moe::Vec3(0.f, 1.f, 0.f))
+				* moe::Mat4::Scaling(1.5f, 1.5f, 1.5f);
+		}
+		moe::ClobberMemory();
+	}
+}
@@ -0,0 +1,118 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <random>
+#include <vector>
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Jobs/JobSystem.h"
+
+#include "Graphics/SceneGraph/SceneGraph.h"
+
+
+namespace
+{
+	const uint32_t	NUM_NODES = 10000;
+
+
+	moe::Transform	RandomTransform(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> posDist(-10.f, 10.f);
+		std::uniform_real_distribution<float> angleDist(-180.f, 180.f);
+
+		return moe::Transform::Translate(moe::Vec3(posDist(rng), posDist(rng), posDist(rng)))
+			* moe::Transform::Rotate(moe::Degs_f(angleDist(rng)), moe::Vec3(0.f, 1.f, 0.f));
+	}
+
+
+	/**
+	 * \brief A scene of a few dozen root objects with random, shallow hierarchies below them, like a level full of props.
+	 */
+	struct BenchScene
+	{
+		BenchScene() :
+			m_graph(NUM_NODES)
+		{
+			std::mt19937 rng(2021);
+
+			for (uint32_t iNode = 0; iNode < NUM_NODES; ++iNode)
+			{
+				const bool isRoot = (iNode < 32);
+				const moe::SceneNodeHandle parent = (isRoot ? moe::SceneGraph::GetRootHandle() : m_nodes[rng() % m_nodes.size()]);
+
+				m_nodes.push_back(m_graph.CreateNode<moe::ASceneNode>(parent, RandomTransform(rng)));
+				m_locals.push_back(RandomTransform(rng));
+			}
+
+			m_graph.UpdateWorldTransforms();
+		}
+
+		moe::SceneGraph						m_graph;
+		std::vector<moe::SceneNodeHandle>	m_nodes;
+		std::vector<moe::Transform>			m_locals;
+	};
+}
+
+
+MOE_BENCHMARK(SceneGraphUpdateAll, "SceneGraph/UpdateAllDirty")
+{
+	BenchScene scene;
+
+	state.SetItemsPerIteration(NUM_NODES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iNode = 0; iNode < NUM_NODES; ++iNode)
+		{
+			scene.m_graph.SetLocalTransform(scene.m_nodes[iNode], scene.m_locals[iNode]);
+		}
+
+		scene.m_graph.UpdateWorldTransforms();
+	}
+}
+
+
+MOE_BENCHMARK(SceneGraphUpdateFew, "SceneGraph/UpdateFewDirty")
+{
+	BenchScene scene;
+
+	// Most frames, only a few objects move.
+	const uint32_t numEdits = NUM_NODES / 100;
+
+	state.SetItemsPerIteration(numEdits);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iEdit = 0; iEdit < numEdits; ++iEdit)
+		{
+			const uint32_t iNode = (iEdit * 7919) % NUM_NODES;
+			scene.m_graph.SetLocalTransform(scene.m_nodes[iNode], scene.m_locals[iNode]);
+		}
+
+		scene.m_graph.UpdateWorldTransforms();
+	}
+}
+
+
+MOE_BENCHMARK(SceneGraphUpdateAllParallel, "SceneGraph/UpdateAllDirtyParallel")
+{
+	BenchScene scene;
+
+	moe::JobSystem jobSystem;
+
+	state.SetItemsPerIteration(NUM_NODES);
+	while (state.KeepRunning())
+	{
+		for (uint32_t iNode = 0; iNode < NUM_NODES; ++iNode)
+		{
+			scene.m_graph.SetLocalTransform(scene.m_nodes[iNode], scene.m_locals[iNode]);
+		}
+
+		scene.m_graph.UpdateWorldTransforms(jobSystem);
+
+		// One update per frame : start each one from fresh job allocators, like a game loop would.
+		jobSystem.NewFrame();
+	}
+}
@@ -0,0 +1,48 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <string>
+
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/StringFormat/moeStringFormat.h"
+
+
+MOE_BENCHMARK(StringFormatMixed, "StringFormat/MixedArguments")
+{
+	std::string formatted;
+	const std::string name = "otter";
+
+	while (state.KeepRunning())
+	{
+		moe::StringFormat(formatted, "Loaded %s (%d vertices, %.2f ms) from %s", name, 42000, 3.14f, "Resources/models/otter.obj");
+		moe::DoNotOptimize(formatted.data());
+	}
+}
+
+
+MOE_BENCHMARK(StringFormatNoArgument, "StringFormat/NoArgument")
+{
+	std::string formatted;
+
+	while (state.KeepRunning())
+	{
+		moe::StringFormat(formatted, "A format string without any argument");
+		moe::DoNotOptimize(formatted.data());
+	}
+}
+
+
+MOE_BENCHMARK(StringFormatWide, "StringFormat/Wide")
+{
+	std::wstring formatted;
+
+	while (state.KeepRunning())
+	{
+		moe::StringFormat(formatted, L"%ls has %d children", L"root", 12);
+		moe::DoNotOptimize(formatted.data());
+	}
+}
@@ -0,0 +1,357 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+
+namespace moe
+{
+	std::vector<BenchmarkDesc>&	GetRegisteredBenchmarks()
+	{
+		// Function-local static : benchmarks register themselves during static initialization, in any translation unit order.
+		static std::vector<BenchmarkDesc> benchmarks;
+		return benchmarks;
+	}
+}
+
+
+namespace
+{
+	struct BenchmarkOptions
+	{
+		std::string	m_filter;
+		std::string	m_jsonPath;
+		uint32_t	m_numSamples = 20;
+		uint32_t	m_numWarmupSamples = 2;
+		double		m_minSampleTimeMs = 10.;
+		bool		m_listOnly = false;
+	};
+
+
+	struct BenchmarkResult
+	{
+		std::string	m_name;
+		uint64_t	m_iterationsPerSample = 0;
+		uint64_t	m_itemsPerIteration = 0;
+
+		// All in nanoseconds per iteration
+		double	m_min = 0.;
+		double	m_max = 0.;
+		double	m_median = 0.;
+		double	m_mean = 0.;
+		double	m_stddev = 0.;
+		double	m_mad = 0.; // Median absolute deviation : unlike the standard deviation, not thrown off by a few preempted samples.
+
+		[[nodiscard]] double	GetItemsPerSecond() const
+		{
+			return (m_itemsPerIteration != 0 && m_median > 0. ? m_itemsPerIteration * 1e9 / m_median : 0.);
+		}
+
+		// A benchmark whose samples vary by more than that should not be trusted to compare runs.
+		static constexpr double	ms_UNSTABLE_THRESHOLD = 0.05;
+
+		[[nodiscard]] bool	IsUnstable() const
+		{
+			return m_median > 0. && m_mad / m_median > ms_UNSTABLE_THRESHOLD;
+		}
+	};
+
+
+	double	RunSample(moe::BenchmarkFunction function, uint64_t numIterations, uint64_t& itemsPerIteration)
+	{
+		moe::BenchmarkState state(numIterations);
+		function(state);
+		itemsPerIteration = state.GetItemsPerIteration();
+		return state.GetElapsedNanoseconds();
+	}
+
+
+	// Finds how many iterations a sample needs to last at least the minimum sample time,
+	// for the clock resolution and the loop overhead to be negligible.
+	uint64_t	CalibrateIterations(moe::BenchmarkFunction function, double minSampleTimeNs)
+	{
+		static const uint64_t MAX_ITERATIONS = 1000000000;
+
+		uint64_t numIterations = 1;
+		uint64_t itemsPerIteration = 0;
+
+		while (numIterations < MAX_ITERATIONS)
+		{
+			const double elapsed = RunSample(function, numIterations, itemsPerIteration);
+			if (elapsed >= minSampleTimeNs)
+			{
+				break;
+			}
+
+			// Aim a bit above the minimum, but don't trust a too short measure to grow more than tenfold at once.
+			const double wanted = numIterations * minSampleTimeNs * 1.2 / std::max(elapsed, 1.);
+			numIterations = (uint64_t)std::min(std::max(wanted, numIterations * 2.), numIterations * 10.);
+		}
+
+		return std::min(numIterations, MAX_ITERATIONS);
+	}
+
+
+	double	Median(std::vector<double> values)
+	{
+		std::sort(values.begin(), values.end());
+
+		const size_t mid = values.size() / 2;
+		return (values.size() % 2 != 0 ? values[mid] : (values[mid - 1] + values[mid]) * 0.5);
+	}
+
+
+	BenchmarkResult	RunBenchmark(const moe::BenchmarkDesc& desc, const BenchmarkOptions& options)
+	{
+		BenchmarkResult result;
+		result.m_name = desc.m_name;
+		result.m_iterationsPerSample = CalibrateIterations(desc.m_function, options.m_minSampleTimeMs * 1e6);
+
+		for (uint32_t iWarmup = 0; iWarmup < options.m_numWarmupSamples; ++iWarmup)
+		{
+			RunSample(desc.m_function, result.m_iterationsPerSample, result.m_itemsPerIteration);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.m_numSamples);
+
+		for (uint32_t iSample = 0; iSample < options.m_numSamples; ++iSample)
+		{
+			const double elapsed = RunSample(desc.m_function, result.m_iterationsPerSample, result.m_itemsPerIteration);
+			samples.push_back(elapsed / result.m_iterationsPerSample);
+		}
+
+		result.m_min = *std::min_element(samples.begin(), samples.end());
+		result.m_max = *std::max_element(samples.begin(), samples.end());
+		result.m_median = Median(samples);
+
+		double sum = 0.;
+		for (double sample : samples)
+			sum += sample;
+		result.m_mean = sum / samples.size();
+
+		double squaredDeviations = 0.;
+		std::vector<double> absDeviations;
+		absDeviations.reserve(samples.size());
+		for (double sample : samples)
+		{
+			squaredDeviations += (sample - result.m_mean) * (sample - result.m_mean);
+			absDeviations.push_back(std::abs(sample - result.m_median));
+		}
+
+		result.m_stddev = (samples.size() > 1 ? std::sqrt(squaredDeviations / (samples.size() - 1)) : 0.);
+		result.m_mad = Median(absDeviations);
+
+		return result;
+	}
+
+
+	void	PrintHeader()
+	{
+		std::printf("%-44s %12s %12s %12s %8s %14s\n", "Benchmark", "Median (ns)", "Min (ns)", "Mean (ns)", "MAD %", "Items/s");
+		std::printf("%s\n", std::string(107, '-').c_str());
+	}
+
+
+	void	PrintResult(const BenchmarkResult& result)
+	{
+		const double madPercent = (result.m_median > 0. ? 100. * result.m_mad / result.m_median : 0.);
+
+		char itemsPerSecond[32] = "-";
+		if (result.GetItemsPerSecond() > 0.)
+		{
+			std::snprintf(itemsPerSecond, sizeof(itemsPerSecond), "%.4g", result.GetItemsPerSecond());
+		}
+
+		std::printf("%-44s %12.2f %12.2f %12.2f %7.2f%% %14s%s\n", result.m_name.c_str(), result.m_median, result.m_min, result.m_mean,
+			madPercent, itemsPerSecond, (result.IsUnstable() ? "  (unstable)" : ""));
+		std::fflush(stdout);
+	}
+
+
+	std::string	EscapeJson(const std::string& str)
+	{
+		std::string escaped;
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+
+	const char*	GetCompilerName()
+	{
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc";
+#else
+		return "unknown";
+#endif
+	}
+
+
+	/**
+	 * \brief Writes the results with the run context, so that two runs can be compared by a script
+	 * (and so that comparing a debug run with a release run is easy to catch).
+	 */
+	bool	WriteJson(const std::string& path, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::fprintf(stderr, "Could not open %s to write benchmark results\n", path.c_str());
+			return false;
+		}
+
+		char date[32] = "";
+		const std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#ifdef NDEBUG
+		const char* buildType = "release";
+#else
+		const char* buildType = "debug";
+#endif
+
+		file << "{\n";
+		file << "\t\"context\": {\n";
+		file << "\t\t\"date\": \"" << date << "\",\n";
+		file << "\t\t\"compiler\": \"" << EscapeJson(GetCompilerName()) << "\",\n";
+		file << "\t\t\"build_type\": \"" << buildType << "\",\n";
+		file << "\t\t\"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+		file << "\t\t\"samples\": " << options.m_numSamples << ",\n";
+		file << "\t\t\"min_sample_time_ms\": " << options.m_minSampleTimeMs << "\n";
+		file << "\t},\n";
+		file << "\t\"benchmarks\": [";
+
+		file.precision(6);
+		file << std::fixed;
+
+		for (size_t iResult = 0; iResult < results.size(); ++iResult)
+		{
+			const BenchmarkResult& result = results[iResult];
+			file << (iResult == 0 ? "\n" : ",\n");
+			file << "\t\t{\n";
+			file << "\t\t\t\"name\": \"" << EscapeJson(result.m_name) << "\",\n";
+			file << "\t\t\t\"iterations\": " << result.m_iterationsPerSample << ",\n";
+			file << "\t\t\t\"median_ns\": " << result.m_median << ",\n";
+			file << "\t\t\t\"min_ns\": " << result.m_min << ",\n";
+			file << "\t\t\t\"max_ns\": " << result.m_max << ",\n";
+			file << "\t\t\t\"mean_ns\": " << result.m_mean << ",\n";
+			file << "\t\t\t\"stddev_ns\": " << result.m_stddev << ",\n";
+			file << "\t\t\t\"mad_ns\": " << result.m_mad << ",\n";
+			file << "\t\t\t\"items_per_second\": " << result.GetItemsPerSecond() << ",\n";
+			file << "\t\t\t\"unstable\": " << (result.IsUnstable() ? "true" : "false") << "\n";
+			file << "\t\t}";
+		}
+
+		file << "\n\t]\n}\n";
+		return file.good();
+	}
+
+
+	void	PrintUsage(const char* program)
+	{
+		std::printf("Usage: %s [options]\n", program);
+		std::printf("  --filter <text>        Only run the benchmarks whose name contains this text\n");
+		std::printf("  --json <file>          Also write the results to this JSON file\n");
+		std::printf("  --samples <n>          Number of measured samples per benchmark (default 20)\n");
+		std::printf("  --warmup <n>           Number of discarded samples run first (default 2)\n");
+		std::printf("  --min-time <ms>        Minimum duration of a sample (default 10)\n");
+		std::printf("  --list                 List the benchmarks and exit\n");
+	}
+
+
+	bool	ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+	{
+		for (int iArg = 1; iArg < argc; ++iArg)
+		{
+			const char* arg = argv[iArg];
+			const bool hasValue = (iArg + 1 < argc);
+
+			if (std::strcmp(arg, "--filter") == 0 && hasValue)
+				options.m_filter = argv[++iArg];
+			else if (std::strcmp(arg, "--json") == 0 && hasValue)
+				options.m_jsonPath = argv[++iArg];
+			else if (std::strcmp(arg, "--samples") == 0 && hasValue)
+				options.m_numSamples = (uint32_t)std::max(std::atoi(argv[++iArg]), 1);
+			else if (std::strcmp(arg, "--warmup") == 0 && hasValue)
+				options.m_numWarmupSamples = (uint32_t)std::max(std::atoi(argv[++iArg]), 0);
+			else if (std::strcmp(arg, "--min-time") == 0 && hasValue)
+				options.m_minSampleTimeMs = std::max(std::atof(argv[++iArg]), 0.001);
+			else if (std::strcmp(arg, "--list") == 0)
+				options.m_listOnly = true;
+			else
+				return false;
+		}
+
+		return true;
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	std::vector<moe::BenchmarkDesc> selected;
+	for (const moe::BenchmarkDesc& desc : moe::GetRegisteredBenchmarks())
+	{
+		if (desc.m_name.find(options.m_filter) != std::string::npos)
+		{
+			selected.push_back(desc);
+		}
+	}
+
+	if (options.m_listOnly)
+	{
+		for (const moe::BenchmarkDesc& desc : selected)
+			std::printf("%s\n", desc.m_name.c_str());
+		return 0;
+	}
+
+	if (selected.empty())
+	{
+		std::fprintf(stderr, "No benchmark matches the filter \"%s\"\n", options.m_filter.c_str());
+		return 1;
+	}
+
+#ifndef NDEBUG
+	std::printf("Warning: this is not an optimized build, timings are not representative.\n\n");
+#endif
+
+	PrintHeader();
+
+	std::vector<BenchmarkResult> results;
+	for (const moe::BenchmarkDesc& desc : selected)
+	{
+		results.push_back(RunBenchmark(desc, options));
+		PrintResult(results.back());
+	}
+
+	if (!options.m_jsonPath.empty() && !WriteJson(options.m_jsonPath, results, options))
+	{
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,149 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h> // _ReadWriteBarrier
+#endif
+
+
+namespace moe
+{
+	/**
+	 * \brief What a benchmark function receives : the measured code goes in a while (state.KeepRunning()) loop.
+	 * The runner decides how many iterations a sample needs, so the benchmark should not assume any count.
+	 * Setup that should not be measured can be excluded with PauseTiming/ResumeTiming, but they are not free :
+	 * prefer doing the setup before the loop.
+	 */
+	class BenchmarkState
+	{
+	public:
+
+		using Clock = std::chrono::steady_clock;
+
+		explicit BenchmarkState(uint64_t numIterations) :
+			m_numIterations(numIterations),
+			m_iterationsLeft(numIterations)
+		{}
+
+		bool	KeepRunning()
+		{
+			if (m_iterationsLeft == 0)
+			{
+				m_end = Clock::now();
+				return false;
+			}
+
+			if (!m_started)
+			{
+				m_started = true;
+				m_start = Clock::now();
+			}
+
+			m_iterationsLeft--;
+			return true;
+		}
+
+		void	PauseTiming()	{ m_pauseStart = Clock::now(); }
+
+		void	ResumeTiming()	{ m_paused += Clock::now() - m_pauseStart; }
+
+		/**
+		 * \brief Tells how many items (elements, nodes, messages...) one iteration processes, to report a throughput.
+		 */
+		void	SetItemsPerIteration(uint64_t numItems)	{ m_itemsPerIteration = numItems; }
+
+		[[nodiscard]] uint64_t	GetNumIterations() const		{ return m_numIterations; }
+
+		[[nodiscard]] uint64_t	GetItemsPerIteration() const	{ return m_itemsPerIteration; }
+
+		/**
+		 * \return The measured time of the whole loop, paused time excluded, in nanoseconds.
+		 */
+		[[nodiscard]] double	GetElapsedNanoseconds() const
+		{
+			return std::chrono::duration<double, std::nano>(m_end - m_start - m_paused).count();
+		}
+
+	private:
+
+		uint64_t	m_numIterations = 0;
+		uint64_t	m_iterationsLeft = 0;
+		uint64_t	m_itemsPerIteration = 0;
+		bool		m_started = false;
+
+		Clock::time_point	m_start{};
+		Clock::time_point	m_end{};
+		Clock::time_point	m_pauseStart{};
+		Clock::duration		m_paused{ 0 };
+	};
+
+
+	/**
+	 * \brief Makes the compiler believe the value is used, so that the computation producing it cannot be optimized away.
+	 */
+	template <typename T>
+	inline void	DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		const volatile char* volatile sink = reinterpret_cast<const volatile char*>(&value);
+		(void)sink;
+		_ReadWriteBarrier();
+#endif
+	}
+
+
+	/**
+	 * \brief Makes the compiler believe all memory may have been read and written, so that stores cannot be optimized away.
+	 */
+	inline void	ClobberMemory()
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : : "memory");
+#else
+		_ReadWriteBarrier();
+#endif
+	}
+
+
+	using BenchmarkFunction = void(*)(BenchmarkState&);
+
+	struct BenchmarkDesc
+	{
+		std::string			m_name;
+		BenchmarkFunction	m_function = nullptr;
+	};
+
+
+	/**
+	 * \brief The benchmarks registered with MOE_BENCHMARK, in registration order.
+	 */
+	std::vector<BenchmarkDesc>&	GetRegisteredBenchmarks();
+
+
+	struct BenchmarkRegistrar
+	{
+		BenchmarkRegistrar(const char* name, BenchmarkFunction function)
+		{
+			GetRegisteredBenchmarks().push_back({ name, function });
+		}
+	};
+
+}
+
+
+/**
+ * \brief Declares and registers a benchmark. Names are "Group/Name" : the group is what --filter usually matches.
+ * Usage : MOE_BENCHMARK(FreelistAdd, "Freelist/Add") { ... while (state.KeepRunning()) { ... } }
+ */
+#define MOE_BENCHMARK(Function, Name) \
+	static void Function(moe::BenchmarkState& state); \
+	static const moe::BenchmarkRegistrar Function##_registrar(Name, &Function); \
+	static void Function(moe::BenchmarkState& state)
@@ -21,6 +21,87 @@ function(MONOCLE_TARGET_COMPILE_CONFIG TARGET_NAME)
 	if(EXISTS ${AUTO_REGEN_SCRIPT})
 		target_sources(${TARGET_NAME} PRIVATE ${AUTO_REGEN_SCRIPT})
 	endif()
+
+	monocle_prehash_strings(${TARGET_NAME})
+endfunction()
+
+
+# Runs the HashStringGenerator on the sources of the target :
+# - the build fails if two hash strings collide, and the debug names of all the hash string IDs are written to
+#   <target>_HashStrings.map, next to the binaries (to make sense of the IDs in the logs of a Shipping build).
+# - in Shipping builds, the .cpp files are compiled from a copy where the HashString("...") and "..."_hs literals
+#   are replaced by their hash : no strings in the binary, and no hashing at startup.
+#   All of them are rewritten (a copy without hash strings is the same file), so that a literal added later is never missed.
+#   Headers cannot be rewritten : in Shipping builds, a hash string literal in a header is a build error.
+function(MONOCLE_PREHASH_STRINGS TARGET_NAME)
+	set(GENERATOR_TARGET ${PROJECT_NAME}_HashStringGenerator)
+	if(NOT TARGET ${GENERATOR_TARGET})
+		return()
+	endif()
+
+	get_target_property(TARGET_SOURCES ${TARGET_NAME} SOURCES)
+	set(PREHASHED_DIR "${CMAKE_CURRENT_BINARY_DIR}/PrehashedStrings")
+
+	set(SCANNED_SOURCES "")
+	set(ORIGINAL_SOURCES "")
+	set(REWRITTEN_SOURCES "")
+	set(ORIGINAL_SOURCE_DIRS "")
+
+	foreach(SOURCE ${TARGET_SOURCES})
+		get_filename_component(SOURCE_EXT ${SOURCE} LAST_EXT)
+		if(NOT SOURCE_EXT MATCHES "^\\.(cpp|h|hpp)$")
+			continue()
+		endif()
+
+		get_filename_component(SOURCE_PATH ${SOURCE} ABSOLUTE)
+		list(APPEND SCANNED_SOURCES ${SOURCE_PATH})
+
+		if(${PROJECT_NAME}_SHIPPING AND SOURCE_EXT STREQUAL ".cpp")
+			file(RELATIVE_PATH REWRITTEN_PATH ${CMAKE_CURRENT_SOURCE_DIR} ${SOURCE_PATH})
+			string(REPLACE "../" "__/" REWRITTEN_PATH ${REWRITTEN_PATH})
+			set(REWRITTEN_PATH "${PREHASHED_DIR}/${REWRITTEN_PATH}")
+
+			add_custom_command(OUTPUT ${REWRITTEN_PATH}
+				COMMAND ${GENERATOR_TARGET} --rewrite ${SOURCE_PATH} ${REWRITTEN_PATH}
+				DEPENDS ${GENERATOR_TARGET} ${SOURCE_PATH}
+				VERBATIM)
+
+			list(APPEND ORIGINAL_SOURCES ${SOURCE})
+			list(APPEND REWRITTEN_SOURCES ${REWRITTEN_PATH})
+
+			get_filename_component(SOURCE_DIR ${SOURCE_PATH} DIRECTORY)
+			list(APPEND ORIGINAL_SOURCE_DIRS ${SOURCE_DIR})
+		endif()
+	endforeach()
+
+	if(REWRITTEN_SOURCES)
+		list(REMOVE_ITEM TARGET_SOURCES ${ORIGINAL_SOURCES})
+		set_property(TARGET ${TARGET_NAME} PROPERTY SOURCES ${TARGET_SOURCES} ${REWRITTEN_SOURCES})
+
+		# The copies still include headers relative to the directory of their original file.
+		list(REMOVE_DUPLICATES ORIGINAL_SOURCE_DIRS)
+		target_include_directories(${TARGET_NAME} PRIVATE ${ORIGINAL_SOURCE_DIRS})
+	endif()
+
+	# Big targets have too many sources for a command line on Windows : give them in a file.
+	set(SOURCE_LIST_FILE "${PREHASHED_DIR}/${TARGET_NAME}_Sources.txt")
+	string(REPLACE ";" "\n" SOURCE_LIST "${SCANNED_SOURCES}")
+	file(WRITE ${SOURCE_LIST_FILE} "${SOURCE_LIST}\n")
+
+	set(SHIPPING_FLAG "")
+	if(${PROJECT_NAME}_SHIPPING)
+		set(SHIPPING_FLAG "--shipping")
+	endif()
+
+	set(MAP_FILE "${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/${TARGET_NAME}_HashStrings.map")
+	add_custom_command(OUTPUT ${MAP_FILE}
+		COMMAND ${GENERATOR_TARGET} --map ${MAP_FILE} ${SHIPPING_FLAG} @${SOURCE_LIST_FILE}
+		DEPENDS ${GENERATOR_TARGET} ${SCANNED_SOURCES}
+		COMMENT "Checking the hash strings of ${TARGET_NAME}"
+		VERBATIM)
+
+	add_custom_target(${TARGET_NAME}_HashStrings DEPENDS ${MAP_FILE})
+	add_dependencies(${TARGET_NAME} ${TARGET_NAME}_HashStrings)
 endfunction()
 
 
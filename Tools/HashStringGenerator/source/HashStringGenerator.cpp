@@ -0,0 +1,218 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+/*
+	Offline pre-hashing of the hash strings of the engine (cf. HashString.h).
+	It finds the string literals given to a HashString constructor (HashString("Name"), HashString name("Name")...)
+	and the "Name"_hs literals, and uses the same FNV-1a hash as the engine to :
+	- write a map of all the hash strings of a set of sources (the debug names of the IDs), failing if two of them collide.
+	- rewrite a source file with each of these literals replaced by its hash, for Shipping builds :
+		then the binary has neither the strings, nor the code to hash them at startup.
+
+	Only .cpp files can be rewritten : for Shipping builds, --map is given --shipping, and fails on hash string literals found in headers.
+
+	Usage:
+		HashStringGenerator --map <output map file> [--shipping] <source files...>
+		HashStringGenerator --rewrite <input source file> <output source file>
+	A @file argument is replaced by the source files listed in the file (one per line), to keep command lines short.
+*/
+
+#include "HashStringLexer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	bool	ReadFile(const std::string& filename, std::string& contents)
+	{
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+		{
+			std::fprintf(stderr, "error: cannot read %s\n", filename.c_str());
+			return false;
+		}
+
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		contents = stream.str();
+		return true;
+	}
+
+
+	bool	WriteFile(const std::string& filename, const std::string& contents)
+	{
+		const std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+		std::error_code error;
+		if (!directory.empty())
+			std::filesystem::create_directories(directory, error);
+
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(contents.data(), contents.size()))
+		{
+			std::fprintf(stderr, "error: cannot write %s\n", filename.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool	IsHeader(const std::string& filename)
+	{
+		const std::string extension = std::filesystem::path(filename).extension().string();
+		return (extension == ".h" || extension == ".hpp" || extension == ".inl");
+	}
+
+
+	int	GenerateMap(const std::string& mapFilename, const std::vector<std::string>& sourceFilenames, bool shipping)
+	{
+		struct MapEntry
+		{
+			moe::HashID	m_id;
+			std::string	m_value;
+			std::string	m_location;
+		};
+
+		std::vector<MapEntry> entries;
+		int numErrors = 0;
+
+		for (const std::string& sourceFilename : sourceFilenames)
+		{
+			std::string source;
+			if (!ReadFile(sourceFilename, source))
+				return 1;
+
+			const bool isHeader = IsHeader(sourceFilename);
+
+			for (const moe::FoundHashString& hashString : moe::FindHashStrings(source, sourceFilename))
+			{
+				std::string value = hashString.m_value;
+				if (hashString.m_kind == moe::HashStringKind::Constructor)
+					value = value.c_str();
+
+				// Headers are not rewritten : the string would end up in the Shipping binary.
+				if (shipping && isHeader)
+				{
+					std::fprintf(stderr, "%s(%u): error: hash string \"%s\" in a header cannot be prehashed for Shipping : move it to a .cpp file.\n",
+						sourceFilename.c_str(), hashString.m_line, moe::EscapeForDisplay(value).c_str());
+					numErrors++;
+				}
+
+				entries.push_back({ hashString.GetID(), std::move(value), sourceFilename + "(" + std::to_string(hashString.m_line) + ")" });
+			}
+		}
+
+		// Grouped by ID, and the same strings together : only the first use of each string is kept.
+		std::stable_sort(entries.begin(), entries.end(), [](const MapEntry& lhs, const MapEntry& rhs)
+		{
+			return (lhs.m_id != rhs.m_id ? lhs.m_id < rhs.m_id : lhs.m_value < rhs.m_value);
+		});
+
+		std::string map = "# Generated by HashStringGenerator : the debug names of the hash string IDs.\n";
+		size_t groupFirst = 0;
+
+		for (size_t iEntry = 0; iEntry < entries.size(); ++iEntry)
+		{
+			const MapEntry& entry = entries[iEntry];
+			if (iEntry == 0 || entries[groupFirst].m_id != entry.m_id)
+			{
+				groupFirst = iEntry;
+				map += moe::ToHex(entry.m_id) + "\t\"" + moe::EscapeForDisplay(entry.m_value) + "\"\n";
+			}
+			else if (entries[iEntry - 1].m_value != entry.m_value)
+			{
+				const MapEntry& kept = entries[groupFirst];
+				std::fprintf(stderr, "%s: error: hash string collision : \"%s\" and \"%s\" (%s) both hash to %s.\n",
+					entry.m_location.c_str(), moe::EscapeForDisplay(entry.m_value).c_str(), moe::EscapeForDisplay(kept.m_value).c_str(),
+					kept.m_location.c_str(), moe::ToHex(entry.m_id).c_str());
+				numErrors++;
+			}
+		}
+
+		if (numErrors != 0)
+		{
+			return 1;
+		}
+
+		return (WriteFile(mapFilename, map) ? 0 : 1);
+	}
+
+
+	int	RewriteSource(const std::string& inputFilename, const std::string& outputFilename)
+	{
+		std::string source;
+		if (!ReadFile(inputFilename, source))
+			return 1;
+
+		return (WriteFile(outputFilename, moe::RewriteHashStrings(source, inputFilename)) ? 0 : 1);
+	}
+
+
+	bool	ExpandSourceList(int argc, char** argv, std::vector<std::string>& sourceFilenames)
+	{
+		for (int iArg = 0; iArg < argc; ++iArg)
+		{
+			if (argv[iArg][0] != '@')
+			{
+				sourceFilenames.emplace_back(argv[iArg]);
+				continue;
+			}
+
+			std::string list;
+			if (!ReadFile(argv[iArg] + 1, list))
+				return false;
+
+			std::istringstream listStream(list);
+			std::string sourceFilename;
+			while (std::getline(listStream, sourceFilename))
+			{
+				if (!sourceFilename.empty() && sourceFilename.back() == '\r')
+					sourceFilename.pop_back();
+
+				if (!sourceFilename.empty())
+					sourceFilenames.push_back(sourceFilename);
+			}
+		}
+
+		return true;
+	}
+
+
+	void	PrintUsage(const char* programName)
+	{
+		std::printf("Usage:\n");
+		std::printf("  %s --map <output map file> [--shipping] <source files...>\n", programName);
+		std::printf("  %s --rewrite <input source file> <output source file>\n", programName);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	if (argc >= 3 && std::strcmp(argv[1], "--map") == 0)
+	{
+		const bool shipping = (argc >= 4 && std::strcmp(argv[3], "--shipping") == 0);
+		const int firstSource = (shipping ? 4 : 3);
+
+		std::vector<std::string> sourceFilenames;
+		if (!ExpandSourceList(argc - firstSource, argv + firstSource, sourceFilenames))
+			return 1;
+
+		return GenerateMap(argv[2], sourceFilenames, shipping);
+	}
+
+	if (argc == 4 && std::strcmp(argv[1], "--rewrite") == 0)
+	{
+		return RewriteSource(argv[2], argv[3]);
+	}
+
+	PrintUsage(argv[0]);
+	return 1;
+}
@@ -0,0 +1,320 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "HashStringLexer.h"
+
+#include <algorithm> // count
+#include <cstdio>
+
+
+namespace
+{
+	bool	IsIdentifierChar(char c)
+	{
+		return (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'));
+	}
+
+	bool	IsSpace(char c)
+	{
+		return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+	}
+
+	int		GetHexDigitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	}
+
+	/* A quote in a number is a digit separator (1'000'000), not the start of a character literal. */
+	bool	IsDigitSeparator(const std::string& source, size_t quotePos)
+	{
+		size_t tokenBegin = quotePos;
+		while (tokenBegin > 0 && (IsIdentifierChar(source[tokenBegin - 1]) || source[tokenBegin - 1] == '\''))
+			tokenBegin--;
+
+		return (tokenBegin < quotePos && source[tokenBegin] >= '0' && source[tokenBegin] <= '9');
+	}
+
+
+	/* Returns false if the literal uses an escape sequence we don't handle (the literal is then left alone). */
+	bool	UnescapeLiteral(const std::string& source, size_t begin, size_t end, std::string& unescaped)
+	{
+		unescaped.clear();
+
+		for (size_t iChar = begin; iChar < end; ++iChar)
+		{
+			if (source[iChar] != '\\')
+			{
+				unescaped += source[iChar];
+				continue;
+			}
+
+			const char escaped = source[++iChar];
+			switch (escaped)
+			{
+			case 'n':	unescaped += '\n'; break;
+			case 't':	unescaped += '\t'; break;
+			case 'r':	unescaped += '\r'; break;
+			case 'a':	unescaped += '\a'; break;
+			case 'b':	unescaped += '\b'; break;
+			case 'f':	unescaped += '\f'; break;
+			case 'v':	unescaped += '\v'; break;
+			case '\\':
+			case '\'':
+			case '"':
+			case '?':	unescaped += escaped; break;
+			case 'x':
+			{
+				unsigned value = 0;
+				size_t iDigit = iChar + 1;
+				for (; iDigit < end && GetHexDigitValue(source[iDigit]) != -1; ++iDigit)
+				{
+					value = value * 16 + GetHexDigitValue(source[iDigit]);
+				}
+
+				if (iDigit == iChar + 1)
+					return false;
+
+				unescaped += (char)value;
+				iChar = iDigit - 1;
+				break;
+			}
+			default:
+				if (escaped < '0' || escaped > '7')
+					return false;
+
+				unsigned value = 0;
+				size_t iDigit = iChar;
+				for (; iDigit < end && iDigit < iChar + 3 && source[iDigit] >= '0' && source[iDigit] <= '7'; ++iDigit)
+				{
+					value = value * 8 + (source[iDigit] - '0');
+				}
+
+				unescaped += (char)value;
+				iChar = iDigit - 1;
+				break;
+			}
+		}
+
+		return true;
+	}
+
+
+	/* Is the literal starting at this position the only argument of a HashString constructor ? */
+	bool	IsHashStringConstructorArgument(const std::string& source, size_t literalBegin, size_t literalEnd)
+	{
+		static const std::string	HASH_STRING_TYPE = "HashString";
+
+		size_t iAfter = literalEnd;
+		while (iAfter < source.size() && IsSpace(source[iAfter]))
+			iAfter++;
+
+		size_t iBefore = literalBegin;
+		while (iBefore > 0 && IsSpace(source[iBefore - 1]))
+			iBefore--;
+
+		if (iBefore == 0 || iAfter == source.size())
+			return false;
+
+		const char opening = source[iBefore - 1];
+		const char closing = source[iAfter];
+		if (!((opening == '(' && closing == ')') || (opening == '{' && closing == '}')))
+			return false;
+
+		iBefore--;
+		while (iBefore > 0 && IsSpace(source[iBefore - 1]))
+			iBefore--;
+
+		// Skip the name of the declared variable, if any : HashString name("Name")
+		size_t identifierBegin = iBefore;
+		while (identifierBegin > 0 && IsIdentifierChar(source[identifierBegin - 1]))
+			identifierBegin--;
+
+		std::string identifier = source.substr(identifierBegin, iBefore - identifierBegin);
+		if (identifier != HASH_STRING_TYPE)
+		{
+			iBefore = identifierBegin;
+			while (iBefore > 0 && IsSpace(source[iBefore - 1]))
+				iBefore--;
+
+			identifierBegin = iBefore;
+			while (identifierBegin > 0 && IsIdentifierChar(source[identifierBegin - 1]))
+				identifierBegin--;
+
+			identifier = source.substr(identifierBegin, iBefore - identifierBegin);
+		}
+
+		return (identifier == HASH_STRING_TYPE);
+	}
+}
+
+
+namespace moe
+{
+	std::vector<FoundHashString>	FindHashStrings(const std::string& source, const std::string& filename)
+	{
+		std::vector<FoundHashString> found;
+		uint32_t line = 1;
+
+		for (size_t iChar = 0; iChar < source.size(); ++iChar)
+		{
+			const char c = source[iChar];
+
+			if (c == '\n')
+			{
+				line++;
+			}
+			else if (c == '/' && iChar + 1 < source.size() && source[iChar + 1] == '/')
+			{
+				while (iChar + 1 < source.size() && source[iChar + 1] != '\n')
+					iChar++;
+			}
+			else if (c == '/' && iChar + 1 < source.size() && source[iChar + 1] == '*')
+			{
+				const size_t commentEnd = source.find("*/", iChar + 2);
+				const size_t last = (commentEnd == std::string::npos ? source.size() : commentEnd + 2);
+				line += (uint32_t)std::count(source.begin() + iChar, source.begin() + last, '\n');
+				iChar = last - 1;
+			}
+			else if (c == '\'' && !IsDigitSeparator(source, iChar))
+			{
+				iChar++;
+				while (iChar < source.size() && source[iChar] != '\'')
+				{
+					if (source[iChar] == '\\')
+						iChar++;
+					iChar++;
+				}
+			}
+			else if (c == '"' && iChar > 0 && source[iChar - 1] == 'R')
+			{
+				// Raw string : R"delimiter( ... )delimiter"
+				const size_t parenthesis = source.find('(', iChar);
+				if (parenthesis == std::string::npos)
+					break;
+
+				const std::string terminator = ")" + source.substr(iChar + 1, parenthesis - iChar - 1) + "\"";
+				const size_t rawEnd = source.find(terminator, parenthesis);
+				const size_t last = (rawEnd == std::string::npos ? source.size() : rawEnd + terminator.size());
+				line += (uint32_t)std::count(source.begin() + iChar, source.begin() + last, '\n');
+				iChar = last - 1;
+			}
+			else if (c == '"')
+			{
+				const size_t literalBegin = iChar;
+				iChar++;
+				while (iChar < source.size() && source[iChar] != '"' && source[iChar] != '\n')
+				{
+					if (source[iChar] == '\\')
+						iChar++;
+					iChar++;
+				}
+
+				size_t literalEnd = iChar + 1;
+
+				// Prefixed literals (L"", u8""...) are not hash strings
+				const bool prefixed = (literalBegin > 0 && IsIdentifierChar(source[literalBegin - 1]));
+
+				FoundHashString hashString;
+				hashString.m_line = line;
+
+				if (!prefixed && source.compare(literalEnd, 3, "_hs") == 0
+					&& (literalEnd + 3 == source.size() || !IsIdentifierChar(source[literalEnd + 3])))
+				{
+					hashString.m_kind = HashStringKind::Literal;
+					literalEnd += 3;
+				}
+				else if (prefixed || !IsHashStringConstructorArgument(source, literalBegin, literalEnd))
+				{
+					continue;
+				}
+
+				if (!UnescapeLiteral(source, literalBegin + 1, iChar, hashString.m_value))
+				{
+					std::fprintf(stderr, "%s(%u): warning: unsupported escape sequence, this hash string is not prehashed.\n", filename.c_str(), line);
+					continue;
+				}
+
+				hashString.m_begin = literalBegin;
+				hashString.m_end = literalEnd;
+				found.push_back(std::move(hashString));
+
+				iChar = literalEnd - 1;
+			}
+		}
+
+		return found;
+	}
+
+
+	std::string	RewriteHashStrings(const std::string& source, const std::string& filename)
+	{
+		// A UTF-8 byte order mark has to stay the very first thing in the file.
+		static const std::string	UTF8_BOM = "\xEF\xBB\xBF";
+		const bool hasBOM = (source.compare(0, UTF8_BOM.size(), UTF8_BOM) == 0);
+
+		// No line changes : the #line directive is enough to keep pointing to the original file.
+		std::string rewritten = (hasBOM ? UTF8_BOM : std::string()) + "#line 1 \"" + EscapeForDisplay(filename) + "\"\n";
+
+		size_t copiedUpTo = (hasBOM ? UTF8_BOM.size() : 0);
+		for (const FoundHashString& hashString : FindHashStrings(source, filename))
+		{
+			rewritten.append(source, copiedUpTo, hashString.m_begin - copiedUpTo);
+
+			const std::string hexID = ToHex(hashString.GetID()) + "ull";
+			if (hashString.m_kind == HashStringKind::Constructor)
+			{
+				rewritten += "moe::HashID(" + hexID + ")";
+			}
+			else
+			{
+				// No comma : the literal may be in a macro argument.
+				rewritten += "moe::HashLiteral{ " + hexID + " }";
+			}
+
+			copiedUpTo = hashString.m_end;
+		}
+
+		rewritten.append(source, copiedUpTo, std::string::npos);
+
+		return rewritten;
+	}
+
+
+	std::string	ToHex(HashID id)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "0x%016llx", (unsigned long long)id);
+		return buffer;
+	}
+
+
+	std::string	EscapeForDisplay(const std::string& value)
+	{
+		std::string escaped;
+		for (char c : value)
+		{
+			if (c == '\\' || c == '"')
+			{
+				escaped += '\\';
+				escaped += c;
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				char buffer[8];
+				std::snprintf(buffer, sizeof(buffer), "\\x%02x", (unsigned char)c);
+				escaped += buffer;
+			}
+			else
+			{
+				escaped += c;
+			}
+		}
+
+		return escaped;
+	}
+}
@@ -0,0 +1,57 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/HashString/HashString.h"
+
+#include <string>
+#include <vector>
+
+
+namespace moe
+{
+	enum class HashStringKind
+	{
+		Constructor,	// HashString("Name") : hashed up to the first null character, like at runtime
+		Literal			// "Name"_hs : hashed with its whole length
+	};
+
+
+	struct FoundHashString
+	{
+		size_t			m_begin = 0;	// The range of the string literal (and the _hs suffix) in the source
+		size_t			m_end = 0;
+		std::string		m_value;		// Unescaped
+		HashStringKind	m_kind = HashStringKind::Constructor;
+		uint32_t		m_line = 0;
+
+		[[nodiscard]] HashID	GetID() const
+		{
+			if (m_kind == HashStringKind::Constructor)
+			{
+				return FNV1aHash(m_value.c_str());
+			}
+
+			return FNV1aHash(m_value.data(), m_value.size());
+		}
+	};
+
+
+	/*
+		A small C++ lexer : just enough to skip comments, character literals and raw strings,
+		and find the string literals that are hash strings.
+		Literals with an escape sequence it does not understand are left out, with a warning mentioning the filename.
+	*/
+	std::vector<FoundHashString>	FindHashStrings(const std::string& source, const std::string& filename);
+
+	/*
+		Returns the source with each hash string literal replaced by its hash, for Shipping builds.
+		It starts with a #line directive, so that diagnostics and debug information keep pointing to the original file.
+	*/
+	std::string	RewriteHashStrings(const std::string& source, const std::string& filename);
+
+	/* Printable on one line, between double quotes : for the map, diagnostics and #line directives. */
+	std::string	EscapeForDisplay(const std::string& value);
+
+	std::string	ToHex(HashID id);
+}
@@ -0,0 +1,163 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include <string>
+#include <thread>
+
+#include "Core/Containers/HashMap/HashMap.h"
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Memory/ArenaAllocator.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Memory/ScratchArena.h"
+#include "Core/StringFormat/moeStringFormat.h"
+
+
+TEST_CASE("Arenas", "[Core]")
+{
+	using namespace moe;
+
+	SECTION("Linear arena")
+	{
+		LinearArena arena(1024);
+
+		void* first = arena.Allocate(10);
+		double* second = arena.Allocate<double>(4);
+		REQUIRE(first != nullptr);
+		REQUIRE(second != nullptr);
+		REQUIRE(reinterpret_cast<uintptr_t>(second) % alignof(double) == 0);
+		REQUIRE(arena.Owns(second));
+
+		// Only the last allocation can be freed individually
+		const size_t used = arena.GetUsedSize();
+		arena.Free(first, 10);
+		REQUIRE(arena.GetUsedSize() == used);
+		arena.Free(second, 4 * sizeof(double));
+		REQUIRE(arena.GetUsedSize() < used);
+
+		{
+			ArenaScope scope(arena);
+			REQUIRE(arena.Allocate(512) != nullptr);
+		}
+		REQUIRE(arena.GetUsedSize() < used);
+		REQUIRE(arena.GetPeakUsedSize() > 512);
+
+		// Freeing in a scope what was allocated before it does not go below the scope marker
+		{
+			void* beforeScope = arena.Allocate(64);
+			const size_t usedBeforeScope = arena.GetUsedSize();
+			{
+				ArenaScope scope(arena);
+				arena.Free(beforeScope, 64);
+				REQUIRE(arena.GetUsedSize() == usedBeforeScope);
+
+				// What was allocated in the scope can still be given back
+				void* inScope = arena.Allocate(64);
+				arena.Free(inScope, 64);
+				REQUIRE(arena.GetUsedSize() == usedBeforeScope);
+			}
+			REQUIRE(arena.GetUsedSize() == usedBeforeScope);
+		}
+
+		// Running out of memory is not an error
+		REQUIRE(arena.Allocate(2048) == nullptr);
+		REQUIRE(arena.GetNumFailedAllocations() == 1);
+
+		arena.Reset();
+		REQUIRE(arena.GetUsedSize() == 0);
+	}
+
+	SECTION("Containers in an arena")
+	{
+		StackArena<16 * 1024> arena;
+
+		{
+			ArenaScope scope(arena);
+
+			Vector<int, ArenaAllocator<int>> numbers{ ArenaAllocator<int>(arena) };
+			for (int iNum = 0; iNum < 100; ++iNum)
+			{
+				numbers.PushBack(iNum);
+			}
+			REQUIRE(numbers.Size() == 100);
+			REQUIRE(numbers[99] == 99);
+			REQUIRE(arena.Owns(numbers.Data()));
+			REQUIRE(numbers.GetAllocator().GetArena() == &arena);
+
+			using ArenaMap = HashMap<int, int, HashMapHasher<int>, ArenaAllocator<std::pair<const int, int>>>;
+			ArenaMap map{ ArenaAllocator<std::pair<const int, int>>(arena) };
+			for (int iNum = 0; iNum < 50; ++iNum)
+			{
+				map[iNum] = iNum * 2;
+			}
+			REQUIRE(map.Size() == 50);
+			REQUIRE(map.Find(21)->second == 42);
+			REQUIRE(arena.Owns(&*map.Find(21)));
+
+			ArenaMap copy(map);
+			REQUIRE(copy == map);
+			REQUIRE(copy.GetAllocator() == map.GetAllocator());
+
+			ArenaString formatted{ ArenaAllocator<char>(arena) };
+			StringFormat(formatted, "%s is %d and this string is long enough to not fit in a small string buffer", "the answer", 42);
+			REQUIRE(formatted == ArenaString("the answer is 42 and this string is long enough to not fit in a small string buffer", ArenaAllocator<char>(arena)));
+			REQUIRE(arena.Owns(formatted.data()));
+		}
+
+		REQUIRE(arena.GetUsedSize() == 0);
+
+		// When the arena is full, containers still work, on the heap
+		Vector<int, ArenaAllocator<int>> bigVector(8192, 7, ArenaAllocator<int>(arena));
+		REQUIRE(bigVector.Size() == 8192);
+		REQUIRE_FALSE(arena.Owns(bigVector.Data()));
+		REQUIRE(arena.GetNumFailedAllocations() > 0);
+	}
+
+	SECTION("Frame arena")
+	{
+		FrameArena frameArena(256, 2);
+
+		int* firstFrameData = frameArena.Allocate<int>();
+		*firstFrameData = 42;
+
+		// Still valid during the next frame...
+		frameArena.BeginFrame();
+		int* secondFrameData = frameArena.Allocate<int>();
+		REQUIRE(*firstFrameData == 42);
+		REQUIRE(secondFrameData != firstFrameData);
+
+		// ... but its memory is reused the frame after.
+		frameArena.BeginFrame();
+		REQUIRE(frameArena.Allocate<int>() == firstFrameData);
+	}
+
+	SECTION("Each thread has its own scratch arena")
+	{
+		LinearArena* mainScratch = &GetThreadScratchArena();
+		LinearArena* otherScratch = nullptr;
+		bool otherAllocated = false;
+
+		std::thread other([&otherScratch, &otherAllocated]()
+		{
+			ScratchScope scratch;
+			otherAllocated = (scratch.GetArena().Allocate(64) != nullptr);
+			otherScratch = &scratch.GetArena();
+		});
+		other.join();
+
+		REQUIRE(otherAllocated);
+		REQUIRE(otherScratch != mainScratch);
+
+		const size_t used = mainScratch->GetUsedSize();
+		{
+			ScratchScope scratch;
+			REQUIRE(mainScratch->Allocate(SCRATCH_ARENA_CAPACITY / 2) != nullptr);
+		}
+		REQUIRE(mainScratch->GetUsedSize() == used);
+	}
+}
@@ -1,5 +1,7 @@
 #include <fstream>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 
 #include "catch.hpp"
@@ -14,6 +16,7 @@
 #include "Core/Containers/Vector/Vector.h"
 #include "Core/Containers/HashMap/HashMap.h"
 #include "Core/Containers/Array/Array.h"
+#include "Core/Containers/FreeList/PagedFreelist.h"
 
 struct NotCopyable
 {
@@ -93,8 +96,8 @@ TEST_CASE("Containers", "[Core]")
 {
 
 
-    SECTION("Vector")
-    {
+	SECTION("Vector")
+	{
 		// Constructors + basic accessors
 		bool eq = false;
 
@@ -266,7 +269,7 @@ TEST_CASE("Containers", "[Core]")
 		{
 			(void)item;
 		}
-    }
+	}
 
 
 	SECTION("HashMap")
@@ -329,6 +332,55 @@ TEST_CASE("Containers", "[Core]")
 		{
 			(void)item;
 		}
+
+		// Heterogeneous lookup
+		moe::HashMap<std::string, int> strMap;
+		strMap["toto"] = 1;
+		strMap.Emplace("titi", 2);
+		std::string_view key = "titi";
+		auto strIt = strMap.Find(key);
+		eq = (strIt != strMap.End() && strIt->second == 2);
+		CHECK(eq);
+		CHECK(strMap.Find("tata") == strMap.End());
+
+		// Reserve / no-rehash mode
+		moe::HashMap<int, int> fixedMap;
+		fixedMap.Reserve(1000);
+		fixedMap.SetRehashAllowed(false);
+		const auto reservedCapacity = fixedMap.Capacity();
+		fixedMap[0] = 0;
+		int* firstValue = &fixedMap[0];
+		for (int i = 1; i < 1000; ++i)
+		{
+			fixedMap[i] = i;
+		}
+		CHECK(fixedMap.Capacity() == reservedCapacity);
+		CHECK(firstValue == &fixedMap[0]);
+
+		// Many insertions and erasures must agree with std::unordered_map
+		moe::HashMap<int, int> stress;
+		std::unordered_map<int, int> reference;
+		for (int i = 0; i < 20000; ++i)
+		{
+			const int k = (i * 7919) % 3001;
+			if (i % 3 == 0)
+			{
+				CHECK(stress.Erase(k) == reference.erase(k));
+			}
+			else
+			{
+				stress[k] = i;
+				reference[k] = i;
+			}
+		}
+		CHECK(stress.Size() == reference.size());
+		bool sameContents = true;
+		for (const auto& item : reference)
+		{
+			auto found = stress.Find(item.first);
+			sameContents &= (found != stress.End() && found->second == item.second);
+		}
+		CHECK(sameContents);
 	}
 
 
@@ -369,5 +421,71 @@ TEST_CASE("Containers", "[Core]")
 	}
 
 
- }
+
+
+
+	SECTION("PagedFreelist")
+	{
+		moe::PagedFreelist<int> list;
+		CHECK(list.Empty());
+
+		// Add enough objects to span several pages
+		moe::Vector<moe::FreelistID> ids;
+		for (int i = 0; i < 200; ++i)
+		{
+			ids.PushBack(list.Add(i));
+		}
+		CHECK(list.Size() == 200);
+		CHECK(list.Capacity() >= 200);
+
+		// Growing must not move live objects
+		int* first = &list.Lookup(ids[0]);
+		for (int i = 200; i < 1000; ++i)
+		{
+			list.Add(i);
+		}
+		CHECK(first == &list.Lookup(ids[0]));
+		CHECK(*first == 0);
+
+		// Stale IDs are rejected, even once the slot has been reused
+		moe::FreelistID removed = ids[42];
+		CHECK(list.Remove(removed));
+		CHECK(list.Remove(removed) == false);
+		CHECK(list.IsValid(removed) == false);
+		CHECK(list.TryLookup(removed) == nullptr);
+
+		moe::FreelistID reused = list.Add(4242);
+		CHECK(reused.Index() == removed.Index());
+		CHECK(reused != removed);
+		CHECK(list.TryLookup(removed) == nullptr);
+		CHECK(list.Lookup(reused) == 4242);
+
+		// Iteration skips the holes
+		for (int i = 0; i < 1000; i += 2)
+		{
+			list.Remove(moe::FreelistID{ (uint32_t)i, (uint32_t)(i == 42 ? 1 : 0) });
+		}
+		CHECK(list.Size() == 500);
+
+		int count = 0;
+		bool allOdd = true;
+		for (auto it = list.Begin(); it != list.End(); ++it)
+		{
+			allOdd &= (*it % 2 == 1);
+			allOdd &= list.IsValid(it.ID());
+			count++;
+		}
+		CHECK(count == 500);
+		CHECK(allOdd);
+
+		// Clear invalidates every ID
+		moe::FreelistID survivor = ids[1];
+		list.Clear();
+		CHECK(list.Size() == 0);
+		CHECK(list.IsValid(survivor) == false);
+		CHECK(list.Begin() == list.End());
+	}
+
+
+}
 
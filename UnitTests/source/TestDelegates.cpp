@@ -10,6 +10,9 @@
 #include "Core/Delegates/Delegate.h"
 #include "Core/Delegates/Event.h"
 
+#include <string>
+#include <vector>
+
 static int test = 0;
 
 void testfunc()
@@ -29,7 +32,12 @@ struct UserStruct
 		test++;
 	}
 
+	int constMember() const
+	{
+		return m_value;
+	}
 
+	int m_value = 42;
 };
 
 
@@ -64,6 +72,75 @@ TEST_CASE("Delegates", "[Core]")
 		CHECK(del2.IsSet());
 		del2();
 		CHECK(test == 2);
+
+		// Const member function
+		moe::Delegate<int()> del4(&testUs, &UserStruct::constMember);
+		CHECK(del4() == 42);
+		moe::Delegate<int()> del5;
+		del5.Set<UserStruct, &UserStruct::constMember>(&testUs);
+		CHECK(del5() == 42);
+	}
+
+	SECTION("Delegate storage")
+	{
+		test = 0;
+
+		// Lambdas are stored inline, captures included
+		int counter = 0;
+		const int increment = 3;
+		moe::Delegate<int(int)> lambdaDel = [&counter, increment](int value)
+		{
+			counter += value * increment;
+			return counter;
+		};
+		CHECK(lambdaDel(2) == 6);
+		CHECK(counter == 6);
+
+		// Copies call the same thing, moved-from delegates are unset
+		moe::Delegate<int(int)> copy = lambdaDel;
+		CHECK(copy(1) == 9);
+		moe::Delegate<int(int)> moved = std::move(copy);
+		CHECK(!copy.IsSet());
+		CHECK(moved(1) == 12);
+
+		// A delegate is never bigger than a few pointers : the stub, the comparison function and the storage
+		CHECK(sizeof(moe::Delegate<void()>) <= 5 * sizeof(void*));
+
+		// Calling an unset delegate asserts, but returns a default value instead of crashing
+		moe::Delegate<int(int)> unset;
+		CHECK(unset(1) == 0);
+	}
+
+	SECTION("Delegate comparison")
+	{
+		UserStruct us1, us2;
+
+		moe::Delegate<void()> memberDel(&us1, &UserStruct::member);
+		CHECK(memberDel == moe::Delegate<void()>(&us1, &UserStruct::member));
+		CHECK(memberDel != moe::Delegate<void()>(&us2, &UserStruct::member));
+
+		moe::Delegate<void()> staticMemberDel;
+		staticMemberDel.Set<UserStruct, &UserStruct::member>(&us1);
+		moe::Delegate<void()> staticMemberDel2;
+		staticMemberDel2.Set<UserStruct, &UserStruct::member>(&us1);
+		CHECK(staticMemberDel == staticMemberDel2);
+
+		moe::Delegate<void()> freeDel = &testfunc;
+		CHECK(freeDel == moe::Delegate<void()>(&testfunc));
+		CHECK(freeDel != moe::Delegate<void()>(&othertestfunc));
+		CHECK(freeDel != memberDel);
+
+		CHECK(moe::Delegate<void()>() == moe::Delegate<void()>(nullptr));
+
+		// Lambdas are only equal to their copies (and captureless ones to any other instance)
+		int value = 0;
+		moe::Delegate<void()> lambdaDel = [&value]() { value++; };
+		moe::Delegate<void()> lambdaCopy = lambdaDel;
+		CHECK(lambdaDel == lambdaCopy);
+		CHECK(lambdaDel != freeDel);
+
+		auto captureless = []() {};
+		CHECK(moe::Delegate<void()>(captureless) == moe::Delegate<void()>(captureless));
 	}
 
 	SECTION("Event")
@@ -71,11 +148,10 @@ TEST_CASE("Delegates", "[Core]")
 		test = 0;
 
 		moe::Event<void()>	testEvent;
-		CHECK(testEvent.GetNextID() == 0);
+		CHECK(testEvent.GetNumDelegates() == 0);
 
 		moe::EventDelegateID dlgId = testEvent.Add<&testfunc>();
-		CHECK(testEvent.GetNextID() == 1);
-		CHECK(dlgId == 0);
+		CHECK(testEvent.GetNumDelegates() == 1);
 
 		CHECK(test == 0);
 		testEvent.Broadcast();
@@ -83,7 +159,7 @@ TEST_CASE("Delegates", "[Core]")
 
 		// The same function can be bound multiple times
 		moe::EventDelegateID dlgId2 = testEvent.Add<&testfunc>();
-		CHECK(dlgId2 == 1);
+		CHECK(dlgId2 != dlgId);
 
 		testEvent.Broadcast();
 		CHECK(test == 3);
@@ -91,10 +167,16 @@ TEST_CASE("Delegates", "[Core]")
 		// Remove
 		bool removeOk = testEvent.Remove(dlgId);
 		CHECK(removeOk);
+		CHECK(testEvent.GetNumDelegates() == 1);
 		testEvent.Broadcast();
 		CHECK(test == 4);
+
+		// The slot of the removed delegate is reused, but its old ID does not work anymore
 		moe::EventDelegateID dlgId3 = testEvent.Add<&testfunc>();
-		CHECK(dlgId3 == 2);
+		CHECK(dlgId3 != dlgId);
+		CHECK(dlgId3 != dlgId2);
+		CHECK_FALSE(testEvent.Remove(dlgId));
+		CHECK(testEvent.GetNumDelegates() == 2);
 		testEvent.Broadcast();
 		CHECK(test == 6);
 
@@ -103,7 +185,7 @@ TEST_CASE("Delegates", "[Core]")
 		UserStruct testUs;
 
 		moe::EventDelegateID dlgId4 = testEvent.Add<UserStruct, &UserStruct::member>(&testUs);
-		CHECK(dlgId4 == 3);
+		CHECK(testEvent.GetNumDelegates() == 3);
 
 		testEvent.Broadcast();
 		CHECK(test == 9);
@@ -112,7 +194,7 @@ TEST_CASE("Delegates", "[Core]")
 		moe::Delegate<void()> del;
 		del.Set<&testfunc>();
 		moe::EventDelegateID dlgId5 = testEvent.AddDelegate(del);
-		CHECK(dlgId5 == 4);
+		CHECK(testEvent.GetNumDelegates() == 4);
 
 		testEvent.Broadcast();
 		CHECK(test == 13);
@@ -122,7 +204,7 @@ TEST_CASE("Delegates", "[Core]")
 
 		del.Set<UserStruct, &UserStruct::member>(&testUs);
 		dlgId5 = testEvent.AddDelegate(del);
-		CHECK(dlgId5 == 5);
+		CHECK(testEvent.GetNumDelegates() == 4);
 
 		testEvent.Broadcast();
 		CHECK(test == 17);
@@ -133,11 +215,201 @@ TEST_CASE("Delegates", "[Core]")
 
 		dlgId5 = testEvent.AddDelegate(std::move(del));
 		CHECK(!del.IsSet());
-		CHECK(dlgId5 == 6);
+		CHECK(testEvent.GetNumDelegates() == 4);
 
 		testEvent.Broadcast();
 		CHECK(test == 21);
 
+		// Remove by comparison : the first equal delegate goes
+		moe::Delegate<void()> memberDel;
+		memberDel.Set<UserStruct, &UserStruct::member>(&testUs);
+		CHECK(testEvent.RemoveDelegate(memberDel));
+		CHECK(testEvent.GetNumDelegates() == 3);
+		CHECK_FALSE(testEvent.Remove(dlgId4));
+		CHECK(testEvent.Remove(dlgId5));
+		CHECK_FALSE(testEvent.RemoveDelegate(memberDel));
+
+		testEvent.Broadcast();
+		CHECK(test == 23);
+
+		testEvent.Clear();
+		CHECK(testEvent.GetNumDelegates() == 0);
+		CHECK_FALSE(testEvent.Remove(dlgId2));
+		testEvent.Broadcast();
+		CHECK(test == 23);
+	}
+
+	SECTION("Event changes during broadcast")
+	{
+		moe::Event<void(int)>	testEvent;
+		std::vector<int>		calls;
+
+		moe::EventDelegateID selfId = 0;
+		moe::EventDelegateID otherId = 0;
+		moe::EventDelegateID addedId = 0;
+
+		auto recordLast = [&calls](int value) { calls.push_back(value * 10); };
+		moe::Delegate<void(int)> recordLastDlgt(&recordLast, &decltype(recordLast)::operator());
+
+		// The first delegate removes itself and the one after it, and adds a new one
+		auto first = [&](int value)
+		{
+			calls.push_back(value);
+			CHECK(testEvent.IsBroadcasting());
+			CHECK(testEvent.Remove(selfId));
+			CHECK(testEvent.Remove(otherId));
+			addedId = testEvent.AddDelegate(recordLastDlgt);
+		};
+		auto second = [&calls](int value) { calls.push_back(-value); };
+
+		selfId = testEvent.AddDelegate(moe::Delegate<void(int)>(&first, &decltype(first)::operator()));
+		otherId = testEvent.AddDelegate(moe::Delegate<void(int)>(&second, &decltype(second)::operator()));
+
+		testEvent.Broadcast(1);
+		REQUIRE((calls == std::vector<int>{ 1 }));
+		CHECK_FALSE(testEvent.IsBroadcasting());
+		CHECK(testEvent.GetNumDelegates() == 1);
+
+		// The delegate added during the broadcast is called by the next one
+		testEvent.Broadcast(2);
+		REQUIRE((calls == std::vector<int>{ 1, 20 }));
+
+		// A delegate added during a broadcast can be removed before it ends
+		auto addAndRemove = [&](int)
+		{
+			moe::EventDelegateID pendingId = testEvent.AddDelegate(recordLastDlgt);
+			CHECK(testEvent.Remove(pendingId));
+		};
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&addAndRemove, &decltype(addAndRemove)::operator()));
+		testEvent.Broadcast(3);
+		testEvent.Broadcast(4);
+		REQUIRE((calls == std::vector<int>{ 1, 20, 30, 40 }));
+		CHECK(testEvent.Remove(addedId));
+	}
+
+	SECTION("Event delegate removing itself")
+	{
+		moe::Event<void(int)>	testEvent;
+		moe::EventDelegateID	selfId = 0;
+		int						received = 0;
+
+		// The captures are stored inline in the delegate : they must survive the removal until the call returns.
+		selfId = testEvent.AddDelegate([&testEvent, &selfId, &received](int value)
+		{
+			CHECK(testEvent.Remove(selfId));
+			received += value;
+		});
+
+		int secondReceived = 0;
+		testEvent.AddDelegate([&secondReceived](int value) { secondReceived += value; });
+
+		testEvent.Broadcast(3);
+		CHECK(received == 3);
+		CHECK(secondReceived == 3);
+
+		testEvent.Broadcast(4);
+		CHECK(received == 3);
+		CHECK(secondReceived == 7);
+
+		// Same with a clear
+		testEvent.AddDelegate([&testEvent, &received](int value)
+		{
+			testEvent.Clear();
+			received += value;
+		});
+
+		int batch[] = { 1, 2 };
+		testEvent.BroadcastBatch(batch, 2);
+		CHECK(received == 4);
+		CHECK(secondReceived == 10);
+		CHECK(testEvent.GetNumDelegates() == 0);
+	}
+
+	SECTION("Event subscription churn")
+	{
+		test = 0;
+
+		moe::Event<void()>	testEvent;
+		std::vector<moe::EventDelegateID> ids;
+		for (int iDlgt = 0; iDlgt < 100; ++iDlgt)
+		{
+			ids.push_back(testEvent.Add<&testfunc>());
+		}
+
+		// Removing most of them compacts the list : the remaining IDs must still work
+		for (size_t iDlgt = 0; iDlgt < ids.size(); ++iDlgt)
+		{
+			if (iDlgt % 4 != 0)
+				CHECK(testEvent.Remove(ids[iDlgt]));
+		}
+
+		testEvent.Broadcast();
+		CHECK(test == 25);
+
+		for (size_t iDlgt = 0; iDlgt < ids.size(); iDlgt += 4)
+		{
+			CHECK(testEvent.Remove(ids[iDlgt]));
+		}
+
+		CHECK(testEvent.GetNumDelegates() == 0);
+		testEvent.Broadcast();
+		CHECK(test == 25);
+	}
+
+	SECTION("Event priorities")
+	{
+		moe::Event<void(int)>	testEvent;
+		std::vector<int>		calls;
+
+		auto record = [&calls](int value) { calls.push_back(value); };
+		auto recordTwice = [&calls](int value) { calls.push_back(value * 2); };
+		auto recordThrice = [&calls](int value) { calls.push_back(value * 3); };
+
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&record, &decltype(record)::operator()));
+		moe::EventDelegateID lateId = testEvent.AddDelegate(moe::Delegate<void(int)>(&recordTwice, &decltype(recordTwice)::operator()), -1);
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&recordThrice, &decltype(recordThrice)::operator()), 10);
+
+		// Higher priority first, then in the order they were added
+		testEvent.Broadcast(1);
+		REQUIRE((calls == std::vector<int>{ 3, 1, 2 }));
+
+		// Inserting in the middle does not break the IDs of the delegates after it
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&record, &decltype(record)::operator()), 10);
+		CHECK(testEvent.Remove(lateId));
+
+		calls.clear();
+		testEvent.Broadcast(1);
+		REQUIRE((calls == std::vector<int>{ 3, 1, 1 }));
+	}
+
+	SECTION("Event batch broadcast")
+	{
+		moe::Event<void(int)>	testEvent;
+		std::vector<int>		calls;
+
+		auto record = [&calls](int value) { calls.push_back(value); };
+		auto recordNegative = [&calls](int value) { calls.push_back(-value); };
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&record, &decltype(record)::operator()));
+		testEvent.AddDelegate(moe::Delegate<void(int)>(&recordNegative, &decltype(recordNegative)::operator()));
+
+		// Each delegate gets all the payloads before the next one is called
+		const int payloads[] = { 1, 2, 3 };
+		testEvent.BroadcastBatch(payloads, 3);
+		REQUIRE((calls == std::vector<int>{ 1, 2, 3, -1, -2, -3 }));
+
+		// Multiple arguments events take tuples
+		moe::Event<void(int, const std::string&)> multiArgsEvent;
+		std::string concatenated;
+		auto concat = [&concatenated](int count, const std::string& str)
+		{
+			for (int i = 0; i < count; ++i)
+				concatenated += str;
+		};
+		multiArgsEvent.AddDelegate(moe::Delegate<void(int, const std::string&)>(&concat, &decltype(concat)::operator()));
+
+		const decltype(multiArgsEvent)::BatchPayload multiPayloads[] = { { 2, "a" }, { 1, "b" } };
+		multiArgsEvent.BroadcastBatch(multiPayloads, 2);
+		REQUIRE(concatenated == "aab");
 	}
 
  }
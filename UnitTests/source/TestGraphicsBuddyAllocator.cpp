@@ -2,12 +2,120 @@
 
 #include "catch.hpp"
 
+#include <Graphics/GraphicsAllocator/BuddyAllocator.h>
 #include <Graphics/GraphicsAllocator/OpenGL/OpenGLBuddyAllocator.h>
+#include <Graphics/GraphicsAllocator/OpenGL/OpenGLBufferPool.h>
 
-// TODO : This test is disabled for now because it needs a working backing rendering context
-// (basically it needs a running application)
-TEST_CASE("OpenGL Buffer Buddy Allocator", "[Graphics][.]")
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	/*
+		Stands in for the buffer functions of the driver, so the GL allocators can be tested without a rendering context :
+		it hands out buffer names, and keeps track of the ones that are still alive.
+	*/
+	struct FakeGLBuffers
+	{
+		FakeGLBuffers() :
+			m_createBuffers(glad_glCreateBuffers), m_deleteBuffers(glad_glDeleteBuffers),
+			m_bufferStorage(glad_glNamedBufferStorage), m_bufferSubData(glad_glNamedBufferSubData)
+		{
+			ms_liveBuffers.clear();
+
+			glad_glCreateBuffers = &CreateBuffers;
+			glad_glDeleteBuffers = &DeleteBuffers;
+			glad_glNamedBufferStorage = &BufferStorage;
+			glad_glNamedBufferSubData = &BufferSubData;
+		}
+
+		~FakeGLBuffers()
+		{
+			glad_glCreateBuffers = m_createBuffers;
+			glad_glDeleteBuffers = m_deleteBuffers;
+			glad_glNamedBufferStorage = m_bufferStorage;
+			glad_glNamedBufferSubData = m_bufferSubData;
+		}
+
+		static bool	IsAlive(GLuint buffer) { return std::find(ms_liveBuffers.begin(), ms_liveBuffers.end(), buffer) != ms_liveBuffers.end(); }
+
+		static inline std::vector<GLuint>	ms_liveBuffers;
+		static inline GLuint				ms_nextName = 1;
+
+	private:
+
+		static void APIENTRY	CreateBuffers(GLsizei n, GLuint* buffers)
+		{
+			for (GLsizei iBuf = 0; iBuf < n; ++iBuf)
+			{
+				buffers[iBuf] = ms_nextName++;
+				ms_liveBuffers.push_back(buffers[iBuf]);
+			}
+		}
+
+		static void APIENTRY	DeleteBuffers(GLsizei n, const GLuint* buffers)
+		{
+			for (GLsizei iBuf = 0; iBuf < n; ++iBuf)
+			{
+				REQUIRE(IsAlive(buffers[iBuf]));
+				ms_liveBuffers.erase(std::find(ms_liveBuffers.begin(), ms_liveBuffers.end(), buffers[iBuf]));
+			}
+		}
+
+		static void APIENTRY	BufferStorage(GLuint, GLsizeiptr, const void*, GLbitfield) {}
+
+		static void APIENTRY	BufferSubData(GLuint, GLintptr, GLsizeiptr, const void*) {}
+
+		PFNGLCREATEBUFFERSPROC			m_createBuffers;
+		PFNGLDELETEBUFFERSPROC			m_deleteBuffers;
+		PFNGLNAMEDBUFFERSTORAGEPROC		m_bufferStorage;
+		PFNGLNAMEDBUFFERSUBDATAPROC		m_bufferSubData;
+	};
+}
+
+
+// The block bookkeeping needs no rendering context.
+TEST_CASE("Buddy Allocator", "[Graphics]")
+{
+	moe::BuddyAllocator test(64 * 1024);
+	REQUIRE(test.GetPoolSize() == 64 * 1024);
+
+	SECTION("Splits blocks and merges buddies back")
+	{
+		const uint32_t offset1 = test.TryAllocate(12);
+		const uint32_t offset2 = test.TryAllocate(12);
+		const uint32_t offset3 = test.TryAllocate(8000);
+		CHECK(offset1 == 0);
+		CHECK(offset2 == 4096);
+		CHECK(offset3 == 8192);
+		CHECK(test.GetNumAllocations() == 3);
+
+		CHECK(test.Free(offset2));
+		CHECK(test.Free(offset1));
+		CHECK(test.Free(offset3));
+		CHECK_FALSE(test.Free(offset3));
+
+		CHECK(test.TryAllocate(64 * 1024) == 0);
+	}
+
+	SECTION("Fails without asserting when memory is exhausted")
+	{
+		CHECK(test.TryAllocate(64 * 1024 + 1) == moe::BuddyAllocator::ms_INVALID_OFFSET);
+
+		const uint32_t wholePool = test.TryAllocate(64 * 1024);
+		CHECK(wholePool == 0);
+		CHECK(test.TryAllocate(12) == moe::BuddyAllocator::ms_INVALID_OFFSET);
+		CHECK(test.Free(wholePool));
+	}
+}
+
+
+TEST_CASE("OpenGL Buffer Buddy Allocator", "[Graphics]")
 {
+	FakeGLBuffers fakeGL;
+
 	SECTION("Allocate leaf block + immediate free")
 	{
 		moe::OpenGLBuddyAllocator test(GL_DYNAMIC_STORAGE_BIT);
@@ -174,4 +282,157 @@ TEST_CASE("OpenGL Buffer Buddy Allocator", "[Graphics][.]")
 		test.Free(offset7);
 	}
 
-}
\ No newline at end of file
+
+	SECTION("Random churn never gives overlapping blocks and merges everything back")
+	{
+		moe::OpenGLBuddyAllocator test(GL_DYNAMIC_STORAGE_BIT);
+
+		std::mt19937 rng(42);
+		std::uniform_int_distribution<uint32_t> sizeDist(1, 20000);
+
+		struct Block { uint32_t m_offset; uint32_t m_size; };
+		std::vector<Block> blocks;
+
+		auto overlapsExisting = [&blocks](uint32_t offset, uint32_t size)
+		{
+			return std::any_of(blocks.begin(), blocks.end(), [&](const Block& other)
+			{
+				return offset < other.m_offset + other.m_size && other.m_offset < offset + size;
+			});
+		};
+
+		bool noOverlap = true;
+		for (int iStep = 0; iStep < 2000; ++iStep)
+		{
+			if (blocks.empty() || rng() % 2 == 0)
+			{
+				const uint32_t size = sizeDist(rng);
+				const uint32_t offset = test.Allocate(nullptr, size);
+				REQUIRE(offset != moe::OpenGLBuddyAllocator::ms_INVALID_OFFSET);
+
+				noOverlap &= !overlapsExisting(offset, size);
+				blocks.push_back({ offset, size });
+			}
+			else
+			{
+				const size_t freedIdx = rng() % blocks.size();
+				test.Free(blocks[freedIdx].m_offset);
+				blocks.erase(blocks.begin() + freedIdx);
+			}
+		}
+
+		CHECK(noOverlap);
+
+		for (const Block& block : blocks)
+		{
+			test.Free(block.m_offset);
+		}
+
+		// Once everything is freed, the whole pool (4096 * 2^12 bytes) is one block again.
+		const uint32_t wholePool = test.Allocate(nullptr, 4096 << 12);
+		CHECK(wholePool == 0);
+		test.Free(wholePool);
+	}
+}
+
+
+TEST_CASE("OpenGL Buffer Pool", "[Graphics]")
+{
+	FakeGLBuffers fakeGL;
+
+	const uint32_t arenaSize = 64 * 1024;
+
+	std::vector<GLuint> deletedBuffers;
+	moe::OpenGLBufferPool pool;
+	pool.SetBufferDeletedDelegate([&deletedBuffers](GLuint buffer)
+	{
+		// Reported before the driver deletes it
+		CHECK(FakeGLBuffers::IsAlive(buffer));
+		deletedBuffers.push_back(buffer);
+	});
+	pool.Initialize(GL_DYNAMIC_STORAGE_BIT, arenaSize, arenaSize / 2);
+
+	REQUIRE(pool.GetNumArenas() == 1);
+
+	SECTION("Grows when an arena is full, and frees empty arenas")
+	{
+		std::vector<moe::OpenGLPoolAllocation> allocs;
+		for (int iAlloc = 0; iAlloc < 40; ++iAlloc)
+		{
+			allocs.push_back(pool.Allocate(nullptr, 4096));
+			REQUIRE(allocs.back().IsValid());
+		}
+
+		// 16 leaf blocks per arena
+		CHECK(pool.GetNumArenas() == 3);
+		CHECK(allocs[0].m_arenaIdx == 0);
+		CHECK(allocs[16].m_arenaIdx == 1);
+		CHECK(allocs[39].m_arenaIdx == 2);
+		CHECK(allocs[16].m_buffer != allocs[0].m_buffer);
+
+		// Emptying the second arena gives it back
+		for (int iAlloc = 16; iAlloc < 32; ++iAlloc)
+		{
+			pool.Free(allocs[iAlloc]);
+		}
+		CHECK(pool.GetNumArenas() == 2);
+
+		// The third arena gets filled first, then a new arena takes the free index
+		for (int iAlloc = 16; iAlloc < 32; ++iAlloc)
+		{
+			allocs[iAlloc] = pool.Allocate(nullptr, 4096);
+		}
+		CHECK(pool.GetNumArenas() == 3);
+		CHECK(allocs[16].m_arenaIdx == 2);
+		CHECK(allocs[31].m_arenaIdx == 1);
+
+		// The first arena is kept even when empty
+		for (const moe::OpenGLPoolAllocation& alloc : allocs)
+		{
+			pool.Free(alloc);
+		}
+		CHECK(pool.GetNumArenas() == 1);
+	}
+
+	SECTION("Big allocations are dedicated")
+	{
+		const moe::OpenGLPoolAllocation big = pool.Allocate(nullptr, 10 * arenaSize);
+		REQUIRE(big.IsValid());
+		CHECK(big.m_arenaIdx == moe::OpenGLBufferPool::ms_DEDICATED_ARENA);
+		CHECK(big.m_offset == 0);
+		CHECK(pool.GetNumDedicatedBuffers() == 1);
+		CHECK(pool.GetNumArenas() == 1);
+
+		pool.Free(big);
+		CHECK(pool.GetNumDedicatedBuffers() == 0);
+	}
+
+	SECTION("Every deleted buffer is reported")
+	{
+		std::vector<moe::OpenGLPoolAllocation> allocs;
+		for (int iAlloc = 0; iAlloc < 32; ++iAlloc)
+		{
+			allocs.push_back(pool.Allocate(nullptr, 4096));
+		}
+		REQUIRE(pool.GetNumArenas() == 2);
+
+		const moe::OpenGLPoolAllocation big = pool.Allocate(nullptr, 10 * arenaSize);
+		const moe::OpenGLPoolAllocation otherBig = pool.Allocate(nullptr, 10 * arenaSize);
+
+		// A freed dedicated buffer
+		pool.Free(big);
+		CHECK((deletedBuffers == std::vector<GLuint>{ big.m_buffer }));
+
+		// An emptied arena
+		for (int iAlloc = 16; iAlloc < 32; ++iAlloc)
+		{
+			pool.Free(allocs[iAlloc]);
+		}
+		CHECK((deletedBuffers == std::vector<GLuint>{ big.m_buffer, allocs[16].m_buffer }));
+
+		// Everything that remains
+		pool.DeleteMemory();
+		CHECK((deletedBuffers == std::vector<GLuint>{ big.m_buffer, allocs[16].m_buffer, allocs[0].m_buffer, otherBig.m_buffer }));
+		CHECK(FakeGLBuffers::ms_liveBuffers.empty());
+	}
+}
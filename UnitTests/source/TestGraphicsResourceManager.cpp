@@ -0,0 +1,109 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Graphics/ResourceManager/GraphicsResourceManager.h"
+#include "Graphics/Renderer/Null/NullRenderer.h"
+
+
+TEST_CASE("GraphicsResourceManager", "[Graphics]")
+{
+	using namespace moe;
+
+	NullRenderer renderer;
+	REQUIRE(renderer.Initialize(nullptr));
+
+	NullGraphicsDevice& device = renderer.MutNullDevice();
+
+	{
+		GraphicsResourceManager resourceManager(renderer);
+		const GraphicsResourceManagerStats& stats = resourceManager.GetStats();
+
+		SECTION("Shares textures between users")
+		{
+			TextureRef albedo = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "textures/albedo.png" });
+			REQUIRE(albedo.IsNotNull());
+			REQUIRE(resourceManager.GetRefCount(albedo) == 1);
+
+			// Different spellings of the same path give the same texture
+			TextureRef sameAlbedo = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "textures/../textures/./albedo.png" });
+			REQUIRE(sameAlbedo == albedo);
+			REQUIRE(sameAlbedo.Get() == albedo.Get());
+			REQUIRE(resourceManager.GetRefCount(albedo) == 2);
+			REQUIRE(stats.m_loads == 1);
+			REQUIRE(stats.m_hits == 1);
+
+			// Copies are references too
+			TextureRef copy = albedo;
+			REQUIRE(resourceManager.GetRefCount(albedo) == 3);
+
+			// The import parameters are part of the key
+			TextureRef srgbAlbedo = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "textures/albedo.png", TextureFormat::SRGB_RGBA8 });
+			REQUIRE(srgbAlbedo != albedo);
+			REQUIRE(srgbAlbedo.Get() != albedo.Get());
+			REQUIRE(resourceManager.GetNumResources() == 2);
+
+			TextureHandle albedoHandle = albedo.Get();
+
+			copy.Reset();
+			sameAlbedo.Reset();
+			REQUIRE(resourceManager.GetRefCount(albedo) == 1);
+			REQUIRE(device.GetTextureLoadState(albedoHandle) == TextureLoadState::Ready);
+
+			// The texture is unloaded with its last reference
+			albedo.Reset();
+			REQUIRE(albedo.IsNull());
+			REQUIRE(stats.m_unloads == 1);
+			REQUIRE(resourceManager.GetNumResources() == 1);
+
+			// Acquiring it again loads it again
+			TextureRef reloaded = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "textures/albedo.png" });
+			REQUIRE(reloaded.IsNotNull());
+			REQUIRE(stats.m_loads == 3);
+		}
+
+		SECTION("Notifies everyone waiting for a texture")
+		{
+			int numLoaded = 0;
+			auto onLoaded = [&numLoaded](TextureHandle, TextureLoadState state)
+			{
+				REQUIRE(state == TextureLoadState::Ready);
+				numLoaded++;
+			};
+
+			TextureRef first = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "normal.png" }, onLoaded);
+			TextureRef second = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "normal.png" }, onLoaded);
+			REQUIRE(resourceManager.GetLoadState(first) == TextureLoadState::Pending);
+			REQUIRE(numLoaded == 0);
+
+			device.EndFrame();
+			REQUIRE(numLoaded == 2);
+			REQUIRE(resourceManager.GetLoadState(first) == TextureLoadState::Ready);
+
+			// Already loaded : called right away
+			TextureRef third = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "normal.png" }, onLoaded);
+			REQUIRE(numLoaded == 3);
+		}
+
+		SECTION("Forgets textures released before they are loaded")
+		{
+			int numLoaded = 0;
+			TextureRef texture = resourceManager.AcquireTexture2D(Texture2DFileDescriptor{ "roughness.png" },
+				[&numLoaded](TextureHandle, TextureLoadState) { numLoaded++; });
+
+			texture.Reset();
+			device.EndFrame();
+			REQUIRE(numLoaded == 0);
+			REQUIRE(resourceManager.GetNumResources() == 0);
+		}
+
+		REQUIRE(device.GetStats().m_invalidHandles == 0);
+	}
+
+	renderer.Shutdown();
+}
@@ -7,6 +7,13 @@
 
 #include "Core/HashString/HashString.h"
 
+// The strings behind the IDs are only kept in "not shipping" modes.
+#ifndef MOE_SHIPPING
+#define CHECK_HASH_STRING(hashString, str)	CHECK((hashString).GetString() == (str))
+#else
+#define CHECK_HASH_STRING(hashString, str)
+#endif
+
 /*
 	This is to verify string hashes produce expected results
 */
@@ -17,69 +24,121 @@ TEST_CASE("HashString", "[Core]")
 		//empty
 		moe::HashString test;
 		CHECK(test() == 0);
-		CHECK(test.GetString() == "");
+		CHECK_HASH_STRING(test, "");
 
 		// set without string
 		test.Set(0x424242);
-		CHECK(test.GetString() == "");
+		CHECK_HASH_STRING(test, "");
 		CHECK(test() == 0x424242);
 
 		// clear
 		test.Clear();
 		CHECK(test() == 0);
-		CHECK(test.GetString() == "");
+		CHECK_HASH_STRING(test, "");
 
 		// other initializations
 		test.Set(0x424242);
 		moe::HashString test2 = test;
-		CHECK(test.GetString() == "");
+		CHECK_HASH_STRING(test, "");
 		CHECK(test() == 0x424242);
-		CHECK(test2.GetString() == "");
+		CHECK_HASH_STRING(test2, "");
 		CHECK(test2() == 0x424242);
 
 		moe::HashString test3(test);
-		CHECK(test3.GetString() == "");
+		CHECK_HASH_STRING(test3, "");
 		CHECK(test3() == 0x424242);
 
 		moe::HashString test4;
 		test4 = test3;
-		CHECK(test3.GetString() == "");
+		CHECK_HASH_STRING(test3, "");
 		CHECK(test3() == 0x424242);
-		CHECK(test4.GetString() == "");
+		CHECK_HASH_STRING(test4, "");
 		CHECK(test4() == 0x424242);
 
 		moe::HashString test5;
 		test5 = std::move(test4);
-		CHECK(test4.GetString() == "");
+		CHECK_HASH_STRING(test4, "");
 		CHECK(test4() == 0);
-		CHECK(test5.GetString() == "");
+		CHECK_HASH_STRING(test5, "");
 		CHECK(test5() == 0x424242);
 
 		moe::HashString test6(std::move(test5));
-		CHECK(test5.GetString() == "");
+		CHECK_HASH_STRING(test5, "");
 		CHECK(test5() == 0);
-		CHECK(test6.GetString() == "");
+		CHECK_HASH_STRING(test6, "");
 		CHECK(test6() == 0x424242);
     }
 
 	// FNV-1a hasher should output same values everywhere
 	SECTION("Hash value FNV-1a")
 	{
+		#ifndef MOE_SHIPPING
 		typedef moe::HashStringT<std::string, moe::FNV1aHashPolicy<std::string>> TestHashString;
 		TestHashString test;
 		TestHashString test2;
 		TestHashString test3;
 
 		test = "toto";
-		CHECK(test() == 0xf6a4e63f5280494d);
+		CHECK(test() == 0x2ff4f1ef38b0c7ad);
 
 		test2 = TestHashString("titi");
-		CHECK(test2() == 0xec92d5697d2707f5);
+		CHECK(test2() == 0x1e35a5ef2e851955);
 
 		test3.SetString("tata");
-		CHECK(test3() == 0xc6ea9a540e406295);
+		CHECK(test3() == 0xd95655ef07a129f5);
+		#endif
+
+		// Reference 64-bit FNV-1a values
+		CHECK(moe::FNV1aHash("") == 0xcbf29ce484222325);
+		CHECK(moe::FNV1aHash("a") == 0xaf63dc4c8601ec8c);
+		CHECK(moe::FNV1aHash("foobar") == 0x85944171f73967e8);
+	}
 
+	SECTION("Hash literals")
+	{
+		using namespace moe::literals;
+
+		// Computed at compile time...
+		static_assert("toto"_hs == 0x2ff4f1ef38b0c7ad, "_hs should be a compile-time FNV-1a hash");
+
+		constexpr moe::HashID jumpID = "Jump"_hs;
+		switch (moe::HashString("Jump")())
+		{
+		case "Jump"_hs:
+			break;
+		default:
+			FAIL("A hash literal should hash like a runtime HashString");
+		}
+
+		// ... and the same as the runtime hash string
+		moe::HashString jump = "Jump"_hs;
+		CHECK(jump() == jumpID);
+		CHECK(jump == moe::HashString("Jump"));
+		CHECK_HASH_STRING(jump, "Jump");
+
+		// Embedded zeroes are part of the literal
+		CHECK("a\0b"_hs != "a"_hs);
+	}
+
+	#ifndef MOE_SHIPPING
+	SECTION("Interning")
+	{
+		moe::HashString first("InterningTest");
+		moe::HashString second(std::string("InterningTest"));
+		CHECK(&first.GetString() == &second.GetString());
+
+		// An ID that was interned finds its string back
+		moe::HashString fromID(first());
+		CHECK_HASH_STRING(fromID, "InterningTest");
+
+		// Collisions are reported, and the first string stays
+		const uint32_t numCollisions = moe::GetNumHashStringCollisions();
+		CHECK(moe::InternHashString(first(), "InterningTest", 13));
+		CHECK_FALSE(moe::InternHashString(first(), "NotInterningTest", 16));
+		CHECK(moe::GetNumHashStringCollisions() == numCollisions + 1);
+		CHECK_HASH_STRING(first, "InterningTest");
 	}
+	#endif
 
 	SECTION("Hash value std::hash")
 	{
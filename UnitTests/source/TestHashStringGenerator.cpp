@@ -0,0 +1,163 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+#include "HashStringLexer.h"
+
+#include <algorithm>
+
+// The sources given to the lexer are raw strings : the lexer skips them, so these tests survive their own Shipping rewrite.
+
+TEST_CASE("HashStringGenerator lexer", "[Tools]")
+{
+	SECTION("Finds the constructor arguments and the _hs literals")
+	{
+		const std::string source = R"(
+			moe::HashString a("First");
+			auto b = moe::HashString{ "Second" };
+			Use(HashString( "Third" ));
+			auto d = "Fourth"_hs;
+		)";
+
+		const std::vector<moe::FoundHashString> found = moe::FindHashStrings(source, "Test.cpp");
+		REQUIRE(found.size() == 4);
+
+		CHECK(found[0].m_value == "First");
+		CHECK(found[0].m_kind == moe::HashStringKind::Constructor);
+		CHECK(found[0].m_line == 2);
+		CHECK(source.substr(found[0].m_begin, found[0].m_end - found[0].m_begin) == "\"First\"");
+
+		CHECK(found[1].m_value == "Second");
+		CHECK(found[2].m_value == "Third");
+		CHECK(found[2].m_line == 4);
+
+		CHECK(found[3].m_value == "Fourth");
+		CHECK(found[3].m_kind == moe::HashStringKind::Literal);
+		CHECK(source.substr(found[3].m_begin, found[3].m_end - found[3].m_begin) == "\"Fourth\"_hs");
+		CHECK(found[3].GetID() == moe::FNV1aHash("Fourth"));
+	}
+
+	SECTION("Leaves the other strings alone")
+	{
+		const std::string source = R"(
+			Print("NotAHashString");
+			moe::HashString a("Too", "ManyArguments");
+			auto b = L"Wide"_hs;
+			auto c = u8"Utf8"_hs;
+			auto d = "Suffix"_hsv;
+			constexpr HashLiteral operator""_hs(const char* str, size_t length);
+		)";
+
+		CHECK(moe::FindHashStrings(source, "Test.cpp").empty());
+	}
+
+	SECTION("Unescapes the literals")
+	{
+		const std::string source = R"(
+			auto a = "Tab\tQuote\"Backslash\\"_hs;
+			auto b = "\x41\101\7"_hs;
+			auto c = "Cut\0Here"_hs;
+			moe::HashString d("Cut\0Here");
+		)";
+
+		const std::vector<moe::FoundHashString> found = moe::FindHashStrings(source, "Test.cpp");
+		REQUIRE(found.size() == 4);
+
+		CHECK(found[0].m_value == "Tab\tQuote\"Backslash\\");
+		CHECK(found[1].m_value == "AA\a");
+
+		// Literals hash their whole length, constructors stop at the first null character, like at runtime.
+		CHECK(found[2].m_value == std::string("Cut\0Here", 8));
+		CHECK(found[2].GetID() == moe::FNV1aHash("Cut\0Here", 8));
+		CHECK(found[3].GetID() == moe::FNV1aHash("Cut"));
+	}
+
+	SECTION("Skips comments")
+	{
+		const std::string source = R"(
+			// moe::HashString a("LineComment");
+			/* auto b = "BlockComment"_hs;
+			   moe::HashString c("StillInTheComment"); */
+			auto d = "AfterComments"_hs; // "Trailing"_hs
+		)";
+
+		const std::vector<moe::FoundHashString> found = moe::FindHashStrings(source, "Test.cpp");
+		REQUIRE(found.size() == 1);
+		CHECK(found[0].m_value == "AfterComments");
+		CHECK(found[0].m_line == 5);
+	}
+
+	SECTION("Skips raw strings and character literals")
+	{
+		const std::string source = "auto a = R\"(moe::HashString b(\"InRaw\");)\";\n"
+			"auto c = R\"delim(\"InDelimitedRaw\"_hs )\" )delim\";\n"
+			"char d = '\"'; char e = '\\''; moe::HashString f(\"AfterChars\");\n"
+			"int g = 1'000'000; auto h = \"AfterSeparators\"_hs;\n";
+
+		const std::vector<moe::FoundHashString> found = moe::FindHashStrings(source, "Test.cpp");
+		REQUIRE(found.size() == 2);
+		CHECK(found[0].m_value == "AfterChars");
+		CHECK(found[0].m_line == 3);
+		CHECK(found[1].m_value == "AfterSeparators");
+		CHECK(found[1].m_line == 4);
+	}
+
+	SECTION("Strings in other strings are not hash strings")
+	{
+		const std::string source = R"(
+			Print("moe::HashString a(\"Escaped\");");
+			auto b = "Real"_hs;
+		)";
+
+		const std::vector<moe::FoundHashString> found = moe::FindHashStrings(source, "Test.cpp");
+		REQUIRE(found.size() == 1);
+		CHECK(found[0].m_value == "Real");
+	}
+}
+
+
+TEST_CASE("HashStringGenerator rewrite", "[Tools]")
+{
+	const std::string source = R"(#include "Core/HashString/HashString.h"
+moe::HashString a("First");
+auto b = "Second"_hs; // "Comment"_hs
+Print("Untouched");
+)";
+
+	const std::string rewritten = moe::RewriteHashStrings(source, "Dir\\Test.cpp");
+
+	SECTION("Points back to the original file")
+	{
+		const std::string lineDirective = "#line 1 \"Dir\\\\Test.cpp\"\n";
+		REQUIRE(rewritten.compare(0, lineDirective.size(), lineDirective) == 0);
+
+		// Same lines after the directive, so the debug information stays right.
+		CHECK(std::count(rewritten.begin(), rewritten.end(), '\n') == std::count(source.begin(), source.end(), '\n') + 1);
+	}
+
+	SECTION("Replaces the literals by their hash")
+	{
+		const std::string expected = "#line 1 \"Dir\\\\Test.cpp\"\n"
+			"#include \"Core/HashString/HashString.h\"\n"
+			"moe::HashString a(moe::HashID(" + moe::ToHex(moe::FNV1aHash("First")) + "ull));\n"
+			"auto b = moe::HashLiteral{ " + moe::ToHex(moe::FNV1aHash("Second")) + "ull }; // \"Comment\"_hs\n"
+			"Print(\"Untouched\");\n";
+
+		CHECK(rewritten == expected);
+		CHECK(moe::ToHex(0x2ff4f1ef38b0c7adull) == "0x2ff4f1ef38b0c7ad");
+	}
+
+	SECTION("Keeps the byte order mark first")
+	{
+		const std::string bom = "\xEF\xBB\xBF";
+		const std::string rewrittenWithBOM = moe::RewriteHashStrings(bom + source, "Dir\\Test.cpp");
+		CHECK(rewrittenWithBOM == bom + rewritten);
+	}
+
+	SECTION("Rewriting twice changes nothing more")
+	{
+		const std::string rewrittenSource = rewritten.substr(rewritten.find('\n') + 1);
+		const std::string rewrittenTwice = moe::RewriteHashStrings(rewrittenSource, "Dir\\Test.cpp");
+		CHECK(rewrittenTwice == rewritten);
+	}
+}
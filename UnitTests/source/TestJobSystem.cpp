@@ -0,0 +1,177 @@
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Jobs/JobSystem.h"
+
+
+TEST_CASE("JobSystem", "[Core]")
+{
+	moe::JobSystemConfig config;
+	config.m_numWorkers = 3;
+	moe::JobSystem jobSystem(config);
+
+	CHECK(jobSystem.GetWorkerCount() == 3);
+	CHECK(jobSystem.GetThreadCount() == 4);
+
+	SECTION("WorkStealingQueue")
+	{
+		moe::WorkStealingQueue<int> queue(4);
+		int values[5] = { 0, 1, 2, 3, 4 };
+
+		CHECK(queue.Pop() == nullptr);
+		CHECK(queue.Steal() == nullptr);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			CHECK(queue.Push(&values[i]));
+		}
+		CHECK(queue.Push(&values[4]) == false); // full
+
+		// The owner pops LIFO, thieves steal FIFO
+		CHECK(queue.Pop() == &values[3]);
+		CHECK(queue.Steal() == &values[0]);
+		CHECK(queue.Pop() == &values[2]);
+		CHECK(queue.Pop() == &values[1]);
+		CHECK(queue.Empty());
+	}
+
+	SECTION("Run and Wait")
+	{
+		std::atomic<int> sum{ 0 };
+		moe::JobCounter counter;
+
+		for (int i = 1; i <= 1000; ++i)
+		{
+			jobSystem.Run([&sum, i]() { sum += i; }, &counter);
+		}
+
+		jobSystem.Wait(counter);
+		CHECK(counter.IsDone());
+		CHECK(sum == 500500);
+	}
+
+	SECTION("Nested jobs")
+	{
+		// Jobs spawning and waiting on other jobs must not deadlock the workers
+		std::atomic<int> leaves{ 0 };
+		moe::JobCounter rootCounter;
+
+		for (int i = 0; i < 16; ++i)
+		{
+			jobSystem.Run([&jobSystem, &leaves]()
+			{
+				moe::JobCounter childCounter;
+				for (int j = 0; j < 16; ++j)
+				{
+					jobSystem.Run([&leaves]() { leaves++; }, &childCounter);
+				}
+				jobSystem.Wait(childCounter);
+			}, &rootCounter);
+		}
+
+		jobSystem.Wait(rootCounter);
+		CHECK(leaves == 256);
+	}
+
+	SECTION("ParallelFor")
+	{
+		std::vector<int> values(10000);
+		jobSystem.ParallelFor((uint32_t)values.size(), 64, [&values](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				values[i] = (int)i * 2;
+			}
+		});
+
+		bool allDone = true;
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			allDone &= (values[i] == (int)i * 2);
+		}
+		CHECK(allDone);
+
+		// Default batch size
+		std::atomic<uint64_t> total{ 0 };
+		jobSystem.ParallelFor(1000, 0, [&total](uint32_t begin, uint32_t end)
+		{
+			uint64_t partial = 0;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				partial += i;
+			}
+			total += partial;
+		});
+		CHECK(total == 499500);
+	}
+
+	SECTION("Run from another thread")
+	{
+		// Other threads cannot touch the deques : their jobs run right away (and assert).
+		int value = 0;
+		bool doneRightAway = false;
+		std::thread outsider([&jobSystem, &value, &doneRightAway]()
+		{
+			moe::JobCounter counter;
+			jobSystem.Run([&value]() { value = 42; }, &counter);
+			doneRightAway = counter.IsDone();
+			jobSystem.Wait(counter);
+		});
+		outsider.join();
+
+		CHECK(doneRightAway);
+		CHECK(value == 42);
+	}
+
+	SECTION("Frame allocator")
+	{
+		// Executed jobs are reused : the ring wraps around without ever running out.
+		moe::FrameJobAllocator allocator(4);
+		moe::Job* firstJobs[4];
+		int executed = 0;
+
+		for (int lap = 0; lap < 3; ++lap)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				moe::Job* job = allocator.Allocate();
+				REQUIRE(job != nullptr);
+				if (lap == 0)
+				{
+					firstJobs[i] = job;
+				}
+				CHECK(job == firstJobs[i]);
+
+				job->Set([&executed]() { executed++; }, nullptr);
+				CHECK(job->IsInFlight());
+				job->Execute();
+				CHECK(false == job->IsInFlight());
+			}
+		}
+		CHECK(executed == 12);
+
+		// Far more jobs than the main thread's 4096, without any NewFrame.
+		std::atomic<int> count{ 0 };
+		for (int frame = 0; frame < 5; ++frame)
+		{
+			moe::JobCounter counter;
+			for (int i = 0; i < 3000; ++i)
+			{
+				jobSystem.Run([&count]() { count++; }, &counter);
+			}
+			jobSystem.Wait(counter);
+		}
+		CHECK(count == 15000);
+
+		jobSystem.NewFrame();
+	}
+}
@@ -0,0 +1,232 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include <cmath>
+#include <random>
+
+#include "Core/Jobs/JobSystem.h"
+#include "Graphics/Camera/Camera.h"
+#include "Graphics/Device/Null/NullGraphicsDevice.h"
+#include "Graphics/Light/LightClusters.h"
+#include "Graphics/Light/LightSystem.h"
+
+
+namespace
+{
+	moe::LightData	MakePointLight(const moe::Vec3& position, float linear, float quadratic)
+	{
+		moe::LightData light;
+		light.m_position = moe::Vec4(position, 1.f);
+		light.m_linearAttenuation = linear;
+		light.m_quadraticAttenuation = quadratic;
+		return light;
+	}
+
+
+	// Finds the cluster of a view space point, the way shaders do it.
+	uint32_t	FindCluster(const moe::LightClusters& clusters, moe::Mat4 projection, const moe::Vec3& viewPos)
+	{
+		using namespace moe;
+
+		const Vec4 clipPos = projection * Vec4(viewPos, 1.f);
+		const float ndcX = clipPos.x() / clipPos.w();
+		const float ndcY = clipPos.y() / clipPos.w();
+
+		const LightClustersParams& params = clusters.GetParams();
+		const uint32_t tileX = std::min((uint32_t)((ndcX * 0.5f + 0.5f) * params.m_numTilesX), params.m_numTilesX - 1);
+		const uint32_t tileY = std::min((uint32_t)((ndcY * 0.5f + 0.5f) * params.m_numTilesY), params.m_numTilesY - 1);
+		const float slice = std::log(-viewPos.z()) * params.m_sliceScale + params.m_sliceBias;
+		const uint32_t sliceIdx = std::min((uint32_t)std::max(slice, 0.f), params.m_numSlices - 1);
+
+		return LightClusters::GetClusterIndex(tileX, tileY, sliceIdx);
+	}
+
+
+	bool	ClusterHasLight(const moe::LightClusters& clusters, uint32_t clusterIdx, uint32_t lightIdx)
+	{
+		const moe::LightCluster& cluster = clusters.GetClusters()[clusterIdx];
+		for (uint32_t iLight = cluster.m_offset; iLight < cluster.m_offset + cluster.m_count; ++iLight)
+		{
+			if (clusters.GetLightIndices()[iLight] == lightIdx)
+				return true;
+		}
+
+		return false;
+	}
+}
+
+
+TEST_CASE("LightClusters", "[Graphics]")
+{
+	using namespace moe;
+
+	const float zNear = 0.1f;
+	const float zFar = 100.f;
+	const Mat4 projection = Mat4::Perspective(Rads_f(Degs_f(60.f)), 16.f / 9.f, zNear, zFar);
+	const Vec2 viewportSize(1600.f, 900.f);
+
+	SECTION("Computes light ranges from attenuation")
+	{
+		const LightData light = MakePointLight(Vec3(0.f), 0.09f, 0.032f);
+		const float range = LightClusters::ComputeLightRange(light);
+		REQUIRE(range > 0.f);
+
+		const float attenuation = 1.f / (1.f + 0.09f * range + 0.032f * range * range);
+		REQUIRE(attenuation == Approx(LightClusters::ms_ATTENUATION_CUTOFF));
+
+		REQUIRE(LightClusters::ComputeLightRange(MakePointLight(Vec3(0.f), 0.f, 0.f)) < 0.f);
+	}
+
+	SECTION("Puts lights in the clusters they reach")
+	{
+		Vector<LightData> lights;
+		lights.PushBack(MakePointLight(Vec3(0.f, 0.f, -10.f), 0.7f, 1.8f)); // range of about 11 units
+
+		LightData directional;
+		directional.m_position = Vec4::ZeroVector();
+		directional.m_direction = Vec4(0.f, -1.f, 0.f, 0.f);
+		lights.PushBack(directional);
+
+		LightClusters clusters;
+		clusters.Build(Mat4::Identity(), projection, zNear, zFar, viewportSize, lights.Data(), (uint32_t)lights.Size());
+
+		// The directional light is global
+		REQUIRE(clusters.GetParams().m_numGlobalLights == 1);
+		REQUIRE(clusters.GetLightIndices()[0] == 1);
+		REQUIRE(clusters.GetClusters().Size() == LightClusters::ms_NUM_CLUSTERS);
+
+		REQUIRE(ClusterHasLight(clusters, FindCluster(clusters, projection, Vec3(0.f, 0.f, -10.f)), 0));
+		REQUIRE(ClusterHasLight(clusters, FindCluster(clusters, projection, Vec3(0.5f, 0.5f, -9.f)), 0));
+
+		// Behind the light, or on the far sides of the frustum, it does not reach
+		REQUIRE_FALSE(ClusterHasLight(clusters, FindCluster(clusters, projection, Vec3(0.f, 0.f, -80.f)), 0));
+		REQUIRE_FALSE(ClusterHasLight(clusters, FindCluster(clusters, projection, Vec3(-80.f, 40.f, -90.f)), 0));
+	}
+
+	SECTION("Never misses a light, in parallel or not")
+	{
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> lateral(-40.f, 40.f);
+		std::uniform_real_distribution<float> depth(-90.f, -0.5f);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+		Vector<LightData> lights;
+		for (int iLight = 0; iLight < 2000; ++iLight)
+		{
+			lights.PushBack(MakePointLight(Vec3(lateral(rng), lateral(rng), depth(rng)), 2.f, 5.f));
+		}
+
+		LightClusters serialClusters;
+		serialClusters.Build(Mat4::Identity(), projection, zNear, zFar, viewportSize, lights.Data(), (uint32_t)lights.Size());
+
+		JobSystemConfig config;
+		config.m_numWorkers = 3;
+		JobSystem jobSystem(config);
+
+		// Build for many frames first : the job system must keep up without ever being reset.
+		LightClusters parallelClusters;
+		for (int frame = 0; frame < 1000; ++frame)
+		{
+			parallelClusters.Build(Mat4::Identity(), projection, zNear, zFar, viewportSize, lights.Data(), 10, &jobSystem);
+		}
+		parallelClusters.Build(Mat4::Identity(), projection, zNear, zFar, viewportSize, lights.Data(), (uint32_t)lights.Size(), &jobSystem);
+
+		REQUIRE(parallelClusters.GetLightIndices().Size() == serialClusters.GetLightIndices().Size());
+		bool sameIndices = true;
+		for (uint32_t iIndex = 0; iIndex < serialClusters.GetLightIndices().Size(); ++iIndex)
+		{
+			sameIndices &= (parallelClusters.GetLightIndices()[iIndex] == serialClusters.GetLightIndices()[iIndex]);
+		}
+		REQUIRE(sameIndices);
+
+		// Lots of lights, but each cluster only gets a few of them
+		REQUIRE(serialClusters.GetLightIndices().Size() < lights.Size() * LightClusters::ms_NUM_CLUSTERS / 20);
+
+		// Any visible point lit by a light must find it in its cluster
+		const float range = LightClusters::ComputeLightRange(lights[0]);
+		uint32_t numChecked = 0;
+		bool allFound = true;
+
+		for (uint32_t iLight = 0; iLight < lights.Size(); iLight += 7)
+		{
+			const Vec3 lightPos = lights[iLight].m_position.xyz();
+			for (int iSample = 0; iSample < 8; ++iSample)
+			{
+				const Vec3 samplePos = lightPos + Vec3(unit(rng), unit(rng), unit(rng)) * (range * 0.5f);
+
+				Mat4 proj = projection;
+				const Vec4 clipPos = proj * Vec4(samplePos, 1.f);
+				if (-samplePos.z() < zNear || -samplePos.z() > zFar
+					|| std::abs(clipPos.x()) > clipPos.w() || std::abs(clipPos.y()) > clipPos.w())
+				{
+					continue; // not visible
+				}
+
+				allFound &= ClusterHasLight(serialClusters, FindCluster(serialClusters, projection, samplePos), iLight);
+				numChecked++;
+			}
+		}
+
+		REQUIRE(numChecked > 100);
+		REQUIRE(allFound);
+	}
+
+	SECTION("Light system has no light limit")
+	{
+		NullGraphicsDevice device;
+		device.Initialize();
+
+		DeviceBufferHandle lightsBuffer;
+		uint64_t numDeletesBefore = 0;
+
+		{
+			LightSystem lightSystem(device);
+			lightsBuffer = lightSystem.GetLightsBufferHandle();
+
+			Vector<LightObject*> lightObjects;
+			for (int iLight = 0; iLight < 3 * MAX_LIGHTS; ++iLight)
+			{
+				lightObjects.PushBack(lightSystem.AddNewLight(MakePointLight(Vec3((float)iLight, 0.f, -5.f), 0.7f, 1.8f)));
+			}
+			REQUIRE(lightSystem.LightsNumber() == 3 * MAX_LIGHTS);
+
+			// Light objects stay valid when more are added, and removing one moves the last one in its place
+			lightSystem.RemoveLight(lightObjects[3]);
+			REQUIRE(lightSystem.LightsNumber() == 3 * MAX_LIGHTS - 1);
+			REQUIRE(lightObjects.Back()->GetLightIndex() == 3);
+
+			CameraMatrices cameraMatrices;
+			const Camera camera(nullptr, ViewportHandle{}, PerspectiveCameraDesc{ Degs_f(60.f), 16.f / 9.f, zNear, zFar }, &cameraMatrices);
+
+			lightSystem.UpdateClusters(camera, viewportSize);
+			lightSystem.BindLightBuffer();
+			lightSystem.BindClusterBuffers();
+
+			REQUIRE_FALSE(lightSystem.NeedsUpdate());
+			REQUIRE(lightSystem.GetLightClusters().GetLightIndices().Size() > 0);
+
+			// Adding lights grows the storage buffers
+			for (int iLight = 0; iLight < 10 * MAX_LIGHTS; ++iLight)
+			{
+				lightSystem.AddNewLight(MakePointLight(Vec3(0.f, (float)iLight, -5.f), 0.7f, 1.8f));
+			}
+
+			lightSystem.UpdateClusters(camera, viewportSize);
+			lightSystem.BindClusterBuffers();
+
+			numDeletesBefore = device.GetStats().GetCalls(NullDeviceCommand::DeleteBuffer);
+		}
+
+		// The light system gives its two uniform blocks and three storage buffers back
+		REQUIRE(device.GetStats().GetCalls(NullDeviceCommand::DeleteBuffer) == numDeletesBefore + 5);
+		REQUIRE_FALSE(device.IsValidBuffer(lightsBuffer));
+		REQUIRE(device.GetStats().m_invalidHandles == 0);
+		device.Destroy();
+	}
+}
@@ -1,4 +1,7 @@
 #include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include "catch.hpp"
 
 // At the moment, tell Monocle we use std::string for our tests
@@ -183,5 +186,52 @@ TEST_CASE("moeLog", "[Core]")
 
         MOE_WARNING(moe::ChanDefault, "This passes the %s filter", "severity");
     }
- }
+
+    SECTION("Async log")
+    {
+        typedef moe::AsyncLogger<moe::SeverityFilterPolicy, moe::NoFormatPolicy, moe::CaptureWritePolicy> AsyncCaptureLogger;
+
+        // A tiny ring that blocks when full : every message must come out, in order for each thread
+        moe::AsyncLoggerConfig config;
+        config.m_ringCapacity = 4;
+        config.m_fullPolicy = moe::AsyncLogFullPolicy::Block;
+        config.m_batchSizeBytes = 16;
+
+        AsyncCaptureLogger asyncLogger(config, moe::SevWarning);
+
+        const int numThreads = 4;
+        const int numMessages = 500;
+        std::vector<std::thread> producers;
+        for (int iThread = 0; iThread < numThreads; ++iThread)
+        {
+            producers.emplace_back([&asyncLogger, iThread, numMessages]()
+            {
+                for (int iMsg = 0; iMsg < numMessages; ++iMsg)
+                {
+                    MOE_LOGGER_INFO(asyncLogger, moe::ChanDefault, "filtered out");
+                    MOE_LOGGER_WARNING(asyncLogger, moe::ChanDefault, "%c%03d;", 'a' + iThread, iMsg);
+                }
+            });
+        }
+
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+
+        asyncLogger.Flush();
+        std::string captured = asyncLogger.GetWritePolicy().GetCapturedOutput();
+        REQUIRE(captured.size() == numThreads * numMessages * 5);
+        CHECK(asyncLogger.GetDroppedCount() == 0);
+
+        bool inOrder = true;
+        int nextMsg[numThreads] = {};
+        for (size_t iChar = 0; iChar < captured.size(); iChar += 5)
+        {
+            const int iThread = captured[iChar] - 'a';
+            inOrder &= (std::stoi(captured.substr(iChar + 1, 3)) == nextMsg[iThread]++);
+        }
+        CHECK(inOrder);
+    }
+}
 
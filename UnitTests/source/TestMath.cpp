@@ -2,10 +2,13 @@
 #include "catch.hpp"
 
 #include "Math/Math.h"
+#include "Math/Bounds/Frustum.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include <random>
+
 // Taken from https://en.cppreference.com/w/cpp/types/numeric_limits/epsilon
 // TODO: study it more and integrate into Math library
 template<class T>
@@ -191,3 +194,113 @@ TEST_CASE("Maths", "[Math]")
 
  }
 
+
+TEST_CASE("Bounds and frustum culling", "[Math]")
+{
+	SECTION("AABB")
+	{
+		moe::AABB box;
+		CHECK_FALSE(box.IsValid());
+
+		const float positions[] = { 1, 2, 3,   -1, 5, 0,   4, -2, 1 };
+		box = moe::AABB::FromPoints(positions, 3);
+		REQUIRE(box.IsValid());
+		CHECK(box.m_min == moe::Vec3(-1, -2, 0));
+		CHECK(box.m_max == moe::Vec3(4, 5, 3));
+		CHECK(box.GetCenter() == moe::Vec3(1.5f, 1.5f, 1.5f));
+		CHECK(box.Contains(moe::Vec3(0, 0, 0)));
+		CHECK_FALSE(box.Contains(moe::Vec3(0, 6, 0)));
+
+		// A translated and scaled box stays tight
+		const moe::Mat4 transform = moe::Mat4::Translation(10, 0, 0) * moe::Mat4::Scaling(2, 2, 2);
+		const moe::AABB moved = box.Transformed(transform);
+		CHECK(moved.m_min == moe::Vec3(8, -4, 0));
+		CHECK(moved.m_max == moe::Vec3(18, 10, 6));
+
+		const moe::BoundingSphere sphere = moe::BoundingSphere::FromAABB(moe::AABB(moe::Vec3(-1), moe::Vec3(1)));
+		CHECK(AlmostEqual(sphere.m_radius, std::sqrt(3.f), 2));
+		CHECK(sphere.Transformed(transform).m_center == moe::Vec3(10, 0, 0));
+	}
+
+
+	const moe::Mat4 proj = moe::Mat4::Perspective(moe::Degs_f(60.f), 16.f / 9.f, 0.1f, 100.f);
+	const moe::Mat4 view = moe::Mat4::LookAtMatrix(moe::Vec3(0, 0, 5), moe::Vec3(0, 0, 0), moe::Vec3(0, 1, 0));
+	const moe::Frustum frustum(proj * view);
+
+	SECTION("Single volumes")
+	{
+		CHECK(frustum.Intersects(moe::AABB(moe::Vec3(-1), moe::Vec3(1))));
+		CHECK_FALSE(frustum.Intersects(moe::AABB(moe::Vec3(-1, -1, 6), moe::Vec3(1, 1, 8)))); // behind the camera
+		CHECK_FALSE(frustum.Intersects(moe::AABB(moe::Vec3(-1, -1, -200), moe::Vec3(1, 1, -150)))); // past the far plane
+		CHECK(frustum.Intersects(moe::AABB(moe::Vec3(-1, -1, 4), moe::Vec3(1, 1, 6)))); // around the camera
+
+		CHECK(frustum.Intersects(moe::BoundingSphere(moe::Vec3(0, 0, -10), 1.f)));
+		CHECK_FALSE(frustum.Intersects(moe::BoundingSphere(moe::Vec3(0, 0, 10), 1.f)));
+		CHECK_FALSE(frustum.Intersects(moe::BoundingSphere(moe::Vec3(100, 0, 0), 1.f)));
+	}
+
+	SECTION("Batch culling matches brute force")
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> posDist(-60.f, 60.f);
+		std::uniform_real_distribution<float> sizeDist(0.f, 5.f);
+
+		// Not a multiple of 4 so the scalar remainder runs as well
+		const uint32_t numBoxes = 4099;
+
+		moe::Vector<moe::AABB> boxes;
+		moe::AABBSoA soa;
+		for (uint32_t iBox = 0; iBox < numBoxes; ++iBox)
+		{
+			const moe::Vec3 center(posDist(rng), posDist(rng), posDist(rng));
+			const moe::Vec3 extents(sizeDist(rng), sizeDist(rng), sizeDist(rng));
+			boxes.PushBack(moe::AABB::FromCenterExtents(center, extents));
+			soa.PushBack(boxes.Back());
+		}
+
+		moe::Vector<uint32_t> visible;
+		frustum.Cull(soa, visible);
+
+		moe::Vector<uint32_t> expected;
+		uint32_t numCornersInside = 0;
+		for (uint32_t iBox = 0; iBox < numBoxes; ++iBox)
+		{
+			if (frustum.Intersects(boxes[iBox]))
+			{
+				expected.PushBack(iBox);
+			}
+
+			// A box with a corner inside the frustum must never get culled
+			for (int iCorner = 0; iCorner < 8; ++iCorner)
+			{
+				const moe::Vec3 corner((iCorner & 1) ? boxes[iBox].m_max.x() : boxes[iBox].m_min.x(),
+					(iCorner & 2) ? boxes[iBox].m_max.y() : boxes[iBox].m_min.y(),
+					(iCorner & 4) ? boxes[iBox].m_max.z() : boxes[iBox].m_min.z());
+
+				bool cornerInside = true;
+				for (int iPlane = 0; iPlane < moe::Frustum::PlaneCount; ++iPlane)
+				{
+					const moe::Vec4 plane = frustum.GetPlane((moe::Frustum::Plane)iPlane);
+					cornerInside &= (plane.x() * corner.x() + plane.y() * corner.y() + plane.z() * corner.z() + plane.w() >= 0.f);
+				}
+
+				if (cornerInside)
+				{
+					numCornersInside++;
+					CHECK(frustum.Intersects(boxes[iBox]));
+				}
+			}
+		}
+
+		CHECK(numCornersInside > 0);
+		CHECK(expected.Size() < numBoxes);
+
+		REQUIRE(visible.Size() == expected.Size());
+		bool sameResults = true;
+		for (uint32_t iVisible = 0; iVisible < visible.Size(); ++iVisible)
+		{
+			sameResults &= (visible[iVisible] == expected[iVisible]);
+		}
+		CHECK(sameResults);
+	}
+}
@@ -0,0 +1,145 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Misc/moeMappedFile.h"
+#include "Graphics/Model/ModelCache.h"
+
+
+TEST_CASE("ModelCache", "[Graphics]")
+{
+	using namespace moe;
+
+	ModelCacheWriter writer;
+
+	const uint32_t brickMat = writer.AddMaterial();
+	writer.SetMaterialTexture(brickMat, ModelTextureType::Diffuse, "brick_albedo.png");
+	writer.SetMaterialTexture(brickMat, ModelTextureType::Normal, "brick_normal.png");
+
+	writer.AddMesh(Vector<VertexPositionNormalTexture>{
+			{Vec3(-1, 0, 0), Vec3(0, 0, 1), Vec2(0, 0)},
+			{Vec3(1, 0, 0), Vec3(0, 0, 1), Vec2(1, 0)},
+			{Vec3(0, 2, -3), Vec3(0, 0, 1), Vec2(0, 1)}
+		}, Vector<uint32_t>{ 0, 1, 2 }, brickMat);
+
+	writer.AddMesh(Vector<VertexPositionNormalTexture>{ {Vec3(5, 5, 5), Vec3(0, 1, 0), Vec2(0, 0)} },
+		Vector<uint32_t>{}, ModelCacheReader::ms_NO_MATERIAL);
+
+	// Empty meshes are not cooked
+	writer.AddMesh(Vector<VertexPositionNormalTexture>{}, Vector<uint32_t>{}, brickMat);
+	REQUIRE(writer.GetNumMeshes() == 2);
+
+	const ModelSourceStamp stamp{ 1234, 5678 };
+	const Vector<std::byte> blob = writer.Cook(stamp);
+
+	SECTION("Reads back cooked models")
+	{
+		const ModelCacheReader reader(blob.Data(), blob.Size());
+		REQUIRE(reader.IsValid());
+		REQUIRE(reader.MatchesSource(stamp));
+		REQUIRE_FALSE(reader.MatchesSource(ModelSourceStamp{ 1234, 5679 }));
+		REQUIRE(reader.GetNumMeshes() == 2);
+
+		const ModelCacheMesh& triangle = reader.GetMesh(0);
+		const MeshDataDescriptor vertexData = reader.GetVertexData(triangle);
+		REQUIRE(vertexData.m_bufferNumElems == 3);
+		REQUIRE(vertexData.m_bufferSizeBytes == 3 * sizeof(VertexPositionNormalTexture));
+		REQUIRE(reinterpret_cast<uintptr_t>(vertexData.m_dataBuffer) % ModelCacheReader::ms_DATA_ALIGNMENT == 0);
+
+		const VertexPositionNormalTexture* vertices = static_cast<const VertexPositionNormalTexture*>(vertexData.m_dataBuffer);
+		REQUIRE(vertices[1].m_position.x() == 1.f);
+		REQUIRE(vertices[2].m_texcoords.y() == 1.f);
+
+		const MeshDataDescriptor indexData = reader.GetIndexData(triangle);
+		REQUIRE(indexData.m_bufferNumElems == 3);
+		REQUIRE(static_cast<const uint32_t*>(indexData.m_dataBuffer)[2] == 2);
+
+		const AABB bounds = ModelCacheReader::GetBounds(triangle);
+		REQUIRE(bounds.m_min.x() == -1.f);
+		REQUIRE(bounds.m_min.z() == -3.f);
+		REQUIRE(bounds.m_max.y() == 2.f);
+
+		const ModelCacheMaterial* material = reader.GetMaterial(triangle);
+		REQUIRE(material != nullptr);
+		REQUIRE(reader.GetTextureName(*material, ModelTextureType::Diffuse) == "brick_albedo.png");
+		REQUIRE(reader.GetTextureName(*material, ModelTextureType::Normal) == "brick_normal.png");
+		REQUIRE(reader.GetTextureName(*material, ModelTextureType::Specular).empty());
+
+		REQUIRE(reader.GetMaterial(reader.GetMesh(1)) == nullptr);
+		REQUIRE(reader.GetIndexData(reader.GetMesh(1)).IsNull());
+	}
+
+	SECTION("Cooks the same blob in parallel")
+	{
+		JobSystemConfig config;
+		config.m_numWorkers = 3;
+		JobSystem jobSystem(config);
+
+		// Enough meshes to keep every thread busy
+		for (uint32_t iMesh = 0; iMesh < 64; ++iMesh)
+		{
+			Vector<VertexPositionNormalTexture> vertices;
+			vertices.Resize(iMesh + 1, VertexPositionNormalTexture{ Vec3((float)iMesh), Vec3(0, 1, 0), Vec2(0, 0) });
+			writer.AddMesh(std::move(vertices), Vector<uint32_t>{ iMesh, iMesh }, brickMat);
+		}
+
+		const Vector<std::byte> serialBlob = writer.Cook(stamp);
+		const Vector<std::byte> parallelBlob = writer.Cook(stamp, &jobSystem);
+		REQUIRE(parallelBlob.Size() == serialBlob.Size());
+		REQUIRE(std::memcmp(parallelBlob.Data(), serialBlob.Data(), serialBlob.Size()) == 0);
+
+		const ModelCacheReader reader(parallelBlob.Data(), parallelBlob.Size());
+		REQUIRE(reader.IsValid());
+		REQUIRE(reader.GetNumMeshes() == 66);
+		REQUIRE(ModelCacheReader::GetBounds(reader.GetMesh(65)).m_max.x() == 63.f);
+	}
+
+	SECTION("Rejects corrupted models")
+	{
+		// Truncated
+		REQUIRE_FALSE(ModelCacheReader(blob.Data(), blob.Size() - 1).IsValid());
+		REQUIRE_FALSE(ModelCacheReader(blob.Data(), sizeof(ModelCacheHeader) - 1).IsValid());
+
+		// Out of bounds mesh data
+		Vector<std::byte> corrupted = blob;
+		ModelCacheMesh mesh;
+		std::memcpy(&mesh, corrupted.Data() + sizeof(ModelCacheHeader), sizeof(mesh));
+		mesh.m_numVertices = 1000;
+		std::memcpy(corrupted.Data() + sizeof(ModelCacheHeader), &mesh, sizeof(mesh));
+		REQUIRE_FALSE(ModelCacheReader(corrupted.Data(), corrupted.Size()).IsValid());
+	}
+
+	SECTION("Maps cooked model files")
+	{
+		const std::string cacheFilename = "TestModelCache.moemodel";
+		REQUIRE(ModelCacheWriter::WriteFile(cacheFilename, blob));
+
+		MappedFile cacheFile;
+		REQUIRE(cacheFile.Open(cacheFilename));
+		REQUIRE(cacheFile.Size() == blob.Size());
+
+		const ModelCacheReader reader(cacheFile.Data(), cacheFile.Size());
+		REQUIRE(reader.IsValid());
+		REQUIRE(reader.GetNumMeshes() == 2);
+		REQUIRE(std::memcmp(cacheFile.Data(), blob.Data(), blob.Size()) == 0);
+
+		// The mapping outlives the file name
+		MappedFile movedFile = std::move(cacheFile);
+		REQUIRE_FALSE(cacheFile.IsOpen());
+		std::remove(cacheFilename.c_str());
+		REQUIRE(movedFile.IsOpen());
+		REQUIRE(ModelCacheReader(movedFile.Data(), movedFile.Size()).IsValid());
+
+		REQUIRE_FALSE(cacheFile.Open(cacheFilename));
+		REQUIRE_FALSE(ModelSourceStamp::Of(cacheFilename).has_value());
+	}
+}
@@ -0,0 +1,247 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Graphics/Device/Null/NullGraphicsDevice.h"
+#include "Graphics/Renderer/Null/NullRenderer.h"
+#include "Graphics/Material/Material.h"
+#include "Graphics/Material/MaterialBindings.h"
+
+
+TEST_CASE("NullGraphicsDevice", "[Graphics]")
+{
+	using namespace moe;
+
+	NullGraphicsDevice device;
+	device.Initialize();
+
+	const NullGraphicsDeviceStats& stats = device.GetStats();
+
+	SECTION("Validates buffer handles")
+	{
+		uint8_t data[64]{};
+
+		DeviceBufferHandle vtxBuffer = device.CreateStaticVertexBuffer(data, sizeof(data));
+		DeviceBufferHandle idxBuffer = device.CreateIndexBuffer(data, 16);
+		REQUIRE(vtxBuffer.IsNotNull());
+		REQUIRE(idxBuffer.IsNotNull());
+		REQUIRE(stats.m_uploadedBytes == sizeof(data) + 16);
+
+		REQUIRE(device.IsValidBuffer(vtxBuffer, NullGraphicsDevice::VertexUsage, sizeof(data)));
+		REQUIRE_FALSE(device.IsValidBuffer(vtxBuffer, NullGraphicsDevice::VertexUsage, sizeof(data) + 1));
+		REQUIRE_FALSE(device.IsValidBuffer(vtxBuffer, NullGraphicsDevice::IndexUsage));
+
+		// Sub-range handles are validated against the buffer they point into
+		DeviceBufferHandle subRange = NullGraphicsDevice::EncodeBufferHandle(NullGraphicsDevice::DecodeBufferHandle(vtxBuffer).first, 48);
+		device.UpdateBuffer(subRange, data, 16);
+		REQUIRE(stats.m_invalidHandles == 0);
+		device.UpdateBuffer(subRange, data, 17);
+		REQUIRE(stats.m_invalidHandles == 1);
+
+		VertexLayoutHandle layout = device.CreateVertexLayout(VertexLayoutDescriptor{ {{"position", VertexElementFormat::Float3}}, LayoutType::Interleaved });
+		REQUIRE(layout.IsNotNull());
+
+		device.DrawVertexBuffer(layout, vtxBuffer, 4, idxBuffer, 6);
+		REQUIRE(stats.m_invalidHandles == 1);
+		REQUIRE(stats.m_drawnVertices == 6);
+
+		// Wrong kind of buffer
+		device.DrawVertexBuffer(layout, idxBuffer, 4, vtxBuffer, 6);
+		REQUIRE(stats.m_invalidHandles == 2);
+
+		// Stale handle : deleted buffers never come back to life
+		device.DeleteStaticVertexBuffer(vtxBuffer);
+		DeviceBufferHandle newBuffer = device.CreateStaticVertexBuffer(data, sizeof(data));
+		REQUIRE(newBuffer != vtxBuffer);
+
+		device.DrawVertexBuffer(layout, vtxBuffer, 4, idxBuffer, 6);
+		REQUIRE(stats.m_invalidHandles == 3);
+		REQUIRE(stats.m_drawnVertices == 6);
+
+		REQUIRE(stats.GetCalls(NullDeviceCommand::DrawVertexBuffer) == 3);
+		REQUIRE(stats.GetCalls(NullDeviceCommand::CreateBuffer) == 4); // Including the streaming buffer
+	}
+
+	SECTION("Keeps vertex layouts and framebuffers in place")
+	{
+		const VertexLayoutDescriptor layoutDesc{ {{"position", VertexElementFormat::Float3}}, LayoutType::Interleaved };
+		const FramebufferDescriptor fbDesc;
+
+		VertexLayoutHandle firstLayout = device.CreateVertexLayout(layoutDesc);
+		const VertexLayout* firstLayoutPtr = device.GetVertexLayout(firstLayout);
+		REQUIRE(firstLayoutPtr != nullptr);
+
+		FramebufferHandle firstFramebuffer = device.CreateFramebuffer(fbDesc);
+		const AFramebuffer* firstFramebufferPtr = device.MutFramebuffer(firstFramebuffer);
+		REQUIRE(firstFramebufferPtr != nullptr);
+
+		// Enough new ones to fill several pages
+		for (int iLayout = 0; iLayout < 200; ++iLayout)
+		{
+			const std::string semantic = "position" + std::to_string(iLayout);
+			device.CreateVertexLayout(VertexLayoutDescriptor{ {{semantic.c_str(), VertexElementFormat::Float3}}, LayoutType::Interleaved });
+			device.CreateFramebuffer(fbDesc);
+		}
+
+		REQUIRE(device.GetVertexLayout(firstLayout) == firstLayoutPtr);
+		REQUIRE(firstLayoutPtr->ReadDescriptor() == layoutDesc);
+		REQUIRE(device.MutFramebuffer(firstFramebuffer) == firstFramebufferPtr);
+
+		// Identical layouts still share a handle
+		REQUIRE(device.CreateVertexLayout(layoutDesc) == firstLayout);
+		REQUIRE(stats.m_invalidHandles == 0);
+	}
+
+	SECTION("Streams uniform data within the frame budget")
+	{
+		uint8_t data[256]{};
+
+		uint32_t numStreamed = 0;
+		while (device.StreamUniformData(data, 200).IsNotNull())
+		{
+			numStreamed++;
+		}
+
+		// Each allocation is aligned
+		REQUIRE(numStreamed == NullGraphicsDevice::ms_STREAM_BUFFER_SIZE / NullGraphicsDevice::ms_STREAM_ALIGNMENT);
+		REQUIRE(stats.m_streamedBytes == numStreamed * 200);
+
+		device.EndFrame();
+		REQUIRE(stats.m_frames == 1);
+
+		DeviceBufferHandle streamed = device.StreamUniformData(data, sizeof(data));
+		REQUIRE(streamed.IsNotNull());
+
+		device.BindUniformBlock(0, streamed, sizeof(data));
+		REQUIRE(stats.m_invalidHandles == 0);
+	}
+
+	SECTION("Signals asynchronous textures at the end of the frame")
+	{
+		int numLoaded = 0;
+		auto onLoaded = [&numLoaded](TextureHandle, TextureLoadState state)
+		{
+			REQUIRE(state == TextureLoadState::Ready);
+			numLoaded++;
+		};
+
+		Texture2DHandle texture = device.CreateTexture2DAsync(Texture2DFileDescriptor{ "albedo.png" }, onLoaded);
+		Texture2DHandle cancelled = device.CreateTexture2DAsync(Texture2DFileDescriptor{ "normal.png" }, onLoaded);
+		REQUIRE(device.GetTextureLoadState(texture) == TextureLoadState::Ready);
+
+		device.DestroyTexture2D(cancelled);
+		REQUIRE(numLoaded == 0);
+
+		device.EndFrame();
+		REQUIRE(numLoaded == 1);
+
+		device.EndFrame();
+		REQUIRE(numLoaded == 1);
+	}
+
+	SECTION("Records the command stream")
+	{
+		device.SetRecordingCommands(true);
+
+		ShaderProgramDescriptor programDesc{ {ShaderStage::Vertex, "void main() {}"} };
+		ShaderProgramHandle program = device.CreateShaderProgramFromSource(programDesc);
+		device.UseShaderProgram(program);
+		REQUIRE(device.RemoveShaderProgram(program));
+		device.UseShaderProgram(program);
+
+		const auto& commands = device.GetRecordedCommands();
+		REQUIRE(commands.Size() == 4);
+		REQUIRE(commands[0].m_command == NullDeviceCommand::CreateShaderProgram);
+		REQUIRE(commands[1].m_command == NullDeviceCommand::UseShaderProgram);
+		REQUIRE(commands[1].m_handle == program.Get());
+		REQUIRE(commands[2].m_command == NullDeviceCommand::RemoveShaderProgram);
+		REQUIRE(commands[3].m_command == NullDeviceCommand::UseShaderProgram);
+
+		for (uint32_t iCmd = 1; iCmd < commands.Size(); ++iCmd)
+		{
+			REQUIRE(commands[iCmd].m_timestampNs >= commands[iCmd - 1].m_timestampNs);
+		}
+
+		REQUIRE(stats.m_invalidHandles == 1);
+
+		device.ResetStats();
+		REQUIRE(stats.GetCalls(NullDeviceCommand::UseShaderProgram) == 0);
+		REQUIRE(stats.m_invalidHandles == 0);
+	}
+
+	device.Destroy();
+}
+
+
+TEST_CASE("NullRenderer", "[Graphics]")
+{
+	using namespace moe;
+
+	struct Vertex
+	{
+		Vec3	m_position;
+	};
+
+	NullRenderer renderer;
+	REQUIRE(renderer.Initialize(nullptr));
+
+	const NullGraphicsDeviceStats& stats = renderer.MutNullDevice().GetStats();
+
+	RenderWorld& world = renderer.CreateRenderWorld();
+
+	Camera* camera = world.CreateCamera(PerspectiveCameraDesc{ 45_degf, 1.f, 0.1f, 100.f }, ViewportDescriptor(0, 0, 800, 600));
+	REQUIRE(camera != nullptr);
+
+	VertexLayoutHandle layout = renderer.CreateVertexLayout(VertexLayoutDescriptor{ {{"position", VertexElementFormat::Float3}}, LayoutType::Interleaved });
+
+	Vector<Vertex> vertices{ {Vec3(-1, -1, 0)}, {Vec3(1, -1, 0)}, {Vec3(0, 1, 0)} };
+	Vector<uint32_t> indices{ 0, 1, 2 };
+
+	// Camera looks down -Z : the mesh behind it gets culled.
+	Mesh* visibleMesh = world.CreateStaticMesh(vertices, indices);
+	visibleMesh->SetTransform(Transform::Translate(Vec3(0, 0, -10)));
+
+	Mesh* culledMesh = world.CreateStaticMesh(vertices, indices);
+	culledMesh->SetTransform(Transform::Translate(Vec3(0, 0, 10)));
+
+	ResourceLayoutDescriptor objectLayoutDesc{
+		{"ObjectMatrices", MaterialBlockBinding::OBJECT_MATRICES, ResourceKind::UniformBuffer, ShaderStage::Vertex }
+	};
+	ResourceLayoutHandle objectLayout = renderer.CreateResourceLayout(objectLayoutDesc);
+	ResourceSetHandle objectSet = renderer.CreateResourceSet(ResourceSetDescriptor{ objectLayout, {renderer.CreateUniformBufferFrom(ObjectMatrices())} });
+
+	ShaderProgramHandle program = renderer.CreateShaderProgramFromSource(ShaderProgramDescriptor{ {ShaderStage::Vertex, "void main() {}"} });
+	Material material(renderer, program);
+	material.AddPerObjectResourceSet(objectSet);
+
+	renderer.MutNullDevice().ResetStats();
+
+	for (int iFrame = 0; iFrame < 3; ++iFrame)
+	{
+		world.BeginDraw();
+
+		const Vector<Mesh*>& visibleObjects = world.GetVisibleObjects(0);
+		REQUIRE(visibleObjects.Size() == 1);
+		REQUIRE(visibleObjects[0] == visibleMesh);
+
+		world.SubmitMesh(visibleObjects[0], layout, &material, PipelineHandle::Null(), 0, 0.f, false);
+		world.FlushRenderQueue();
+
+		renderer.MutGraphicsDevice().EndFrame();
+	}
+
+	REQUIRE(stats.m_invalidHandles == 0);
+	REQUIRE(stats.m_frames == 3);
+	REQUIRE(stats.GetCalls(NullDeviceCommand::DrawVertexBuffer) == 3);
+	REQUIRE(stats.GetCalls(NullDeviceCommand::UseViewport) == 3);
+	REQUIRE(stats.GetCalls(NullDeviceCommand::UseShaderProgram) == 3);
+	REQUIRE(stats.GetCalls(NullDeviceCommand::StreamUniformData) == 3);
+	REQUIRE(stats.m_drawnVertices == 9);
+
+	renderer.Shutdown();
+}
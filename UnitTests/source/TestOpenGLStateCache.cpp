@@ -0,0 +1,121 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+#include <Graphics/Device/OpenGL/OpenGLStateCache.h>
+
+
+namespace
+{
+	/*
+		Stands in for the state functions of the driver, so the state cache can be tested without a rendering context :
+		it only counts the calls that reach it.
+	*/
+	struct FakeGLState
+	{
+		FakeGLState() :
+			m_enable(glad_glEnable), m_disable(glad_glDisable), m_depthMask(glad_glDepthMask), m_depthFunc(glad_glDepthFunc),
+			m_stencilMask(glad_glStencilMask), m_stencilOp(glad_glStencilOpSeparate), m_stencilFunc(glad_glStencilFuncSeparate),
+			m_bindVertexArray(glad_glBindVertexArray), m_bindSampler(glad_glBindSampler)
+		{
+			ms_stencilMaskCalls = 0;
+			ms_bindVertexArrayCalls = 0;
+			ms_bindSamplerCalls = 0;
+
+			glad_glEnable = [](GLenum) {};
+			glad_glDisable = [](GLenum) {};
+			glad_glDepthMask = [](GLboolean) {};
+			glad_glDepthFunc = [](GLenum) {};
+			glad_glStencilMask = [](GLuint) { ms_stencilMaskCalls++; };
+			glad_glStencilOpSeparate = [](GLenum, GLenum, GLenum, GLenum) {};
+			glad_glStencilFuncSeparate = [](GLenum, GLenum, GLint, GLuint) {};
+			glad_glBindVertexArray = [](GLuint) { ms_bindVertexArrayCalls++; };
+			glad_glBindSampler = [](GLuint, GLuint) { ms_bindSamplerCalls++; };
+		}
+
+		~FakeGLState()
+		{
+			glad_glEnable = m_enable;
+			glad_glDisable = m_disable;
+			glad_glDepthMask = m_depthMask;
+			glad_glDepthFunc = m_depthFunc;
+			glad_glStencilMask = m_stencilMask;
+			glad_glStencilOpSeparate = m_stencilOp;
+			glad_glStencilFuncSeparate = m_stencilFunc;
+			glad_glBindVertexArray = m_bindVertexArray;
+			glad_glBindSampler = m_bindSampler;
+		}
+
+		static inline int	ms_stencilMaskCalls = 0;
+		static inline int	ms_bindVertexArrayCalls = 0;
+		static inline int	ms_bindSamplerCalls = 0;
+
+	private:
+
+		PFNGLENABLEPROC				m_enable;
+		PFNGLDISABLEPROC			m_disable;
+		PFNGLDEPTHMASKPROC			m_depthMask;
+		PFNGLDEPTHFUNCPROC			m_depthFunc;
+		PFNGLSTENCILMASKPROC		m_stencilMask;
+		PFNGLSTENCILOPSEPARATEPROC	m_stencilOp;
+		PFNGLSTENCILFUNCSEPARATEPROC	m_stencilFunc;
+		PFNGLBINDVERTEXARRAYPROC	m_bindVertexArray;
+		PFNGLBINDSAMPLERPROC		m_bindSampler;
+	};
+}
+
+
+TEST_CASE("OpenGLStateCache", "[Graphics]")
+{
+	using namespace moe;
+
+	FakeGLState fakeGL;
+	OpenGLStateCache cache;
+
+	SECTION("Every stencil write mask is a valid state")
+	{
+		OpenGLDepthStencilState dsState;
+		dsState.m_stencilWriteMask = 0xFFFFFFFF;
+
+		cache.SetDepthStencilState(dsState);
+		REQUIRE(FakeGLState::ms_stencilMaskCalls == 1);
+
+		cache.SetDepthStencilState(dsState);
+		REQUIRE(FakeGLState::ms_stencilMaskCalls == 1);
+
+		dsState.m_stencilWriteMask = 0xFF;
+		cache.SetDepthStencilState(dsState);
+		REQUIRE(FakeGLState::ms_stencilMaskCalls == 2);
+
+		// Unknown again after an invalidation
+		cache.Invalidate();
+		cache.SetDepthStencilState(dsState);
+		REQUIRE(FakeGLState::ms_stencilMaskCalls == 3);
+	}
+
+	SECTION("Forgets deleted vertex arrays and samplers")
+	{
+		cache.BindVertexArray(3);
+		cache.BindVertexArray(3);
+		REQUIRE(FakeGLState::ms_bindVertexArrayCalls == 1);
+
+		cache.BindSampler(0, 5);
+		cache.BindSampler(0, 5);
+		REQUIRE(FakeGLState::ms_bindSamplerCalls == 1);
+
+		// The names may be recycled by new objects : they have to be bound again.
+		cache.ForgetVertexArray(3);
+		cache.ForgetSampler(5);
+
+		cache.BindVertexArray(3);
+		cache.BindSampler(0, 5);
+		REQUIRE(FakeGLState::ms_bindVertexArrayCalls == 2);
+		REQUIRE(FakeGLState::ms_bindSamplerCalls == 2);
+
+		// Other bindings are left alone
+		cache.BindSampler(1, 6);
+		cache.ForgetSampler(5);
+		cache.BindSampler(1, 6);
+		REQUIRE(FakeGLState::ms_bindSamplerCalls == 3);
+	}
+}
@@ -0,0 +1,68 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "catch.hpp"
+
+#include "Graphics/Shader/Manager/OpenGL/OpenGLProgramBinaryCache.h"
+
+// The keys need no rendering context : they only hash the program descriptor and the driver hash.
+TEST_CASE("Program binary cache keys", "[Graphics]")
+{
+	using namespace moe;
+
+	const uint64_t driverHash = 0x0123456789abcdefull;
+
+	const auto makeProgram = []()
+	{
+		return ShaderProgramDescriptor{
+			{ ShaderStage::Vertex, "void main() { gl_Position = vec4(0.0); }", "main" },
+			{ ShaderStage::Fragment, "out vec4 color; void main() { color = vec4(1.0); }", "main" }
+		};
+	};
+
+	const ShaderProgramDescriptor program = makeProgram();
+	const uint64_t key = OpenGLProgramBinaryCache::ComputeProgramKey(program, false, driverHash);
+
+	SECTION("Identical inputs give identical keys")
+	{
+		const ShaderProgramDescriptor sameProgram = makeProgram();
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(sameProgram, false, driverHash) == key);
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(program, false, driverHash) == key);
+	}
+
+	SECTION("The shader code changes the key")
+	{
+		ShaderProgramDescriptor changed = makeProgram();
+		changed.m_modules[1].m_shaderCode = "out vec4 color; void main() { color = vec4(0.5); }";
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(changed, false, driverHash) != key);
+
+		// Moving code from a module to the next one is a different program too
+		ShaderProgramDescriptor moved = makeProgram();
+		moved.m_modules[1].m_shaderCode = moved.m_modules[0].m_shaderCode.substr(moved.m_modules[0].m_shaderCode.size() - 1) + moved.m_modules[1].m_shaderCode;
+		moved.m_modules[0].m_shaderCode.pop_back();
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(moved, false, driverHash) != key);
+	}
+
+	SECTION("The entry point changes the key")
+	{
+		ShaderProgramDescriptor changed = makeProgram();
+		changed.m_modules[0].m_entryPoint = "vertexMain";
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(changed, false, driverHash) != key);
+	}
+
+	SECTION("The stage changes the key")
+	{
+		ShaderProgramDescriptor changed = makeProgram();
+		changed.m_modules[0].m_moduleStage = ShaderStage::Geometry;
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(changed, false, driverHash) != key);
+	}
+
+	SECTION("The driver changes the key")
+	{
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(program, false, driverHash + 1) != key);
+	}
+
+	SECTION("GLSL and SPIR-V programs have different keys")
+	{
+		CHECK(OpenGLProgramBinaryCache::ComputeProgramKey(program, true, driverHash) != key);
+	}
+}
@@ -0,0 +1,169 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Misc/moeRadixSort.h"
+
+#include "Graphics/RenderQueue/RenderQueue.h"
+
+
+TEST_CASE("RadixSort64", "[Core]")
+{
+	struct KeyValue
+	{
+		uint64_t	m_key;
+		uint32_t	m_order;
+	};
+
+	auto getKey = [](const KeyValue& kv) { return kv.m_key; };
+
+	SECTION("Matches std::stable_sort")
+	{
+		std::mt19937_64 rng(42);
+
+		// Odd and even amounts of non-trivial passes, and keys with lots of duplicates to check stability
+		for (uint64_t keyMask : { 0xFFull, 0xFFFFull, 0xFF00FF0000ull, ~0ull, 0x7ull })
+		{
+			std::vector<KeyValue> values(1000);
+			for (uint32_t iValue = 0; iValue < values.size(); ++iValue)
+			{
+				values[iValue] = { rng() & keyMask, iValue };
+			}
+
+			std::vector<KeyValue> expected = values;
+			std::stable_sort(expected.begin(), expected.end(), [](const KeyValue& lhs, const KeyValue& rhs) { return lhs.m_key < rhs.m_key; });
+
+			std::vector<KeyValue> scratch(values.size());
+			moe::RadixSort64(values.data(), scratch.data(), values.size(), getKey);
+
+			bool sameOrder = true;
+			for (uint32_t iValue = 0; iValue < values.size(); ++iValue)
+			{
+				sameOrder &= (values[iValue].m_key == expected[iValue].m_key && values[iValue].m_order == expected[iValue].m_order);
+			}
+			CHECK(sameOrder);
+		}
+	}
+
+	SECTION("Trivial inputs")
+	{
+		KeyValue single{ 12, 0 };
+		KeyValue scratch;
+		moe::RadixSort64(&single, &scratch, 1, getKey);
+		CHECK(single.m_key == 12);
+
+		KeyValue allSame[3] = { {5, 0}, {5, 1}, {5, 2} };
+		KeyValue scratches[3];
+		moe::RadixSort64(allSame, scratches, 3, getKey);
+		CHECK((allSame[0].m_order == 0 && allSame[1].m_order == 1 && allSame[2].m_order == 2));
+	}
+}
+
+
+TEST_CASE("RenderKey", "[Graphics]")
+{
+	using moe::RenderKey;
+
+	SECTION("Depth quantization")
+	{
+		CHECK(RenderKey::QuantizeDepth(-1.f) == 0);
+		CHECK(RenderKey::QuantizeDepth(0.f) == 0);
+		CHECK(RenderKey::QuantizeDepth(2.f) == RenderKey::ms_MAX_DEPTH);
+		CHECK(RenderKey::QuantizeDepth(0.25f) < RenderKey::QuantizeDepth(0.5f));
+	}
+
+	SECTION("Passes come first")
+	{
+		const uint64_t pass0 = RenderKey::Translucent(0, 1023, 1000, 1000, RenderKey::ms_MAX_DEPTH);
+		const uint64_t pass1 = RenderKey::Opaque(1, 0, 0, 0, 0);
+		CHECK(pass0 < pass1);
+		CHECK(RenderKey::GetPass(pass1) == 1);
+		CHECK(RenderKey::GetPass(RenderKey::Opaque(63, 5, 5, 5, 5)) == 63);
+	}
+
+	SECTION("Opaque draws are grouped by state, then front to back")
+	{
+		const uint32_t near = RenderKey::QuantizeDepth(0.1f);
+		const uint32_t far = RenderKey::QuantizeDepth(0.9f);
+
+		CHECK(RenderKey::Opaque(0, 1, 1, 1, near) < RenderKey::Opaque(0, 1, 1, 1, far));
+		// A far draw using the same state than another must not be separated from it by a closer draw using another state
+		CHECK(RenderKey::Opaque(0, 1, 1, 1, far) < RenderKey::Opaque(0, 1, 2, 1, near));
+		CHECK(RenderKey::Opaque(0, 1, 9, 9, far) < RenderKey::Opaque(0, 2, 0, 0, near));
+	}
+
+	SECTION("Translucent draws go back to front")
+	{
+		const uint32_t near = RenderKey::QuantizeDepth(0.1f);
+		const uint32_t far = RenderKey::QuantizeDepth(0.9f);
+
+		CHECK(RenderKey::Translucent(0, 5, 5, 5, far) < RenderKey::Translucent(0, 1, 1, 1, near));
+	}
+}
+
+
+TEST_CASE("RenderQueue", "[Graphics]")
+{
+	// Commands are never executed here : we only need distinguishable payloads.
+	auto makeCommand = [](uintptr_t id)
+	{
+		moe::DrawCommand cmd;
+		cmd.m_mesh = reinterpret_cast<moe::Mesh*>(id);
+		return cmd;
+	};
+
+	SECTION("Draws recorded in several buckets get sorted together")
+	{
+		moe::RenderQueue queue(3);
+		CHECK(queue.GetBucketCount() == 3);
+
+		queue.Submit(30, makeCommand(3), 0);
+		queue.Submit(10, makeCommand(1), 1);
+		queue.Submit(20, makeCommand(2), 2);
+		queue.Submit(0, makeCommand(42), 2);
+
+		queue.Sort();
+
+		REQUIRE(queue.GetSortedCount() == 4);
+		CHECK(queue.GetSortedKey(0) == 0);
+		CHECK(queue.GetSortedKey(1) == 10);
+		CHECK(queue.GetSortedKey(2) == 20);
+		CHECK(queue.GetSortedKey(3) == 30);
+		CHECK(queue.GetSortedCommand(0).m_mesh == reinterpret_cast<moe::Mesh*>(42));
+		CHECK(queue.GetSortedCommand(3).m_mesh == reinterpret_cast<moe::Mesh*>(3));
+	}
+
+	SECTION("Equal keys keep their recording order, bucket by bucket")
+	{
+		moe::RenderQueue queue(2);
+
+		queue.Submit(7, makeCommand(3), 1);
+		queue.Submit(7, makeCommand(1), 0);
+		queue.Submit(7, makeCommand(2), 0);
+
+		queue.Sort();
+
+		REQUIRE(queue.GetSortedCount() == 3);
+		CHECK(queue.GetSortedCommand(0).m_mesh == reinterpret_cast<moe::Mesh*>(1));
+		CHECK(queue.GetSortedCommand(1).m_mesh == reinterpret_cast<moe::Mesh*>(2));
+		CHECK(queue.GetSortedCommand(2).m_mesh == reinterpret_cast<moe::Mesh*>(3));
+	}
+
+	SECTION("Clear drops the draws")
+	{
+		moe::RenderQueue queue;
+		queue.Submit(1, makeCommand(1));
+		queue.Clear();
+		queue.Sort();
+		CHECK(queue.GetSortedCount() == 0);
+	}
+}
@@ -0,0 +1,211 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "catch.hpp"
+
+// At the moment, tell Monocle we use std::string for our tests
+#ifndef MOE_STD_SUPPORT
+#define MOE_STD_SUPPORT
+#endif
+
+#include "Core/Jobs/JobSystem.h"
+
+#include "Graphics/SceneGraph/SceneGraph.h"
+
+
+namespace
+{
+	bool	NearlyEqual(const moe::Mat4& lhs, const moe::Mat4& rhs, float epsilon = 1e-3f)
+	{
+		for (int iCol = 0; iCol < 4; ++iCol)
+		{
+			for (int iRow = 0; iRow < 4; ++iRow)
+			{
+				const float diff = std::fabs(lhs[iCol][iRow] - rhs[iCol][iRow]);
+				if (diff > epsilon * std::fmax(1.f, std::fabs(rhs[iCol][iRow])))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+
+	moe::Transform	RandomTransform(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> posDist(-10.f, 10.f);
+		std::uniform_real_distribution<float> angleDist(-180.f, 180.f);
+		std::uniform_real_distribution<float> scaleDist(0.5f, 1.5f);
+
+		return moe::Transform::Translate(moe::Vec3(posDist(rng), posDist(rng), posDist(rng)))
+			* moe::Transform::Rotate(moe::Degs_f(angleDist(rng)), moe::Vec3(0.f, 1.f, 0.f))
+			* moe::Transform::Scale(moe::Vec3(scaleDist(rng)));
+	}
+
+
+	// Brute force reference : the world transform is the product of all the local transforms from the root.
+	struct ReferenceNode
+	{
+		moe::SceneNodeHandle	m_handle;
+		int						m_parent = -1;
+		moe::Transform			m_local;
+	};
+
+	moe::Mat4	ReferenceWorld(const std::vector<ReferenceNode>& nodes, int nodeIdx)
+	{
+		moe::Mat4 world = nodes[nodeIdx].m_local.Matrix();
+		for (int parent = nodes[nodeIdx].m_parent; parent != -1; parent = nodes[parent].m_parent)
+		{
+			world = nodes[parent].m_local.Matrix() * world;
+		}
+		return world;
+	}
+}
+
+
+TEST_CASE("SceneGraph", "[Graphics]")
+{
+	std::mt19937 rng(2021);
+
+	moe::SceneGraph graph(1024);
+
+	// Build a random hierarchy, each node having one of the previous nodes (or the root) as parent.
+	std::vector<ReferenceNode> nodes;
+	for (int iNode = 0; iNode < 1000; ++iNode)
+	{
+		ReferenceNode node;
+		node.m_parent = (iNode == 0 ? -1 : (int)(rng() % (iNode + 1)) - 1);
+		node.m_local = RandomTransform(rng);
+
+		const moe::SceneNodeHandle parentHandle = (node.m_parent == -1 ? moe::SceneGraph::GetRootHandle() : nodes[node.m_parent].m_handle);
+		node.m_handle = graph.CreateNode<moe::ASceneNode>(parentHandle, node.m_local);
+
+		nodes.push_back(node);
+	}
+
+	auto checkAllWorldTransforms = [&]()
+	{
+		bool allEqual = true;
+		for (int iNode = 0; iNode < (int)nodes.size(); ++iNode)
+		{
+			allEqual &= NearlyEqual(graph.GetWorldTransform(nodes[iNode].m_handle).Matrix(), ReferenceWorld(nodes, iNode));
+		}
+		return allEqual;
+	};
+
+	SECTION("World transforms match brute force")
+	{
+		CHECK(graph.GetTransforms().NeedsUpdate());
+		CHECK(checkAllWorldTransforms());
+		CHECK_FALSE(graph.GetTransforms().NeedsUpdate());
+		CHECK(graph.GetTransforms().GetNumLevels() > 2);
+	}
+
+	SECTION("Batched local edits")
+	{
+		graph.UpdateWorldTransforms();
+
+		for (int iEdit = 0; iEdit < 200; ++iEdit)
+		{
+			const int editedIdx = rng() % nodes.size();
+			nodes[editedIdx].m_local = RandomTransform(rng);
+			graph.MutSceneNode(nodes[editedIdx].m_handle)->SetLocalTransform(nodes[editedIdx].m_local);
+		}
+
+		CHECK(graph.GetTransforms().NeedsUpdate());
+		graph.UpdateWorldTransforms();
+		CHECK(checkAllWorldTransforms());
+	}
+
+	SECTION("Parallel update gives the same results")
+	{
+		moe::JobSystemConfig config;
+		config.m_numWorkers = 3;
+		moe::JobSystem jobSystem(config);
+
+		graph.UpdateWorldTransforms(jobSystem);
+		CHECK(checkAllWorldTransforms());
+
+		for (int iEdit = 0; iEdit < 500; ++iEdit)
+		{
+			const int editedIdx = rng() % nodes.size();
+			nodes[editedIdx].m_local = RandomTransform(rng);
+			graph.SetLocalTransform(nodes[editedIdx].m_handle, nodes[editedIdx].m_local);
+		}
+
+		graph.UpdateWorldTransforms(jobSystem);
+		CHECK_FALSE(graph.GetTransforms().NeedsUpdate());
+		CHECK(checkAllWorldTransforms());
+	}
+
+	SECTION("Reparenting keeps the world transform")
+	{
+		// Take a leaf and give it another parent that is not one of its descendants
+		const int movedIdx = (int)nodes.size() - 1;
+		const int newParentIdx = 0;
+		const moe::Mat4 worldBefore = graph.GetWorldTransform(nodes[movedIdx].m_handle).Matrix();
+
+		graph.AddChild(nodes[newParentIdx].m_handle, nodes[movedIdx].m_handle);
+
+		CHECK(NearlyEqual(graph.GetWorldTransform(nodes[movedIdx].m_handle).Matrix(), worldBefore));
+		CHECK(graph.GetSceneNode(nodes[movedIdx].m_handle)->GetParent() == graph.GetSceneNode(nodes[newParentIdx].m_handle));
+
+		// Now its new parent moves it
+		nodes[movedIdx].m_parent = newParentIdx;
+		nodes[movedIdx].m_local = graph.GetLocalTransform(nodes[movedIdx].m_handle);
+		nodes[newParentIdx].m_local = RandomTransform(rng);
+		graph.SetLocalTransform(nodes[newParentIdx].m_handle, nodes[newParentIdx].m_local);
+		CHECK(checkAllWorldTransforms());
+	}
+
+	SECTION("Setting a world transform")
+	{
+		const int nodeIdx = (int)nodes.size() / 2;
+		const moe::Transform target = moe::Transform::Translate(moe::Vec3(1.f, 2.f, 3.f));
+
+		graph.MutSceneNode(nodes[nodeIdx].m_handle)->SetWorldTransform(target);
+		CHECK(NearlyEqual(graph.GetWorldTransform(nodes[nodeIdx].m_handle).Matrix(), target.Matrix()));
+	}
+
+	SECTION("Removing a node keeps its orphans in place")
+	{
+		// Find a node with children
+		int removedIdx = -1;
+		for (int iNode = 0; iNode < (int)nodes.size() && removedIdx == -1; ++iNode)
+		{
+			if (nodes[iNode].m_parent != -1)
+			{
+				removedIdx = nodes[iNode].m_parent;
+			}
+		}
+		REQUIRE(removedIdx != -1);
+
+		std::vector<moe::Mat4> worldsBefore;
+		for (int iNode = 0; iNode < (int)nodes.size(); ++iNode)
+		{
+			worldsBefore.push_back(graph.GetWorldTransform(nodes[iNode].m_handle).Matrix());
+		}
+
+		graph.RemoveNode(nodes[removedIdx].m_handle, false);
+
+		bool sameWorlds = true;
+		for (int iNode = 0; iNode < (int)nodes.size(); ++iNode)
+		{
+			if (iNode != removedIdx)
+			{
+				sameWorlds &= NearlyEqual(graph.GetWorldTransform(nodes[iNode].m_handle).Matrix(), worldsBefore[iNode]);
+			}
+		}
+		CHECK(sameWorlds);
+
+		// The freed slot gets reused by the next node
+		const moe::SceneNodeHandle newHandle = graph.CreateNode<moe::ASceneNode>(moe::SceneGraph::GetRootHandle(), moe::Transform::Identity());
+		CHECK(newHandle == nodes[removedIdx].m_handle);
+		CHECK(NearlyEqual(graph.GetWorldTransform(newHandle).Matrix(), moe::Mat4::Identity()));
+	}
+}
@@ -60,6 +60,9 @@ void moe::BaseGlfwApplication::PollInputEvents()
 
 void moe::BaseGlfwApplication::SwapBuffers()
 {
+	// Everything drawn this frame has been submitted : the device can recycle its per-frame memory.
+	MutRenderer().MutGraphicsDevice().EndFrame();
+
 	glfwSwapBuffers(m_window);
 }
 
@@ -5,17 +5,30 @@ set(Monocle_Core_SOURCES
 ./Containers/FreeList/detail/FreeListObject.h
 ./Containers/FreeList/Freelist.h
 ./Containers/FreeList/Freelist.hpp
+./Containers/FreeList/PagedFreelist.h
+./Containers/FreeList/PagedFreelist.hpp
 ./Containers/FreeList/PolymorphicFreelist.h
 ./Containers/FreeList/PolymorphicFreelist.hpp
+./Containers/HashMap/detail/HashMapGroup.h
 ./Containers/HashMap/HashMap.h
+./Containers/HashMap/HashMap.hpp
 ./Containers/IntrusiveListNode.h
 ./Containers/Private/IntrusiveListNode.internal.hpp
+./Containers/RingBuffer/MpscRingBuffer.h
 ./Containers/Vector/Vector.h
 ./Debugger/moeDebugger.h
 ./Delegates/Delegate.h
 ./Delegates/event.h
 ./HashString/HashString.h
+./HashString/Private/HashString.cpp
+./Jobs/FrameJobAllocator.h
+./Jobs/Job.h
+./Jobs/JobSystem.h
+./Jobs/JobSystem.hpp
+./Jobs/Private/JobSystem.cpp
+./Jobs/WorkStealingQueue.h
 ./Log/LogUtils.h
+./Log/moeAsyncLogger.h
 ./Log/moeLog.h
 ./Log/moeLogger.h
 ./Log/moeLoggerBase.h
@@ -30,6 +43,7 @@ set(Monocle_Core_SOURCES
 ./Log/Policies/OutStreamWritePolicy.h
 ./Log/Policies/SeverityFilterPolicy.h
 ./Log/Private/LogUtils.cpp
+./Log/Private/moeAsyncLogger.internal.hpp
 ./Log/Private/moeLogger.internal.hpp
 ./Log/Private/moeLoggerBase.cpp
 ./Log/Private/moeLoggerBase.internal.hpp
@@ -40,15 +54,23 @@ set(Monocle_Core_SOURCES
 ./Log/Private/Policies/NoFormatPolicy.cpp
 ./Log/Private/Policies/OutStreamWritePolicy.cpp
 ./Log/Private/Policies/SeverityFilterPolicy.cpp
+./Memory/ArenaAllocator.h
+./Memory/FrameArena.h
+./Memory/LinearArena.h
+./Memory/Private/ScratchArena.cpp
+./Memory/ScratchArena.h
 ./Misc/Literals.cpp
 ./Misc/Literals.h
 ./Misc/moeAbort.h
+./Misc/moeBits.h
 ./Misc/moeCountof.h
 ./Misc/moeEnum.h
 ./Misc/moeError.h
 ./Misc/moeFalse.h
 ./Misc/moeFile.h
+./Misc/moeMappedFile.h
 ./Misc/moeNamedType.h
+./Misc/moeRadixSort.h
 ./Misc/moeTypeList.h
 ./Misc/Private/moeAbort.cpp
 ./Misc/Private/moeFile.cpp
@@ -75,6 +97,7 @@ if(WIN32)
 ./Log/Policies/Windows/Win_IdeWritePolicy.h
 ./Log/Private/Policies/Windows/Win_IdeWritePolicy.cpp
 ./Misc/Private/Windows/GetLastErrorAsString.cpp
+./Misc/Private/Windows/moeMappedFile.cpp
 ./Misc/Windows/GetLastErrorAsString.h
 ./StringFormat/Private/Windows/Win_moeSwprintf.internal.hpp
 	)
@@ -95,6 +118,7 @@ elseif(UNIX)
 	./Debugger/Private/Linux/moeDebugger.cpp
 ./Log/Policies/Linux/Linux_IdeWritePolicy.h
 ./Log/Private/Policies/Linux/Linux_IdeWritePolicy.cpp
+./Misc/Private/Linux/moeMappedFile.cpp
 ./StringFormat/Private/Linux/Linux_moeSwprintf.internal.hpp
 	)
 	
@@ -0,0 +1,185 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Core/Misc/moeBits.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "detail/FreeListObject.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <memory> // unique_ptr
+#include <utility> // exchange
+#include <new> // launder
+#endif
+
+namespace moe
+{
+
+	/**
+	 * \brief A generational free list that stores its objects in fixed-size pages.
+	 * Pages are allocated one by one and never move, so growing the list never invalidates pointers to live objects.
+	 * Each slot keeps a generation counter that is bumped every time its object is removed : IDs handed out by Add
+	 * carry the generation they were created with, so a stale ID referring to a reused slot is detected in O(1).
+	 * Each page also keeps an occupancy bitmask, which lets iteration skip over the holes left by removed objects.
+	 * \tparam Object the type of object stored in the free list
+	 * \tparam PageSize the number of objects per page. Must be a power of two and a multiple of 64.
+	 */
+	template <class Object, uint32_t PageSize = 64>
+	class PagedFreelist
+	{
+		static_assert(PageSize >= 64 && (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two, at least 64");
+
+		static const uint32_t	ms_WORDS_PER_PAGE = PageSize / 64;
+		static constexpr uint32_t	ms_INVALID_SLOT = UINT32_MAX;
+
+		struct Page
+		{
+			Object*	Slot(uint32_t localIdx)
+			{
+				return std::launder(reinterpret_cast<Object*>(m_storage + localIdx * sizeof(Object)));
+			}
+
+			const Object*	Slot(uint32_t localIdx) const
+			{
+				return std::launder(reinterpret_cast<const Object*>(m_storage + localIdx * sizeof(Object)));
+			}
+
+			[[nodiscard]] bool	IsOccupied(uint32_t localIdx) const
+			{
+				return (m_occupancy[localIdx / 64] & (1ull << (localIdx % 64))) != 0;
+			}
+
+			alignas(Object) byte_t	m_storage[PageSize * sizeof(Object)];
+			uint32_t	m_generations[PageSize]{};	// Generation of each slot, bumped every time its object is removed.
+			uint32_t	m_nextFree[PageSize]{};		// When a slot is free, index of the next free slot in the list.
+			uint64_t	m_occupancy[ms_WORDS_PER_PAGE]{};
+		};
+
+
+		template <typename ListT, typename ValueT>
+		class IteratorT
+		{
+		public:
+			IteratorT(ListT* list, uint32_t index) :
+				m_list(list), m_index(index)
+			{}
+
+			ValueT&	operator*() const { return *m_list->SlotAt(m_index); }
+			ValueT*	operator->() const { return m_list->SlotAt(m_index); }
+
+			IteratorT&	operator++()
+			{
+				m_index = m_list->FindNextOccupied(m_index + 1);
+				return *this;
+			}
+
+			bool	operator==(const IteratorT& other) const { return m_index == other.m_index; }
+			bool	operator!=(const IteratorT& other) const { return m_index != other.m_index; }
+
+			/**
+			 * \brief Rebuilds the full generational ID of the object this iterator points to.
+			 */
+			[[nodiscard]] FreelistID	ID() const { return m_list->MakeID(m_index); }
+
+		private:
+			ListT*		m_list = nullptr;
+			uint32_t	m_index = 0;
+		};
+
+	public:
+
+		using Iterator = IteratorT<PagedFreelist, Object>;
+		using ConstIterator = IteratorT<const PagedFreelist, const Object>;
+
+		PagedFreelist() = default;
+
+		PagedFreelist(uint32_t numReserved)
+		{
+			Reserve(numReserved);
+		}
+
+		~PagedFreelist();
+
+		PagedFreelist(const PagedFreelist&) = delete;
+		PagedFreelist& operator=(const PagedFreelist&) = delete;
+
+		PagedFreelist(PagedFreelist&& other) noexcept;
+		PagedFreelist& operator=(PagedFreelist&& other) noexcept;
+
+		/**
+		 * \brief Allocates enough pages to hold at least numReserved objects. Never moves existing objects.
+		 */
+		void	Reserve(uint32_t numReserved);
+
+		/**
+		 * \brief Destroys every live object. Pages are kept, and all outstanding IDs become stale.
+		 */
+		void	Clear();
+
+		template <typename... Args>
+		FreelistID	Add(Args&&... args);
+
+		/**
+		 * \brief Destroys the object referenced by the ID.
+		 * \return false if the ID was stale or invalid (in which case nothing is done)
+		 */
+		bool	Remove(FreelistID removedId);
+
+		[[nodiscard]] bool	IsValid(FreelistID id) const;
+
+		/**
+		 * \brief Asserts the ID is valid. Prefer TryLookup when the ID may be stale.
+		 */
+		[[nodiscard]] Object&		Lookup(FreelistID id);
+		[[nodiscard]] const Object&	Lookup(FreelistID id) const;
+
+		/**
+		 * \brief Returns nullptr if the ID is stale or invalid.
+		 */
+		[[nodiscard]] Object*		TryLookup(FreelistID id);
+		[[nodiscard]] const Object*	TryLookup(FreelistID id) const;
+
+		[[nodiscard]] uint32_t	Size() const { return m_size; }
+		[[nodiscard]] bool		Empty() const { return m_size == 0; }
+		[[nodiscard]] uint32_t	Capacity() const { return (uint32_t)m_pages.Size() * PageSize; }
+
+		Iterator		Begin() { return Iterator(this, FindNextOccupied(0)); }
+		ConstIterator	Begin() const { return ConstIterator(this, FindNextOccupied(0)); }
+		Iterator		End() { return Iterator(this, m_highWaterMark); }
+		ConstIterator	End() const { return ConstIterator(this, m_highWaterMark); }
+
+		// Lowercase versions for range-based for loops
+		Iterator		begin() { return Begin(); }
+		ConstIterator	begin() const { return Begin(); }
+		Iterator		end() { return End(); }
+		ConstIterator	end() const { return End(); }
+
+	private:
+
+		[[nodiscard]] Object*		SlotAt(uint32_t index) { return m_pages[index / PageSize]->Slot(index % PageSize); }
+		[[nodiscard]] const Object*	SlotAt(uint32_t index) const { return m_pages[index / PageSize]->Slot(index % PageSize); }
+
+		[[nodiscard]] FreelistID	MakeID(uint32_t index) const { return FreelistID{ index, m_pages[index / PageSize]->m_generations[index % PageSize] }; }
+
+		/**
+		 * \brief Returns the index of the first live object at or after startIdx, or the high water mark if there is none.
+		 */
+		[[nodiscard]] uint32_t	FindNextOccupied(uint32_t startIdx) const;
+
+		void	DestroyAll();
+
+		Vector<std::unique_ptr<Page>>	m_pages;
+
+		uint32_t	m_nextFreeSlot = ms_INVALID_SLOT;
+
+		uint32_t	m_highWaterMark = 0;	// Slots past this index have never been used
+
+		uint32_t	m_size = 0;
+	};
+}
+
+#include "PagedFreelist.hpp"
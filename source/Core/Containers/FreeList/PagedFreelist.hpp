@@ -0,0 +1,196 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+namespace moe
+{
+	template <class Object, uint32_t PageSize>
+	PagedFreelist<Object, PageSize>::~PagedFreelist()
+	{
+		DestroyAll();
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	PagedFreelist<Object, PageSize>::PagedFreelist(PagedFreelist&& other) noexcept :
+		m_pages(std::move(other.m_pages)),
+		m_nextFreeSlot(std::exchange(other.m_nextFreeSlot, ms_INVALID_SLOT)),
+		m_highWaterMark(std::exchange(other.m_highWaterMark, 0)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+		other.m_pages.Clear();
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	PagedFreelist<Object, PageSize>& PagedFreelist<Object, PageSize>::operator=(PagedFreelist&& other) noexcept
+	{
+		if (this != &other)
+		{
+			DestroyAll();
+			m_pages = std::move(other.m_pages);
+			other.m_pages.Clear();
+			m_nextFreeSlot = std::exchange(other.m_nextFreeSlot, ms_INVALID_SLOT);
+			m_highWaterMark = std::exchange(other.m_highWaterMark, 0);
+			m_size = std::exchange(other.m_size, 0);
+		}
+
+		return *this;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	void PagedFreelist<Object, PageSize>::Reserve(uint32_t numReserved)
+	{
+		while (Capacity() < numReserved)
+		{
+			m_pages.EmplaceBack(std::make_unique<Page>());
+		}
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	void PagedFreelist<Object, PageSize>::Clear()
+	{
+		DestroyAll();
+
+		// Keep the pages (and their generations, so old IDs stay stale) but restart from the first slot.
+		m_nextFreeSlot = ms_INVALID_SLOT;
+		m_highWaterMark = 0;
+		m_size = 0;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	template <typename ... Args>
+	FreelistID PagedFreelist<Object, PageSize>::Add(Args&&... args)
+	{
+		uint32_t newObjIdx;
+
+		if (m_nextFreeSlot != ms_INVALID_SLOT)
+		{
+			newObjIdx = m_nextFreeSlot;
+			m_nextFreeSlot = m_pages[newObjIdx / PageSize]->m_nextFree[newObjIdx % PageSize];
+		}
+		else
+		{
+			newObjIdx = m_highWaterMark++;
+			Reserve(m_highWaterMark);
+		}
+
+		Page& page = *m_pages[newObjIdx / PageSize];
+		const uint32_t localIdx = newObjIdx % PageSize;
+
+		new (page.Slot(localIdx)) Object(std::forward<Args>(args)...);
+		page.m_occupancy[localIdx / 64] |= (1ull << (localIdx % 64));
+		m_size++;
+
+		return FreelistID{ newObjIdx, page.m_generations[localIdx] };
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	bool PagedFreelist<Object, PageSize>::Remove(FreelistID removedId)
+	{
+		if (false == IsValid(removedId))
+		{
+			return false;
+		}
+
+		Page& page = *m_pages[removedId.Index() / PageSize];
+		const uint32_t localIdx = removedId.Index() % PageSize;
+
+		page.Slot(localIdx)->~Object();
+		page.m_occupancy[localIdx / 64] &= ~(1ull << (localIdx % 64));
+		page.m_generations[localIdx]++;
+		page.m_nextFree[localIdx] = m_nextFreeSlot;
+		m_nextFreeSlot = removedId.Index();
+		m_size--;
+
+		return true;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	bool PagedFreelist<Object, PageSize>::IsValid(FreelistID id) const
+	{
+		if (id.Index() >= m_highWaterMark)
+		{
+			return false;
+		}
+
+		const Page& page = *m_pages[id.Index() / PageSize];
+		const uint32_t localIdx = id.Index() % PageSize;
+		return page.IsOccupied(localIdx) && page.m_generations[localIdx] == id.Generation();
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	Object& PagedFreelist<Object, PageSize>::Lookup(FreelistID id)
+	{
+		MOE_ASSERT(IsValid(id));
+		return *SlotAt(id.Index());
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	const Object& PagedFreelist<Object, PageSize>::Lookup(FreelistID id) const
+	{
+		MOE_ASSERT(IsValid(id));
+		return *SlotAt(id.Index());
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	Object* PagedFreelist<Object, PageSize>::TryLookup(FreelistID id)
+	{
+		return IsValid(id) ? SlotAt(id.Index()) : nullptr;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	const Object* PagedFreelist<Object, PageSize>::TryLookup(FreelistID id) const
+	{
+		return IsValid(id) ? SlotAt(id.Index()) : nullptr;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	uint32_t PagedFreelist<Object, PageSize>::FindNextOccupied(uint32_t startIdx) const
+	{
+		// Scan the occupancy masks one 64-bit word at a time, masking off the bits before startIdx in the first word.
+		uint32_t wordIdx = startIdx / 64;
+		const uint32_t lastWordIdx = (m_highWaterMark + 63) / 64;
+		uint64_t mask = (startIdx % 64 == 0 ? ~0ull : ~0ull << (startIdx % 64));
+
+		for (; wordIdx < lastWordIdx; ++wordIdx)
+		{
+			const Page& page = *m_pages[wordIdx / ms_WORDS_PER_PAGE];
+			const uint64_t word = page.m_occupancy[wordIdx % ms_WORDS_PER_PAGE] & mask;
+			if (word != 0)
+			{
+				return wordIdx * 64 + CountTrailingZeros64(word);
+			}
+
+			mask = ~0ull;
+		}
+
+		return m_highWaterMark;
+	}
+
+
+	template <class Object, uint32_t PageSize>
+	void PagedFreelist<Object, PageSize>::DestroyAll()
+	{
+		for (uint32_t iObj = FindNextOccupied(0); iObj < m_highWaterMark; iObj = FindNextOccupied(iObj + 1))
+		{
+			Page& page = *m_pages[iObj / PageSize];
+			const uint32_t localIdx = iObj % PageSize;
+
+			page.Slot(localIdx)->~Object();
+			page.m_occupancy[localIdx / 64] &= ~(1ull << (localIdx % 64));
+			page.m_generations[localIdx]++;
+		}
+	}
+
+}
@@ -45,6 +45,7 @@ namespace moe
 		{
 			newObjIdx = m_nextFreeListSlot;
 			m_nextFreeListSlot = m_objects[m_nextFreeListSlot].m_nextSlot;
+			m_objects[newObjIdx].m_obj = new Derived(std::forward<Args>(args)...);
 		}
 
 		return FreelistID{ newObjIdx };
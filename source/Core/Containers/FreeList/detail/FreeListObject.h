@@ -18,12 +18,22 @@ namespace moe
 
 		FreelistID() = default;
 
-		FreelistID(uint32_t index) :
-			m_index(index)
+		FreelistID(uint32_t index, uint32_t generation = 0) :
+			m_index(index),
+			m_generation(generation)
 		{}
 
 		[[nodiscard]] uint32_t	Index() const { return m_index; }
 
+		/**
+		 * \brief The generation of the slot at the time this ID was given out.
+		 * Only generational free lists (like PagedFreelist) make use of it to detect stale IDs.
+		 */
+		[[nodiscard]] uint32_t	Generation() const { return m_generation; }
+
+		bool	operator==(const FreelistID& other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+		bool	operator!=(const FreelistID& other) const { return !(*this == other); }
+
 
 		/**
 		 * \brief This function always returns index + 1 to avoid returning 0 on first ID, resulting in a null handle.
@@ -35,6 +45,7 @@ namespace moe
 	private:
 
 		uint32_t	m_index{ 0 };
+		uint32_t	m_generation{ 0 };
 	};
 
 
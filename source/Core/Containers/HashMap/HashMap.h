@@ -2,71 +2,214 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <functional> // std::hash
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::allocator
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "detail/HashMapGroup.h"
 
 namespace moe
 {
-	// Implementation of a hash map
-	// Currently relying on the standard library.
-	template <class Key, class Data>
+	/**
+	 * \brief The default hasher of HashMap : std::hash, except for strings.
+	 */
+	template <class Key>
+	struct HashMapHasher : std::hash<Key>
+	{};
+
+
+	/**
+	 * \brief Strings get a transparent hasher, so string maps can be searched with a string_view or a C string
+	 * without building a temporary std::string. The standard guarantees std::hash<string> and std::hash<string_view>
+	 * give the same result for the same characters.
+	 */
+	template <>
+	struct HashMapHasher<std::string>
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view str) const noexcept
+		{
+			return std::hash<std::string_view>()(str);
+		}
+	};
+
+
+	/**
+	 * \brief Implementation of a cache-friendly hash map using open addressing (SwissTable-style).
+	 * Keys and values live in a single flat slot array, with one control byte per slot holding 7 bits of the key hash.
+	 * Lookups probe 8 control bytes at a time, and only compare keys whose control byte matches.
+	 * Unlike std::unordered_map, rehashing moves the elements : pointers and iterators are invalidated by any insertion
+	 * that makes the map grow. Use Reserve and SetRehashAllowed(false) to guarantee it never happens.
+	 * Erasing never moves the other elements.
+	 * \tparam Key The key type
+	 * \tparam Data The mapped type
+	 * \tparam Hasher The hash function object. When it declares is_transparent, Find also accepts any type comparable to Key.
+	 * \tparam Allocator Allocates the slots and control bytes (rebound to both), e.g. an ArenaAllocator for a map that lives for a frame.
+	 */
+	template <class Key, class Data, class Hasher = HashMapHasher<Key>, class Allocator = std::allocator<std::pair<const Key, Data>>>
 	class HashMap
 	{
+		using Group = detail::HashMapGroup;
+
+	public:
+
+		typedef	std::pair<const Key, Data>	ValueType;
+		typedef	std::size_t					SizeType;
+		typedef	Allocator					AllocatorType;
+
+	private:
+
+		using AllocTraits = std::allocator_traits<Allocator>;
+		using SlotAllocator = typename AllocTraits::template rebind_alloc<ValueType>;
+		using CtrlAllocator = typename AllocTraits::template rebind_alloc<byte_t>;
+
+		template <typename MapT, typename ValueT>
+		class IteratorT
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = ValueType;
+			using difference_type = std::ptrdiff_t;
+			using pointer = ValueT*;
+			using reference = ValueT&;
+
+			IteratorT() = default;
+
+			IteratorT(MapT* map, SizeType index) :
+				m_map(map), m_index(index)
+			{}
+
+			// Iterator to ConstIterator conversion
+			template <typename OtherMapT, typename OtherValueT>
+			IteratorT(const IteratorT<OtherMapT, OtherValueT>& other) :
+				m_map(other.m_map), m_index(other.m_index)
+			{}
+
+			ValueT&	operator*() const { return m_map->m_slots[m_index]; }
+			ValueT*	operator->() const { return &m_map->m_slots[m_index]; }
+
+			IteratorT&	operator++()
+			{
+				m_index = m_map->FindNextFull(m_index + 1);
+				return *this;
+			}
+
+			IteratorT	operator++(int)
+			{
+				IteratorT tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			bool	operator==(const IteratorT& other) const { return m_index == other.m_index; }
+			bool	operator!=(const IteratorT& other) const { return m_index != other.m_index; }
+
+		private:
+			template <typename, typename> friend class IteratorT;
+			friend class HashMap;
+
+			MapT*		m_map = nullptr;
+			SizeType	m_index = 0;
+		};
+
 	public:
 
-		typedef	typename std::unordered_map<Key, Data>::iterator		Iterator;
-		typedef	typename std::unordered_map<Key, Data>::const_iterator	ConstIterator;
-		typedef	typename std::unordered_map<Key, Data>::value_type		ValueType;
-		typedef	typename std::unordered_map<Key, Data>::size_type		SizeType;
+		typedef	IteratorT<HashMap, ValueType>				Iterator;
+		typedef	IteratorT<const HashMap, const ValueType>	ConstIterator;
 
 		// The Coplien rain dance to make things compile
 		HashMap() = default;
-		~HashMap() = default;
-		HashMap(const HashMap& other) = default;
-		HashMap& operator=(const HashMap& other) = default;
-		HashMap(HashMap&& other) = default;
-		HashMap& operator=(HashMap&& other) = default;
+		~HashMap();
+		HashMap(const HashMap& other);
+		HashMap& operator=(const HashMap& other);
+		HashMap(HashMap&& other) noexcept;
+		HashMap& operator=(HashMap&& other) noexcept;
 		// ----------------------------------------------
 
-		std::pair<Iterator, bool>	Insert(ValueType&& value)						{ return m_hashmap.insert(std::forward<ValueType>(value)); }
-		std::pair<Iterator, bool>	Insert(const ValueType& val)					{ return m_hashmap.insert(val); }
+		HashMap(std::initializer_list<ValueType> il) { Insert(il); }
+
+		explicit HashMap(const Allocator& alloc) :
+			m_allocator(alloc)
+		{}
+
+		[[nodiscard]] AllocatorType	GetAllocator() const { return m_allocator; }
+
+		std::pair<Iterator, bool>	Insert(ValueType&& value)						{ return EmplaceKey(value.first, std::move(value.second)); }
+		std::pair<Iterator, bool>	Insert(const ValueType& val)					{ return EmplaceKey(val.first, val.second); }
 		template <class P>
-		std::pair<Iterator, bool>	Insert(P&& val)									{ return m_hashmap.insert(val); }
-		Iterator					Insert(ConstIterator hint, const ValueType& val){ return m_hashmap.insert(hint, val); }
+		std::pair<Iterator, bool>	Insert(P&& val)									{ return Emplace(std::forward<P>(val)); }
+		Iterator					Insert(ConstIterator /*hint*/, const ValueType& val){ return Insert(val).first; }
 		template <class P>
-		Iterator					Insert(ConstIterator hint, P&& val)				{ return m_hashmap.insert(hint, val); }
+		Iterator					Insert(ConstIterator /*hint*/, P&& val)			{ return Insert(std::forward<P>(val)).first; }
 		template <class InputIterator>
-		void						Insert(InputIterator first, InputIterator last)	{ m_hashmap.insert(first, last); }
-		void						Insert(std::initializer_list<ValueType> il)		{ m_hashmap.insert(il); }
+		void						Insert(InputIterator first, InputIterator last)	{ for (; first != last; ++first) Insert(*first); }
+		void						Insert(std::initializer_list<ValueType> il)		{ Reserve(Size() + il.size()); Insert(il.begin(), il.end()); }
+
+		template <class... Args>
+		std::pair<Iterator, bool>	Emplace(Args&&... args);
 
+		/**
+		 * \brief Only constructs the value if the key is not already present.
+		 */
 		template <class... Args>
-		std::pair<Iterator, bool>	Emplace(Args&&... args) { return m_hashmap.emplace(std::forward<Args>(args)...); }
+		std::pair<Iterator, bool>	TryEmplace(const Key& k, Args&&... args)	{ return EmplaceKey(k, std::forward<Args>(args)...); }
+
+		Iterator	Erase(ConstIterator position);
+		SizeType	Erase(const Key& k);
+		Iterator	Erase(ConstIterator first, ConstIterator last);
+
+
+		SizeType	Size() const { return m_size; }
 
-		Iterator	Erase(ConstIterator position)					{ return m_hashmap.erase(position); }
-		SizeType	Erase(const Key& k)								{ return m_hashmap.erase(k); }
-		Iterator	Erase(ConstIterator first, ConstIterator last)	{ return m_hashmap.erase(first, last); }
+		[[nodiscard]] bool	Empty() const { return m_size == 0; }
 
+		[[nodiscard]] SizeType	Capacity() const { return m_capacity; }
 
-		SizeType	Size() const { return m_hashmap.size(); }
 
+		void	Clear();
 
-		void	Clear() { m_hashmap.clear(); }
+		/**
+		 * \brief Makes room for at least size elements, so that inserting up to that many elements never rehashes.
+		 */
+		void	Reserve(SizeType size);
 
-		void	Reserve(SizeType size) { m_hashmap.reserve(size); }
+		/**
+		 * \brief When rehashing is not allowed, an insertion that would need to grow the table asserts
+		 * (but still grows, so it stays correct). Pair it with Reserve to guarantee pointer and iterator stability.
+		 */
+		void	SetRehashAllowed(bool allowed) { m_rehashAllowed = allowed; }
 
+		[[nodiscard]] bool	IsRehashAllowed() const { return m_rehashAllowed; }
 
-		Iterator		Find(const Key& k)			{ return m_hashmap.find(k); }
-		ConstIterator	Find(const Key& k) const	{ return m_hashmap.find(k); }
 
+		Iterator		Find(const Key& k)			{ return Iterator(this, FindIndex(k)); }
+		ConstIterator	Find(const Key& k) const	{ return ConstIterator(this, FindIndex(k)); }
 
-		Data& operator[] (const Key& k) { return m_hashmap[k]; }
-		Data& operator[] (Key&& k) { return m_hashmap[k]; }
+		// Heterogeneous lookup (e.g. a std::string map searched with a std::string_view), available with transparent hashers.
+		template <class K, class H = Hasher, typename = typename H::is_transparent>
+		Iterator		Find(const K& k)			{ return Iterator(this, FindIndex(k)); }
+		template <class K, class H = Hasher, typename = typename H::is_transparent>
+		ConstIterator	Find(const K& k) const		{ return ConstIterator(this, FindIndex(k)); }
 
-		Iterator		Begin()			{ return m_hashmap.begin(); }
-		ConstIterator	Begin() const	{ return m_hashmap.begin(); }
 
+		Data& operator[] (const Key& k) { return EmplaceKey(k).first->second; }
+		Data& operator[] (Key&& k) { return EmplaceKey(std::move(k)).first->second; }
 
-		Iterator		End()		{ return m_hashmap.end(); }
-		ConstIterator	End() const	{ return m_hashmap.end(); }
+		Iterator		Begin()			{ return Iterator(this, FindNextFull(0)); }
+		ConstIterator	Begin() const	{ return ConstIterator(this, FindNextFull(0)); }
+
+
+		Iterator		End()		{ return Iterator(this, m_capacity); }
+		ConstIterator	End() const	{ return ConstIterator(this, m_capacity); }
 
 		// Range-based for loops interface
 		Iterator		begin() { return Begin(); }
@@ -78,20 +221,59 @@ namespace moe
 
 
 	private:
-		std::unordered_map<Key, Data>	m_hashmap;
+
+		static const SizeType	ms_MIN_CAPACITY = Group::ms_WIDTH;
+
+		// The table grows when it gets 7/8th full (empty slots are needed for lookups to terminate).
+		static SizeType	MaxLoad(SizeType capacity) { return capacity - capacity / 8; }
+
+		static SizeType	CapacityFor(SizeType size);
+
+		template <class K>
+		[[nodiscard]] SizeType	FindIndex(const K& k) const;
+
+		/**
+		 * \brief Finds the key, or constructs a new element from the key and args if it is not there.
+		 */
+		template <class K, class... Args>
+		std::pair<Iterator, bool>	EmplaceKey(K&& k, Args&&... args);
+
+		[[nodiscard]] SizeType	FindInsertSlot(uint64_t hash) const;
+
+		void	SetCtrl(SizeType index, byte_t ctrl) { m_ctrl[index] = ctrl; }
+
+		[[nodiscard]] SizeType	FindNextFull(SizeType index) const;
+
+		void	EraseAt(SizeType index);
+
+		void	Rehash(SizeType newCapacity);
+
+		void	Deallocate();
+
+		byte_t*		m_ctrl = nullptr;
+		ValueType*	m_slots = nullptr;
+
+		SizeType	m_capacity = 0;
+		SizeType	m_size = 0;
+		SizeType	m_deleted = 0;	// Number of tombstones, which still count against the load factor
+
+		bool		m_rehashAllowed = true;
+
+		Hasher		m_hasher;
+
+		Allocator	m_allocator;
 
 	public:
 		// Relational operator soup
-		bool operator== (const HashMap& rhs) const
-		{
-			return m_hashmap == rhs.m_hashmap;
-		}
+		bool operator== (const HashMap& rhs) const;
 
 		bool operator!= (const HashMap& rhs) const
 		{
-			return m_hashmap != rhs.m_hashmap;
+			return !(*this == rhs);
 		}
 
 	};
 
-}
\ No newline at end of file
+}
+
+#include "HashMap.hpp"
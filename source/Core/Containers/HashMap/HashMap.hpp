@@ -0,0 +1,412 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+namespace moe
+{
+	template <class Key, class Data, class Hasher, class Allocator>
+	HashMap<Key, Data, Hasher, Allocator>::~HashMap()
+	{
+		Deallocate();
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	HashMap<Key, Data, Hasher, Allocator>::HashMap(const HashMap& other) :
+		m_rehashAllowed(other.m_rehashAllowed),
+		m_hasher(other.m_hasher),
+		m_allocator(AllocTraits::select_on_container_copy_construction(other.m_allocator))
+	{
+		Reserve(other.m_size);
+		for (const ValueType& value : other)
+		{
+			EmplaceKey(value.first, value.second);
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	HashMap<Key, Data, Hasher, Allocator>& HashMap<Key, Data, Hasher, Allocator>::operator=(const HashMap& other)
+	{
+		if (this != &other)
+		{
+			// The copy keeps our allocator, unless the allocator says it should be copied too.
+			HashMap copy(AllocTraits::propagate_on_container_copy_assignment::value ? other.m_allocator : m_allocator);
+			copy.m_rehashAllowed = other.m_rehashAllowed;
+			copy.m_hasher = other.m_hasher;
+			copy.Reserve(other.m_size);
+			for (const ValueType& value : other)
+			{
+				copy.EmplaceKey(value.first, value.second);
+			}
+
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	HashMap<Key, Data, Hasher, Allocator>::HashMap(HashMap&& other) noexcept :
+		m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+		m_slots(std::exchange(other.m_slots, nullptr)),
+		m_capacity(std::exchange(other.m_capacity, 0)),
+		m_size(std::exchange(other.m_size, 0)),
+		m_deleted(std::exchange(other.m_deleted, 0)),
+		m_rehashAllowed(other.m_rehashAllowed),
+		m_hasher(std::move(other.m_hasher)),
+		m_allocator(std::move(other.m_allocator))
+	{}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	HashMap<Key, Data, Hasher, Allocator>& HashMap<Key, Data, Hasher, Allocator>::operator=(HashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if constexpr (!AllocTraits::propagate_on_container_move_assignment::value)
+			{
+				// We can't take memory allocated by another allocator : move the elements one by one instead.
+				if (!(m_allocator == other.m_allocator))
+				{
+					Clear();
+					Reserve(other.m_size);
+					for (ValueType& value : other)
+					{
+						EmplaceKey(value.first, std::move(value.second));
+					}
+
+					m_rehashAllowed = other.m_rehashAllowed;
+					m_hasher = std::move(other.m_hasher);
+					other.Deallocate();
+					return *this;
+				}
+			}
+
+			Deallocate();
+			m_ctrl = std::exchange(other.m_ctrl, nullptr);
+			m_slots = std::exchange(other.m_slots, nullptr);
+			m_capacity = std::exchange(other.m_capacity, 0);
+			m_size = std::exchange(other.m_size, 0);
+			m_deleted = std::exchange(other.m_deleted, 0);
+			m_rehashAllowed = other.m_rehashAllowed;
+			m_hasher = std::move(other.m_hasher);
+
+			if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+			{
+				m_allocator = std::move(other.m_allocator);
+			}
+		}
+
+		return *this;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	template <class ... Args>
+	std::pair<typename HashMap<Key, Data, Hasher, Allocator>::Iterator, bool> HashMap<Key, Data, Hasher, Allocator>::Emplace(Args&&... args)
+	{
+		if constexpr (sizeof...(Args) == 2)
+		{
+			// The usual (key, value) case : avoid building a temporary pair.
+			return [this](auto&& k, auto&& v)
+			{
+				return EmplaceKey(Key(std::forward<decltype(k)>(k)), std::forward<decltype(v)>(v));
+			}(std::forward<Args>(args)...);
+		}
+		else
+		{
+			ValueType tmp(std::forward<Args>(args)...);
+			return EmplaceKey(tmp.first, std::move(tmp.second));
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::Iterator HashMap<Key, Data, Hasher, Allocator>::Erase(ConstIterator position)
+	{
+		MOE_ASSERT(position.m_map == this && position.m_index < m_capacity);
+		EraseAt(position.m_index);
+		return Iterator(this, FindNextFull(position.m_index + 1));
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::SizeType HashMap<Key, Data, Hasher, Allocator>::Erase(const Key& k)
+	{
+		const SizeType index = FindIndex(k);
+		if (index == m_capacity)
+		{
+			return 0;
+		}
+
+		EraseAt(index);
+		return 1;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::Iterator HashMap<Key, Data, Hasher, Allocator>::Erase(ConstIterator first, ConstIterator last)
+	{
+		// Erasing never moves elements, so the range stays valid while we walk it.
+		while (first != last)
+		{
+			const SizeType index = first.m_index;
+			++first;
+			EraseAt(index);
+		}
+
+		return Iterator(this, last.m_index);
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	void HashMap<Key, Data, Hasher, Allocator>::Clear()
+	{
+		for (SizeType iSlot = FindNextFull(0); iSlot < m_capacity; iSlot = FindNextFull(iSlot + 1))
+		{
+			m_slots[iSlot].~ValueType();
+		}
+
+		if (m_ctrl != nullptr)
+		{
+			std::memset(m_ctrl, detail::CtrlEmpty, m_capacity);
+		}
+
+		m_size = 0;
+		m_deleted = 0;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	void HashMap<Key, Data, Hasher, Allocator>::Reserve(SizeType size)
+	{
+		const SizeType neededCapacity = CapacityFor(size);
+		if (neededCapacity > m_capacity)
+		{
+			Rehash(neededCapacity);
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::SizeType HashMap<Key, Data, Hasher, Allocator>::CapacityFor(SizeType size)
+	{
+		SizeType capacity = ms_MIN_CAPACITY;
+		while (MaxLoad(capacity) < size)
+		{
+			capacity *= 2;
+		}
+
+		return capacity;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	template <class K>
+	typename HashMap<Key, Data, Hasher, Allocator>::SizeType HashMap<Key, Data, Hasher, Allocator>::FindIndex(const K& k) const
+	{
+		if (m_size == 0)
+		{
+			return m_capacity;
+		}
+
+		const uint64_t hash = detail::HashMapMix(m_hasher(k));
+		const byte_t h2 = (byte_t)(hash & 0x7F);
+		const SizeType groupMask = m_capacity / Group::ms_WIDTH - 1;
+
+		// Quadratic (triangular) probing over groups visits every group once when the group count is a power of two.
+		SizeType iGroup = (SizeType)(hash >> 7) & groupMask;
+		for (SizeType probe = 1; ; ++probe)
+		{
+			const SizeType groupStart = iGroup * Group::ms_WIDTH;
+			const Group group(m_ctrl + groupStart);
+
+			for (auto match = group.Match(h2); match.Any(); match.Next())
+			{
+				const SizeType index = groupStart + match.Lowest();
+				if (m_slots[index].first == k)
+				{
+					return index;
+				}
+			}
+
+			if (group.MatchEmpty().Any() || probe > groupMask)
+			{
+				return m_capacity;
+			}
+
+			iGroup = (iGroup + probe) & groupMask;
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::SizeType HashMap<Key, Data, Hasher, Allocator>::FindInsertSlot(uint64_t hash) const
+	{
+		const SizeType groupMask = m_capacity / Group::ms_WIDTH - 1;
+
+		SizeType iGroup = (SizeType)(hash >> 7) & groupMask;
+		for (SizeType probe = 1; ; ++probe)
+		{
+			const SizeType groupStart = iGroup * Group::ms_WIDTH;
+			const auto available = Group(m_ctrl + groupStart).MatchEmptyOrDeleted();
+			if (available.Any())
+			{
+				return groupStart + available.Lowest();
+			}
+
+			iGroup = (iGroup + probe) & groupMask;
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	template <class K, class ... Args>
+	std::pair<typename HashMap<Key, Data, Hasher, Allocator>::Iterator, bool> HashMap<Key, Data, Hasher, Allocator>::EmplaceKey(K&& k, Args&&... args)
+	{
+		const SizeType existing = FindIndex(k);
+		if (existing != m_capacity)
+		{
+			return { Iterator(this, existing), false };
+		}
+
+		if (m_size + m_deleted + 1 > MaxLoad(m_capacity))
+		{
+			MOE_ASSERT(m_rehashAllowed || m_capacity == 0); // the map was reserved too small to hold everything
+
+			// If the table is mostly tombstones, rehashing at the same size is enough to clean it up.
+			const SizeType newCapacity = (m_capacity != 0 && (m_size + 1) * 2 <= MaxLoad(m_capacity)) ? m_capacity : CapacityFor((m_size + 1) * 2);
+			Rehash(newCapacity);
+		}
+
+		const uint64_t hash = detail::HashMapMix(m_hasher(k));
+		const SizeType index = FindInsertSlot(hash);
+
+		if (m_ctrl[index] == detail::CtrlDeleted)
+		{
+			m_deleted--;
+		}
+
+		new (&m_slots[index]) ValueType(std::piecewise_construct,
+			std::forward_as_tuple(std::forward<K>(k)),
+			std::forward_as_tuple(std::forward<Args>(args)...));
+		SetCtrl(index, (byte_t)(hash & 0x7F));
+		m_size++;
+
+		return { Iterator(this, index), true };
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	typename HashMap<Key, Data, Hasher, Allocator>::SizeType HashMap<Key, Data, Hasher, Allocator>::FindNextFull(SizeType index) const
+	{
+		while (index < m_capacity && (m_ctrl[index] & detail::CtrlEmpty) != 0)
+		{
+			index++;
+		}
+
+		return index;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	void HashMap<Key, Data, Hasher, Allocator>::EraseAt(SizeType index)
+	{
+		m_slots[index].~ValueType();
+		m_size--;
+
+		// A group that still has an empty slot has never been full since the last rehash, so no probe sequence
+		// ever went past it : the slot can be marked empty again. Otherwise, leave a tombstone to keep probes going.
+		const SizeType groupStart = index - (index % Group::ms_WIDTH);
+		if (Group(m_ctrl + groupStart).MatchEmpty().Any())
+		{
+			SetCtrl(index, detail::CtrlEmpty);
+		}
+		else
+		{
+			SetCtrl(index, detail::CtrlDeleted);
+			m_deleted++;
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	void HashMap<Key, Data, Hasher, Allocator>::Rehash(SizeType newCapacity)
+	{
+		byte_t* oldCtrl = m_ctrl;
+		ValueType* oldSlots = m_slots;
+		const SizeType oldCapacity = m_capacity;
+
+		CtrlAllocator ctrlAllocator(m_allocator);
+		SlotAllocator slotAllocator(m_allocator);
+
+		m_ctrl = std::allocator_traits<CtrlAllocator>::allocate(ctrlAllocator, newCapacity);
+		m_slots = std::allocator_traits<SlotAllocator>::allocate(slotAllocator, newCapacity);
+		m_capacity = newCapacity;
+		m_deleted = 0;
+		std::memset(m_ctrl, detail::CtrlEmpty, newCapacity);
+
+		for (SizeType iSlot = 0; iSlot < oldCapacity; ++iSlot)
+		{
+			if ((oldCtrl[iSlot] & detail::CtrlEmpty) == 0)
+			{
+				// The 7-bit tag is not enough to find the group again : the full hash has to be recomputed.
+				const uint64_t hash = detail::HashMapMix(m_hasher(oldSlots[iSlot].first));
+				const SizeType index = FindInsertSlot(hash);
+				new (&m_slots[index]) ValueType(std::move(oldSlots[iSlot]));
+				SetCtrl(index, oldCtrl[iSlot]);
+				oldSlots[iSlot].~ValueType();
+			}
+		}
+
+		if (oldCtrl != nullptr)
+		{
+			std::allocator_traits<CtrlAllocator>::deallocate(ctrlAllocator, oldCtrl, oldCapacity);
+			std::allocator_traits<SlotAllocator>::deallocate(slotAllocator, oldSlots, oldCapacity);
+		}
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	void HashMap<Key, Data, Hasher, Allocator>::Deallocate()
+	{
+		if (m_ctrl == nullptr)
+		{
+			return;
+		}
+
+		Clear();
+
+		CtrlAllocator ctrlAllocator(m_allocator);
+		SlotAllocator slotAllocator(m_allocator);
+		std::allocator_traits<CtrlAllocator>::deallocate(ctrlAllocator, m_ctrl, m_capacity);
+		std::allocator_traits<SlotAllocator>::deallocate(slotAllocator, m_slots, m_capacity);
+		m_ctrl = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+	}
+
+
+	template <class Key, class Data, class Hasher, class Allocator>
+	bool HashMap<Key, Data, Hasher, Allocator>::operator==(const HashMap& rhs) const
+	{
+		if (m_size != rhs.m_size)
+		{
+			return false;
+		}
+
+		for (const ValueType& value : *this)
+		{
+			auto it = rhs.Find(value.first);
+			if (it == rhs.End() || !(it->second == value.second))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,101 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+#include "Core/Misc/moeBits.h"
+
+#include <cstring> // memcpy
+
+namespace moe
+{
+	namespace detail
+	{
+		/**
+		 * \brief Control bytes of the flat hash map.
+		 * A full slot stores the 7 low bits of its hash (high bit clear), an empty or deleted slot has its high bit set.
+		 */
+		enum HashMapCtrl : byte_t
+		{
+			CtrlEmpty = 0x80,
+			CtrlDeleted = 0xFE
+		};
+
+
+		/**
+		 * \brief A bitmask with one bit set per matching slot of a group (bit 7 of each matching byte).
+		 * Iterate with Next() while Any() is true.
+		 */
+		struct HashMapGroupMask
+		{
+			[[nodiscard]] bool		Any() const { return m_mask != 0; }
+
+			[[nodiscard]] uint32_t	Lowest() const { return CountTrailingZeros64(m_mask) / 8; }
+
+			void	Next() { m_mask &= (m_mask - 1); }
+
+			uint64_t	m_mask;
+		};
+
+
+		/**
+		 * \brief A portable (SWAR) group of 8 control bytes, matched all at once with 64-bit arithmetic.
+		 * Assumes a little-endian platform, like all the platforms we currently target.
+		 */
+		struct HashMapGroup
+		{
+			static const uint32_t	ms_WIDTH = 8;
+
+			static const uint64_t	ms_LSBS = 0x0101010101010101ull;
+			static const uint64_t	ms_MSBS = 0x8080808080808080ull;
+
+			explicit HashMapGroup(const byte_t* ctrl)
+			{
+				std::memcpy(&m_ctrl, ctrl, sizeof(m_ctrl));
+			}
+
+			/**
+			 * \brief Slots whose control byte equals h2. Can report rare false positives, so keys must still be compared.
+			 */
+			[[nodiscard]] HashMapGroupMask	Match(byte_t h2) const
+			{
+				const uint64_t x = m_ctrl ^ (ms_LSBS * h2);
+				return { (x - ms_LSBS) & ~x & ms_MSBS };
+			}
+
+			[[nodiscard]] HashMapGroupMask	MatchEmpty() const
+			{
+				// Empty is the only control value with bit 7 set and bit 1 clear.
+				return { m_ctrl & (~m_ctrl << 6) & ms_MSBS };
+			}
+
+			[[nodiscard]] HashMapGroupMask	MatchEmptyOrDeleted() const
+			{
+				return { m_ctrl & ms_MSBS };
+			}
+
+			[[nodiscard]] HashMapGroupMask	MatchFull() const
+			{
+				return { ~m_ctrl & ms_MSBS };
+			}
+
+			uint64_t	m_ctrl;
+		};
+
+
+		/**
+		 * \brief Scrambles the hash so that weak hash functions (std::hash is the identity for integers on most
+		 * implementations) still spread over the groups and the 7-bit control tags.
+		 */
+		inline uint64_t	HashMapMix(uint64_t hash)
+		{
+			// Murmur3 64-bit finalizer
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			hash *= 0xc4ceb9fe1a85ec53ull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+	}
+}
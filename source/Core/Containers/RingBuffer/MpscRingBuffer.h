@@ -0,0 +1,166 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <atomic>
+#include <memory> // unique_ptr
+#endif
+
+namespace moe
+{
+	/**
+	 * \brief A bounded, lock-free, multiple producers / single consumer ring buffer.
+	 * Based on Dmitry Vyukov's bounded queue : each cell carries a sequence number telling whether it is ready
+	 * to be written (by the producer which claimed that position) or read (by the consumer).
+	 * Producers only contend on a single atomic compare-exchange, and never wait for each other or for the consumer.
+	 * \tparam T the type of the elements. It is default-constructed once per cell and then assigned to, so
+	 * fixed-size records work best.
+	 */
+	template <typename T>
+	class MpscRingBuffer
+	{
+	public:
+
+		/**
+		 * \brief Creates the buffer and allocates all of its memory.
+		 * \param capacity The maximum number of elements. Must be a power of two.
+		 */
+		MpscRingBuffer(uint32_t capacity);
+
+		MpscRingBuffer(const MpscRingBuffer&) = delete;
+		MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+		/**
+		 * \brief Safe to call from any thread.
+		 * \param writer A functor receiving a T& to fill in place. Only called if a cell could be claimed.
+		 * \return false if the buffer was full
+		 */
+		template <typename WriterFunc>
+		bool	TryPushWith(WriterFunc&& writer);
+
+		bool	TryPush(const T& value)
+		{
+			return TryPushWith([&value](T& cellValue) { cellValue = value; });
+		}
+
+		/**
+		 * \brief Must only be called from the (single) consumer thread.
+		 * \param reader A functor receiving a T& to consume in place. Only called if an element was available.
+		 * \return false if the buffer was empty
+		 */
+		template <typename ReaderFunc>
+		bool	TryPopWith(ReaderFunc&& reader);
+
+		bool	TryPop(T& value)
+		{
+			return TryPopWith([&value](T& cellValue) { value = std::move(cellValue); });
+		}
+
+		[[nodiscard]] uint32_t	Capacity() const { return m_mask + 1; }
+
+		/**
+		 * \brief Only an estimate while producers are running.
+		 */
+		[[nodiscard]] bool	Empty() const
+		{
+			return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos.load(std::memory_order_acquire);
+		}
+
+	private:
+
+		struct Cell
+		{
+			std::atomic<size_t>	m_sequence{ 0 };
+			T					m_value{};
+		};
+
+		// Keep producers' and consumer's positions on different cache lines to avoid false sharing.
+		static const size_t	ms_CACHE_LINE_SIZE = 64;
+
+		std::unique_ptr<Cell[]>	m_cells;
+		size_t					m_mask = 0;
+
+		alignas(ms_CACHE_LINE_SIZE) std::atomic<size_t>	m_enqueuePos{ 0 };
+		alignas(ms_CACHE_LINE_SIZE) std::atomic<size_t>	m_dequeuePos{ 0 };
+	};
+
+
+	template <typename T>
+	MpscRingBuffer<T>::MpscRingBuffer(uint32_t capacity) :
+		m_cells(new Cell[capacity]),
+		m_mask(capacity - 1)
+	{
+		MOE_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+		for (size_t iCell = 0; iCell < capacity; ++iCell)
+		{
+			m_cells[iCell].m_sequence.store(iCell, std::memory_order_relaxed);
+		}
+	}
+
+
+	template <typename T>
+	template <typename WriterFunc>
+	bool MpscRingBuffer<T>::TryPushWith(WriterFunc&& writer)
+	{
+		Cell* cell;
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			cell = &m_cells[pos & m_mask];
+			const size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				// The cell is free for this position : try to claim it.
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				// The consumer has not freed this cell yet : we're full.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed this position, retry with the new one.
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		writer(cell->m_value);
+		cell->m_sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	template <typename T>
+	template <typename ReaderFunc>
+	bool MpscRingBuffer<T>::TryPopWith(ReaderFunc&& reader)
+	{
+		const size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		Cell& cell = m_cells[pos & m_mask];
+
+		if (cell.m_sequence.load(std::memory_order_acquire) != pos + 1)
+		{
+			// Empty, or the producer which claimed this cell has not finished writing it yet.
+			return false;
+		}
+
+		reader(cell.m_value);
+
+		// Hand the cell back to producers for their next lap around the ring.
+		cell.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+		m_dequeuePos.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+}
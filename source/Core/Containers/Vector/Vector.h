@@ -10,15 +10,19 @@ namespace moe
 {
 	// Implementation of a vector
 	// Currently relying on the standard library.
-	template <class DataType>
+	// The allocator can be swapped for short-lived vectors, e.g. an ArenaAllocator to allocate in a frame or scratch arena.
+	template <class DataType, class Allocator = std::allocator<DataType>>
 	class Vector
 	{
+		using StdVector = std::vector<DataType, Allocator>;
+
 	public:
 
-		typedef	typename std::vector<DataType>::iterator		Iterator;
-		typedef	typename std::vector<DataType>::const_iterator	ConstIterator;
-		typedef	typename std::vector<DataType>::value_type		ValueType;
-		typedef	typename std::vector<DataType>::size_type		SizeType;
+		typedef	typename StdVector::iterator		Iterator;
+		typedef	typename StdVector::const_iterator	ConstIterator;
+		typedef	typename StdVector::value_type		ValueType;
+		typedef	typename StdVector::size_type		SizeType;
+		typedef	Allocator							AllocatorType;
 
 		// The Coplien rain dance to make things compile
 		explicit Vector() = default;
@@ -32,6 +36,16 @@ namespace moe
 		Vector(std::initializer_list<ValueType> il) :
 			m_vec(il) {}
 
+		// Allocator-aware versions
+		explicit Vector(const Allocator& alloc) :
+			m_vec(alloc) {}
+		Vector(SizeType n, const Allocator& alloc) :
+			m_vec(n, alloc) {}
+		Vector(SizeType n, const ValueType& val, const Allocator& alloc) :
+			m_vec(n, val, alloc) {}
+		Vector(std::initializer_list<ValueType> il, const Allocator& alloc) :
+			m_vec(il, alloc) {}
+
 		~Vector() = default;
 		Vector(const Vector& other) = default;
 		Vector& operator=(const Vector& other) = default;
@@ -95,6 +109,8 @@ namespace moe
 		void	Resize(SizeType n)							{ return m_vec.resize(n); }
 		void	Resize(SizeType n, const ValueType& val)	{ return m_vec.resize(n, val); }
 
+		AllocatorType	GetAllocator() const { return m_vec.get_allocator(); }
+
 		ValueType*			Data() noexcept			{ return m_vec.data(); }
 		const ValueType*	Data() const noexcept	{ return m_vec.data(); }
 
@@ -120,7 +136,7 @@ namespace moe
 
 	private:
 
-		std::vector<DataType>	m_vec;
+		StdVector	m_vec;
 
 	public:
 		// Relational operators soup
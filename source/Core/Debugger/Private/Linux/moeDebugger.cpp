@@ -28,7 +28,7 @@ namespace moe
         }
 
         char buf[256]; // arbitrary size
-        std::size_t numRead = std::fread(buf, sizeof(char), sizeof(buf), statusFileHandle);
+        std::size_t numRead = std::fread(buf, sizeof(char), sizeof(buf) - 1, statusFileHandle);
         bool debuggerPresent = false;
 
         if (numRead > 0)
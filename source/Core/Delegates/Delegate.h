@@ -1,62 +1,117 @@
 /*
-	Implementation of a callback delegate using variadic template parameters
-	Heavily inspired by https://nikitablack.github.io/2016/04/26/stdfunction-as-delegate.html
+	Implementation of an allocation-free callback delegate using variadic template parameters
+	Uses the "stub" technique of Sergey Ryazanov's "The Impossibly Fast C++ Delegates"
 */
 
 #pragma once
 
-#include <functional> // std::function
-#include <utility> // std::index_sequence_for
+#include "Core/Preprocessor/moeAssert.h"
+#include "Core/Preprocessor/moeLikely.h"
 
-// We're going to use a metaprogramming integer sequence to statically generate std::placeholders stubs to pass to std::bind
-// in order to construct our delegates.
-namespace moe
-{
-	template<size_t>
-	struct DelegatePlaceholder {};
-
-	template <size_t N>
-	DelegatePlaceholder<N + 1> GetNextPlaceholder()
-	{
-		return{};
-	}
-}
-
-// Using std::is_placeholder, we're able to tell that for example, EventPlaceholder<2> is to be replaced by placeholders::_2, etc...
-namespace std
-{
-	template<size_t N>
-	struct is_placeholder<moe::DelegatePlaceholder<N>> : public integral_constant<size_t, N> {};
-}
+#include <cstddef> // nullptr_t
+#include <cstdlib> // abort
+#include <cstring> // memcmp, memcpy
+#include <type_traits>
+#include <utility> // std::forward
 
 
-// We're going to use a metaprogramming integer sequence to statically generate std::placeholders stubs to pass to std::bind
-// in order to construct our delegates.
 namespace moe
 {
 	template<typename FunctionType>
 	class Delegate;
 
+	/*
+		A delegate never allocates : it is a "stub" function pointer, that knows how to call the target,
+		and a small inline storage for what the stub needs (a function pointer, an object and a member function pointer,
+		or the captures of a lambda). Calling it is a single indirect call.
+		When the function is known at compile time (Set<&func>, Set<Callee, &Callee::func>), it is baked in the stub :
+		then the storage only holds the object pointer, and the call can even be inlined in the stub.
+		Delegates are copied bit by bit : stored lambdas must be trivially copyable and destructible,
+		and small enough to fit the storage (capturing a few pointers or values is fine, capturing a std::string is not).
+		Two delegates compare equal when they call the same function on the same object.
+		Lambdas have no equality of their own : a delegate storing one is only equal to its copies.
+	*/
 	template <typename Ret, typename... Args>
 	class Delegate<Ret(Args...)>
 	{
-		using DelegateType = std::function<Ret(Args...)>;
+	public:
 
-		DelegateType	m_func = nullptr;
+		/*
+			Room for an object pointer and a member function pointer (up to two pointers big with multiple inheritance).
+			MSVC member function pointers to a class only forward declared where they are bound can be bigger :
+			binding one is a compile error rather than an overflow.
+		*/
+		static const std::size_t	ms_STORAGE_SIZE = 3 * sizeof(void*);
 
-	public:
 
 		Delegate() = default;
 
-		Delegate(Ret(*funcPtr)(Args...)) :
-			m_func(funcPtr)
+		Delegate(std::nullptr_t)
 		{}
 
+		Delegate(Ret(*funcPtr)(Args...))
+		{
+			if (funcPtr != nullptr)
+			{
+				Store(funcPtr, &CallFunctionPointer, &ValuesEqual<Ret(*)(Args...)>);
+			}
+		}
+
 
 		template<class Callee>
 		Delegate(Callee* obj, Ret(Callee::*funcPtr)(Args...))
 		{
-			m_func = Bind(obj, funcPtr, std::index_sequence_for<Args...>{});
+			static_assert(sizeof(MemberBinding<Callee, decltype(funcPtr)>) <= ms_STORAGE_SIZE,
+				"This member function pointer is too big to be stored in a delegate (MSVC : the class inheritance is unknown here).");
+
+			Store(MemberBinding<Callee, decltype(funcPtr)>{ obj, funcPtr }, &CallMemberBinding<Callee, decltype(funcPtr)>, &ValuesEqual<MemberBinding<Callee, decltype(funcPtr)>>);
+		}
+
+		template<class Callee>
+		Delegate(const Callee* obj, Ret(Callee::*funcPtr)(Args...) const)
+		{
+			static_assert(sizeof(MemberBinding<const Callee, decltype(funcPtr)>) <= ms_STORAGE_SIZE,
+				"This member function pointer is too big to be stored in a delegate (MSVC : the class inheritance is unknown here).");
+
+			Store(MemberBinding<const Callee, decltype(funcPtr)>{ obj, funcPtr }, &CallMemberBinding<const Callee, decltype(funcPtr)>,
+				&ValuesEqual<MemberBinding<const Callee, decltype(funcPtr)>>);
+		}
+
+
+		/* Any other callable object, typically a lambda. */
+		template <class Callable, typename = std::enable_if_t<
+			!std::is_same_v<std::decay_t<Callable>, Delegate> && std::is_invocable_r_v<Ret, std::decay_t<Callable>&, Args...>>>
+		Delegate(Callable&& callable)
+		{
+			using Stored = std::decay_t<Callable>;
+			static_assert(sizeof(Stored) <= ms_STORAGE_SIZE, "This callable is too big to be stored in a delegate.");
+			static_assert(alignof(Stored) <= alignof(void*), "This callable is too aligned to be stored in a delegate.");
+			static_assert(std::is_trivially_copyable_v<Stored> && std::is_trivially_destructible_v<Stored>,
+				"Delegates are copied bit by bit : stored callables must be trivially copyable and destructible.");
+
+			Store(Stored(std::forward<Callable>(callable)), &CallCallable<Stored>, &CopiesEqual<Stored>);
+		}
+
+
+		Delegate(const Delegate& other) = default;
+		Delegate& operator=(const Delegate& other) = default;
+
+		// A moved-from delegate is unset
+		Delegate(Delegate&& other) noexcept :
+			Delegate(other)
+		{
+			other.Reset();
+		}
+
+		Delegate& operator=(Delegate&& other) noexcept
+		{
+			if (this != &other)
+			{
+				*this = other;
+				other.Reset();
+			}
+
+			return *this;
 		}
 
 
@@ -64,33 +119,159 @@ namespace moe
 		template<Ret(*funcPtr)(Args...)>
 		void	Set()
 		{
-			m_func = funcPtr;
+			Reset();
+			m_stub = &CallFreeFunction<funcPtr>;
 		}
 
 		// Member function version
 		template<class Callee, Ret(Callee::*funcPtr)(Args...)>
 		void	Set(Callee* obj)
 		{
-			m_func = Bind(obj, funcPtr, std::index_sequence_for<Args...>{});
+			Reset();
+			Store(obj, &CallMemberFunction<Callee, funcPtr>, &ValuesEqual<Callee*>);
+		}
+
+		// Const member function version
+		template<class Callee, Ret(Callee::*funcPtr)(Args...) const>
+		void	Set(const Callee* obj)
+		{
+			Reset();
+			Store(obj, &CallConstMemberFunction<Callee, funcPtr>, &ValuesEqual<const Callee*>);
+		}
+
+		void	Reset()
+		{
+			m_stub = nullptr;
+			m_equals = nullptr;
+		}
+
+
+		Ret	operator()(Args... args) const
+		{
+			if (MOE_UNLIKELY(m_stub == nullptr))
+			{
+				MOE_ASSERT(false); // calling an unset delegate
+
+				if constexpr (std::is_void_v<Ret> || std::is_default_constructible_v<Ret>)
+					return Ret();
+				else
+					std::abort(); // there is nothing sensible to return
+			}
+
+			return m_stub(m_storage, std::forward<Args>(args)...);
 		}
 
-		Ret	operator()(Args... args)
+		bool	IsSet() const { return m_stub != nullptr; }
+
+
+		bool	operator==(const Delegate& other) const
 		{
-			return m_func(args...);
+			// The same stub means the same stored type, hence the same comparison function.
+			return m_stub == other.m_stub && (m_equals == nullptr || m_equals(m_storage, other.m_storage));
 		}
 
-		bool	IsSet() const { return m_func != nullptr; }
+		bool	operator!=(const Delegate& other) const
+		{
+			return !(*this == other);
+		}
 
 	private:
 
+		using StubType = Ret(*)(const void*, Args...);
+		using EqualsType = bool(*)(const void*, const void*);
+
+
+		template <class Callee, class MemberFuncPtr>
+		struct MemberBinding
+		{
+			Callee*			m_obj;
+			MemberFuncPtr	m_func;
+
+			bool	operator==(const MemberBinding& other) const { return m_obj == other.m_obj && m_func == other.m_func; }
+		};
+
+
+		template <class Stored>
+		void	Store(const Stored& stored, StubType stub, EqualsType equals)
+		{
+			static_assert(sizeof(Stored) <= ms_STORAGE_SIZE, "Delegate storage is too small.");
+
+			std::memcpy(m_storage, &stored, sizeof(Stored));
+			m_stub = stub;
+			m_equals = equals;
+		}
+
+		template <class Stored>
+		static const Stored&	Load(const void* storage)
+		{
+			return *static_cast<const Stored*>(storage);
+		}
+
+
+		/*
+			Compares the stored values themselves : their padding bytes may differ.
+		*/
+		template <class Stored>
+		static bool	ValuesEqual(const void* lhs, const void* rhs)
+		{
+			return Load<Stored>(lhs) == Load<Stored>(rhs);
+		}
 
 		/*
-			Using std::index_sequence, GetNextPlaceholder<Idx>() will get expanded into appropriate std::placeholders::_Idx.
+			Delegates are copied bit by bit, so a copy of a stored lambda has the same bytes, padding included.
 		*/
-		template <class Callee, std::size_t... Idx>
-		static DelegateType	Bind(Callee* obj, Ret(Callee::*funcPtr)(Args...), std::index_sequence<Idx...>)
+		template <class Stored>
+		static bool	CopiesEqual(const void* lhs, const void* rhs)
 		{
-			return std::bind(funcPtr, obj, GetNextPlaceholder<Idx>()...);
+			if constexpr (std::is_empty_v<Stored>)
+				return true; // captureless : all the instances do the same thing
+			else
+				return std::memcmp(lhs, rhs, sizeof(Stored)) == 0;
 		}
+
+
+		static Ret	CallFunctionPointer(const void* storage, Args... args)
+		{
+			return Load<Ret(*)(Args...)>(storage)(std::forward<Args>(args)...);
+		}
+
+		template <Ret(*funcPtr)(Args...)>
+		static Ret	CallFreeFunction(const void*, Args... args)
+		{
+			return funcPtr(std::forward<Args>(args)...);
+		}
+
+		template <class Callee, Ret(Callee::*funcPtr)(Args...)>
+		static Ret	CallMemberFunction(const void* storage, Args... args)
+		{
+			return (Load<Callee*>(storage)->*funcPtr)(std::forward<Args>(args)...);
+		}
+
+		template <class Callee, Ret(Callee::*funcPtr)(Args...) const>
+		static Ret	CallConstMemberFunction(const void* storage, Args... args)
+		{
+			return (Load<const Callee*>(storage)->*funcPtr)(std::forward<Args>(args)...);
+		}
+
+		template <class Callee, class MemberFuncPtr>
+		static Ret	CallMemberBinding(const void* storage, Args... args)
+		{
+			const MemberBinding<Callee, MemberFuncPtr>& binding = Load<MemberBinding<Callee, MemberFuncPtr>>(storage);
+			return (binding.m_obj->*binding.m_func)(std::forward<Args>(args)...);
+		}
+
+		template <class Callable>
+		static Ret	CallCallable(const void* storage, Args... args)
+		{
+			Callable& callable = const_cast<Callable&>(Load<Callable>(storage));
+			return callable(std::forward<Args>(args)...);
+		}
+
+
+		StubType	m_stub = nullptr;
+		EqualsType	m_equals = nullptr;	// Null when there is nothing stored to compare
+
+		// Mutable so that a const delegate can call a mutable lambda, like std::function does.
+		alignas(void*) mutable unsigned char	m_storage[ms_STORAGE_SIZE] = {};
 	};
-}
\ No newline at end of file
+}
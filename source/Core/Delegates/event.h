@@ -7,20 +7,50 @@
 
 #include "Core/Containers/Vector/Vector.h"
 #include "Core/Delegates/Delegate.h"
+#include "Core/Misc/Types.h"
 
-#include <algorithm> // std::find_if
+#include <algorithm> // upper_bound
+#include <tuple> // std::apply
+#include <type_traits>
 
 namespace moe
 {
-	typedef	std::size_t	EventDelegateID;
+	/*
+		Identifies a delegate added to an event : the index of its slot, and the generation of the slot.
+		Slots are reused after a removal, but with a new generation, so an old ID never removes a newer delegate.
+	*/
+	typedef	uint64_t	EventDelegateID;
 
 	template<typename FunctionType>
 	class Event;
 
+
+	namespace detail
+	{
+		/* What BroadcastBatch takes an array of : the argument itself for single-argument events, a tuple of arguments otherwise. */
+		template <typename... Args>
+		struct EventBatchPayload
+		{
+			using Type = std::tuple<std::decay_t<Args>...>;
+		};
+
+		template <typename Arg>
+		struct EventBatchPayload<Arg>
+		{
+			using Type = std::decay_t<Arg>;
+		};
+	}
+
+
 	/*
 		An event you can bind delegates to, that will be called when the event is Broadcast'ed.
 		This implementation does not prevent you to call the same function multiple times for the same event, know what you're doing.
-		It keeps track of a "delegate ID" it returns you when you add a new delegate so that you can remove your delegate if you wish.
+		It keeps track of a "delegate ID" it returns you when you add a new delegate so that you can remove your delegate in O(1).
+
+		Delegates are called by decreasing priority, then in the order they were added.
+		Removing a delegate only leaves a hole in the call list, that is skipped by broadcasts and compacted later :
+		it never reorders the other delegates, and it is safe to do during a broadcast (even the delegate being called can remove itself).
+		Delegates added during a broadcast are queued, and only added when the outermost broadcast ends : they won't be called by it.
 	*/
 	template <typename Ret, typename... Args>
 	class Event<Ret(Args...)>
@@ -28,98 +58,355 @@ namespace moe
 	public:
 		using DelegateType = Delegate<Ret(Args...)>;
 
+		using BatchPayload = typename detail::EventBatchPayload<Args...>::Type;
 
-		EventDelegateID	AddDelegate(const DelegateType& func)
+
+		EventDelegateID	AddDelegate(const DelegateType& func, int32_t priority = 0)
 		{
-			m_delegates.EmplaceBack(m_nextID, func);
-			return m_nextID++;
+			return AddListener(DelegateType(func), priority);
 		}
 
-		EventDelegateID	AddDelegate(DelegateType&& func)
+		EventDelegateID	AddDelegate(DelegateType&& func, int32_t priority = 0)
 		{
-			m_delegates.EmplaceBack(m_nextID, std::forward<DelegateType>(func));
-			return m_nextID++;
+			return AddListener(std::move(func), priority);
 		}
 
 
 		// Free function version
 		template<Ret(*funcPtr)(Args...)>
-		EventDelegateID	Add()
+		EventDelegateID	Add(int32_t priority = 0)
 		{
-			return AddDelegate(funcPtr);
+			DelegateType dlgt;
+			dlgt.template Set<funcPtr>();
+			return AddListener(std::move(dlgt), priority);
 		}
 
 		// Member function version
 		template<class Callee, Ret(Callee::*funcPtr)(Args...)>
-		EventDelegateID Add(Callee* obj)
+		EventDelegateID Add(Callee* obj, int32_t priority = 0)
 		{
-			return AddDelegate(DelegateType(obj, funcPtr));
+			DelegateType dlgt;
+			dlgt.template Set<Callee, funcPtr>(obj);
+			return AddListener(std::move(dlgt), priority);
 		}
 
 
 		/*
-			This function performs a linear search for a delegate with this ID (O(N) complexity).
-			The assumption is that it won't be used very often. It also expects to find the given ID.
+			Removes a delegate in O(1).
+			Returns false if there is no delegate with this ID (e.g. it has already been removed).
 		*/
 		bool	Remove(EventDelegateID dlgtId)
 		{
-			auto dlgtStructIt = std::find_if(m_delegates.Begin(), m_delegates.End(), [dlgtId](const EventDelegate& dlgtStruct)
+			const uint32_t slotIdx = (uint32_t)(dlgtId & UINT32_MAX);
+			const uint32_t generation = (uint32_t)(dlgtId >> 32);
+
+			if (slotIdx >= m_slots.Size() || m_slots[slotIdx].m_generation != generation || m_slots[slotIdx].m_listenerIdx == ms_FREE_SLOT)
 			{
-				return (dlgtStruct.m_id == dlgtId);
-			});
+				return false;
+			}
+
+			Slot& slot = m_slots[slotIdx];
+			if (slot.m_listenerIdx & ms_PENDING_FLAG)
+			{
+				m_pendingAdds[slot.m_listenerIdx & ~ms_PENDING_FLAG].m_removed = true;
+			}
+			else
+			{
+				// Only flagged, not reset : the delegate may be the one running right now, still reading its captures.
+				m_listeners[slot.m_listenerIdx].m_removed = true;
+				m_numHoles++;
+			}
+
+			FreeSlot(slotIdx);
+
+			if (m_broadcastDepth == 0)
+			{
+				CompactIfNeeded();
+			}
+
+			return true;
+		}
+
+
+		/*
+			Removes the first delegate (in call order) equal to this one. This performs a linear search (O(N) complexity) :
+			prefer removing by ID when you can.
+		*/
+		bool	RemoveDelegate(const DelegateType& dlgt)
+		{
+			for (const Listener& listener : m_listeners)
+			{
+				if (!listener.m_removed && listener.m_delegate == dlgt)
+				{
+					return Remove(MakeID(listener.m_slot));
+				}
+			}
 
-			bool found = dlgtStructIt != m_delegates.End();
-			if (MOE_ASSERT(found))
+			for (const Listener& pending : m_pendingAdds)
 			{
-				m_delegates.EraseBySwap(dlgtStructIt); // Changes the order of the vector but we don't care !
+				if (!pending.m_removed && pending.m_delegate == dlgt)
+				{
+					return Remove(MakeID(pending.m_slot));
+				}
 			}
 
-			return found;
+			return false;
 		}
 
 
 		/* Triggers all the delegates */
 		void	Broadcast(Args... args)
 		{
-			for (auto& dlgtStruct : m_delegates)
+			m_broadcastDepth++;
+
+			// Nothing can be inserted in the list during the broadcast, so it can't be reallocated under our feet.
+			const size_t numListeners = m_listeners.Size();
+			for (size_t iListener = 0; iListener < numListeners; ++iListener)
 			{
-				dlgtStruct.m_delegate(args...);
+				const Listener& listener = m_listeners[iListener];
+				if (listener.IsCallable())
+				{
+					listener.m_delegate(args...);
+				}
 			}
+
+			EndBroadcast();
 		}
 
 
-		EventDelegateID	GetNextID() const { return m_nextID; }
+		/*
+			Triggers all the delegates with each payload in turn : each delegate goes through all the payloads before the next one is called
+			(so the delegate and its target stay hot in cache).
+			The payloads are the arguments for single-argument events, and tuples of arguments otherwise.
+			A delegate removed in the middle of the batch does not receive the remaining payloads.
+		*/
+		void	BroadcastBatch(const BatchPayload* payloads, size_t numPayloads)
+		{
+			m_broadcastDepth++;
 
+			const size_t numListeners = m_listeners.Size();
+			for (size_t iListener = 0; iListener < numListeners; ++iListener)
+			{
+				const Listener& listener = m_listeners[iListener];
+				for (size_t iPayload = 0; iPayload < numPayloads && listener.IsCallable(); ++iPayload)
+				{
+					if constexpr (sizeof...(Args) == 1)
+					{
+						listener.m_delegate(payloads[iPayload]);
+					}
+					else
+					{
+						std::apply(listener.m_delegate, payloads[iPayload]);
+					}
+				}
+			}
 
-	private:
+			EndBroadcast();
+		}
 
 
+		/* Removes all delegates. Any ID given so far becomes invalid. */
+		void	Clear()
+		{
+			for (const Listener& pending : m_pendingAdds)
+			{
+				if (!pending.m_removed)
+					FreeSlot(pending.m_slot);
+			}
 
-		/* A simple struct holding the actual delegate and an ID */
-		struct EventDelegate
+			// Don't pull the list from under a running broadcast : leaving holes is enough.
+			for (Listener& listener : m_listeners)
+			{
+				if (!listener.m_removed)
+				{
+					FreeSlot(listener.m_slot);
+					listener.m_removed = true;
+					m_numHoles++;
+				}
+			}
+
+			m_pendingAdds.Clear();
+
+			if (m_broadcastDepth == 0)
+			{
+				CompactIfNeeded();
+			}
+		}
+
+
+		/* Number of delegates that will be called by the next broadcast (or after the current one ends, for queued delegates). */
+		[[nodiscard]] size_t	GetNumDelegates() const { return m_slots.Size() - m_freeSlots.Size(); }
+
+		[[nodiscard]] bool		IsBroadcasting() const { return m_broadcastDepth != 0; }
+
+
+	private:
+
+		/* A delegate in the call list, and the slot its ID refers to. */
+		struct Listener
 		{
-			EventDelegate() = default;
-			EventDelegate(EventDelegateID id, const DelegateType& dlgt) :
-				m_id(id), m_delegate(dlgt)
-			{}
-			EventDelegate(EventDelegateID id, DelegateType&& dlgt) :
-				m_id(id), m_delegate(std::move(dlgt))
+			Listener() = default;
+			Listener(DelegateType&& dlgt, int32_t priority, uint32_t slot) :
+				m_delegate(std::move(dlgt)), m_priority(priority), m_slot(slot)
 			{}
 
+			bool	IsCallable() const { return !m_removed && m_delegate.IsSet(); }
+
 			DelegateType	m_delegate = nullptr;
-			EventDelegateID	m_id = 0;
+			int32_t			m_priority = 0;
+			uint32_t		m_slot = 0;
+			bool			m_removed = false;	// A hole in the list, until the next compaction (its delegate is kept intact until then).
 		};
 
+		/* Where the delegate with this ID is : its index in the call list, or in the pending list. */
+		struct Slot
+		{
+			uint32_t	m_listenerIdx = ms_FREE_SLOT;
+			uint32_t	m_generation = 0;
+		};
 
+		static const uint32_t	ms_FREE_SLOT = UINT32_MAX;
+		static const uint32_t	ms_PENDING_FLAG = 1u << 31;	// The delegate was added during a broadcast, and is waiting in the pending list.
 
 
+		EventDelegateID	MakeID(uint32_t slotIdx) const
+		{
+			return ((EventDelegateID)m_slots[slotIdx].m_generation << 32) | slotIdx;
+		}
+
 
-		typedef moe::Vector<EventDelegate>	EventDelegates;
-		EventDelegates	m_delegates;
-		EventDelegateID	m_nextID = 0;
-	};
+		EventDelegateID	AddListener(DelegateType&& dlgt, int32_t priority)
+		{
+			uint32_t slotIdx;
+			if (m_freeSlots.Empty())
+			{
+				slotIdx = (uint32_t)m_slots.Size();
+				m_slots.EmplaceBack();
+			}
+			else
+			{
+				slotIdx = m_freeSlots.Back();
+				m_freeSlots.PopBack();
+			}
 
+			if (m_broadcastDepth != 0)
+			{
+				m_slots[slotIdx].m_listenerIdx = (uint32_t)m_pendingAdds.Size() | ms_PENDING_FLAG;
+				m_pendingAdds.EmplaceBack(std::move(dlgt), priority, slotIdx);
+			}
+			else
+			{
+				InsertListener(std::move(dlgt), priority, slotIdx);
+			}
+
+			return MakeID(slotIdx);
+		}
+
+
+		void	InsertListener(DelegateType&& dlgt, int32_t priority, uint32_t slotIdx)
+		{
+			// Usual case : lower or same priority as the last delegate, it just goes at the end.
+			if (m_listeners.Empty() || m_listeners.Back().m_priority >= priority)
+			{
+				m_slots[slotIdx].m_listenerIdx = (uint32_t)m_listeners.Size();
+				m_listeners.EmplaceBack(std::move(dlgt), priority, slotIdx);
+				return;
+			}
+
+			// Otherwise, it goes after all the delegates of higher or same priority : this shifts the others (O(N)).
+			auto insertIt = std::upper_bound(m_listeners.Begin(), m_listeners.End(), priority, [](int32_t prio, const Listener& listener)
+			{
+				return prio > listener.m_priority;
+			});
+
+			const size_t insertIdx = insertIt - m_listeners.Begin();
+			m_listeners.Insert(insertIt, Listener(std::move(dlgt), priority, slotIdx));
+
+			for (size_t iListener = insertIdx; iListener < m_listeners.Size(); ++iListener)
+			{
+				if (!m_listeners[iListener].m_removed)
+				{
+					m_slots[m_listeners[iListener].m_slot].m_listenerIdx = (uint32_t)iListener;
+				}
+			}
+		}
 
-}
 
+		void	FreeSlot(uint32_t slotIdx)
+		{
+			m_slots[slotIdx].m_listenerIdx = ms_FREE_SLOT;
+			m_slots[slotIdx].m_generation++;
+			m_freeSlots.PushBack(slotIdx);
+		}
+
+
+		void	EndBroadcast()
+		{
+			if (--m_broadcastDepth != 0)
+			{
+				return;
+			}
+
+			CompactIfNeeded();
 
+			if (!m_pendingAdds.Empty())
+			{
+				// Delegates added by delegates of the pending list get appended to it while we go through it.
+				for (size_t iPending = 0; iPending < m_pendingAdds.Size(); ++iPending)
+				{
+					Listener& pending = m_pendingAdds[iPending];
+					if (!pending.m_removed)
+					{
+						InsertListener(std::move(pending.m_delegate), pending.m_priority, pending.m_slot);
+					}
+				}
+
+				m_pendingAdds.Clear();
+			}
+		}
+
+
+		/*
+			Holes are removed once they are more than half of the list : every removal stays O(1) amortized,
+			and broadcasts never skip more holes than delegates they call.
+		*/
+		void	CompactIfNeeded()
+		{
+			if (m_numHoles == 0 || m_numHoles * 2 < m_listeners.Size())
+			{
+				return;
+			}
+
+			size_t iKept = 0;
+			for (size_t iListener = 0; iListener < m_listeners.Size(); ++iListener)
+			{
+				if (!m_listeners[iListener].m_removed)
+				{
+					if (iKept != iListener)
+					{
+						m_listeners[iKept] = std::move(m_listeners[iListener]);
+					}
+
+					m_slots[m_listeners[iKept].m_slot].m_listenerIdx = (uint32_t)iKept;
+					iKept++;
+				}
+			}
+
+			m_listeners.Resize(iKept);
+			m_numHoles = 0;
+		}
+
+
+		typedef moe::Vector<Listener>	Listeners;
+		Listeners			m_listeners;	// In call order
+		Listeners			m_pendingAdds;	// Added during a broadcast
+
+		Vector<Slot>		m_slots;
+		Vector<uint32_t>	m_freeSlots;
+
+		size_t				m_numHoles = 0;
+		uint32_t			m_broadcastDepth = 0;
+	};
+
+
+}
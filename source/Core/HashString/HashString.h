@@ -2,11 +2,50 @@
 
 #pragma once
 
+#include "Core/Misc/Types.h"
+
+#include "Monocle_Core_Export.h"
+
 #include <string>
+#include <type_traits>
 
 namespace moe
 {
-	typedef std::size_t		HashID;
+	typedef uint64_t		HashID;
+
+	/*
+	64-bit FNV-1a : simple, good enough to hash names, and constexpr, so that string literals can be hashed at compile time.
+	cf. http://www.isthe.com/chongo/tech/comp/fnv/index.html
+	*/
+	static constexpr HashID	FNV1A_OFFSET_BASIS = 0xcbf29ce484222325ull;
+	static constexpr HashID	FNV1A_PRIME = 0x100000001b3ull;
+
+	constexpr HashID	FNV1aHash(const char* str, size_t length)
+	{
+		HashID hash = FNV1A_OFFSET_BASIS;
+
+		for (size_t iChar = 0; iChar < length; ++iChar)
+		{
+			hash ^= (unsigned char)str[iChar];
+			hash *= FNV1A_PRIME;
+		}
+
+		return hash;
+	}
+
+	constexpr HashID	FNV1aHash(const char* cstr)
+	{
+		HashID hash = FNV1A_OFFSET_BASIS;
+
+		while (*cstr != '\0')
+		{
+			hash ^= (unsigned char)*cstr++;
+			hash *= FNV1A_PRIME;
+		}
+
+		return hash;
+	}
+
 
 	// "Stealing" this from https://blog.molecular-matters.com/2011/06/24/hashed-strings/
 	template <class String>
@@ -15,24 +54,13 @@ namespace moe
 	public:
 		static HashID	Hash(const String& str)
 		{
-			return (Hash(str.c_str()));
+			return FNV1aHash(str.data(), str.size());
 		}
 
 		static constexpr HashID	Hash(const char* cstr)
 		{
-			std::size_t hash = s_offset;
-
-			while (*cstr != '\0')
-			{
-				hash ^= *cstr++;
-				hash *= s_prime;
-			}
-
-			return hash;
+			return FNV1aHash(cstr);
 		}
-
-		static const std::size_t	s_offset = 2166136261u;
-		static const std::size_t	s_prime = 16777619u;
 	};
 
 
@@ -48,20 +76,61 @@ namespace moe
 
 		static HashID	Hash(const char* cstr)
 		{
-			std::hash<const char*> hash;
-			return hash(cstr);
+			// Hash the characters, not the pointer
+			return Hash(String(cstr));
 		}
 
 	};
 
+
+	/*
+	A string hashed at compile time by the _hs literal : "Jump"_hs.
+	It converts to a HashString (or directly to its HashID, e.g. for a switch case).
+	*/
+	struct HashLiteral
+	{
+		constexpr operator HashID() const { return m_id; }
+
+		HashID		m_id = 0;
+		const char*	m_str = nullptr;
+		size_t		m_length = 0;
+	};
+
+	inline namespace literals
+	{
+		constexpr HashLiteral	operator""_hs(const char* str, size_t length)
+		{
+			return HashLiteral{ FNV1aHash(str, length), str, length };
+		}
+	}
+
+
+	#ifndef MOE_SHIPPING
+	/*
+	The global table of the strings behind the hash strings, only there in "not shipping" modes, for debugging.
+	It keeps one copy of each string (hash strings only store their ID), and is safe to use from any thread.
+	When two different strings have the same hash, the first one stays in the table, and the collision is logged as an error.
+	*/
+
+	// Returns false if a different string was already interned with this ID.
+	Monocle_Core_API bool	InternHashString(HashID id, const char* str, size_t length);
+
+	// Returns nullptr if no string was interned with this ID.
+	Monocle_Core_API const std::string*	FindInternedHashString(HashID id);
+
+	Monocle_Core_API uint32_t	GetNumHashStringCollisions();
+	#endif
+
 	/*
 	Implementation of a simple Hash String
 	The purpose of a hash string is to be easily used as a hash key in a hash map, for example.
-	The origin string is stored in "not shipping" modes for ease of debugging.
+	The origin string is interned in the global hash string table in "not shipping" modes for ease of debugging :
+	a hash string is only its ID, in every mode.
 	Useful to reference asset IDs, the string constructor is disabled in Shipping mode to only allow using IDs (no useless strings).
-	TODO: make a generator to replace all HashString string constructors by their hash value.
+	Prefer the _hs literal to the string constructors : the hash is computed at compile time.
+	In Shipping builds, the HashStringGenerator tool replaces the HashString("...") and "..."_hs literals of .cpp files by their hash value (literals in headers are a Shipping build error).
 	*/
-	template <class String = std::string, class HashPolicy = StdHashPolicy<String>>
+	template <class String = std::string, class HashPolicy = FNV1aHashPolicy<String>>
 	class HashStringT
 	{
 	public:
@@ -69,16 +138,14 @@ namespace moe
 		HashStringT() = default;
 
 		#ifndef MOE_SHIPPING
-		explicit HashStringT(const String& str) :
-			m_str(str)
+		explicit HashStringT(const String& str)
 		{
-			m_id = HashPolicy::Hash(m_str);
+			SetString(str);
 		}
 
-		explicit HashStringT(const char* str) :
-			m_str(str)
+		explicit HashStringT(const char* str)
 		{
-			m_id = HashPolicy::Hash(m_str);
+			SetString(str);
 		}
 		#endif
 
@@ -86,32 +153,30 @@ namespace moe
 			m_id(id)
 		{}
 
-		HashStringT(const HashStringT & other)
+		HashStringT(const HashLiteral& literal) :
+			m_id(literal.m_id)
 		{
-			m_id = other.m_id;
+			static_assert(std::is_same_v<HashPolicy, FNV1aHashPolicy<String>>, "Hash literals are only compatible with FNV-1a hash strings.");
+
 			#ifndef MOE_SHIPPING
-			m_str = other.m_str;
+			InternHashString(m_id, literal.m_str, literal.m_length);
 			#endif
 		}
 
+		HashStringT(const HashStringT & other)
+		{
+			m_id = other.m_id;
+		}
+
 		explicit HashStringT(HashStringT&& other)
 		{
 			m_id = other.m_id;
 			other.m_id = 0;
-
-			#ifndef MOE_SHIPPING
-			m_str = std::move(other.m_str);
-			#endif
 		}
 
 		HashStringT& operator=(const HashStringT& rhs)
 		{
 			m_id = rhs.m_id;
-
-			#ifndef MOE_SHIPPING
-			m_str = rhs.m_str;
-			#endif
-
 			return *this;
 		}
 
@@ -119,19 +184,13 @@ namespace moe
 		{
 			m_id = rhs.m_id;
 			rhs.m_id = 0;
-
-			#ifndef MOE_SHIPPING
-			m_str = std::move(rhs.m_str);
-			#endif
-
 			return *this;
 		}
 
 		#ifndef MOE_SHIPPING
 		HashStringT& operator=(const char* str)
 		{
-			m_str = str;
-			m_id = HashPolicy::Hash(m_str);
+			SetString(str);
 			return *this;
 		}
 		#endif
@@ -154,9 +213,6 @@ namespace moe
 		void	Clear()
 		{
 			m_id = 0;
-			#ifndef MOE_SHIPPING
-			m_str.clear();
-			#endif
 		}
 
 
@@ -164,21 +220,25 @@ namespace moe
 		#ifndef MOE_SHIPPING
 		HashID SetString(const String& str)
 		{
-			m_str = str;
 			m_id = HashPolicy::Hash(str);
+			InternHashString(m_id, str.data(), str.size());
 			return m_id;
 		}
 
 		HashID SetString(const char* str)
 		{
-			m_str = str;
 			m_id = HashPolicy::Hash(str);
+			InternHashString(m_id, str, std::char_traits<char>::length(str));
 			return m_id;
 		}
 
-		const String&	GetString() const
+		// The interned string with this ID : empty if it was only given an ID, that no string hashed to so far.
+		const std::string&	GetString() const
 		{
-			return m_str;
+			static const std::string noString;
+
+			const std::string* interned = (m_id != 0 ? FindInternedHashString(m_id) : nullptr);
+			return (interned != nullptr ? *interned : noString);
 		}
 		#endif
 
@@ -217,9 +277,6 @@ namespace moe
 
 
 	private:
-		#ifndef MOE_SHIPPING
-		String	m_str;
-		#endif
 
 		HashID	m_id = 0;
 	};
@@ -233,9 +290,9 @@ namespace moe
 #ifdef MOE_STD_SUPPORT
 namespace std
 {
-	// With std support, Monocle HashMap relies on std::unordered_map.
-	// In order to use a custom type as a unordered_map key you need to specialize the std::hash template.
-	// With this in place, you can instantiate a std::unordered_map using HashString as the key:
+	// Monocle HashMap (and std::unordered_map) hash their keys with std::hash by default.
+	// In order to use a custom type as a hash map key you need to specialize the std::hash template.
+	// With this in place, you can instantiate a HashMap using HashString as the key:
 	// it will automatically use std::hash<HashString> for the hash value calculations.
 	template <class String, class HashPolicy>
 	struct hash<moe::HashStringT<String, HashPolicy>>
@@ -0,0 +1,89 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Core/HashString/HashString.h"
+
+#ifndef MOE_SHIPPING
+
+#include "Core/Log/moeLog.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace moe
+{
+	namespace
+	{
+		struct HashStringTable
+		{
+			// Node-based : the interned strings never move, so we can give references to them.
+			std::unordered_map<HashID, std::string>	m_strings;
+			std::shared_mutex						m_mutex;
+			uint32_t								m_numCollisions = 0;
+		};
+
+		HashStringTable&	GetHashStringTable()
+		{
+			static HashStringTable table;
+			return table;
+		}
+
+
+		bool	CheckCollision(HashStringTable& table, HashID id, const std::string& interned, std::string_view str)
+		{
+			if (interned == str)
+			{
+				return true;
+			}
+
+			table.m_numCollisions++;
+			MOE_ERROR(ChanDefault, "Hash string collision : '%s' and '%s' both hash to 0x%llx.",
+				interned.c_str(), std::string(str).c_str(), (unsigned long long)id);
+			return false;
+		}
+	}
+
+
+	bool	InternHashString(HashID id, const char* str, size_t length)
+	{
+		HashStringTable& table = GetHashStringTable();
+		const std::string_view strView(str, length);
+
+		// Most strings are interned already : only take the write lock for new ones.
+		{
+			std::shared_lock<std::shared_mutex> readLock(table.m_mutex);
+			auto stringIt = table.m_strings.find(id);
+			if (stringIt != table.m_strings.end() && stringIt->second == strView)
+			{
+				return true;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> writeLock(table.m_mutex);
+		auto [stringIt, inserted] = table.m_strings.try_emplace(id, strView);
+		return (inserted || CheckCollision(table, id, stringIt->second, strView));
+	}
+
+
+	const std::string*	FindInternedHashString(HashID id)
+	{
+		HashStringTable& table = GetHashStringTable();
+
+		std::shared_lock<std::shared_mutex> readLock(table.m_mutex);
+		auto stringIt = table.m_strings.find(id);
+		return (stringIt != table.m_strings.end() ? &stringIt->second : nullptr);
+	}
+
+
+	uint32_t	GetNumHashStringCollisions()
+	{
+		HashStringTable& table = GetHashStringTable();
+
+		std::shared_lock<std::shared_mutex> readLock(table.m_mutex);
+		return table.m_numCollisions;
+	}
+}
+
+#endif // MOE_SHIPPING
@@ -0,0 +1,55 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Jobs/Job.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <memory> // unique_ptr
+#endif
+
+namespace moe
+{
+	/**
+	 * \brief A ring of jobs owned by a single thread.
+	 * Allocation is a simple index bump that wraps around, reusing the jobs that have finished executing :
+	 * jobs are never freed explicitly, and only the jobs still in flight count against the capacity.
+	 * Each JobSystem thread has one, so allocation never needs synchronization.
+	 */
+	class FrameJobAllocator
+	{
+	public:
+		FrameJobAllocator(uint32_t capacity) :
+			m_jobs(new Job[capacity]),
+			m_capacity(capacity)
+		{}
+
+		/**
+		 * \return nullptr if the next job of the ring is still in flight
+		 */
+		[[nodiscard]] Job*	Allocate()
+		{
+			Job& job = m_jobs[m_next];
+			if (job.IsInFlight())
+			{
+				MOE_DEBUG_ASSERT(false); // too many jobs in flight : increase JobSystemConfig::m_jobsPerThreadPerFrame
+				return nullptr;
+			}
+
+			m_next = (m_next + 1 == m_capacity ? 0 : m_next + 1);
+			return &job;
+		}
+
+		/**
+		 * \brief Starts allocating from the beginning of the ring again, so a frame's jobs are contiguous.
+		 */
+		void	Reset() { m_next = 0; }
+
+	private:
+		std::unique_ptr<Job[]>	m_jobs;
+		uint32_t				m_capacity = 0;
+		uint32_t				m_next = 0;
+	};
+}
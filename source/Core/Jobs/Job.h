@@ -0,0 +1,87 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <atomic>
+#include <cstddef> // max_align_t
+#include <new>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace moe
+{
+	/**
+	 * \brief Tracks the completion of a group of jobs. Every job given a counter increments it when it is submitted,
+	 * and decrements it once it has finished. Waiting on a counter (JobSystem::Wait) means waiting for it to reach zero.
+	 * Counters are not copyable and must outlive the jobs referencing them.
+	 */
+	struct JobCounter
+	{
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		[[nodiscard]] bool	IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+		std::atomic<uint32_t>	m_pending{ 0 };
+	};
+
+
+	/**
+	 * \brief A unit of work for the JobSystem, exactly one cache line big.
+	 * The callable is stored inline in the job (no allocation), so its captures have to fit in ms_PAYLOAD_SIZE bytes :
+	 * capture big data by pointer or reference. Jobs are allocated by the JobSystem's frame allocators,
+	 * that reuse a job once it has been executed.
+	 */
+	struct alignas(64) Job
+	{
+		using Function = void(*)(Job&);
+
+		static const size_t	ms_PAYLOAD_SIZE = 64 - sizeof(Function) - sizeof(JobCounter*);
+
+		template <typename Callable>
+		void	Set(Callable&& callable, JobCounter* counter)
+		{
+			using CallableT = std::decay_t<Callable>;
+			static_assert(sizeof(CallableT) <= ms_PAYLOAD_SIZE, "Job callable is too big : capture less data, or capture it by pointer");
+			static_assert(alignof(CallableT) <= alignof(std::max_align_t), "Job callable is over-aligned");
+
+			new (m_payload) CallableT(std::forward<Callable>(callable));
+			m_counter = counter;
+			// Relaxed : the job is published to the other threads by the deque.
+			m_function.store([](Job& job)
+			{
+				CallableT& storedCallable = *std::launder(reinterpret_cast<CallableT*>(job.m_payload));
+				storedCallable();
+				storedCallable.~CallableT();
+			}, std::memory_order_relaxed);
+		}
+
+		void	Execute()
+		{
+			JobCounter* counter = m_counter;
+			m_function.load(std::memory_order_relaxed)(*this);
+
+			// Release the job before the counter : once the counter reaches zero, the job may be reused right away.
+			m_function.store(nullptr, std::memory_order_release);
+
+			if (counter != nullptr)
+			{
+				counter->m_pending.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+		/**
+		 * \brief A job is in flight from Set until it has finished executing.
+		 */
+		[[nodiscard]] bool	IsInFlight() const { return m_function.load(std::memory_order_acquire) != nullptr; }
+
+		std::atomic<Function>	m_function{ nullptr };	// nullptr while the job is free
+		JobCounter*				m_counter = nullptr;
+		alignas(std::max_align_t) byte_t	m_payload[ms_PAYLOAD_SIZE];
+	};
+}
@@ -0,0 +1,126 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Jobs/Job.h"
+#include "Core/Jobs/FrameJobAllocator.h"
+#include "Core/Jobs/WorkStealingQueue.h"
+
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Monocle_Core_Export.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <atomic>
+#include <condition_variable>
+#include <memory> // unique_ptr
+#include <mutex>
+#include <thread>
+#endif
+
+namespace moe
+{
+	struct JobSystemConfig
+	{
+		uint32_t	m_numWorkers = 0;				// Number of worker threads. 0 means one per hardware thread, minus the main thread.
+		uint32_t	m_queueCapacity = 4096;			// Per-thread deque size. Must be a power of two.
+		uint32_t	m_jobsPerThreadPerFrame = 4096;	// Size of each thread's frame allocator : how many jobs a thread can have in flight at once.
+	};
+
+
+	/**
+	 * \brief A work-stealing job system.
+	 * The thread creating the JobSystem (the "main" thread) and each worker thread own a deque of jobs :
+	 * jobs are pushed to the deque of the thread running them, and idle threads steal from the others.
+	 * Dependencies are expressed with JobCounters : Wait(counter) keeps executing jobs until the counter drops to zero,
+	 * so waiting from inside a job never deadlocks a worker.
+	 * Jobs come from per-thread frame allocators, that reuse each job once it has been executed.
+	 * Only the main thread and the workers can create and run jobs : called from any other thread,
+	 * Run asserts and executes the job right away.
+	 */
+	class JobSystem
+	{
+	public:
+
+		Monocle_Core_API JobSystem(const JobSystemConfig& config = JobSystemConfig());
+
+		Monocle_Core_API ~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+
+		/**
+		 * \brief Schedules a callable to run on any thread of the system.
+		 * \param callable Anything invocable without arguments, whose captures fit in a Job payload
+		 * \param counter Optional counter incremented now, and decremented once the job has run
+		 */
+		template <typename Callable>
+		void	Run(Callable&& callable, JobCounter* counter = nullptr);
+
+		/**
+		 * \brief Executes pending jobs on the calling thread until the counter reaches zero.
+		 */
+		Monocle_Core_API void	Wait(const JobCounter& counter);
+
+		/**
+		 * \brief Splits [0, count) in ranges of at most batchSize elements, runs function(begin, end) on each range
+		 * in parallel and waits for all of them to finish.
+		 */
+		template <typename RangeFunction>
+		void	ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function);
+
+		/**
+		 * \brief Rewinds all the frame allocators, so the jobs of a frame are contiguous in memory.
+		 * Optional, since the allocators recycle executed jobs anyway : the owner of the JobSystem can call it
+		 * once per frame, from the main thread, while no job is in flight.
+		 */
+		Monocle_Core_API void	NewFrame();
+
+		[[nodiscard]] uint32_t	GetWorkerCount() const { return (uint32_t)m_workers.Size(); }
+
+		/**
+		 * \brief Total number of threads executing jobs (the workers and the main thread).
+		 */
+		[[nodiscard]] uint32_t	GetThreadCount() const { return (uint32_t)m_threadData.Size(); }
+
+	private:
+
+		struct alignas(64) ThreadData
+		{
+			ThreadData(const JobSystemConfig& config) :
+				m_queue(config.m_queueCapacity),
+				m_allocator(config.m_jobsPerThreadPerFrame)
+			{}
+
+			WorkStealingQueue<Job>	m_queue;
+			FrameJobAllocator		m_allocator;
+			uint32_t				m_nextVictim = 0;
+		};
+
+		Monocle_Core_API Job*	AllocateJob();
+
+		Monocle_Core_API void	Submit(Job* job);
+
+		/**
+		 * \brief Pops a job from the calling thread's deque, or steals one from another thread.
+		 */
+		Job*	FindJob(ThreadData& self);
+
+		void	WorkerLoop(uint32_t threadIndex);
+
+		ThreadData&	GetCurrentThreadData();
+
+		Vector<std::unique_ptr<ThreadData>>	m_threadData;	// Index 0 is the main thread
+		Vector<std::thread>					m_workers;
+
+		std::atomic<bool>		m_running{ true };
+
+		// Sleeping workers are woken up whenever a job is submitted
+		std::atomic<uint32_t>	m_sleepingWorkers{ 0 };
+		std::mutex				m_sleepMutex;
+		std::condition_variable	m_sleepCondition;
+	};
+}
+
+#include "JobSystem.hpp"
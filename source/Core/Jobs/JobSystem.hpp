@@ -0,0 +1,56 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+namespace moe
+{
+	template <typename Callable>
+	void JobSystem::Run(Callable&& callable, JobCounter* counter)
+	{
+		if (counter != nullptr)
+		{
+			counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		Job* job = AllocateJob();
+		if (job == nullptr)
+		{
+			// Too many jobs in flight, or not a thread of this system : still honor the request, synchronously.
+			callable();
+			if (counter != nullptr)
+			{
+				counter->m_pending.fetch_sub(1, std::memory_order_release);
+			}
+			return;
+		}
+
+		job->Set(std::forward<Callable>(callable), counter);
+		Submit(job);
+	}
+
+
+	template <typename RangeFunction>
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (batchSize == 0)
+		{
+			// Default to a few batches per thread, to leave room for load balancing.
+			batchSize = (count + GetThreadCount() * 4 - 1) / (GetThreadCount() * 4);
+		}
+
+		JobCounter counter;
+
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			const uint32_t end = (count - begin > batchSize ? begin + batchSize : count);
+			Run([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+
+		Wait(counter);
+	}
+}
@@ -0,0 +1,218 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Core/Jobs/JobSystem.h"
+
+#include <chrono>
+
+namespace
+{
+	// Which job system the current thread belongs to, and its index in it.
+	thread_local const moe::JobSystem*	tl_jobSystem = nullptr;
+	thread_local uint32_t				tl_threadIndex = 0;
+
+	// Number of unsuccessful job searches a worker does before going to sleep.
+	const uint32_t	gs_SPIN_COUNT_BEFORE_SLEEP = 64;
+}
+
+
+namespace moe
+{
+	JobSystem::JobSystem(const JobSystemConfig& config)
+	{
+		uint32_t numWorkers = config.m_numWorkers;
+		if (numWorkers == 0)
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			numWorkers = (hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+		}
+
+		m_threadData.Reserve(numWorkers + 1);
+		for (uint32_t iThread = 0; iThread < numWorkers + 1; ++iThread)
+		{
+			m_threadData.EmplaceBack(std::make_unique<ThreadData>(config));
+			m_threadData.Back()->m_nextVictim = (iThread + 1) % (numWorkers + 1);
+		}
+
+		// The creating thread is the main thread of this system
+		tl_jobSystem = this;
+		tl_threadIndex = 0;
+
+		m_workers.Reserve(numWorkers);
+		for (uint32_t iWorker = 0; iWorker < numWorkers; ++iWorker)
+		{
+			m_workers.EmplaceBack(&JobSystem::WorkerLoop, this, iWorker + 1);
+		}
+	}
+
+
+	JobSystem::~JobSystem()
+	{
+		m_running.store(false, std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_sleepCondition.notify_all();
+		}
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+
+		if (tl_jobSystem == this)
+		{
+			tl_jobSystem = nullptr;
+		}
+	}
+
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		if (tl_jobSystem != this)
+		{
+			// Not one of our threads : it has no deque to help from, so it can only wait.
+			MOE_ASSERT(false);
+			while (false == counter.IsDone())
+			{
+				std::this_thread::yield();
+			}
+			return;
+		}
+
+		ThreadData& self = GetCurrentThreadData();
+
+		// Help with the work instead of blocking : this is what keeps nested waits from deadlocking.
+		while (false == counter.IsDone())
+		{
+			Job* job = FindJob(self);
+			if (job != nullptr)
+			{
+				job->Execute();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+
+	void JobSystem::NewFrame()
+	{
+		MOE_ASSERT(tl_jobSystem == this && tl_threadIndex == 0);
+
+		for (auto& threadData : m_threadData)
+		{
+			MOE_DEBUG_ASSERT(threadData->m_queue.Empty()); // Jobs are still in flight !
+			threadData->m_allocator.Reset();
+		}
+	}
+
+
+	Job* JobSystem::AllocateJob()
+	{
+		// Only its owner thread can push to a deque : any other thread would race with it.
+		if (tl_jobSystem != this)
+		{
+			MOE_ASSERT(false); // Run must be called from the main thread or a worker of this system
+			return nullptr;
+		}
+
+		return GetCurrentThreadData().m_allocator.Allocate();
+	}
+
+
+	void JobSystem::Submit(Job* job)
+	{
+		if (false == GetCurrentThreadData().m_queue.Push(job))
+		{
+			// Our deque is full : run the job right away rather than losing it.
+			job->Execute();
+			return;
+		}
+
+		if (m_sleepingWorkers.load(std::memory_order_acquire) != 0)
+		{
+			m_sleepCondition.notify_one();
+		}
+	}
+
+
+	Job* JobSystem::FindJob(ThreadData& self)
+	{
+		Job* job = self.m_queue.Pop();
+		if (job != nullptr)
+		{
+			return job;
+		}
+
+		// Our deque is empty : go steal from the others, starting where we last succeeded.
+		const uint32_t numThreads = (uint32_t)m_threadData.Size();
+		for (uint32_t iAttempt = 0; iAttempt < numThreads; ++iAttempt)
+		{
+			const uint32_t victim = self.m_nextVictim;
+			if (m_threadData[victim].get() != &self)
+			{
+				job = m_threadData[victim]->m_queue.Steal();
+				if (job != nullptr)
+				{
+					return job;
+				}
+			}
+
+			self.m_nextVictim = (victim + 1) % numThreads;
+		}
+
+		return nullptr;
+	}
+
+
+	void JobSystem::WorkerLoop(uint32_t threadIndex)
+	{
+		tl_jobSystem = this;
+		tl_threadIndex = threadIndex;
+
+		ThreadData& self = *m_threadData[threadIndex];
+		uint32_t failedSearches = 0;
+
+		while (m_running.load(std::memory_order_acquire))
+		{
+			Job* job = FindJob(self);
+			if (job != nullptr)
+			{
+				job->Execute();
+				failedSearches = 0;
+				continue;
+			}
+
+			if (++failedSearches < gs_SPIN_COUNT_BEFORE_SLEEP)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Nothing to do for a while : sleep until a job gets submitted.
+			// The timeout covers the race where a job is submitted right before we start waiting.
+			m_sleepingWorkers.fetch_add(1, std::memory_order_acq_rel);
+			{
+				std::unique_lock<std::mutex> lock(m_sleepMutex);
+				if (m_running.load(std::memory_order_acquire))
+				{
+					m_sleepCondition.wait_for(lock, std::chrono::milliseconds(1));
+				}
+			}
+			m_sleepingWorkers.fetch_sub(1, std::memory_order_acq_rel);
+			failedSearches = 0;
+		}
+
+		tl_jobSystem = nullptr;
+	}
+
+
+	JobSystem::ThreadData& JobSystem::GetCurrentThreadData()
+	{
+		// Only the threads of this system have a deque and an allocator.
+		MOE_ASSERT(tl_jobSystem == this);
+		return *m_threadData[tl_threadIndex];
+	}
+}
@@ -0,0 +1,123 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <atomic>
+#include <memory> // unique_ptr
+#endif
+
+namespace moe
+{
+	/**
+	 * \brief A fixed-capacity Chase-Lev work-stealing deque of pointers.
+	 * The owning thread pushes and pops at the bottom (LIFO, which is cache-friendly for the jobs it just spawned),
+	 * while other threads steal from the top (FIFO, so they take the oldest, usually biggest, pieces of work).
+	 * cf. "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013.
+	 */
+	template <typename T>
+	class WorkStealingQueue
+	{
+	public:
+		/**
+		 * \param capacity Must be a power of two.
+		 */
+		WorkStealingQueue(uint32_t capacity) :
+			m_items(new std::atomic<T*>[capacity]),
+			m_mask(capacity - 1)
+		{
+			MOE_ASSERT(capacity != 0 && (capacity & (capacity - 1)) == 0);
+		}
+
+		/**
+		 * \brief Owner thread only.
+		 * \return false if the queue is full
+		 */
+		bool	Push(T* item)
+		{
+			const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			const int64_t top = m_top.load(std::memory_order_acquire);
+			if (bottom - top > (int64_t)m_mask)
+			{
+				return false;
+			}
+
+			m_items[bottom & m_mask].store(item, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * \brief Owner thread only.
+		 * \return The most recently pushed item, or nullptr if the queue is empty
+		 */
+		T*	Pop()
+		{
+			const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_seq_cst);
+
+			if (top > bottom)
+			{
+				// Empty
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_items[bottom & m_mask].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last item : race against thieves for it.
+				if (false == m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					item = nullptr;
+				}
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		/**
+		 * \brief Any thread.
+		 * \return The oldest item, or nullptr if the queue is empty or another thread won the race for it
+		 */
+		T*	Steal()
+		{
+			int64_t top = m_top.load(std::memory_order_seq_cst);
+			const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+			if (top >= bottom)
+			{
+				return nullptr;
+			}
+
+			T* item = m_items[top & m_mask].load(std::memory_order_relaxed);
+			if (false == m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return nullptr;
+			}
+
+			return item;
+		}
+
+		/**
+		 * \brief Only an estimate when other threads are using the queue.
+		 */
+		[[nodiscard]] bool	Empty() const
+		{
+			return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::unique_ptr<std::atomic<T*>[]>	m_items;
+		int64_t								m_mask;
+
+		alignas(64) std::atomic<int64_t>	m_top{ 0 };
+		alignas(64) std::atomic<int64_t>	m_bottom{ 0 };
+	};
+}
@@ -0,0 +1,174 @@
+#include "Core/StringFormat/moeStringFormat.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace moe
+{
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::AsyncLogger(const AsyncLoggerConfig& config, FilterPolicy&& filter, FormatPolicy&& formatter, WritePolicy&& writer) :
+        m_config(config),
+        m_filter(std::move(filter)),
+        m_formatter(std::move(formatter)),
+        m_writer(std::move(writer)),
+        m_ring(config.m_ringCapacity)
+    {
+        m_batch.reserve(m_config.m_batchSizeBytes + AsyncLogRecord::ms_MAX_MESSAGE_SIZE);
+
+        // Start the thread last, once everything it uses is ready
+        m_loggingThread = std::thread(&AsyncLogger::LoggingThreadLoop, this);
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::~AsyncLogger()
+    {
+        m_stopRequested.store(true, std::memory_order_release);
+        WakeLoggingThread();
+
+        if (m_loggingThread.joinable())
+        {
+            m_loggingThread.join();
+        }
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::Flush()
+    {
+        const uint64_t target = m_pushedCount.load(std::memory_order_acquire);
+
+        WakeLoggingThread();
+
+        std::unique_lock<std::mutex> lock(m_flushMutex);
+        m_flushCondition.wait(lock, [this, target]() { return m_writtenCount.load(std::memory_order_acquire) >= target; });
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::ConsumeLogMessage(const LogInfo& logInfo)
+    {
+        if (false == m_filter.Filter(logInfo))
+        {
+            return;
+        }
+
+        auto fillRecord = [&logInfo](AsyncLogRecord& record)
+        {
+            record.m_messageSize = (uint32_t)std::min<size_t>(logInfo.message.size(), AsyncLogRecord::ms_MAX_MESSAGE_SIZE);
+            std::memcpy(record.m_message, logInfo.message.data(), record.m_messageSize);
+            record.m_file = logInfo.file;
+            record.m_line = logInfo.line;
+            record.m_channel = logInfo.channel;
+            record.m_severity = logInfo.severity;
+        };
+
+        bool pushed = m_ring.TryPushWith(fillRecord);
+
+        if (!pushed && m_config.m_fullPolicy == AsyncLogFullPolicy::Block)
+        {
+            WakeLoggingThread();
+            do
+            {
+                std::this_thread::yield();
+                pushed = m_ring.TryPushWith(fillRecord);
+            } while (!pushed);
+        }
+
+        if (pushed)
+        {
+            m_pushedCount.fetch_add(1, std::memory_order_release);
+        }
+        else
+        {
+            m_droppedSinceLastBatch.fetch_add(1, std::memory_order_relaxed);
+            m_totalDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::LoggingThreadLoop()
+    {
+        for (;;)
+        {
+            // Read the stop flag before draining : everything pushed before the destructor ran gets written.
+            const bool stopping = m_stopRequested.load(std::memory_order_acquire);
+
+            bool drainedAny = false;
+            while (m_ring.TryPopWith([this](const AsyncLogRecord& record) { FormatRecord(record); }))
+            {
+                drainedAny = true;
+                if (m_batch.size() >= m_config.m_batchSizeBytes)
+                {
+                    WriteBatch();
+                }
+            }
+
+            // The ring is empty : don't keep messages waiting.
+            WriteBatch();
+
+            if (stopping)
+            {
+                break;
+            }
+
+            if (!drainedAny)
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCondition.wait_for(lock, m_config.m_idleWaitTime);
+            }
+        }
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::FormatRecord(const AsyncLogRecord& record)
+    {
+        m_messageBuffer.assign(record.m_message, record.m_messageSize);
+
+        const LogInfo logInfo{ m_messageBuffer, record.m_file, record.m_line, record.m_channel, record.m_severity };
+
+        m_formatBuffer.resize(m_formatBuffer.capacity());
+        m_batch += m_formatter.Format(m_formatBuffer, logInfo);
+        m_batchRecordCount++;
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::WriteBatch()
+    {
+        const uint64_t dropped = m_droppedSinceLastBatch.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0)
+        {
+            StringFormat(m_formatBuffer, "[%llu log messages dropped]\n", (unsigned long long)dropped);
+            m_batch += m_formatBuffer;
+        }
+
+        if (m_batch.empty())
+        {
+            return;
+        }
+
+        m_writer.Write(m_batch);
+        m_batch.clear();
+
+        {
+            // Under the lock, so that a flushing thread cannot miss the notification between its check and its wait.
+            std::lock_guard<std::mutex> lock(m_flushMutex);
+            m_writtenCount.fetch_add(m_batchRecordCount, std::memory_order_release);
+        }
+        m_flushCondition.notify_all();
+
+        m_batchRecordCount = 0;
+    }
+
+
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    void    AsyncLogger<FilterPolicy, FormatPolicy, WritePolicy>::WakeLoggingThread()
+    {
+        // Producers never take the lock : if this races with the logging thread going to sleep,
+        // it only delays it by m_idleWaitTime at worst.
+        m_wakeCondition.notify_one();
+    }
+}
@@ -13,9 +13,24 @@ namespace moe
     {
         if (m_filter.Filter(logInfo))
         {
-            std::string tempBuffer;
-            const std::string& formattedBuffer = m_formatter.Format(tempBuffer, logInfo);
+            // Any thread can log : each one formats in its own buffer, reused to avoid allocating each time.
+            // A write policy logging again from inside Write gets a fresh buffer to not overwrite the message being written.
+            thread_local std::string tl_formatBuffer;
+            thread_local bool tl_bufferInUse = false;
+
+            std::string localBuffer;
+            const bool useThreadBuffer = !tl_bufferInUse;
+            std::string& formatBuffer = (useThreadBuffer ? tl_formatBuffer : localBuffer);
+            tl_bufferInUse = true;
+
+            formatBuffer.resize(formatBuffer.capacity());
+            const std::string& formattedBuffer = m_formatter.Format(formatBuffer, logInfo);
             m_writer.Write(formattedBuffer);
+
+            if (useThreadBuffer)
+            {
+                tl_bufferInUse = false;
+            }
         }
     }
 }
\ No newline at end of file
@@ -5,8 +5,19 @@ namespace moe
     template <typename... Args>
     void    LoggerBase::Log(LogChannel channel, LogSeverity severity, const char* file, int line, const char* format, const Args&... args)
     {
-        // Preformat the message once for all chained loggers, instead of letting them doing it multiple times
-        std::string msgStr;
+        // Preformat the message once for all chained loggers, instead of letting them doing it multiple times.
+        // Each thread reuses its own buffer so logging doesn't allocate every time.
+        // A logger logging from inside ConsumeLogMessage gets a fresh buffer to not overwrite the message being consumed.
+        thread_local std::string tl_msgBuffer;
+        thread_local bool tl_bufferInUse = false;
+
+        std::string localBuffer;
+        const bool useThreadBuffer = !tl_bufferInUse;
+        std::string& msgStr = (useThreadBuffer ? tl_msgBuffer : localBuffer);
+        tl_bufferInUse = true;
+
+        // StringFormat formats in place as long as the message fits the current size, so offer it the whole capacity.
+        msgStr.resize(msgStr.capacity());
         StringFormat(msgStr, format, args...);
 
         const LogInfo logMessage{ msgStr, file, line, channel, severity };
@@ -22,5 +33,10 @@ namespace moe
                 loggerNode = loggerNode->Next();
             }
         } while (loggerNode != this);
+
+        if (useThreadBuffer)
+        {
+            tl_bufferInUse = false;
+        }
     }
 }
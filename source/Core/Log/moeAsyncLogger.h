@@ -0,0 +1,132 @@
+#ifndef MOE_ASYNC_LOGGER_H_
+#define MOE_ASYNC_LOGGER_H_
+
+#include "Core/Log/moeLoggerBase.h"
+
+#ifdef MOE_STD_SUPPORT
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Core/Containers/RingBuffer/MpscRingBuffer.h"
+
+namespace moe
+{
+    // What an AsyncLogger does when a producer thread finds the ring buffer full.
+    enum class AsyncLogFullPolicy
+    {
+        Drop,   // The message is lost (and counted). Logging never stalls the caller.
+        Block   // The caller waits for the logging thread to make room. No message is ever lost.
+    };
+
+
+    struct AsyncLoggerConfig
+    {
+        uint32_t                    m_ringCapacity = 4096;              // Number of records. Must be a power of two.
+        AsyncLogFullPolicy          m_fullPolicy = AsyncLogFullPolicy::Drop;
+        size_t                      m_batchSizeBytes = 64 * 1024;       // The batch is written when it gets this big, or when the ring is empty.
+        std::chrono::milliseconds   m_idleWaitTime{ 5 };                // How long the logging thread sleeps when there is nothing to log.
+    };
+
+
+    // A fixed-size copy of a log message, so that pushing it in the ring never allocates.
+    // Messages longer than the record are truncated.
+    struct AsyncLogRecord
+    {
+        static const uint32_t   ms_MAX_MESSAGE_SIZE = 240;
+
+        char        m_message[ms_MAX_MESSAGE_SIZE];
+        uint32_t    m_messageSize = 0;
+        const char* m_file = nullptr;   // __FILE__ is a string literal : storing the pointer is enough.
+        int         m_line = 0;
+        LogChannel  m_channel = ChanDefault;
+        LogSeverity m_severity = SevInfo;
+    };
+
+
+    // A logger that hands messages over to a background thread instead of formatting and writing them in place.
+    // Producers (any thread) only filter the message and copy it into a lock-free MPSC ring buffer of fixed-size records.
+    // The logging thread drains the ring, formats the records and gives them to the write policy in large batches,
+    // so the write policy is only ever called from a single thread and callers never wait on I/O.
+    // Memory is bounded by the ring capacity : when it is full, the message is either dropped or the caller blocks.
+    // Filter must be thread-safe (the provided policies are), Format and Write are only used by the logging thread.
+    template <class FilterPolicy, class FormatPolicy, class WritePolicy>
+    class AsyncLogger : public LoggerBase
+    {
+    public:
+        AsyncLogger(
+            const AsyncLoggerConfig& config = AsyncLoggerConfig(),
+            FilterPolicy&& filter       = FilterPolicy(),
+            FormatPolicy&& formatter    = FormatPolicy(),
+            WritePolicy&& writer        = WritePolicy());
+
+        // Writes everything still in the ring before returning.
+        virtual ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // Blocks until every message logged before the call has been handed to the write policy.
+        void    Flush();
+
+        // Number of messages lost because the ring was full (only with AsyncLogFullPolicy::Drop).
+        uint64_t    GetDroppedCount() const { return m_totalDropped.load(std::memory_order_relaxed); }
+
+        FilterPolicy&   GetFilterPolicy() { return m_filter; }
+
+        // The format and write policies are used by the logging thread : only touch them after a Flush,
+        // while no other thread is logging.
+        FormatPolicy&   GetFormatPolicy() { return m_formatter; }
+        WritePolicy&    GetWritePolicy()  { return m_writer; }
+
+    protected:
+        virtual void    ConsumeLogMessage(const LogInfo& logInfo) override;
+
+    private:
+        void    LoggingThreadLoop();
+
+        void    FormatRecord(const AsyncLogRecord& record);
+
+        void    WriteBatch();
+
+        void    WakeLoggingThread();
+
+        AsyncLoggerConfig   m_config;
+
+        FilterPolicy    m_filter;
+        FormatPolicy    m_formatter;
+        WritePolicy     m_writer;
+
+        MpscRingBuffer<AsyncLogRecord>  m_ring;
+
+        // Logging thread only
+        std::string     m_batch;
+        std::string     m_messageBuffer;
+        std::string     m_formatBuffer;
+        uint64_t        m_batchRecordCount = 0;
+
+        std::atomic<uint64_t>   m_pushedCount{ 0 };
+        std::atomic<uint64_t>   m_writtenCount{ 0 };
+        std::atomic<uint64_t>   m_droppedSinceLastBatch{ 0 };
+        std::atomic<uint64_t>   m_totalDropped{ 0 };
+        std::atomic<bool>       m_stopRequested{ false };
+
+        std::mutex              m_wakeMutex;
+        std::condition_variable m_wakeCondition;
+
+        // Signalled by the logging thread every time it writes a batch
+        std::mutex              m_flushMutex;
+        std::condition_variable m_flushCondition;
+
+        std::thread     m_loggingThread;
+    };
+}
+
+#include "Core/Log/Private/moeAsyncLogger.internal.hpp"
+
+#endif // MOE_STD_SUPPORT
+
+#endif // MOE_ASYNC_LOGGER_H_
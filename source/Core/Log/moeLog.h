@@ -7,6 +7,7 @@
 
 // The logger basically includes everything else
 #include "Core/Log/moeLogger.h"
+#include "Core/Log/moeAsyncLogger.h"
 #include "Core/Log/moeLogMacros.h"
 
 // Logger Policies
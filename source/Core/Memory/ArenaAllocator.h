@@ -0,0 +1,103 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+#include <new> // operator new, align_val_t
+#include <type_traits>
+
+#ifdef MOE_STD_SUPPORT
+#include <string>
+#endif
+
+
+namespace moe
+{
+	/**
+	 * \brief A standard-compatible allocator that allocates in a LinearArena, to give to containers like Vector or HashMap.
+	 * When the arena is full, it falls back to the heap, so that a too small arena is a performance problem, not a crash
+	 * (the arena counts the failed allocations).
+	 * Containers can only be moved to or swapped with containers using the same arena : a copy gets the same arena too.
+	 * The container must not outlive the memory of its arena (be careful with scopes and Reset).
+	 */
+	template <class T>
+	class ArenaAllocator
+	{
+	public:
+
+		using value_type = T;
+
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		ArenaAllocator(LinearArena& arena) noexcept :
+			m_arena(&arena)
+		{}
+
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+			m_arena(other.GetArena())
+		{}
+
+
+		[[nodiscard]] T*	allocate(std::size_t n)
+		{
+			void* memory = m_arena->Allocate(n * sizeof(T), alignof(T));
+			if (memory == nullptr)
+			{
+				if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				{
+					memory = ::operator new(n * sizeof(T), std::align_val_t(alignof(T)));
+				}
+				else
+				{
+					memory = ::operator new(n * sizeof(T));
+				}
+			}
+
+			return static_cast<T*>(memory);
+		}
+
+		void	deallocate(T* ptr, std::size_t n) noexcept
+		{
+			if (m_arena->Owns(ptr))
+			{
+				m_arena->Free(ptr, n * sizeof(T));
+			}
+			else if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			{
+				::operator delete(ptr, std::align_val_t(alignof(T)));
+			}
+			else
+			{
+				::operator delete(ptr);
+			}
+		}
+
+
+		[[nodiscard]] LinearArena*	GetArena() const noexcept { return m_arena; }
+
+
+		template <class U>
+		bool	operator==(const ArenaAllocator<U>& rhs) const noexcept { return m_arena == rhs.GetArena(); }
+
+		template <class U>
+		bool	operator!=(const ArenaAllocator<U>& rhs) const noexcept { return m_arena != rhs.GetArena(); }
+
+	private:
+
+		LinearArena*	m_arena = nullptr;
+	};
+
+
+#ifdef MOE_STD_SUPPORT
+	/**
+	 * \brief A string allocated in an arena, e.g. a temporary StringFormat buffer in a ScratchScope.
+	 */
+	template <typename CharT>
+	using BasicArenaString = std::basic_string<CharT, std::char_traits<CharT>, ArenaAllocator<CharT>>;
+
+	using ArenaString = BasicArenaString<char>;
+#endif // MOE_STD_SUPPORT
+}
@@ -0,0 +1,62 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+#include "Core/Containers/Vector/Vector.h"
+
+
+namespace moe
+{
+	/**
+	 * \brief Linear arenas for data that lives for one frame (visible lists, command payloads, uniform staging...).
+	 * There is one arena per frame in flight, used in turn : data allocated during a frame stays valid
+	 * until the same arena comes back, numFramesInFlight frames later (e.g. while the GPU may still read it).
+	 * Like LinearArena, it is owned by a single thread : other threads should use their scratch arena.
+	 */
+	class FrameArena
+	{
+	public:
+
+		explicit FrameArena(size_t capacityPerFrame, uint32_t numFramesInFlight = 2)
+		{
+			MOE_ASSERT(numFramesInFlight != 0);
+
+			m_arenas.Reserve(numFramesInFlight);
+			for (uint32_t iFrame = 0; iFrame < numFramesInFlight; ++iFrame)
+			{
+				m_arenas.EmplaceBack(std::make_unique<LinearArena>(capacityPerFrame));
+			}
+		}
+
+		/**
+		 * \brief Switches to the arena of the next frame, freeing everything that was allocated in it numFramesInFlight frames ago.
+		 */
+		void	BeginFrame()
+		{
+			m_currentFrame = (m_currentFrame + 1) % (uint32_t)m_arenas.Size();
+			m_arenas[m_currentFrame]->Reset();
+		}
+
+		[[nodiscard]] LinearArena&	Get() { return *m_arenas[m_currentFrame]; }
+
+		[[nodiscard]] void*	Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			return Get().Allocate(size, alignment);
+		}
+
+		template <typename T>
+		[[nodiscard]] T*	Allocate(size_t count = 1)
+		{
+			return Get().Allocate<T>(count);
+		}
+
+		[[nodiscard]] uint32_t	GetNumFramesInFlight() const { return (uint32_t)m_arenas.Size(); }
+
+	private:
+
+		Vector<std::unique_ptr<LinearArena>>	m_arenas;
+		uint32_t								m_currentFrame = 0;
+	};
+}
@@ -0,0 +1,198 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include <algorithm> // max
+#include <cstddef> // max_align_t
+#include <memory> // unique_ptr
+#include <utility> // exchange
+
+
+namespace moe
+{
+	/**
+	 * \brief A linear (bump) allocator in a fixed-size buffer, meant for short-lived data : a frame, a function, a job.
+	 * Allocation is a pointer bump, and memory is only given back all at once, by Reset or by rewinding to a marker.
+	 * Freeing the last allocation is the only individual free that reclaims memory (it lets a growing container reuse its space),
+	 * as long as it was made in the current ArenaScope : memory is never reclaimed below the marker the scope will rewind to.
+	 * When the buffer is full, Allocate returns nullptr instead of asserting : callers like ArenaAllocator fall back to the heap,
+	 * and the number of failed allocations tells the arena was sized too small.
+	 * It is not thread-safe : each thread should use its own (see GetThreadScratchArena).
+	 */
+	class LinearArena
+	{
+	public:
+
+		using Marker = size_t;
+
+		LinearArena() = default;
+
+		explicit LinearArena(size_t capacity) :
+			m_ownedBuffer(new byte_t[capacity]),
+			m_buffer(m_ownedBuffer.get()),
+			m_capacity(capacity)
+		{}
+
+		/**
+		 * \brief Allocates in a buffer the arena does not own : it must outlive the arena.
+		 */
+		LinearArena(void* buffer, size_t capacity) :
+			m_buffer(static_cast<byte_t*>(buffer)),
+			m_capacity(capacity)
+		{}
+
+		// Allocators keep a pointer to their arena : it can't be copied nor moved.
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+
+		/**
+		 * \return nullptr if there is not enough room left
+		 */
+		[[nodiscard]] void*	Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			MOE_DEBUG_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+			const uintptr_t current = reinterpret_cast<uintptr_t>(m_buffer) + m_used;
+			const size_t padding = (alignment - (current & (alignment - 1))) & (alignment - 1);
+
+			if (m_capacity - m_used < padding || m_capacity - m_used - padding < size)
+			{
+				m_numFailedAllocations++;
+				return nullptr;
+			}
+
+			byte_t* allocation = m_buffer + m_used + padding;
+			m_lastAllocation = m_used + padding;
+			m_used += padding + size;
+			m_peakUsed = std::max(m_peakUsed, m_used);
+
+			return allocation;
+		}
+
+		template <typename T>
+		[[nodiscard]] T*	Allocate(size_t count = 1)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		/**
+		 * \brief Only reclaims the memory if it was the last allocation : otherwise, it will come back with the next Reset or Rewind.
+		 */
+		void	Free(void* ptr, size_t size)
+		{
+			MOE_DEBUG_ASSERT(Owns(ptr));
+
+			const size_t offset = static_cast<byte_t*>(ptr) - m_buffer;
+			if (offset >= m_freeFloor && offset == m_lastAllocation && offset + size == m_used)
+			{
+				m_used = offset;
+			}
+		}
+
+		[[nodiscard]] Marker	GetMarker() const { return m_used; }
+
+		/**
+		 * \brief Frees everything allocated since the marker was taken.
+		 */
+		void	Rewind(Marker marker)
+		{
+			MOE_DEBUG_ASSERT(marker <= m_used);
+			m_used = marker;
+			m_lastAllocation = marker;
+		}
+
+		void	Reset() { Rewind(0); }
+
+		/**
+		 * \brief Keeps Free from reclaiming memory below this marker (what ArenaScope uses, so it never rewinds above the used size).
+		 * \return The previous floor, to restore when the scope ends
+		 */
+		Marker	SetFreeFloor(Marker floor) { return std::exchange(m_freeFloor, floor); }
+
+		[[nodiscard]] bool	Owns(const void* ptr) const
+		{
+			const byte_t* bytePtr = static_cast<const byte_t*>(ptr);
+			return (bytePtr >= m_buffer && bytePtr < m_buffer + m_capacity);
+		}
+
+		[[nodiscard]] size_t	GetCapacity() const { return m_capacity; }
+
+		[[nodiscard]] size_t	GetUsedSize() const { return m_used; }
+
+		/**
+		 * \brief The most memory ever used at once : what the capacity should be to never fail.
+		 */
+		[[nodiscard]] size_t	GetPeakUsedSize() const { return m_peakUsed; }
+
+		[[nodiscard]] uint32_t	GetNumFailedAllocations() const { return m_numFailedAllocations; }
+
+	private:
+
+		std::unique_ptr<byte_t[]>	m_ownedBuffer;
+
+		byte_t*		m_buffer = nullptr;
+		size_t		m_capacity = 0;
+		size_t		m_used = 0;
+		size_t		m_lastAllocation = 0;
+		size_t		m_freeFloor = 0;
+		size_t		m_peakUsed = 0;
+		uint32_t	m_numFailedAllocations = 0;
+	};
+
+
+	/**
+	 * \brief Makes an arena behave like a stack : everything allocated during the lifetime of the scope is freed at its end.
+	 * Scopes can be nested, but must be destroyed in reverse order of creation (which C++ scopes naturally do).
+	 */
+	class ArenaScope
+	{
+	public:
+
+		explicit ArenaScope(LinearArena& arena) :
+			m_arena(arena),
+			m_marker(arena.GetMarker()),
+			m_previousFreeFloor(arena.SetFreeFloor(m_marker))
+		{}
+
+		~ArenaScope()
+		{
+			m_arena.Rewind(m_marker);
+			m_arena.SetFreeFloor(m_previousFreeFloor);
+		}
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+		[[nodiscard]] LinearArena&	GetArena() { return m_arena; }
+
+	private:
+
+		LinearArena&		m_arena;
+		LinearArena::Marker	m_marker;
+		LinearArena::Marker	m_previousFreeFloor;
+	};
+
+
+	/**
+	 * \brief An arena with its buffer inline : declared as a local variable, temporary containers live entirely on the stack.
+	 * Keep the size reasonable, thread stacks are small.
+	 */
+	template <size_t Size>
+	class StackArena : public LinearArena
+	{
+	public:
+
+		StackArena() :
+			LinearArena(m_storage, Size)
+		{}
+
+	private:
+
+		alignas(std::max_align_t) byte_t	m_storage[Size];
+	};
+}
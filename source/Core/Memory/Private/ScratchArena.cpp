@@ -0,0 +1,13 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Core/Memory/ScratchArena.h"
+
+
+namespace moe
+{
+	LinearArena&	GetThreadScratchArena()
+	{
+		thread_local LinearArena scratchArena(SCRATCH_ARENA_CAPACITY);
+		return scratchArena;
+	}
+}
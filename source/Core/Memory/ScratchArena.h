@@ -0,0 +1,36 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+#include "Monocle_Core_Export.h"
+
+
+namespace moe
+{
+	/**
+	 * \brief The capacity of the scratch arena of each thread, allocated the first time the thread asks for it.
+	 */
+	static const size_t	SCRATCH_ARENA_CAPACITY = 256 * 1024;
+
+	/**
+	 * \brief Each thread has its own scratch arena, for temporary allocations that never leave the calling function or job.
+	 * Since no other thread ever touches it, allocating in it needs no synchronization.
+	 * Always allocate in it through a ScratchScope, so that the memory is given back when the scope ends.
+	 */
+	Monocle_Core_API LinearArena&	GetThreadScratchArena();
+
+
+	/**
+	 * \brief An ArenaScope in the scratch arena of the calling thread.
+	 */
+	class ScratchScope : public ArenaScope
+	{
+	public:
+
+		ScratchScope() :
+			ArenaScope(GetThreadScratchArena())
+		{}
+	};
+}
@@ -0,0 +1,59 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Core/Misc/moeMappedFile.h"
+
+#include <string>
+
+#include <fcntl.h>		// open
+#include <sys/mman.h>	// mmap
+#include <sys/stat.h>	// fstat
+#include <unistd.h>		// close
+
+// Linux version of the memory mapped file (using mmap)
+
+namespace moe
+{
+	bool MappedFile::Open(std::string_view fileName)
+	{
+		Close();
+
+		const std::string fileNameStr(fileName); // Make sure it is null-terminated
+		const int fd = ::open(fileNameStr.c_str(), O_RDONLY);
+		if (fd == -1)
+		{
+			return false;
+		}
+
+		struct stat fileStat;
+		if (::fstat(fd, &fileStat) == -1 || fileStat.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* mapping = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// The mapping keeps its own reference to the file.
+		::close(fd);
+
+		if (mapping == MAP_FAILED)
+		{
+			return false;
+		}
+
+		m_data = static_cast<const std::byte*>(mapping);
+		m_size = (size_t)fileStat.st_size;
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (m_data != nullptr)
+		{
+			::munmap(const_cast<std::byte*>(m_data), m_size);
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+}
@@ -0,0 +1,68 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Core/Misc/moeMappedFile.h"
+
+#include <string>
+
+#include <Windows.h>
+
+// Windows version of the memory mapped file (using a file mapping object)
+
+namespace moe
+{
+	bool MappedFile::Open(std::string_view fileName)
+	{
+		Close();
+
+		const std::string fileNameStr(fileName); // Make sure it is null-terminated
+		HANDLE file = ::CreateFileA(fileNameStr.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (::GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart == 0)
+		{
+			::CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			::CloseHandle(file);
+			return false;
+		}
+
+		const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			::CloseHandle(mapping);
+			::CloseHandle(file);
+			return false;
+		}
+
+		m_data = static_cast<const std::byte*>(view);
+		m_size = (size_t)fileSize.QuadPart;
+		m_fileHandle = file;
+		m_mappingHandle = mapping;
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (m_data != nullptr)
+		{
+			::UnmapViewOfFile(m_data);
+			::CloseHandle(m_mappingHandle);
+			::CloseHandle(m_fileHandle);
+
+			m_data = nullptr;
+			m_size = 0;
+			m_fileHandle = nullptr;
+			m_mappingHandle = nullptr;
+		}
+	}
+}
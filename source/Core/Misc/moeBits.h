@@ -0,0 +1,65 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Portable wrappers around the compiler's bit-scanning intrinsics.
+// All of them have an undefined result when given zero: check before calling.
+namespace moe
+{
+	/**
+	 * \brief Returns the index of the lowest set bit of a non-zero 64-bit value.
+	 */
+	inline uint32_t	CountTrailingZeros64(uint64_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return (uint32_t)index;
+#else
+		return (uint32_t)__builtin_ctzll(value);
+#endif
+	}
+
+
+	/**
+	 * \brief Returns the index of the highest set bit of a non-zero 64-bit value (that is, floor(log2(value))).
+	 */
+	inline uint32_t	FindLastSet64(uint64_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return (uint32_t)index;
+#else
+		return 63u - (uint32_t)__builtin_clzll(value);
+#endif
+	}
+
+
+	/**
+	 * \brief Returns the number of set bits in a 64-bit value.
+	 */
+	inline uint32_t	PopCount64(uint64_t value)
+	{
+#ifdef _MSC_VER
+		return (uint32_t)__popcnt64(value);
+#else
+		return (uint32_t)__builtin_popcountll(value);
+#endif
+	}
+
+
+	/**
+	 * \brief Rounds a non-zero value up to the next power of two's exponent (ceil(log2(value))).
+	 */
+	inline uint32_t	CeilLog2(uint64_t value)
+	{
+		return (value <= 1) ? 0 : FindLastSet64(value - 1) + 1;
+	}
+}
@@ -0,0 +1,96 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utility> // swap
+
+#include "Monocle_Core_Export.h"
+
+namespace moe
+{
+	/**
+	 * \brief A read-only memory mapping of a whole file.
+	 * The contents are paged in by the OS on first access, which makes it cheap to open big binary files
+	 * that are only partly read, or read once to be copied elsewhere (e.g. uploaded to the GPU).
+	 * The mapping stays valid until the file is closed or the MappedFile is destroyed.
+	 */
+	class MappedFile
+	{
+	public:
+
+		MappedFile() = default;
+
+		~MappedFile()
+		{
+			Close();
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+
+		/**
+		 * \brief Maps the file, closing the previously mapped one if any.
+		 * \return false if the file does not exist or could not be mapped. Empty files cannot be mapped.
+		 */
+		Monocle_Core_API bool	Open(std::string_view fileName);
+
+		Monocle_Core_API void	Close();
+
+
+		[[nodiscard]] bool				IsOpen() const { return m_data != nullptr; }
+
+		[[nodiscard]] const std::byte*	Data() const { return m_data; }
+
+		[[nodiscard]] size_t			Size() const { return m_size; }
+
+
+	private:
+
+		const std::byte*	m_data = nullptr;
+		size_t				m_size = 0;
+
+		#ifdef MOE_WINDOWS
+		void*				m_fileHandle = nullptr;
+		void*				m_mappingHandle = nullptr;
+		#endif
+	};
+
+
+	inline MappedFile::MappedFile(MappedFile&& other) noexcept :
+		m_data(other.m_data), m_size(other.m_size)
+		#ifdef MOE_WINDOWS
+		, m_fileHandle(other.m_fileHandle), m_mappingHandle(other.m_mappingHandle)
+		#endif
+	{
+		other.m_data = nullptr;
+		other.m_size = 0;
+		#ifdef MOE_WINDOWS
+		other.m_fileHandle = nullptr;
+		other.m_mappingHandle = nullptr;
+		#endif
+	}
+
+
+	inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+
+			std::swap(m_data, other.m_data);
+			std::swap(m_size, other.m_size);
+			#ifdef MOE_WINDOWS
+			std::swap(m_fileHandle, other.m_fileHandle);
+			std::swap(m_mappingHandle, other.m_mappingHandle);
+			#endif
+		}
+
+		return *this;
+	}
+}
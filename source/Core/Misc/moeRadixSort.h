@@ -0,0 +1,87 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <cstring> // memset
+#include <utility> // swap
+#endif
+
+namespace moe
+{
+	/**
+	 * \brief Stable LSD radix sort of values by a 64-bit key, one byte per pass.
+	 * The histograms of all the passes are built in a single read of the data, and the passes
+	 * where every key has the same byte (typically the unused high bits of the keys) are skipped.
+	 * \param values The values to sort. Sorted in place.
+	 * \param scratch A buffer of at least count elements, used as the ping-pong destination. Its contents are undefined afterwards.
+	 * \param count Number of values
+	 * \param getKey A function returning the uint64_t sort key of a value
+	 */
+	template <typename T, typename KeyFunction>
+	void	RadixSort64(T* values, T* scratch, size_t count, const KeyFunction& getKey)
+	{
+		static const uint32_t NUM_PASSES = 8;
+		static const uint32_t RADIX = 256;
+
+		if (count < 2)
+		{
+			return;
+		}
+
+		size_t histograms[NUM_PASSES][RADIX];
+		memset(histograms, 0, sizeof(histograms));
+
+		for (size_t iValue = 0; iValue < count; ++iValue)
+		{
+			const uint64_t key = getKey(values[iValue]);
+			for (uint32_t iPass = 0; iPass < NUM_PASSES; ++iPass)
+			{
+				histograms[iPass][(key >> (iPass * 8)) & 0xFF]++;
+			}
+		}
+
+		T* source = values;
+		T* dest = scratch;
+
+		for (uint32_t iPass = 0; iPass < NUM_PASSES; ++iPass)
+		{
+			size_t* histogram = histograms[iPass];
+
+			// If every key falls in the same bucket, this pass would not move anything.
+			const uint64_t firstDigit = (getKey(source[0]) >> (iPass * 8)) & 0xFF;
+			if (histogram[firstDigit] == count)
+			{
+				continue;
+			}
+
+			// Turn the counts into starting offsets
+			size_t offset = 0;
+			for (uint32_t iDigit = 0; iDigit < RADIX; ++iDigit)
+			{
+				const size_t digitCount = histogram[iDigit];
+				histogram[iDigit] = offset;
+				offset += digitCount;
+			}
+
+			for (size_t iValue = 0; iValue < count; ++iValue)
+			{
+				const uint64_t digit = (getKey(source[iValue]) >> (iPass * 8)) & 0xFF;
+				dest[histogram[digit]++] = std::move(source[iValue]);
+			}
+
+			std::swap(source, dest);
+		}
+
+		// After an odd number of passes, the sorted data lives in the scratch buffer.
+		if (source != values)
+		{
+			for (size_t iValue = 0; iValue < count; ++iValue)
+			{
+				values[iValue] = std::move(source[iValue]);
+			}
+		}
+	}
+}
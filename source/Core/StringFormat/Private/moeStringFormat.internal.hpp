@@ -61,11 +61,12 @@ namespace moe
 
 #ifdef MOE_STD_SUPPORT
 
-    template <typename CharT>
-    class StringFormatBuffer<std::basic_string<CharT>>
+    // Works with any std::basic_string, so temporary buffers can use another allocator (e.g. an ArenaString).
+    template <typename CharT, typename Traits, typename Alloc>
+    class StringFormatBuffer<std::basic_string<CharT, Traits, Alloc>>
     {
     public:
-        StringFormatBuffer(std::basic_string<CharT>& buf) : m_buf(buf) {}
+        StringFormatBuffer(std::basic_string<CharT, Traits, Alloc>& buf) : m_buf(buf) {}
 
         std::size_t Size() const
         {
@@ -83,7 +84,7 @@ namespace moe
         }
 
     private:
-        std::basic_string<CharT>& m_buf;
+        std::basic_string<CharT, Traits, Alloc>& m_buf;
     };
 #endif // MOE_STD_SUPPORT
 
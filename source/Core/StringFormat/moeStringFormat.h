@@ -13,8 +13,8 @@ namespace moe
     #ifdef MOE_STD_SUPPORT
     // If std is supported, provide convenient specializations for StringFormat to work with std::string "out of the box".
     // This specialization has to be put BEFORE the more generic template because GCC takes the first one that fits
-    template <typename CharT>
-    const CharT * StringFormatArg(const std::basic_string<CharT> & stringArg)
+    template <typename CharT, typename Traits, typename Alloc>
+    const CharT * StringFormatArg(const std::basic_string<CharT, Traits, Alloc> & stringArg)
     {
       return stringArg.c_str();
     }
@@ -29,8 +29,12 @@ set(Monocle_Graphics_SOURCES
 ./DepthStencilState/StencilOps.h
 ./DepthStencilState/StencilOpsDescriptor.h
 ./Device/GraphicsDevice.h
+./Device/Null/NullGraphicsDevice.cpp
+./Device/Null/NullGraphicsDevice.h
 ./Device/OpenGL/OpenGLGraphicsDevice.cpp
 ./Device/OpenGL/OpenGLGraphicsDevice.h
+./Device/OpenGL/OpenGLStateCache.cpp
+./Device/OpenGL/OpenGLStateCache.h
 ./DeviceBuffer/BufferDescription.h
 ./DeviceBuffer/BufferUsage.cpp
 ./DeviceBuffer/BufferUsage.h
@@ -49,9 +53,17 @@ set(Monocle_Graphics_SOURCES
 ./Framebuffer/FramebufferHandle.h
 ./Framebuffer/OpenGL/OpenGLFramebuffer.cpp
 ./Framebuffer/OpenGL/OpenGLFramebuffer.h
+./GraphicsAllocator/BuddyAllocator.cpp
+./GraphicsAllocator/BuddyAllocator.h
 ./GraphicsAllocator/OpenGL/OpenGLBuddyAllocator.cpp
 ./GraphicsAllocator/OpenGL/OpenGLBuddyAllocator.h
+./GraphicsAllocator/OpenGL/OpenGLBufferPool.cpp
+./GraphicsAllocator/OpenGL/OpenGLBufferPool.h
+./GraphicsAllocator/OpenGL/OpenGLStreamingRingBuffer.cpp
+./GraphicsAllocator/OpenGL/OpenGLStreamingRingBuffer.h
 ./Handle/ObjectHandle.h
+./Light/LightClusters.cpp
+./Light/LightClusters.h
 ./Light/LightObject.cpp
 ./Light/LightObject.h
 ./Light/LightSystem.cpp
@@ -77,6 +89,8 @@ set(Monocle_Graphics_SOURCES
 ./Mesh/OpenGL/OpenGLMesh.h
 ./Model/Model.cpp
 ./Model/Model.h
+./Model/ModelCache.cpp
+./Model/ModelCache.h
 ./OpenGL/moeOpenGL.h
 ./OpenGL/Std140.h
 ./Pipeline/OpenGL/OpenGLPipeline.cpp
@@ -86,10 +100,15 @@ set(Monocle_Graphics_SOURCES
 ./RasterizerState/RasterizerStateDescriptor.h
 ./Renderer/AbstractRenderer/AbstractRenderer.cpp
 ./Renderer/AbstractRenderer/AbstractRenderer.h
+./Renderer/Null/NullRenderer.cpp
+./Renderer/Null/NullRenderer.h
 ./Renderer/OpenGL/OpenGLRenderer.cpp
 ./Renderer/OpenGL/OpenGLRenderer.h
 ./Renderer/Renderer.h
 ./Renderer/RendererDescriptor.h
+./RenderQueue/RenderKey.h
+./RenderQueue/RenderQueue.cpp
+./RenderQueue/RenderQueue.h
 ./RenderTarget/RenderTargetHandle.h
 ./RenderWorld/GraphicsObject.cpp
 ./RenderWorld/GraphicsObject.h
@@ -100,6 +119,8 @@ set(Monocle_Graphics_SOURCES
 ./ResourceFactory/OpenGLResourceFactory/OpenGLResourceFactory.cpp
 ./ResourceFactory/OpenGLResourceFactory/OpenGLResourceFactory.h
 ./ResourceFactory/ResourceFactory.h
+./ResourceManager/GraphicsResourceManager.cpp
+./ResourceManager/GraphicsResourceManager.h
 ./Resources/ResourceLayout/ResourceKind.h
 ./Resources/ResourceLayout/ResourceLayoutBindingDescriptor.h
 ./Resources/ResourceLayout/ResourceLayoutDescriptor.h
@@ -126,6 +147,7 @@ set(Monocle_Graphics_SOURCES
 ./Resources/shaders/OpenGL/bloom_light_box.frag
 ./Resources/shaders/OpenGL/brdf_lut.frag
 ./Resources/shaders/OpenGL/brdf_lut.vert
+./Resources/shaders/OpenGL/clustered_blinn_phong.frag
 ./Resources/shaders/OpenGL/cubemaps.frag
 ./Resources/shaders/OpenGL/cubemaps.vert
 ./Resources/shaders/OpenGL/deferred_gbuffer.frag
@@ -204,7 +226,11 @@ set(Monocle_Graphics_SOURCES
 ./SceneGraph/SceneNode.cpp
 ./SceneGraph/SceneNode.h
 ./SceneGraph/SceneNodeHandle.h
+./SceneGraph/SceneTransforms.cpp
+./SceneGraph/SceneTransforms.h
 ./Shader/Handle/ShaderHandle.h
+./Shader/Manager/OpenGL/OpenGLProgramBinaryCache.cpp
+./Shader/Manager/OpenGL/OpenGLProgramBinaryCache.h
 ./Shader/Manager/OpenGL/OpenGLShaderManager.cpp
 ./Shader/Manager/OpenGL/OpenGLShaderManager.h
 ./Shader/Module/ShaderModuleDescriptor.h
@@ -223,12 +249,15 @@ set(Monocle_Graphics_SOURCES
 ./Swapchain/SwapchainHandle.h
 ./Texture/OpenGL/OpenGLTextureFormat.cpp
 ./Texture/OpenGL/OpenGLTextureFormat.h
+./Texture/OpenGL/OpenGLTextureStreamer.cpp
+./Texture/OpenGL/OpenGLTextureStreamer.h
 ./Texture/Texture.h
 ./Texture/Texture2DHandle.h
 ./Texture/TextureDescription.h
 ./Texture/TextureFormat.cpp
 ./Texture/TextureFormat.h
 ./Texture/TextureHandle.h
+./Texture/TextureLoadState.h
 ./Texture/TextureUsage.h
 ./Texture/TextureView.h
 ./Texture/TextureViewDescription.h
@@ -8,6 +8,7 @@ namespace moe
 {
 	Camera::Camera(RenderWorld* world, const GraphicObjectData& data, ViewportHandle vpHandle, const OrthographicCameraDesc& orthoDesc, const Transform& transf) :
 		AGraphicObject(world, data, transf),
+		m_matricesDataPtr(&m_matrices), // Render world cameras are not part of a camera system : they own their matrices
 		m_cameraData(orthoDesc),
 		m_viewportHandle(vpHandle),
 		m_projectionType {CameraProjection::Orthographic}
@@ -17,6 +18,7 @@ namespace moe
 
 	Camera::Camera(RenderWorld* world, const GraphicObjectData& data, ViewportHandle vpHandle, const PerspectiveCameraDesc& perspecDesc, const Transform& transf) :
 		AGraphicObject(world, data, transf),
+		m_matricesDataPtr(&m_matrices), // Render world cameras are not part of a camera system : they own their matrices
 		m_cameraData(perspecDesc),
 		m_viewportHandle(vpHandle),
 		m_projectionType{ CameraProjection::Perspective }
@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "Core/Containers/FreeList/Freelist.h"
+#include "Core/Containers/FreeList/PagedFreelist.h"
 
 #include "Camera.h"
 
@@ -30,7 +30,7 @@ namespace moe
 
 
 	private:
-		Freelist<Camera>	m_cameras;
+		PagedFreelist<Camera>	m_cameras;
 	};
 
 }
@@ -21,6 +21,7 @@
 #include "Graphics/Texture/TextureHandle.h"
 #include "Graphics/Texture/Texture2DHandle.h"
 #include "Graphics/Texture/TextureDescription.h"
+#include "Graphics/Texture/TextureLoadState.h"
 
 #include "Graphics/Pipeline/PipelineDescriptor.h"
 #include "Graphics/Pipeline/PipelineHandle.h"
@@ -91,11 +92,35 @@ namespace moe
 
 		virtual void	BindUniformBlock(unsigned int uniformBlockBinding, DeviceBufferHandle ubHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) = 0;
 
+		/**
+		 * \brief Copies uniform data that changes every draw into transient GPU memory, only valid until the end of the frame.
+		 * Cheaper than UpdateBuffer on a dedicated buffer, as no driver call is made per update.
+		 * \return A handle to bind with BindUniformBlock (passing the data size), or a null handle if this frame's streaming memory is exhausted.
+		 */
+		[[nodiscard]] virtual DeviceBufferHandle	StreamUniformData(const void* data, uint32_t dataSizeBytes) = 0;
+
+		/**
+		 * \brief Tells the device a frame is over (i.e. all draws reading the streamed data of this frame were submitted).
+		 */
+		virtual void	EndFrame() = 0;
+
 		[[nodiscard]] virtual ViewportHandle	CreateViewport(const ViewportDescriptor& vpDesc) = 0;
 		virtual void	UseViewport(ViewportHandle vpHandle) = 0;
 
 		[[nodiscard]] virtual DeviceBufferHandle	CreateUniformBuffer(const void* uniformData, size_t uniformDataSizeBytes) = 0;
 
+		virtual void	DeleteUniformBuffer(DeviceBufferHandle ubHandle) = 0;
+
+		/**
+		 * \brief Creates a shader storage buffer : unlike uniform buffers, storage buffers can be as big as needed and are sized at runtime by shaders.
+		 * The buffer can be updated with UpdateBuffer.
+		 */
+		[[nodiscard]] virtual DeviceBufferHandle	CreateStorageBuffer(const void* storageData, size_t storageDataSizeBytes) = 0;
+
+		virtual void	DeleteStorageBuffer(DeviceBufferHandle ssboHandle) = 0;
+
+		virtual void	BindStorageBuffer(unsigned int storageBinding, DeviceBufferHandle ssboHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) = 0;
+
 		[[nodiscard]] virtual ResourceLayoutHandle	CreateResourceLayout(const ResourceLayoutDescriptor& newDesc) = 0;
 
 		[[nodiscard]] virtual ResourceSetHandle		CreateResourceSet(const ResourceSetDescriptor& newDesc) = 0;
@@ -115,6 +140,20 @@ namespace moe
 
 		[[nodiscard]] virtual TextureHandle	CreateCubemapTexture(const CubeMapTextureDescriptor& cubemapDesc) = 0;
 
+		/**
+		 * \brief Creates a texture right away, but reads and uploads the file(s) in the background over the next frames.
+		 * The texture can be used immediately : a placeholder is bound instead until it is Ready.
+		 * \param onLoaded Optional, called from EndFrame when the load succeeded or failed
+		 */
+		[[nodiscard]] virtual Texture2DHandle	CreateTexture2DAsync(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded = nullptr) = 0;
+
+		[[nodiscard]] virtual TextureHandle	CreateCubemapTextureAsync(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded = nullptr) = 0;
+
+		/**
+		 * \brief Textures that were not created asynchronously are always Ready.
+		 */
+		[[nodiscard]] virtual TextureLoadState	GetTextureLoadState(TextureHandle texHandle) const = 0;
+
 		virtual void	GenerateTextureMipmaps(TextureHandle texHandle) = 0;
 
 		virtual void	DestroyTexture2D(Texture2DHandle textureHandle) = 0;
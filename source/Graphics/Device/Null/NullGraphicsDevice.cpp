@@ -0,0 +1,782 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "NullGraphicsDevice.h"
+
+namespace moe
+{
+	NullGraphicsDevice::CommandScope::CommandScope(const NullGraphicsDevice& device, NullDeviceCommand command, uint64_t handle, uint64_t size) :
+		m_device(device),
+		m_command(command),
+		m_start(std::chrono::steady_clock::now())
+	{
+		m_device.m_stats.m_calls[(size_t)command]++;
+
+		if (m_device.m_recordCommands)
+		{
+			m_device.m_recordedCommands.PushBack({ command, handle, size, m_device.GetFrameTimestampNs() });
+		}
+	}
+
+
+	NullGraphicsDevice::CommandScope::~CommandScope()
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - m_start;
+		m_device.m_stats.m_callTimesNs[(size_t)m_command] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	}
+
+
+	void NullGraphicsDevice::NullFramebuffer::Bind()
+	{
+		CommandScope scope(*m_device, NullDeviceCommand::BindFramebuffer, m_handle.Get());
+	}
+
+
+	void NullGraphicsDevice::NullFramebuffer::Unbind()
+	{
+		// Unbinding is binding the default framebuffer.
+		CommandScope scope(*m_device, NullDeviceCommand::BindFramebuffer, 0);
+	}
+
+
+	void NullGraphicsDevice::Initialize()
+	{
+		Destroy();
+
+		// Like the OpenGL device, stream uniform data in a buffer of its own.
+		m_streamBufferID = DecodeBufferHandle(AddBuffer(nullptr, ms_STREAM_BUFFER_SIZE, UniformUsage)).first;
+
+		m_frameStart = std::chrono::steady_clock::now();
+	}
+
+
+	void NullGraphicsDevice::Destroy()
+	{
+		m_shaderPrograms.Clear();
+		// Start over from fresh free lists : layouts and framebuffers are never removed, so their IDs all keep the first generation.
+		m_vertexLayouts = PagedFreelist<VertexLayout>();
+		m_buffers.Clear();
+		m_viewports.Clear();
+		m_resourceLayouts.Clear();
+		m_resourceSets.Clear();
+		m_textures.Clear();
+		m_textureLoadCallbacks.Clear();
+		m_numPipelines = 0;
+		m_framebuffers = PagedFreelist<NullFramebuffer>();
+		m_numSamplers = 0;
+
+		m_streamBufferID = 0;
+		m_streamOffset = 0;
+
+		m_recordedCommands.Clear();
+	}
+
+
+	ShaderProgramHandle NullGraphicsDevice::CreateShaderProgramFromSource(const ShaderProgramDescriptor& shaProDesc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateShaderProgram);
+
+		if (!MOE_ASSERT(shaProDesc.Count() != 0))
+			return ShaderProgramHandle::Null();
+
+		m_shaderPrograms.PushBack(true);
+		return ShaderProgramHandle{ (ShaderProgramHandle::Underlying) m_shaderPrograms.Size() };
+	}
+
+
+	ShaderProgramHandle NullGraphicsDevice::CreateShaderProgramFromBinary(const ShaderProgramDescriptor& shaProDesc)
+	{
+		return CreateShaderProgramFromSource(shaProDesc);
+	}
+
+
+	bool NullGraphicsDevice::RemoveShaderProgram(ShaderProgramHandle programHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::RemoveShaderProgram, programHandle.Get());
+
+		if (!IsValidShaderProgram(programHandle))
+			return ReportInvalidHandle(NullDeviceCommand::RemoveShaderProgram);
+
+		m_shaderPrograms[programHandle.Get() - 1] = false;
+		return true;
+	}
+
+
+	void NullGraphicsDevice::UseShaderProgram(ShaderProgramHandle programHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::UseShaderProgram, programHandle.Get());
+
+		if (!IsValidShaderProgram(programHandle))
+			ReportInvalidHandle(NullDeviceCommand::UseShaderProgram);
+	}
+
+
+	uint32_t NullGraphicsDevice::GetShaderProgramUniformBlockSize(ShaderProgramHandle shaderHandle, const std::string& /*uniformBlockName*/)
+	{
+		if (!IsValidShaderProgram(shaderHandle))
+			ReportInvalidHandle(NullDeviceCommand::UseShaderProgram);
+
+		return 0;
+	}
+
+
+	bool NullGraphicsDevice::IsPartOfUniformBlock(ShaderProgramHandle shaderHandle, const std::string& /*uniformBlockName*/, const std::string& /*uniformMemberName*/) const
+	{
+		if (!IsValidShaderProgram(shaderHandle))
+			ReportInvalidHandle(NullDeviceCommand::UseShaderProgram);
+
+		return false;
+	}
+
+
+	void NullGraphicsDevice::UpdateUniformBlockVariable(ShaderProgramHandle program, DeviceBufferHandle targetBlockBuffer, const std::string& /*variableName*/,
+		const void* /*data*/, size_t dataSizeBytes)
+	{
+		CommandScope scope(*this, NullDeviceCommand::UpdateUniformBlockVariable, targetBlockBuffer.Get(), dataSizeBytes);
+
+		if (!IsValidShaderProgram(program) || !IsValidBuffer(targetBlockBuffer, UniformUsage, dataSizeBytes))
+		{
+			ReportInvalidHandle(NullDeviceCommand::UpdateUniformBlockVariable);
+			return;
+		}
+
+		m_stats.m_uploadedBytes += dataSizeBytes;
+	}
+
+
+	VertexLayoutHandle NullGraphicsDevice::CreateVertexLayout(const VertexLayoutDescriptor& desc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateVertexLayout);
+
+		// Like the OpenGL device, give out the same handle for identical layouts.
+		for (uint32_t iLayout = 0; iLayout < m_vertexLayouts.Size(); ++iLayout)
+		{
+			if (m_vertexLayouts.Lookup(FreelistID{ iLayout }).ReadDescriptor() == desc)
+			{
+				return FreelistID{ iLayout }.ToHandle<VertexLayoutHandle>();
+			}
+		}
+
+		return m_vertexLayouts.Add(desc).ToHandle<VertexLayoutHandle>();
+	}
+
+
+	VertexLayoutHandle NullGraphicsDevice::CreateVertexLayout(InstancedVertexLayoutDescriptor desc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateVertexLayout);
+
+		return m_vertexLayouts.Add(std::move(desc)).ToHandle<VertexLayoutHandle>();
+	}
+
+
+	const VertexLayout* NullGraphicsDevice::GetVertexLayout(VertexLayoutHandle handle) const
+	{
+		if (IsValidVertexLayout(handle))
+		{
+			return &m_vertexLayouts.Lookup(FreelistID{ handle.Get() - 1 });
+		}
+
+		return nullptr;
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::CreateStaticVertexBuffer(const void* data, size_t dataSize)
+	{
+		return AddBuffer(data, dataSize, VertexUsage);
+	}
+
+
+	void NullGraphicsDevice::DeleteStaticVertexBuffer(DeviceBufferHandle vtxHandle)
+	{
+		RemoveBuffer(vtxHandle, VertexUsage);
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::CreateIndexBuffer(const void* indexData, size_t indexDataSizeBytes)
+	{
+		return AddBuffer(indexData, indexDataSizeBytes, IndexUsage);
+	}
+
+
+	void NullGraphicsDevice::DeleteIndexBuffer(DeviceBufferHandle idxHandle)
+	{
+		RemoveBuffer(idxHandle, IndexUsage);
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::CreateUniformBuffer(const void* uniformData, size_t uniformDataSizeBytes)
+	{
+		return AddBuffer(uniformData, uniformDataSizeBytes, UniformUsage);
+	}
+
+
+	void NullGraphicsDevice::DeleteUniformBuffer(DeviceBufferHandle ubHandle)
+	{
+		RemoveBuffer(ubHandle, UniformUsage);
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::CreateStorageBuffer(const void* storageData, size_t storageDataSizeBytes)
+	{
+		return AddBuffer(storageData, storageDataSizeBytes, StorageUsage);
+	}
+
+
+	void NullGraphicsDevice::DeleteStorageBuffer(DeviceBufferHandle ssboHandle)
+	{
+		RemoveBuffer(ssboHandle, StorageUsage);
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::CreateMultiUsageBuffer(size_t dataSizeBytes)
+	{
+		return AddBuffer(nullptr, dataSizeBytes, AnyUsage);
+	}
+
+
+	void NullGraphicsDevice::DeleteBuffer(DeviceBufferHandle bufferHandle)
+	{
+		RemoveBuffer(bufferHandle, AnyUsage);
+	}
+
+
+	void NullGraphicsDevice::CopyBuffer(DeviceBufferHandle from, uint32_t fromSizeBytes, DeviceBufferHandle to)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CopyBuffer, to.Get(), fromSizeBytes);
+
+		if (!IsValidBuffer(from, AnyUsage, fromSizeBytes) || !IsValidBuffer(to, AnyUsage, fromSizeBytes))
+		{
+			ReportInvalidHandle(NullDeviceCommand::CopyBuffer);
+		}
+	}
+
+
+	void NullGraphicsDevice::DrawVertexBuffer(VertexLayoutHandle vtxLayoutHandle, DeviceBufferHandle vtxBufHandle, size_t numVertices,
+		DeviceBufferHandle idxBufHandle, size_t numIndices)
+	{
+		const size_t drawnVertices = (numIndices != 0 ? numIndices : numVertices);
+
+		CommandScope scope(*this, NullDeviceCommand::DrawVertexBuffer, vtxBufHandle.Get(), drawnVertices);
+
+		if (!IsValidVertexLayout(vtxLayoutHandle) || !IsValidBuffer(vtxBufHandle, VertexUsage)
+			|| (idxBufHandle.IsNotNull() && !IsValidBuffer(idxBufHandle, IndexUsage)))
+		{
+			ReportInvalidHandle(NullDeviceCommand::DrawVertexBuffer);
+			return;
+		}
+
+		m_stats.m_drawnVertices += drawnVertices;
+	}
+
+
+	void NullGraphicsDevice::DrawInstancedMesh(VertexLayoutHandle vtxLayoutHandle, DeviceBufferHandle vtxBufHandle, size_t numVertices,
+		DeviceBufferHandle idxBufHandle, size_t numIndices, DeviceBufferHandle instancingBuffer, uint32_t instancesAmount)
+	{
+		const size_t drawnVertices = (numIndices != 0 ? numIndices : numVertices) * instancesAmount;
+
+		CommandScope scope(*this, NullDeviceCommand::DrawInstancedMesh, vtxBufHandle.Get(), drawnVertices);
+
+		if (!IsValidVertexLayout(vtxLayoutHandle) || !IsValidBuffer(vtxBufHandle, VertexUsage)
+			|| (idxBufHandle.IsNotNull() && !IsValidBuffer(idxBufHandle, IndexUsage))
+			|| !IsValidBuffer(instancingBuffer, VertexUsage))
+		{
+			ReportInvalidHandle(NullDeviceCommand::DrawInstancedMesh);
+			return;
+		}
+
+		m_stats.m_drawnVertices += drawnVertices;
+	}
+
+
+	void NullGraphicsDevice::UpdateBuffer(DeviceBufferHandle bufferHandle, const void* /*data*/, size_t dataSize) const
+	{
+		CommandScope scope(*this, NullDeviceCommand::UpdateBuffer, bufferHandle.Get(), dataSize);
+
+		if (!IsValidBuffer(bufferHandle, AnyUsage, dataSize))
+		{
+			ReportInvalidHandle(NullDeviceCommand::UpdateBuffer);
+			return;
+		}
+
+		m_stats.m_uploadedBytes += dataSize;
+	}
+
+
+	void NullGraphicsDevice::BindUniformBlock(unsigned int /*uniformBlockBinding*/, DeviceBufferHandle ubHandle, uint32_t bufferSize, uint32_t relativeOffset)
+	{
+		CommandScope scope(*this, NullDeviceCommand::BindUniformBlock, ubHandle.Get(), bufferSize);
+
+		const DeviceBufferHandle boundHandle{ ubHandle.Get() + relativeOffset };
+		if (!IsValidBuffer(boundHandle, UniformUsage, bufferSize))
+		{
+			ReportInvalidHandle(NullDeviceCommand::BindUniformBlock);
+		}
+	}
+
+
+	void NullGraphicsDevice::BindStorageBuffer(unsigned int /*storageBinding*/, DeviceBufferHandle ssboHandle, uint32_t bufferSize, uint32_t relativeOffset)
+	{
+		CommandScope scope(*this, NullDeviceCommand::BindStorageBuffer, ssboHandle.Get(), bufferSize);
+
+		const DeviceBufferHandle boundHandle{ ssboHandle.Get() + relativeOffset };
+		if (!IsValidBuffer(boundHandle, StorageUsage, bufferSize))
+		{
+			ReportInvalidHandle(NullDeviceCommand::BindStorageBuffer);
+		}
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::StreamUniformData(const void* /*data*/, uint32_t dataSizeBytes)
+	{
+		CommandScope scope(*this, NullDeviceCommand::StreamUniformData, 0, dataSizeBytes);
+
+		if (m_streamBufferID == 0 || m_streamOffset + dataSizeBytes > ms_STREAM_BUFFER_SIZE)
+			return DeviceBufferHandle::Null();
+
+		const DeviceBufferHandle streamedHandle = EncodeBufferHandle(m_streamBufferID, m_streamOffset);
+
+		m_streamOffset += (dataSizeBytes + ms_STREAM_ALIGNMENT - 1) & ~(ms_STREAM_ALIGNMENT - 1);
+		m_stats.m_streamedBytes += dataSizeBytes;
+
+		return streamedHandle;
+	}
+
+
+	void NullGraphicsDevice::EndFrame()
+	{
+		{
+			CommandScope scope(*this, NullDeviceCommand::EndFrame);
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		const uint64_t frameTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_frameStart).count();
+
+		m_stats.m_frames++;
+		m_stats.m_lastFrameTimeNs = frameTimeNs;
+		m_stats.m_totalFrameTimeNs += frameTimeNs;
+
+		m_frameStart = now;
+		m_streamOffset = 0;
+
+		if (!m_textureLoadCallbacks.Empty())
+		{
+			// Callbacks may create other textures.
+			Vector<std::pair<TextureHandle, TextureLoadCallback>> callbacks;
+			std::swap(callbacks, m_textureLoadCallbacks);
+
+			for (auto& [texHandle, onLoaded] : callbacks)
+			{
+				// Like on other devices, destroying a texture cancels its load.
+				if (IsValidTexture(texHandle))
+				{
+					onLoaded(texHandle, TextureLoadState::Ready);
+				}
+			}
+		}
+	}
+
+
+	ViewportHandle NullGraphicsDevice::CreateViewport(const ViewportDescriptor& vpDesc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateViewport);
+
+		if (!MOE_ASSERT(m_viewports.Size() < UINT8_MAX))
+			return ViewportHandle::Null();
+
+		m_viewports.PushBack(vpDesc);
+		return ViewportHandle{ (ViewportHandle::Underlying) m_viewports.Size() };
+	}
+
+
+	void NullGraphicsDevice::UseViewport(ViewportHandle vpHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::UseViewport, vpHandle.Get());
+
+		if (vpHandle.IsNull() || vpHandle.Get() > m_viewports.Size())
+		{
+			ReportInvalidHandle(NullDeviceCommand::UseViewport);
+		}
+	}
+
+
+	ResourceLayoutHandle NullGraphicsDevice::CreateResourceLayout(const ResourceLayoutDescriptor& newDesc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateResourceLayout);
+
+		m_resourceLayouts.PushBack(newDesc);
+		return ResourceLayoutHandle{ (ResourceLayoutHandle::Underlying) m_resourceLayouts.Size() };
+	}
+
+
+	ResourceSetHandle NullGraphicsDevice::CreateResourceSet(const ResourceSetDescriptor& newDesc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateResourceSet);
+
+		if (!IsValidResourceLayout(newDesc.GetResourceLayoutHandle()))
+		{
+			ReportInvalidHandle(NullDeviceCommand::CreateResourceSet);
+			return ResourceSetHandle::Null();
+		}
+
+		m_resourceSets.PushBack(newDesc);
+		return ResourceSetHandle{ (ResourceSetHandle::Underlying) m_resourceSets.Size() };
+	}
+
+
+	const ResourceLayoutDescriptor& NullGraphicsDevice::GetResourceLayoutDescriptor(ResourceLayoutHandle layoutHandle) const
+	{
+		MOE_ASSERT(IsValidResourceLayout(layoutHandle));
+		return m_resourceLayouts[layoutHandle.Get() - 1];
+	}
+
+
+	const ResourceSetDescriptor& NullGraphicsDevice::GetResourceSetDescriptor(ResourceSetHandle setHandle) const
+	{
+		MOE_ASSERT(IsValidResourceSet(setHandle));
+		return m_resourceSets[setHandle.Get() - 1];
+	}
+
+
+	void NullGraphicsDevice::UpdateResourceSetDescriptor(ResourceSetHandle rscSetHandle, uint32_t resourceIdx, ResourceHandle newResource)
+	{
+		CommandScope scope(*this, NullDeviceCommand::UpdateResourceSet, rscSetHandle.Get());
+
+		if (!IsValidResourceSet(rscSetHandle))
+		{
+			ReportInvalidHandle(NullDeviceCommand::UpdateResourceSet);
+			return;
+		}
+
+		m_resourceSets[rscSetHandle.Get() - 1].Update(resourceIdx, newResource);
+	}
+
+
+	Texture2DHandle NullGraphicsDevice::CreateTexture2D(const Texture2DDescriptor& /*tex2DDesc*/)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateTexture);
+
+		m_textures.PushBack(true);
+
+		Texture2DHandle texHandle;
+		texHandle.m_handle = (Texture2DHandle::Underlying) m_textures.Size();
+		return texHandle;
+	}
+
+
+	Texture2DHandle NullGraphicsDevice::CreateTexture2D(const Texture2DFileDescriptor& /*tex2DFileDesc*/)
+	{
+		return CreateTexture2D(Texture2DDescriptor());
+	}
+
+
+	TextureHandle NullGraphicsDevice::CreateCubemapTexture(const CubeMapTextureFilesDescriptor& /*cubemapFilesDesc*/)
+	{
+		return CreateTexture2D(Texture2DDescriptor());
+	}
+
+
+	TextureHandle NullGraphicsDevice::CreateCubemapTexture(const CubeMapTextureDescriptor& /*cubemapDesc*/)
+	{
+		return CreateTexture2D(Texture2DDescriptor());
+	}
+
+
+	Texture2DHandle NullGraphicsDevice::CreateTexture2DAsync(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded)
+	{
+		Texture2DHandle texHandle = CreateTexture2D(tex2DFileDesc);
+
+		if (onLoaded)
+		{
+			m_textureLoadCallbacks.EmplaceBack(texHandle, std::move(onLoaded));
+		}
+
+		return texHandle;
+	}
+
+
+	TextureHandle NullGraphicsDevice::CreateCubemapTextureAsync(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded)
+	{
+		TextureHandle texHandle = CreateCubemapTexture(cubemapFilesDesc);
+
+		if (onLoaded)
+		{
+			m_textureLoadCallbacks.EmplaceBack(texHandle, std::move(onLoaded));
+		}
+
+		return texHandle;
+	}
+
+
+	TextureLoadState NullGraphicsDevice::GetTextureLoadState(TextureHandle texHandle) const
+	{
+		return (IsValidTexture(texHandle) ? TextureLoadState::Ready : TextureLoadState::Failed);
+	}
+
+
+	void NullGraphicsDevice::GenerateTextureMipmaps(TextureHandle texHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::GenerateTextureMipmaps, texHandle.Get());
+
+		if (!IsValidTexture(texHandle))
+		{
+			ReportInvalidHandle(NullDeviceCommand::GenerateTextureMipmaps);
+		}
+	}
+
+
+	void NullGraphicsDevice::DestroyTexture2D(Texture2DHandle textureHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::DestroyTexture, textureHandle.Get());
+
+		if (!IsValidTexture(textureHandle))
+		{
+			ReportInvalidHandle(NullDeviceCommand::DestroyTexture);
+			return;
+		}
+
+		m_textures[textureHandle.Get() - 1] = false;
+	}
+
+
+	void NullGraphicsDevice::BindTextureUnit(int /*textureBindingPoint*/, TextureHandle texHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::BindTextureUnit, texHandle.Get());
+
+		if (!IsValidTexture(texHandle))
+		{
+			ReportInvalidHandle(NullDeviceCommand::BindTextureUnit);
+		}
+	}
+
+
+	PipelineHandle NullGraphicsDevice::CreatePipeline(PipelineDescriptor& /*pipelineDesc*/)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreatePipeline);
+
+		return PipelineHandle{ ++m_numPipelines };
+	}
+
+
+	void NullGraphicsDevice::SetPipeline(PipelineHandle pipeHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::SetPipeline, pipeHandle.Get());
+
+		if (pipeHandle.IsNull() || pipeHandle.Get() > m_numPipelines)
+		{
+			ReportInvalidHandle(NullDeviceCommand::SetPipeline);
+		}
+	}
+
+
+	SwapchainHandle NullGraphicsDevice::CreateSwapChain(uint32_t /*renderWidth*/, uint32_t /*renderHeight*/, FramebufferAttachment /*wantedAttachments*/)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateSwapchain);
+
+		// Like the OpenGL device, there is only one swap chain.
+		return SwapchainHandle{ 1 };
+	}
+
+
+	FramebufferHandle NullGraphicsDevice::CreateFramebuffer(const FramebufferDescriptor& fbDesc)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateFramebuffer);
+
+		for (Texture2DHandle colorAttachment : fbDesc.m_colorAttachments)
+		{
+			if (!IsValidTexture(colorAttachment))
+			{
+				ReportInvalidHandle(NullDeviceCommand::CreateFramebuffer);
+				return FramebufferHandle::Null();
+			}
+		}
+
+		// Framebuffers are never removed : the next one takes the next index.
+		const FramebufferHandle fbHandle = FreelistID{ m_framebuffers.Size() }.ToHandle<FramebufferHandle>();
+		m_framebuffers.Add(*this, fbHandle);
+		return fbHandle;
+	}
+
+
+	void NullGraphicsDevice::BlitFramebuffer(FramebufferHandle srcFramebuffer, FramebufferHandle destFramebuffer, TargetBuffer /*target*/,
+		const Rect2Di& /*srcArea*/, const Rect2Di& /*destArea*/, SamplerFilter /*stretchFilter*/)
+	{
+		CommandScope scope(*this, NullDeviceCommand::BlitFramebuffer, destFramebuffer.Get());
+
+		// The null handle is the default framebuffer
+		if (srcFramebuffer.Get() > m_framebuffers.Size() || destFramebuffer.Get() > m_framebuffers.Size())
+		{
+			ReportInvalidHandle(NullDeviceCommand::BlitFramebuffer);
+		}
+	}
+
+
+	AFramebuffer* NullGraphicsDevice::MutFramebuffer(FramebufferHandle fbHandle)
+	{
+		if (fbHandle.IsNull() || fbHandle.Get() > m_framebuffers.Size())
+		{
+			ReportInvalidHandle(NullDeviceCommand::BindFramebuffer);
+			return nullptr;
+		}
+
+		return &m_framebuffers.Lookup(FreelistID{ fbHandle.Get() - 1 });
+	}
+
+
+	SamplerHandle NullGraphicsDevice::CreateSampler(const SamplerDescriptor& /*samplerDesc*/)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateSampler);
+
+		return SamplerHandle{ ++m_numSamplers };
+	}
+
+
+	void NullGraphicsDevice::BindSamplerToTextureUnit(int /*textureBindingPoint*/, SamplerHandle samplerHandle)
+	{
+		CommandScope scope(*this, NullDeviceCommand::BindSampler, samplerHandle.Get());
+
+		if (samplerHandle.IsNull() || samplerHandle.Get() > m_numSamplers)
+		{
+			ReportInvalidHandle(NullDeviceCommand::BindSampler);
+		}
+	}
+
+
+	bool NullGraphicsDevice::IsValidShaderProgram(ShaderProgramHandle programHandle) const
+	{
+		return (programHandle.IsNotNull() && programHandle.Get() <= m_shaderPrograms.Size() && m_shaderPrograms[programHandle.Get() - 1]);
+	}
+
+
+	bool NullGraphicsDevice::IsValidVertexLayout(VertexLayoutHandle layoutHandle) const
+	{
+		return (layoutHandle.IsNotNull() && layoutHandle.Get() <= m_vertexLayouts.Size());
+	}
+
+
+	bool NullGraphicsDevice::IsValidBuffer(DeviceBufferHandle bufferHandle, uint8_t usages, uint64_t accessedBytes) const
+	{
+		auto [bufferID, bufferOffset] = DecodeBufferHandle(bufferHandle);
+		if (bufferID == 0 || bufferID > m_buffers.Size())
+			return false;
+
+		const NullBuffer& buffer = m_buffers[bufferID - 1];
+		return ((buffer.m_usages & usages) != 0 && bufferOffset + accessedBytes <= buffer.m_size);
+	}
+
+
+	bool NullGraphicsDevice::IsValidTexture(TextureHandle texHandle) const
+	{
+		return (texHandle.IsNotNull() && texHandle.Get() <= m_textures.Size() && m_textures[texHandle.Get() - 1]);
+	}
+
+
+	bool NullGraphicsDevice::IsValidResourceLayout(ResourceLayoutHandle layoutHandle) const
+	{
+		return (layoutHandle.IsNotNull() && layoutHandle.Get() <= m_resourceLayouts.Size());
+	}
+
+
+	bool NullGraphicsDevice::IsValidResourceSet(ResourceSetHandle setHandle) const
+	{
+		return (setHandle.IsNotNull() && setHandle.Get() <= m_resourceSets.Size());
+	}
+
+
+	const char* NullGraphicsDevice::GetCommandName(NullDeviceCommand command)
+	{
+		static const char* const commandNames[] =
+		{
+			"CreateShaderProgram",
+			"RemoveShaderProgram",
+			"UseShaderProgram",
+			"UpdateUniformBlockVariable",
+			"CreateVertexLayout",
+			"CreateBuffer",
+			"DeleteBuffer",
+			"UpdateBuffer",
+			"CopyBuffer",
+			"StreamUniformData",
+			"BindUniformBlock",
+			"BindStorageBuffer",
+			"DrawVertexBuffer",
+			"DrawInstancedMesh",
+			"CreateViewport",
+			"UseViewport",
+			"CreateResourceLayout",
+			"CreateResourceSet",
+			"UpdateResourceSet",
+			"CreateTexture",
+			"GenerateTextureMipmaps",
+			"DestroyTexture",
+			"BindTextureUnit",
+			"CreatePipeline",
+			"SetPipeline",
+			"CreateSwapchain",
+			"CreateFramebuffer",
+			"BindFramebuffer",
+			"BlitFramebuffer",
+			"CreateSampler",
+			"BindSampler",
+			"EndFrame"
+		};
+
+		static_assert(sizeof(commandNames) / sizeof(commandNames[0]) == (size_t)NullDeviceCommand::Count, "Update the command names list !");
+
+		if (!MOE_ASSERT(command < NullDeviceCommand::Count))
+			return "Unknown";
+
+		return commandNames[(size_t)command];
+	}
+
+
+	DeviceBufferHandle NullGraphicsDevice::AddBuffer(const void* data, size_t dataSizeBytes, uint8_t usages)
+	{
+		CommandScope scope(*this, NullDeviceCommand::CreateBuffer, 0, dataSizeBytes);
+
+		if (!MOE_ASSERT(dataSizeBytes != 0 && dataSizeBytes <= UINT32_MAX))
+			return DeviceBufferHandle::Null();
+
+		m_buffers.PushBack({ dataSizeBytes, usages });
+
+		if (data != nullptr)
+		{
+			m_stats.m_uploadedBytes += dataSizeBytes;
+		}
+
+		return EncodeBufferHandle((uint32_t) m_buffers.Size(), 0);
+	}
+
+
+	void NullGraphicsDevice::RemoveBuffer(DeviceBufferHandle bufferHandle, uint8_t usages)
+	{
+		CommandScope scope(*this, NullDeviceCommand::DeleteBuffer, bufferHandle.Get());
+
+		auto [bufferID, bufferOffset] = DecodeBufferHandle(bufferHandle);
+
+		// Only the handle given at creation can delete a buffer
+		if (bufferOffset != 0 || !IsValidBuffer(bufferHandle, usages))
+		{
+			ReportInvalidHandle(NullDeviceCommand::DeleteBuffer);
+			return;
+		}
+
+		m_buffers[bufferID - 1].m_usages = 0;
+	}
+
+
+	bool NullGraphicsDevice::ReportInvalidHandle(NullDeviceCommand command) const
+	{
+		m_stats.m_invalidHandles++;
+
+		MOE_ERROR(ChanGraphics, "Null graphics device : invalid handle passed to %s.", GetCommandName(command));
+		MOE_DEBUG_ASSERT(false);
+
+		return false;
+	}
+
+
+	uint64_t NullGraphicsDevice::GetFrameTimestampNs() const
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - m_frameStart;
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	}
+}
@@ -0,0 +1,409 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_STD_SUPPORT
+#include <chrono>
+#include <utility> // std::pair
+#endif
+
+#include "Core/Containers/Array/Array.h"
+#include "Core/Containers/FreeList/PagedFreelist.h"
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Graphics/Device/GraphicsDevice.h"
+
+#include "Graphics/Resources/ResourceLayout/ResourceLayoutDescriptor.h"
+#include "Graphics/Resources/ResourceSet/ResourceSetDescriptor.h"
+
+#include "Monocle_Graphics_Export.h"
+
+
+namespace moe
+{
+	/**
+	 * \brief The kinds of commands a null graphics device keeps statistics about.
+	 * Creation functions of a same kind of resource share the same command (e.g. all the texture creation functions are CreateTexture).
+	 */
+	enum class NullDeviceCommand : uint8_t
+	{
+		CreateShaderProgram = 0,
+		RemoveShaderProgram,
+		UseShaderProgram,
+		UpdateUniformBlockVariable,
+		CreateVertexLayout,
+		CreateBuffer,
+		DeleteBuffer,
+		UpdateBuffer,
+		CopyBuffer,
+		StreamUniformData,
+		BindUniformBlock,
+		BindStorageBuffer,
+		DrawVertexBuffer,
+		DrawInstancedMesh,
+		CreateViewport,
+		UseViewport,
+		CreateResourceLayout,
+		CreateResourceSet,
+		UpdateResourceSet,
+		CreateTexture,
+		GenerateTextureMipmaps,
+		DestroyTexture,
+		BindTextureUnit,
+		CreatePipeline,
+		SetPipeline,
+		CreateSwapchain,
+		CreateFramebuffer,
+		BindFramebuffer,
+		BlitFramebuffer,
+		CreateSampler,
+		BindSampler,
+		EndFrame,
+		Count
+	};
+
+
+	/**
+	 * \brief One entry of the command stream recorded by the null device.
+	 */
+	struct NullDeviceCommandRecord
+	{
+		NullDeviceCommand	m_command{ NullDeviceCommand::Count };
+		uint64_t			m_handle = 0;		// The handle of the main object the command used, if any
+		uint64_t			m_size = 0;			// Bytes for buffer commands, vertices (or indices if any) for draws
+		uint64_t			m_timestampNs = 0;	// Time elapsed since the end of last frame when the command was received
+	};
+
+
+	/**
+	 * \brief What went through the null device since the last reset.
+	 * Call times are the time spent inside the device, which is basically the cost of handle validation.
+	 * The interesting number is usually the frame time : since the device does not do any work, it's all CPU-side renderer overhead.
+	 */
+	struct NullGraphicsDeviceStats
+	{
+		static constexpr size_t	ms_NUM_COMMANDS = (size_t)NullDeviceCommand::Count;
+
+		[[nodiscard]] uint64_t	GetCalls(NullDeviceCommand command) const { return m_calls[(size_t)command]; }
+		[[nodiscard]] uint64_t	GetCallTimeNs(NullDeviceCommand command) const { return m_callTimesNs[(size_t)command]; }
+
+		Array<uint64_t, ms_NUM_COMMANDS>	m_calls{};
+		Array<uint64_t, ms_NUM_COMMANDS>	m_callTimesNs{};
+
+		uint64_t	m_uploadedBytes = 0;
+		uint64_t	m_streamedBytes = 0;
+		uint64_t	m_drawnVertices = 0;
+		uint64_t	m_invalidHandles = 0;
+
+		uint64_t	m_frames = 0;
+		uint64_t	m_lastFrameTimeNs = 0;
+		uint64_t	m_totalFrameTimeNs = 0;
+	};
+
+
+	/**
+	 * \brief A graphics device that does not talk to any GPU.
+	 * It hands out handles, keeps the descriptors the renderer reads back (resource layouts and sets, vertex layouts...),
+	 * validates every handle it receives (use of destroyed objects, out of range buffer accesses, wrong kind of buffer...)
+	 * and counts and times the calls it receives. It can also record the whole command stream.
+	 * This allows to run the renderer without a graphics context, to test it or measure its CPU overhead on machines without GPU.
+	 * Handles of destroyed objects are never given out again, so that using a stale handle is always caught.
+	 */
+	class NullGraphicsDevice final : public IGraphicsDevice
+	{
+	public:
+
+		/**
+		 * \brief The usages a buffer was created for, checked when the buffer is used.
+		 */
+		enum BufferUsage : uint8_t
+		{
+			VertexUsage = 1 << 0,
+			IndexUsage = 1 << 1,
+			UniformUsage = 1 << 2,
+			StorageUsage = 1 << 3,
+			AnyUsage = VertexUsage | IndexUsage | UniformUsage | StorageUsage
+		};
+
+		Monocle_Graphics_API NullGraphicsDevice() = default;
+
+		Monocle_Graphics_API void	Initialize() override;
+
+		Monocle_Graphics_API void	Destroy() override;
+
+
+		Monocle_Graphics_API [[nodiscard]] ShaderProgramHandle	CreateShaderProgramFromSource(const ShaderProgramDescriptor& shaProDesc) override;
+		Monocle_Graphics_API [[nodiscard]] ShaderProgramHandle	CreateShaderProgramFromBinary(const ShaderProgramDescriptor& shaProDesc) override;
+		Monocle_Graphics_API bool	RemoveShaderProgram(ShaderProgramHandle programHandle) override;
+
+		void	UseShaderProgram(ShaderProgramHandle programHandle);
+
+		/**
+		 * \brief There is no shader reflection without a driver : always returns 0.
+		 */
+		[[nodiscard]] uint32_t	GetShaderProgramUniformBlockSize(ShaderProgramHandle shaderHandle, const std::string& uniformBlockName) override;
+
+		/**
+		 * \brief There is no shader reflection without a driver : always returns false.
+		 */
+		[[nodiscard]] bool	IsPartOfUniformBlock(ShaderProgramHandle shaderHandle, const std::string& uniformBlockName, const std::string& uniformMemberName) const override;
+
+		void	UpdateUniformBlockVariable(ShaderProgramHandle program, DeviceBufferHandle targetBlockBuffer, const std::string& variableName,
+											const void* data, size_t dataSizeBytes) override;
+
+
+		Monocle_Graphics_API [[nodiscard]] VertexLayoutHandle	CreateVertexLayout(const VertexLayoutDescriptor& desc) override;
+		Monocle_Graphics_API [[nodiscard]] VertexLayoutHandle	CreateVertexLayout(InstancedVertexLayoutDescriptor desc) override;
+
+		Monocle_Graphics_API [[nodiscard]] const VertexLayout*	GetVertexLayout(VertexLayoutHandle handle) const override;
+
+
+		Monocle_Graphics_API [[nodiscard]] DeviceBufferHandle	CreateStaticVertexBuffer(const void* data, size_t dataSize) override;
+
+		void	DeleteStaticVertexBuffer(DeviceBufferHandle vtxHandle) override;
+
+		[[nodiscard]] DeviceBufferHandle	CreateIndexBuffer(const void* indexData, size_t indexDataSizeBytes) override;
+
+		void	DeleteIndexBuffer(DeviceBufferHandle idxHandle) override;
+
+		[[nodiscard]] DeviceBufferHandle	CreateUniformBuffer(const void* uniformData, size_t uniformDataSizeBytes) override;
+
+		void	DeleteUniformBuffer(DeviceBufferHandle ubHandle) override;
+
+		[[nodiscard]] DeviceBufferHandle	CreateStorageBuffer(const void* storageData, size_t storageDataSizeBytes) override;
+
+		void	DeleteStorageBuffer(DeviceBufferHandle ssboHandle) override;
+
+		/**
+		 * \brief Creates a buffer that can be used as any kind of buffer, like the memory renderers allocate for render world objects.
+		 */
+		Monocle_Graphics_API [[nodiscard]] DeviceBufferHandle	CreateMultiUsageBuffer(size_t dataSizeBytes);
+
+		/**
+		 * \brief Deletes any kind of buffer.
+		 */
+		Monocle_Graphics_API void	DeleteBuffer(DeviceBufferHandle bufferHandle);
+
+		Monocle_Graphics_API void	CopyBuffer(DeviceBufferHandle from, uint32_t fromSizeBytes, DeviceBufferHandle to);
+
+
+		void	DrawVertexBuffer(VertexLayoutHandle vtxLayoutHandle, DeviceBufferHandle vtxBufHandle, size_t numVertices,
+								DeviceBufferHandle idxBufHandle, size_t numIndices) override;
+
+		void	DrawInstancedMesh(VertexLayoutHandle vtxLayoutHandle, DeviceBufferHandle vtxBufHandle, size_t numVertices,
+			DeviceBufferHandle idxBufHandle, size_t numIndices, DeviceBufferHandle instancingBuffer, uint32_t instancesAmount) override;
+
+		void	UpdateBuffer(DeviceBufferHandle bufferHandle, const void* data, size_t dataSize) const override;
+
+		void	BindUniformBlock(unsigned int uniformBlockBinding, DeviceBufferHandle ubHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) override;
+
+		void	BindStorageBuffer(unsigned int storageBinding, DeviceBufferHandle ssboHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) override;
+
+		/**
+		 * \brief Only sub-allocates the frame streaming budget : the data is not copied anywhere.
+		 * Like on a real device, returns a null handle when the budget of the frame is exhausted.
+		 */
+		[[nodiscard]] DeviceBufferHandle	StreamUniformData(const void* data, uint32_t dataSizeBytes) override;
+
+		Monocle_Graphics_API void	EndFrame() override;
+
+
+		[[nodiscard]] ViewportHandle	CreateViewport(const ViewportDescriptor& vpDesc) override;
+
+		void	UseViewport(ViewportHandle vpHandle) override;
+
+
+		[[nodiscard]] ResourceLayoutHandle	CreateResourceLayout(const ResourceLayoutDescriptor& newDesc) override;
+
+		[[nodiscard]] ResourceSetHandle		CreateResourceSet(const ResourceSetDescriptor& newDesc) override;
+
+		[[nodiscard]] const ResourceLayoutDescriptor&	GetResourceLayoutDescriptor(ResourceLayoutHandle layoutHandle) const override;
+
+		[[nodiscard]] const ResourceSetDescriptor&		GetResourceSetDescriptor(ResourceSetHandle setHandle) const override;
+
+		void	UpdateResourceSetDescriptor(ResourceSetHandle rscSetHandle, uint32_t resourceIdx, ResourceHandle newResource) override;
+
+
+		/**
+		 * \brief Texture creation functions never read the image data (or the image files).
+		 */
+		[[nodiscard]] Texture2DHandle	CreateTexture2D(const Texture2DDescriptor& tex2DDesc) override;
+		[[nodiscard]] Texture2DHandle	CreateTexture2D(const Texture2DFileDescriptor& tex2DFileDesc) override;
+
+		[[nodiscard]] TextureHandle	CreateCubemapTexture(const CubeMapTextureFilesDescriptor& cubemapFilesDesc) override;
+
+		[[nodiscard]] TextureHandle	CreateCubemapTexture(const CubeMapTextureDescriptor& cubemapDesc) override;
+
+		/**
+		 * \brief Asynchronous textures are Ready right away, but their callback is still only called at the end of the frame, like on other devices.
+		 */
+		[[nodiscard]] Texture2DHandle	CreateTexture2DAsync(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded = nullptr) override;
+
+		[[nodiscard]] TextureHandle	CreateCubemapTextureAsync(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded = nullptr) override;
+
+		[[nodiscard]] TextureLoadState	GetTextureLoadState(TextureHandle texHandle) const override;
+
+		void	GenerateTextureMipmaps(TextureHandle texHandle) override;
+
+		void	DestroyTexture2D(Texture2DHandle textureHandle) override;
+
+		void	BindTextureUnit(int textureBindingPoint, TextureHandle texHandle) override;
+
+
+		[[nodiscard]]	PipelineHandle	CreatePipeline(PipelineDescriptor& pipelineDesc) override;
+
+		void	SetPipeline(PipelineHandle pipeHandle) override;
+
+
+		[[nodiscard]]	SwapchainHandle	CreateSwapChain(uint32_t renderWidth, uint32_t renderHeight, FramebufferAttachment wantedAttachments) override;
+
+
+		[[nodiscard]]	FramebufferHandle	CreateFramebuffer(const FramebufferDescriptor& fbDesc) override;
+						void				BlitFramebuffer(FramebufferHandle srcFramebuffer, FramebufferHandle destFramebuffer, TargetBuffer target, const Rect2Di& srcArea, const Rect2Di& destArea, SamplerFilter stretchFilter) override;
+		[[nodiscard]]	AFramebuffer*		MutFramebuffer(FramebufferHandle fbHandle) override;
+
+
+		[[nodiscard]]	SamplerHandle	CreateSampler(const SamplerDescriptor& samplerDesc) override;
+
+		void	BindSamplerToTextureUnit(int textureBindingPoint, SamplerHandle samplerHandle) override;
+
+
+
+		[[nodiscard]] bool	IsValidShaderProgram(ShaderProgramHandle programHandle) const;
+
+		[[nodiscard]] bool	IsValidVertexLayout(VertexLayoutHandle layoutHandle) const;
+
+		/**
+		 * \brief Checks the handle points to a live buffer created for (at least one of) the given usages,
+		 * and that the accessed range fits in the buffer.
+		 */
+		[[nodiscard]] bool	IsValidBuffer(DeviceBufferHandle bufferHandle, uint8_t usages = AnyUsage, uint64_t accessedBytes = 0) const;
+
+		[[nodiscard]] bool	IsValidTexture(TextureHandle texHandle) const;
+
+		[[nodiscard]] bool	IsValidResourceLayout(ResourceLayoutHandle layoutHandle) const;
+
+		[[nodiscard]] bool	IsValidResourceSet(ResourceSetHandle setHandle) const;
+
+
+		/**
+		 * \brief When enabled, every command received is appended to the command stream (until Destroy or ClearRecordedCommands).
+		 */
+		void	SetRecordingCommands(bool record) { m_recordCommands = record; }
+
+		[[nodiscard]] const Vector<NullDeviceCommandRecord>&	GetRecordedCommands() const { return m_recordedCommands; }
+
+		void	ClearRecordedCommands() { m_recordedCommands.Clear(); }
+
+
+		[[nodiscard]] const NullGraphicsDeviceStats&	GetStats() const { return m_stats; }
+
+		void	ResetStats() { m_stats = NullGraphicsDeviceStats(); }
+
+
+		[[nodiscard]] Monocle_Graphics_API static const char*	GetCommandName(NullDeviceCommand command);
+
+
+		/**
+		 * \brief Buffer handles are the buffer index in the high 32 bits and an offset in the low 32 bits, so renderers can offset them.
+		 */
+		static DeviceBufferHandle	EncodeBufferHandle(uint32_t bufferID, uint32_t bufferOffset)
+		{
+			return DeviceBufferHandle{ ((uint64_t)bufferID << 32) | bufferOffset };
+		}
+
+		static std::pair<uint32_t, uint32_t>	DecodeBufferHandle(DeviceBufferHandle handle)
+		{
+			return { (uint32_t)(handle.Get() >> 32), (uint32_t)handle.Get() };
+		}
+
+
+		static constexpr uint32_t	ms_STREAM_BUFFER_SIZE = 1024 * 1024; // Per frame, like the OpenGL device ring buffer regions
+		static constexpr uint32_t	ms_STREAM_ALIGNMENT = 256; // The usual GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT value
+
+
+	private:
+
+		/**
+		 * \brief Counts and times a command from construction to destruction, and records it if needed.
+		 */
+		class CommandScope
+		{
+		public:
+			CommandScope(const NullGraphicsDevice& device, NullDeviceCommand command, uint64_t handle = 0, uint64_t size = 0);
+			~CommandScope();
+
+		private:
+			const NullGraphicsDevice&				m_device;
+			NullDeviceCommand						m_command;
+			std::chrono::steady_clock::time_point	m_start;
+		};
+
+
+		/**
+		 * \brief A framebuffer that only tells the device it got bound.
+		 */
+		class NullFramebuffer final : public AFramebuffer
+		{
+		public:
+			NullFramebuffer(NullGraphicsDevice& device, FramebufferHandle handle) :
+				m_device(&device), m_handle(handle)
+			{}
+
+			void	Bind() override;
+			void	Unbind() override;
+
+			void	BindColorAttachment(int /*colorAttachmentIdx*/, TextureHandle /*colorAttachment*/, int /*mipLevel*/ = 0, bool /*layered*/ = false, int /*layerIdx*/ = 0) override {}
+
+			void	BindDepthAttachment(TextureHandle /*depthAttachment*/, int /*mipLevel*/ = 0, bool /*layered*/ = false, int /*layerIdx*/ = 0) override {}
+
+			bool	IsComplete() const override { return true; }
+
+		private:
+			NullGraphicsDevice*	m_device = nullptr;
+			FramebufferHandle	m_handle;
+		};
+
+
+		struct NullBuffer
+		{
+			uint64_t	m_size = 0;
+			uint8_t		m_usages = 0; // 0 once deleted
+		};
+
+
+		[[nodiscard]] DeviceBufferHandle	AddBuffer(const void* data, size_t dataSizeBytes, uint8_t usages);
+
+		void	RemoveBuffer(DeviceBufferHandle bufferHandle, uint8_t usages);
+
+		/**
+		 * \brief Counts and reports an invalid handle. Always returns false, so it can be used as the result of a failed validation.
+		 */
+		bool	ReportInvalidHandle(NullDeviceCommand command) const;
+
+		[[nodiscard]] uint64_t	GetFrameTimestampNs() const;
+
+
+		Vector<uint8_t>				m_shaderPrograms;	// "Alive" flag of each program
+		PagedFreelist<VertexLayout>	m_vertexLayouts;	// Paged : GetVertexLayout hands out pointers that must survive new layouts
+		Vector<NullBuffer>			m_buffers;
+		Vector<ViewportDescriptor>	m_viewports;
+		Vector<ResourceLayoutDescriptor>	m_resourceLayouts;
+		Vector<ResourceSetDescriptor>		m_resourceSets;
+		Vector<uint8_t>				m_textures;			// "Alive" flag of each texture
+		Vector<std::pair<TextureHandle, TextureLoadCallback>>	m_textureLoadCallbacks;
+		uint32_t					m_numPipelines = 0;
+		PagedFreelist<NullFramebuffer>	m_framebuffers;	// Paged, for the same reason (MutFramebuffer)
+		uint32_t					m_numSamplers = 0;
+
+		uint32_t					m_streamBufferID = 0;
+		uint32_t					m_streamOffset = 0;
+
+		bool									m_recordCommands = false;
+		mutable Vector<NullDeviceCommandRecord>	m_recordedCommands;
+
+		mutable NullGraphicsDeviceStats			m_stats;
+		std::chrono::steady_clock::time_point	m_frameStart;
+	};
+
+}
@@ -22,9 +22,26 @@ namespace moe
 
 	void OpenGLGraphicsDevice::Initialize()
 	{
-		m_vertexBufferPool.ReservePoolMemory(GL_DYNAMIC_STORAGE_BIT);
-		m_indexBufferPool.ReservePoolMemory(GL_DYNAMIC_STORAGE_BIT);
-		m_uniformBufferPool.ReservePoolMemory(GL_DYNAMIC_STORAGE_BIT);
+		// The pools delete their buffers themselves : the state cache must not keep thinking a recycled name is still bound.
+		OpenGLBufferPool::BufferDeletedDelegate forgetBuffer;
+		forgetBuffer.Set<OpenGLStateCache, &OpenGLStateCache::ForgetBuffer>(&m_stateCache);
+		m_vertexBufferPool.SetBufferDeletedDelegate(forgetBuffer);
+		m_indexBufferPool.SetBufferDeletedDelegate(forgetBuffer);
+		m_uniformBufferPool.SetBufferDeletedDelegate(forgetBuffer);
+
+		m_vertexBufferPool.Initialize(GL_DYNAMIC_STORAGE_BIT);
+		m_indexBufferPool.Initialize(GL_DYNAMIC_STORAGE_BIT);
+		m_uniformBufferPool.Initialize(GL_DYNAMIC_STORAGE_BIT);
+
+		GLint uboAlignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uboAlignment);
+		m_uniformStreamBuffer.Initialize(OpenGLStreamingRingBuffer::ms_DEFAULT_REGION_SIZE, (uint32_t)uboAlignment);
+
+		m_textureStreamer.Initialize();
+
+		m_shaderManager.MutBinaryCache().Initialize();
+
+		m_stateCache.Invalidate();
 
 		// Because OpenGL expects the 0.0 coordinate on the y-axis to be on the bottom-side of the image,
 		// most images will appear vertically reversed in OpenGL since images usually have 0.0 at the top of the y-axis.
@@ -44,12 +61,43 @@ namespace moe
 		for (const auto& layout : m_vertexLayouts)
 		{
 			vaoIDs[iLayout] = layout;
+			m_stateCache.ForgetVertexArray(vaoIDs[iLayout]);
 			iLayout++;
 		}
 
 		glDeleteVertexArrays((GLsizei)vaoIDs.Size(), vaoIDs.Data());
 
 		m_vertexLayouts.clear();
+
+		// Same for the samplers.
+		Vector<GLuint> samplerIDs(m_samplers.Size());
+
+		for (uint32_t iSampler = 0; iSampler < m_samplers.Size(); iSampler++)
+		{
+			samplerIDs[iSampler] = m_samplers[iSampler].GetID();
+			m_stateCache.ForgetSampler(samplerIDs[iSampler]);
+		}
+
+		glDeleteSamplers((GLsizei)samplerIDs.Size(), samplerIDs.Data());
+
+		m_samplers.Clear();
+
+		m_uniformStreamBuffer.Destroy();
+
+		m_textureStreamer.Destroy();
+
+		m_vertexBufferPool.DeleteMemory();
+		m_indexBufferPool.DeleteMemory();
+		m_uniformBufferPool.DeleteMemory();
+
+		for (const auto& [ssboHandle, ssboSize] : m_storageBufferSizes)
+		{
+			const GLuint ssbo = DecodeBufferHandle(ssboHandle).first;
+			glDeleteBuffers(1, &ssbo);
+		}
+		m_storageBufferSizes.Clear();
+
+		m_stateCache.Invalidate();
 	}
 
 
@@ -72,7 +120,7 @@ namespace moe
 	GLuint OpenGLGraphicsDevice::UseShaderProgram(ShaderProgramHandle programHandle)
 	{
 		GLuint programID = GetShaderProgramID(programHandle);
-		glUseProgram(programID);
+		m_stateCache.UseProgram(programID);
 
 		return programID;
 	}
@@ -93,6 +141,14 @@ namespace moe
 	}
 
 
+	const OpenGLShaderProgram* OpenGLGraphicsDevice::GetShaderProgram(ShaderProgramHandle programHandle) const
+	{
+		const OpenGLShaderProgram* programPtr = m_shaderManager.GetProgram(programHandle);
+		MOE_ASSERT(programPtr != nullptr);
+		return programPtr;
+	}
+
+
 	VertexLayoutHandle OpenGLGraphicsDevice::CreateVertexLayout(const VertexLayoutDescriptor& vertexLayoutDesc)
 	{
 		// First and foremost, check that we do not have an existing vertex layout that could fit this description...
@@ -116,6 +172,8 @@ namespace moe
 
 		uint32_t totalStride{ 0 }; // only really useful for Interleaved mode
 
+		Vector<uint32_t> packedElementSizes; // only useful for Packed mode
+
 		switch (vertexLayoutDesc.Type())
 		{
 			case LayoutType::Interleaved:
@@ -192,6 +250,9 @@ namespace moe
 					// As data will be tightly packed, we need to bind each attribute to a different binding index.
 					glVertexArrayAttribBinding(vaoID, iAttrib, iAttrib);
 
+					// Keep the element size to compute binding offsets at draw time without translating formats again.
+					packedElementSizes.PushBack(sizeOpt.value());
+
 					iAttrib++;
 				}
 
@@ -206,12 +267,13 @@ namespace moe
 		if (handle.IsNull())
 		{
 			// There was a problem somewhere : delete our created VAO
+			m_stateCache.ForgetVertexArray(vaoID);
 			glDeleteVertexArrays(1, &vaoID);
 		}
 		else
 		{
 			// The VAO was successfully initialized : we store our vertex layout
-			m_vertexLayouts.emplace(vertexLayoutDesc, vaoID, totalStride);
+			m_vertexLayouts.emplace(vertexLayoutDesc, vaoID, totalStride, std::move(packedElementSizes));
 		}
 
 		return handle;
@@ -342,6 +404,7 @@ namespace moe
 		else
 		{
 			// There was a problem somewhere : delete our created VAO
+			m_stateCache.ForgetVertexArray(vaoID);
 			glDeleteVertexArrays(1, &vaoID);
 		}
 
@@ -368,7 +431,7 @@ namespace moe
 
 		if (MOE_ASSERT(layout != nullptr))
 		{
-			glBindVertexArray((GLuint)*layout);
+			m_stateCache.BindVertexArray((GLuint)*layout);
 		}
 		else
 		{
@@ -381,31 +444,14 @@ namespace moe
 
 	DeviceBufferHandle OpenGLGraphicsDevice::CreateStaticVertexBuffer(const void* data, size_t byteSize)
 	{
-		uint32_t meshOffset = m_vertexBufferPool.Allocate(data, (uint32_t)byteSize);
-
-		GLuint bufferID;
-
-		if (meshOffset == OpenGLBuddyAllocator::ms_INVALID_OFFSET)
-		{
-			// The requested allocation didn't fit in our allocation scheme : allocate an ad hoc buffer.
-			// TODO: this is very bad ! This allocation goes completely off the grid ! It should be recorded somewhere...
-			glCreateBuffers(1, &bufferID);
-
-			MOE_DEBUG_ASSERT(bufferID != 0);
-
-			glNamedBufferStorage(bufferID, byteSize, data, GL_DYNAMIC_STORAGE_BIT);
-
-			meshOffset = 0;
-		}
-		else
+		// Big allocations (e.g. instancing buffers) get a dedicated buffer, tracked by the pool.
+		const OpenGLPoolAllocation allocation = m_vertexBufferPool.Allocate(data, (uint32_t)byteSize);
+		if (false == allocation.IsValid())
 		{
-			bufferID = m_vertexBufferPool.GetBufferHandle();
+			return DeviceBufferHandle::Null();
 		}
 
-		// Encode the VBO ID and the offset in the handle.
-		// The handle looks like : | VBO ID (32 bits) | offset in VBO (32 bits) |
-		DeviceBufferHandle bufHandle = EncodeBufferHandle(bufferID, meshOffset);
-		return bufHandle;
+		return EncodeBufferHandle(allocation.m_buffer, allocation.m_offset, allocation.m_arenaIdx);
 	}
 
 
@@ -416,30 +462,19 @@ namespace moe
 			return ; // not supposed to happen
 		}
 
-		// Right now, the pool only needs the offset (we use a single VBO).
-
-		// Controlled narrowing conversion to only keep the 32 least-significant bits (containing the offset value)
-		uint32_t offset = (uint32_t)vtxHandle.Get();
-
-		m_vertexBufferPool.Free(offset);
+		m_vertexBufferPool.Free(DecodePoolAllocation(vtxHandle));
 	}
 
 
 	DeviceBufferHandle OpenGLGraphicsDevice::CreateIndexBuffer(const void* indexData, size_t indexDataSizeBytes)
 	{
-		const uint32_t indexOffset = m_indexBufferPool.Allocate(indexData, (uint32_t)indexDataSizeBytes);
-		if (indexOffset == OpenGLBuddyAllocator::ms_INVALID_OFFSET)
+		const OpenGLPoolAllocation allocation = m_indexBufferPool.Allocate(indexData, (uint32_t)indexDataSizeBytes);
+		if (false == allocation.IsValid())
 		{
 			return DeviceBufferHandle::Null();
 		}
-		else
-		{
-			// Encode the EBO ID and the offset in the handle.
-			// The handle looks like : | EBO ID (32 bits) | offset in EBO (32 bits) |
-			uint64_t handleValue = (uint64_t)m_indexBufferPool.GetBufferHandle() << 32;
-			handleValue |= indexOffset;
-			return DeviceBufferHandle{ handleValue };
-		}
+
+		return EncodeBufferHandle(allocation.m_buffer, allocation.m_offset, allocation.m_arenaIdx);
 	}
 
 
@@ -450,12 +485,7 @@ namespace moe
 			return; // not supposed to happen
 		}
 
-		// Right now, the pool only needs the offset (we use a single EBO).
-
-		// Controlled narrowing conversion to only keep the 32 least-significant bits (containing the offset value)
-		uint32_t offset = (uint32_t)idxHandle.Get();
-
-		m_indexBufferPool.Free(offset);
+		m_indexBufferPool.Free(DecodePoolAllocation(idxHandle));
 	}
 
 
@@ -473,23 +503,19 @@ namespace moe
 
 		if (vtxLayout->IsInterleaved())
 		{
-			glVertexArrayVertexBuffer(vtxLayout->VAO(), 0, vbo, vboOffset, vtxLayout->GetStrideBytes());
+			m_stateCache.VertexArrayVertexBuffer(vtxLayout->VAO(), 0, vbo, vboOffset, vtxLayout->GetStrideBytes());
 		}
 		else
 		{
 			// In packed mode, set the bindings one by one.
-			const VertexLayoutDescriptor& layoutDesc = vtxLayout->ReadDescriptor();
-
 			uint32_t bindingIdx = 0;
 			size_t elemBufferOffset = vboOffset;
 
-			for (const VertexElementDescriptor& elemDesc : layoutDesc)
+			for (uint32_t elemSize : vtxLayout->GetPackedElementSizes())
 			{
-				auto oglElemFormat = OpenGLVertexElementFormat::TranslateFormat(elemDesc.m_format);
-				auto typeSize = OpenGLVertexElementFormat::FindTypeSize(oglElemFormat.value().m_numCpnts, oglElemFormat.value().m_type);
-				glVertexArrayVertexBuffer(vtxLayout->VAO(), bindingIdx, vbo, elemBufferOffset, typeSize.value());
+				m_stateCache.VertexArrayVertexBuffer(vtxLayout->VAO(), bindingIdx, vbo, elemBufferOffset, elemSize);
 
-				elemBufferOffset += numVertices * typeSize.value();
+				elemBufferOffset += numVertices * elemSize;
 				bindingIdx++;
 			}
 		}
@@ -498,7 +524,7 @@ namespace moe
 		{
 			auto[ebo, eboOffset] = DecodeBufferHandle(idxBufHandle);
 
-			glVertexArrayElementBuffer(vtxLayout->VAO(), ebo);
+			m_stateCache.VertexArrayElementBuffer(vtxLayout->VAO(), ebo);
 
 			glDrawElements(m_primitiveTopology, (GLsizei)numIndices, GL_UNSIGNED_INT, (const void*)((uint64_t)eboOffset));
 		}
@@ -533,23 +559,19 @@ namespace moe
 
 			if (vtxBindings.IsInterleaved())
 			{
-				glVertexArrayVertexBuffer(vtxLayout->VAO(), vtxBindings.BufferBinding(), bufferIDAndOffset.first, bufferIDAndOffset.second, vtxBindings.GetTotalStride());
+				m_stateCache.VertexArrayVertexBuffer(vtxLayout->VAO(), vtxBindings.BufferBinding(), bufferIDAndOffset.first, bufferIDAndOffset.second, vtxBindings.GetTotalStride());
 			}
 			else
 			{
 				// In packed mode, set the bindings one by one.
-				const VertexLayoutDescriptor& layoutDesc = vtxLayout->ReadDescriptor();
-
 				uint32_t bindingIdx = 0;
 				size_t elemBufferOffset = bufferIDAndOffset.second;
 
-				for (const VertexElementDescriptor& elemDesc : layoutDesc)
+				for (uint32_t elemSize : vtxLayout->GetPackedElementSizes())
 				{
-					auto oglElemFormat = OpenGLVertexElementFormat::TranslateFormat(elemDesc.m_format);
-					auto typeSize = OpenGLVertexElementFormat::FindTypeSize(oglElemFormat.value().m_numCpnts, oglElemFormat.value().m_type);
-					glVertexArrayVertexBuffer(vtxLayout->VAO(), bindingIdx, bufferIDAndOffset.first, elemBufferOffset, typeSize.value());
+					m_stateCache.VertexArrayVertexBuffer(vtxLayout->VAO(), bindingIdx, bufferIDAndOffset.first, elemBufferOffset, elemSize);
 
-					elemBufferOffset += numVertices * typeSize.value();
+					elemBufferOffset += numVertices * elemSize;
 					bindingIdx++;
 				}
 			}
@@ -559,7 +581,7 @@ namespace moe
 		{
 			auto[ebo, eboOffset] = DecodeBufferHandle(idxBufHandle);
 
-			glVertexArrayElementBuffer(vtxLayout->VAO(), ebo);
+			m_stateCache.VertexArrayElementBuffer(vtxLayout->VAO(), ebo);
 
 			glDrawElementsInstanced(m_primitiveTopology, (GLsizei)numIndices, GL_UNSIGNED_INT, (const void*)(uint64_t)eboOffset, instancesAmount);
 		}
@@ -596,25 +618,67 @@ namespace moe
 
 	DeviceBufferHandle OpenGLGraphicsDevice::CreateUniformBuffer(const void* uniformData, size_t uniformDataSizeBytes)
 	{
-		const uint32_t uboOffset = m_uniformBufferPool.Allocate(uniformData, (uint32_t)uniformDataSizeBytes);
-		if (uboOffset == OpenGLBuddyAllocator::ms_INVALID_OFFSET)
+		const OpenGLPoolAllocation allocation = m_uniformBufferPool.Allocate(uniformData, (uint32_t)uniformDataSizeBytes);
+		if (false == allocation.IsValid())
 		{
 			return DeviceBufferHandle::Null();
 		}
-		else
+
+		DeviceBufferHandle newBufferHandle = EncodeBufferHandle(allocation.m_buffer, allocation.m_offset, allocation.m_arenaIdx);
+
+		// Don't forget to store the size, it will be useful when using the buffer.
+		m_uniformBufferSizes[newBufferHandle] = (uint32_t)uniformDataSizeBytes;
+
+		return newBufferHandle;
+	}
+
+
+	void OpenGLGraphicsDevice::DeleteUniformBuffer(DeviceBufferHandle ubHandle)
+	{
+		auto sizeIt = m_uniformBufferSizes.Find(ubHandle);
+		if (!MOE_ASSERT(sizeIt != m_uniformBufferSizes.End()))
 		{
-			// Encode the UBO ID and the offset in the handle.
-			// The handle looks like : | UBO ID (32 bits) | offset in UBO (32 bits) |
-			uint64_t handleValue = (uint64_t)m_uniformBufferPool.GetBufferHandle() << 32;
-			handleValue |= uboOffset;
+			return; // not supposed to happen
+		}
+
+		m_uniformBufferSizes.Erase(sizeIt);
+
+		m_uniformBufferPool.Free(DecodePoolAllocation(ubHandle));
+	}
+
+
+	DeviceBufferHandle OpenGLGraphicsDevice::CreateStorageBuffer(const void* storageData, size_t storageDataSizeBytes)
+	{
+		if (!MOE_ASSERT(storageDataSizeBytes != 0))
+		{
+			return DeviceBufferHandle::Null();
+		}
+
+		GLuint ssbo = 0;
+		glCreateBuffers(1, &ssbo);
+		glNamedBufferStorage(ssbo, storageDataSizeBytes, storageData, GL_DYNAMIC_STORAGE_BIT);
+
+		DeviceBufferHandle newBufferHandle = EncodeBufferHandle(ssbo, 0);
 
-			DeviceBufferHandle newBufferHandle{handleValue};
+		m_storageBufferSizes[newBufferHandle] = (uint32_t)storageDataSizeBytes;
+
+		return newBufferHandle;
+	}
 
-			// Don't forget to store the size, it will be useful when using the buffer.
-			m_uniformBufferSizes[newBufferHandle] = (uint32_t)uniformDataSizeBytes;
 
-			return newBufferHandle;
+	void OpenGLGraphicsDevice::DeleteStorageBuffer(DeviceBufferHandle ssboHandle)
+	{
+		auto sizeIt = m_storageBufferSizes.Find(ssboHandle);
+		if (!MOE_ASSERT(sizeIt != m_storageBufferSizes.End()))
+		{
+			return; // not supposed to happen
 		}
+
+		m_storageBufferSizes.Erase(sizeIt);
+
+		const GLuint ssbo = DecodeBufferHandle(ssboHandle).first;
+		m_stateCache.ForgetBuffer(ssbo);
+		glDeleteBuffers(1, &ssbo);
 	}
 
 
@@ -847,6 +911,20 @@ namespace moe
 	}
 
 
+	Texture2DHandle OpenGLGraphicsDevice::CreateTexture2DAsync(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded)
+	{
+		Texture2DHandle texHandle;
+		texHandle.m_handle = m_textureStreamer.LoadTexture2D(tex2DFileDesc, std::move(onLoaded));
+		return texHandle;
+	}
+
+
+	TextureHandle OpenGLGraphicsDevice::CreateCubemapTextureAsync(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded)
+	{
+		return TextureHandle{ m_textureStreamer.LoadCubemap(cubemapFilesDesc, std::move(onLoaded)) };
+	}
+
+
 	TextureHandle OpenGLGraphicsDevice::CreateCubemapTexture(const CubeMapTextureDescriptor& cubemapDesc)
 	{
 		// First ensure source and target texture formats are valid - don't bother going further if not
@@ -913,11 +991,13 @@ namespace moe
 	void OpenGLGraphicsDevice::DestroyTexture2D(Texture2DHandle texHandle)
 	{
 		GLuint texID{texHandle.Get()};
+		m_textureStreamer.Forget(texID);
 		glDeleteTextures(1, &texID);
+		m_stateCache.ForgetTexture(texID);
 	}
 
 
-	uint32_t OpenGLGraphicsDevice::GetShaderProgramUniformBlockSize(ShaderProgramHandle shaderHandle, const std::string& /*uniformBlockName*/)
+	uint32_t OpenGLGraphicsDevice::GetShaderProgramUniformBlockSize(ShaderProgramHandle shaderHandle, const std::string& uniformBlockName)
 	{
 		const OpenGLShaderProgram* programPtr = m_shaderManager.GetProgram(shaderHandle);
 
@@ -926,47 +1006,13 @@ namespace moe
 			return UINT32_MAX;
 		}
 
-		GLuint shaderProgramID = (GLuint)(*programPtr);
-
-		GLint numBlocks = 0;
-		glGetProgramInterfaceiv(shaderProgramID, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &numBlocks);
-		const GLenum blockProperties[1] = { GL_NUM_ACTIVE_VARIABLES };
-		const GLenum activeUnifProp[1] = { GL_ACTIVE_VARIABLES };
-		const GLenum unifProperties[3] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION };
-
-		for (int blockIx = 0; blockIx < numBlocks; ++blockIx)
+		const uint32_t blockSlot = programPtr->FindUniformBlockSlot(uniformBlockName);
+		if (blockSlot == OpenGLShaderProgram::ms_INVALID_SLOT)
 		{
-
-			GLint numActiveUnifs = 0;
-			glGetProgramResourceiv(shaderProgramID, GL_UNIFORM_BLOCK, blockIx, 1, blockProperties, 1, NULL, &numActiveUnifs);
-
-			if (!numActiveUnifs)
-				continue;
-
-			std::vector<GLint> blockUnifs(numActiveUnifs);
-			glGetProgramResourceiv(shaderProgramID, GL_UNIFORM_BLOCK, blockIx, 1, activeUnifProp, numActiveUnifs, NULL, &blockUnifs[0]);
-
-			for (int unifIx = 0; unifIx < numActiveUnifs; ++unifIx)
-			{
-				GLint values[3];
-				glGetProgramResourceiv(shaderProgramID, GL_UNIFORM, blockUnifs[unifIx], 3, unifProperties, 3, NULL, values);
-
-				// Get the name. Must use a std::vector rather than a std::string for C++03 standards issues.
-				// C++11 would let you use a std::string directly.
-				std::vector<char> nameData(values[0]);
-				glGetProgramResourceName(shaderProgramID, GL_UNIFORM, blockUnifs[unifIx], (GLsizei)nameData.size(), NULL, &nameData[0]);
-				std::string name(nameData.begin(), nameData.end() - 1);
-				const char* nameStr = name.c_str();
-				unsigned int indices[1];
-				GLint offsets[1];
-
-				glGetUniformIndices(shaderProgramID, 1, &nameStr, indices);
-				glGetActiveUniformsiv(shaderProgramID, 1, indices, GL_UNIFORM_OFFSET, offsets);
-
-			}
+			return 0;
 		}
 
-		return 0;
+		return (uint32_t)programPtr->GetUniformBlock(blockSlot).m_dataSize;
 	}
 
 
@@ -979,86 +1025,35 @@ namespace moe
 			return false;
 		}
 
-		GLuint shaderProgramID = (GLuint)(*programPtr);
-
-		GLint numBlocks;
-		glGetProgramiv(shaderProgramID, GL_ACTIVE_UNIFORM_BLOCKS, &numBlocks);
-
+		return programPtr->HasBlockMember(uniformBlockName, uniformMemberName);
+	}
 
-		std::vector<std::string> nameList;
-		nameList.reserve(numBlocks);
 
-		for (int blockIx = 0; blockIx < numBlocks; ++blockIx)
+	void OpenGLGraphicsDevice::BindProgramUniformBlock(const OpenGLShaderProgram& program, uint32_t blockSlot, int uniformBlockBinding, DeviceBufferHandle ubHandle, uint32_t bufferSize)
+	{
+		if (blockSlot == OpenGLShaderProgram::ms_INVALID_SLOT)
 		{
-			GLint nameLen;
-			glGetActiveUniformBlockiv(shaderProgramID, blockIx, GL_UNIFORM_BLOCK_NAME_LENGTH, &nameLen);
-
-			std::string blockName;
-			blockName.resize(nameLen);
-			glGetActiveUniformBlockName(shaderProgramID, blockIx, nameLen, nullptr, &blockName[0]);
-
-			if (blockName != uniformBlockName)
-				continue;
-
-			const GLenum blockProperties[1] = { GL_NUM_ACTIVE_VARIABLES };
-			const GLenum activeUnifProp[1] = { GL_ACTIVE_VARIABLES };
-			const GLenum unifProperties[1] = { GL_NAME_LENGTH };
-
-			for (int blockVarIdx = 0; blockVarIdx < numBlocks; ++blockVarIdx)
-			{
-				GLint numActiveUnifs = 0;
-				glGetProgramResourceiv(shaderProgramID, GL_UNIFORM_BLOCK, blockVarIdx, 1, blockProperties, 1, NULL, &numActiveUnifs);
-
-				if (!numActiveUnifs)
-					continue;
-
-				std::vector<GLint> blockUnifs(numActiveUnifs);
-				glGetProgramResourceiv(shaderProgramID, GL_UNIFORM_BLOCK, blockVarIdx, 1, activeUnifProp, numActiveUnifs, NULL, &blockUnifs[0]);
-
-				for (int unifIx = 0; unifIx < numActiveUnifs; ++unifIx)
-				{
-					GLint values[1];
-					glGetProgramResourceiv(shaderProgramID, GL_UNIFORM, blockUnifs[unifIx], 1, unifProperties, 1, NULL, values);
-
-					// Get the name. Must use a std::vector rather than a std::string for C++03 standards issues.
-					// C++11 would let you use a std::string directly.
-					std::vector<char> nameData(values[0]);
-					glGetProgramResourceName(shaderProgramID, GL_UNIFORM, blockUnifs[unifIx], (GLsizei)nameData.size(), NULL, &nameData[0]);
-					std::string name(nameData.begin(), nameData.end() - 1);
-
-					if (name == uniformMemberName)
-						return true;
-				}
-			}
+			MOE_ASSERT(false);
+			MOE_ERROR(ChanGraphics, "Tried to bind a uniform block in shader program %u but this block was not found inside the shader.", (GLuint)program);
+			return;
 		}
 
-		return false;
-	}
-
-
-	void OpenGLGraphicsDevice::BindProgramUniformBlock(GLuint shaderProgramID, const char* uniformBlockName, int uniformBlockBinding, DeviceBufferHandle ubHandle)
-	{
 		// First retrieve the size of our uniform buffer or early exit...
-		auto sizeIt = m_uniformBufferSizes.Find(ubHandle);
-		if (!MOE_ASSERT(sizeIt != m_uniformBufferSizes.End()))
+		if (bufferSize == 0)
 		{
-			return;
+			auto sizeIt = m_uniformBufferSizes.Find(ubHandle);
+			if (!MOE_ASSERT(sizeIt != m_uniformBufferSizes.End()))
+			{
+				return;
+			}
+
+			bufferSize = sizeIt->second;
 		}
 
 		auto [ubo, uboOffset] = DecodeBufferHandle(ubHandle);
 
-		const unsigned int uniformBlockProgramIndex = glGetUniformBlockIndex(shaderProgramID, uniformBlockName);
-
-		if (uniformBlockProgramIndex != UINT32_MAX)
-		{
-			glUniformBlockBinding(shaderProgramID, uniformBlockProgramIndex, uniformBlockBinding);
-			glBindBufferRange(GL_UNIFORM_BUFFER, uniformBlockBinding, ubo, uboOffset, sizeIt->second);
-		}
-		else
-		{
-			MOE_ASSERT(false);
-			MOE_ERROR(ChanGraphics, "Tried to use block %s in shader program %u but this block was not found inside the shader.", uniformBlockName, shaderProgramID);
-		}
+		program.SetUniformBlockBinding(blockSlot, uniformBlockBinding);
+		m_stateCache.BindUniformBufferRange(uniformBlockBinding, ubo, uboOffset, bufferSize);
 	}
 
 
@@ -1078,7 +1073,38 @@ namespace moe
 
 		auto[ubo, uboOffset] = DecodeBufferHandle(ubHandle);
 
-		glBindBufferRange(GL_UNIFORM_BUFFER, uniformBlockBinding, ubo, uboOffset + relativeOffset, bufferSize);
+		m_stateCache.BindUniformBufferRange(uniformBlockBinding, ubo, uboOffset + relativeOffset, bufferSize);
+	}
+
+
+	void OpenGLGraphicsDevice::BindStorageBuffer(unsigned int storageBinding, DeviceBufferHandle ssboHandle, uint32_t bufferSize, uint32_t relativeOffset)
+	{
+		if (bufferSize == 0)
+		{
+			auto sizeIt = m_storageBufferSizes.Find(ssboHandle);
+			if (!MOE_ASSERT(sizeIt != m_storageBufferSizes.End()))
+			{
+				return;
+			}
+
+			bufferSize = sizeIt->second - relativeOffset;
+		}
+
+		auto [ssbo, ssboOffset] = DecodeBufferHandle(ssboHandle);
+
+		m_stateCache.BindStorageBufferRange(storageBinding, ssbo, ssboOffset + relativeOffset, bufferSize);
+	}
+
+
+	DeviceBufferHandle OpenGLGraphicsDevice::StreamUniformData(const void* data, uint32_t dataSizeBytes)
+	{
+		const uint32_t streamOffset = m_uniformStreamBuffer.Push(data, dataSizeBytes);
+		if (streamOffset == OpenGLStreamingRingBuffer::ms_INVALID_OFFSET)
+		{
+			return DeviceBufferHandle::Null();
+		}
+
+		return EncodeBufferHandle(m_uniformStreamBuffer.GetBufferHandle(), streamOffset);
 	}
 
 
@@ -1090,41 +1116,42 @@ namespace moe
 	}
 
 
-	void OpenGLGraphicsDevice::BindTextureUnitToProgramUniform(GLuint shaderProgramID, int textureUnitIndex, TextureHandle texHandle, const char* uniformName)
+	void OpenGLGraphicsDevice::BindTextureUnitToProgramSampler(const OpenGLShaderProgram& program, uint32_t samplerSlot, int textureUnitIndex, TextureHandle texHandle)
 	{
-		glBindTextureUnit(textureUnitIndex, texHandle.Get());
-		glProgramUniform1i(shaderProgramID, glGetUniformLocation(shaderProgramID, uniformName), textureUnitIndex);
+		// The driver is free to optimize out samplers the shader never reads : that's not an error, there's just nothing to bind.
+		if (samplerSlot == OpenGLShaderProgram::ms_INVALID_SLOT)
+		{
+			return;
+		}
+
+		m_stateCache.BindTextureUnit(textureUnitIndex, m_textureStreamer.ResolveTexture(texHandle.Get()));
+
+		program.SetSamplerTextureUnit(samplerSlot, textureUnitIndex);
 	}
 
 
 	void OpenGLGraphicsDevice::BindTextureUnit(int textureBindingPoint, TextureHandle texHandle)
 	{
-		glBindTextureUnit(textureBindingPoint, texHandle.Get());
-
+		m_stateCache.BindTextureUnit(textureBindingPoint, m_textureStreamer.ResolveTexture(texHandle.Get()));
 	}
 
 
 	PipelineHandle OpenGLGraphicsDevice::CreatePipeline(PipelineDescriptor& pipelineDesc)
 	{
-		// TODO: make a move version (or take a PipelineDescriptor without ref and move it)
-		// TODO: we should store a "OpenGLPipelineDescriptor" to avoid having to translate pipeline values on every SetPipeline.
-		FreelistID pipelineID = m_pipelines.Add(pipelineDesc);
+		// Translate the pipeline once and for all, so SetPipeline only has to compare GL values against the state cache.
+		FreelistID pipelineID = m_pipelines.Add(OpenGLPipeline::Translate(pipelineDesc));
 		return pipelineID.ToHandle<PipelineHandle>();
 	}
 
 
 	void OpenGLGraphicsDevice::SetPipeline(PipelineHandle pipeHandle)
 	{
-		const PipelineDescriptor& pipelineDesc = m_pipelines.Lookup(pipeHandle.Get() - 1);
-
-		// Program the OpenGL pipeline to fit the description of the given pipeline.
-		OpenGLPipeline::SetBlendState(pipelineDesc.m_blendStateDesc);
-
-		OpenGLPipeline::SetDepthStencilState(pipelineDesc.m_depthStencilStateDesc);
+		const OpenGLPipelineState& pipelineState = m_pipelines.Lookup(pipeHandle.Get() - 1);
 
-		OpenGLPipeline::SetRasterizerState(pipelineDesc.m_rasterizerStateDesc);
+		// Program the OpenGL pipeline to fit the description of the given pipeline. Only what changed is actually sent to the driver.
+		m_stateCache.SetPipelineState(pipelineState);
 
-		m_primitiveTopology = OpenGLPipeline::GetOpenGLPrimitiveTopology(pipelineDesc.m_topology);
+		m_primitiveTopology = pipelineState.m_topology;
 	}
 
 
@@ -1227,7 +1254,7 @@ namespace moe
 	void OpenGLGraphicsDevice::BindSamplerToTextureUnit(int textureBindingPoint, SamplerHandle samplerHandle)
 	{
 		auto [samplerID, _ ] = DecodeSamplerHandle(samplerHandle);
-		glBindSampler(textureBindingPoint, samplerID);
+		m_stateCache.BindSampler(textureBindingPoint, samplerID);
 	}
 
 
@@ -1246,9 +1273,13 @@ namespace moe
 	}
 
 
-	DeviceBufferHandle OpenGLGraphicsDevice::EncodeBufferHandle(uint32_t bufferID, uint32_t bufferOffset)
+	DeviceBufferHandle OpenGLGraphicsDevice::EncodeBufferHandle(uint32_t bufferID, uint32_t bufferOffset, uint32_t arenaIdx)
 	{
-		uint64_t handleValue = (uint64_t)bufferID << 32;
+		// The handle looks like : | arena index (8 bits) | buffer ID (24 bits) | offset in buffer (32 bits) |
+		MOE_DEBUG_ASSERT(bufferID <= ms_BUFFER_ID_MASK && arenaIdx <= OpenGLBufferPool::ms_DEDICATED_ARENA);
+
+		uint64_t handleValue = (uint64_t)arenaIdx << 56;
+		handleValue |= (uint64_t)bufferID << 32;
 		handleValue |= bufferOffset;
 		return DeviceBufferHandle{ handleValue };
 	}
@@ -1258,12 +1289,20 @@ namespace moe
 		const RenderObjectHandle<std::uint64_t>& handle)
 	{
 		uint64_t handleVal = handle.Get();
-		uint32_t bufferID = handleVal >> 32;
+		uint32_t bufferID = (handleVal >> 32) & ms_BUFFER_ID_MASK;
 		uint32_t bufferOffset = (uint32_t)handleVal;
 		return {bufferID, bufferOffset};
 	}
 
 
+	OpenGLPoolAllocation OpenGLGraphicsDevice::DecodePoolAllocation(DeviceBufferHandle handle)
+	{
+		auto [bufferID, bufferOffset] = DecodeBufferHandle(handle);
+		const uint32_t arenaIdx = (uint32_t)(handle.Get() >> 56);
+		return { bufferID, bufferOffset, arenaIdx };
+	}
+
+
 }
 
 #endif
\ No newline at end of file
@@ -21,7 +21,8 @@
 #include "Graphics/VertexLayout/OpenGL/OpenGLVertexLayout.h"
 #include "Graphics/VertexLayout/OpenGL/OpenGLVertexLayoutComparator.h"
 
-#include "Graphics/GraphicsAllocator/OpenGL/OpenGLBuddyAllocator.h"
+#include "Graphics/GraphicsAllocator/OpenGL/OpenGLBufferPool.h"
+#include "Graphics/GraphicsAllocator/OpenGL/OpenGLStreamingRingBuffer.h"
 
 #include "Graphics/Camera/ViewportHandle.h"
 #include "Graphics/Camera/ViewportDescriptor.h"
@@ -33,10 +34,14 @@
 
 #include "Graphics/Pipeline/PipelineHandle.h"
 
+#include "Graphics/Device/OpenGL/OpenGLStateCache.h"
+
 #include "Graphics/Swapchain/OpenGL/OpenGLSwapchain.h"
 
 #include "Graphics/Sampler/OpenGL/OpenGLSampler.h"
 
+#include "Graphics/Texture/OpenGL/OpenGLTextureStreamer.h"
+
 #include "Monocle_Graphics_Export.h"
 
 
@@ -89,6 +94,7 @@ namespace moe
 		 */
 		Monocle_Graphics_API bool	RemoveShaderProgram(ShaderProgramHandle programHandle) override
 		{
+			m_stateCache.ForgetProgram(programHandle.Get());
 			return m_shaderManager.DestroyProgram(programHandle);
 		}
 
@@ -101,6 +107,8 @@ namespace moe
 
 		GLuint	GetShaderProgramID(ShaderProgramHandle programHandle);
 
+		[[nodiscard]] const OpenGLShaderProgram*	GetShaderProgram(ShaderProgramHandle programHandle) const;
+
 
 		Monocle_Graphics_API [[nodiscard]] VertexLayoutHandle	CreateVertexLayout(const VertexLayoutDescriptor& desc) override;
 		Monocle_Graphics_API [[nodiscard]] VertexLayoutHandle	CreateVertexLayout(InstancedVertexLayoutDescriptor desc) override; // TODO: remove
@@ -134,6 +142,15 @@ namespace moe
 
 		[[nodiscard]] DeviceBufferHandle	CreateUniformBuffer(const void* uniformData, size_t uniformDataSizeBytes) override;
 
+		void	DeleteUniformBuffer(DeviceBufferHandle ubHandle) override;
+
+		/**
+		 * \brief Storage buffers are not pooled : they are usually big and resized as a whole, so each of them gets a dedicated GL buffer.
+		 */
+		[[nodiscard]] DeviceBufferHandle	CreateStorageBuffer(const void* storageData, size_t storageDataSizeBytes) override;
+
+		void	DeleteStorageBuffer(DeviceBufferHandle ssboHandle) override;
+
 		[[nodiscard]] ResourceLayoutHandle	CreateResourceLayout(const ResourceLayoutDescriptor& newDesc) override;
 
 		[[nodiscard]] ResourceSetHandle		CreateResourceSet(const ResourceSetDescriptor& newDesc) override;
@@ -177,6 +194,24 @@ namespace moe
 		[[nodiscard]] TextureHandle	CreateCubemapTexture(const CubeMapTextureDescriptor& cubemapDesc) override;
 
 
+		/**
+		 * \brief Creates a texture whose file is decoded by the texture streamer's loader threads, then uploaded through a pixel unpack buffer
+		 * a few rows at a time at the end of each frame.
+		 * \return A handle usable right away (it binds a placeholder until the texture is ready), or Texture2DHandle::Null if the target format is invalid
+		 */
+		[[nodiscard]] Texture2DHandle	CreateTexture2DAsync(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded = nullptr) override;
+
+		/**
+		 * \brief Same as CreateTexture2DAsync, the six faces being decoded in parallel.
+		 */
+		[[nodiscard]] TextureHandle	CreateCubemapTextureAsync(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded = nullptr) override;
+
+		[[nodiscard]] TextureLoadState	GetTextureLoadState(TextureHandle texHandle) const override
+		{
+			return m_textureStreamer.GetLoadState(texHandle.Get());
+		}
+
+
 		void	GenerateTextureMipmaps(TextureHandle texHandle) override;
 
 		/**
@@ -191,10 +226,26 @@ namespace moe
 		[[nodiscard]] bool	IsPartOfUniformBlock(ShaderProgramHandle shaderHandle, const std::string& uniformBlockName, const std::string& uniformMemberName) const override;
 
 
-		void	BindProgramUniformBlock(GLuint shaderProgramID, const char* uniformBlockName, int uniformBlockBinding, DeviceBufferHandle ubHandle);
+		/**
+		 * \brief Binds a uniform buffer to a block of the program, using a block slot found with OpenGLShaderProgram::FindUniformBlockSlot.
+		 */
+		void	BindProgramUniformBlock(const OpenGLShaderProgram& program, uint32_t blockSlot, int uniformBlockBinding, DeviceBufferHandle ubHandle, uint32_t bufferSize = 0);
 
 		void	BindUniformBlock(unsigned int uniformBlockBinding, DeviceBufferHandle ubHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) override;
 
+		void	BindStorageBuffer(unsigned int storageBinding, DeviceBufferHandle ssboHandle, uint32_t bufferSize = 0, uint32_t relativeOffset = 0) override;
+
+		/**
+		 * \brief Writes the data in the persistently mapped streaming buffer. The returned handle is aligned on GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+		 */
+		[[nodiscard]] DeviceBufferHandle	StreamUniformData(const void* data, uint32_t dataSizeBytes) override;
+
+		void	EndFrame() override
+		{
+			m_textureStreamer.Update();
+			m_uniformStreamBuffer.EndFrame();
+		}
+
 		Monocle_Graphics_API void	UpdateUniformBuffer(DeviceBufferHandle ubHandle, const void* data, size_t dataSizeBytes, uint32_t relativeOffset = 0);
 
 		template <typename T>
@@ -204,7 +255,10 @@ namespace moe
 		}
 
 
-		void	BindTextureUnitToProgramUniform(GLuint shaderProgramID, int textureUnitIndex, TextureHandle texHandle, const char* uniformName);
+		/**
+		 * \brief Binds a texture to a unit and makes a sampler of the program read from it, using a sampler slot found with OpenGLShaderProgram::FindSamplerSlot.
+		 */
+		void	BindTextureUnitToProgramSampler(const OpenGLShaderProgram& program, uint32_t samplerSlot, int textureUnitIndex, TextureHandle texHandle);
 
 		void	BindTextureUnit(int textureBindingPoint, TextureHandle texHandle) override;
 
@@ -228,11 +282,34 @@ namespace moe
 		void	BindSamplerToTextureUnit(int textureBindingPoint, SamplerHandle samplerHandle) override;
 
 
+		/**
+		 * \brief How many state changes reached the driver, and how many were filtered out as redundant, since the last reset.
+		 */
+		[[nodiscard]] const OpenGLStateCacheStats&	GetStateCacheStats() const { return m_stateCache.GetStats(); }
+
+		void	ResetStateCacheStats() { m_stateCache.ResetStats(); }
 
-		static DeviceBufferHandle						EncodeBufferHandle(uint32_t bufferID, uint32_t bufferOffset);
+		/**
+		 * \brief Gives access to the state cache to code that needs to change GL state outside of the device.
+		 */
+		[[nodiscard]] OpenGLStateCache&	MutStateCache() { return m_stateCache; }
+
+		/**
+		 * \brief The on-disk cache of linked shader programs. It is initialized with its default directory : re-initialize it to use another one.
+		 */
+		[[nodiscard]] OpenGLProgramBinaryCache&	MutProgramBinaryCache() { return m_shaderManager.MutBinaryCache(); }
+
+
+
+		/**
+		 * \brief Buffer handles pack the buffer ID, the offset in the buffer, and the index of the pool arena the memory comes from (only needed to free it).
+		 */
+		static DeviceBufferHandle						EncodeBufferHandle(uint32_t bufferID, uint32_t bufferOffset, uint32_t arenaIdx = 0);
 
 		static std::pair<unsigned int, unsigned int>	DecodeBufferHandle(const RenderObjectHandle<std::uint64_t>& handle);
 
+		static OpenGLPoolAllocation						DecodePoolAllocation(DeviceBufferHandle handle);
+
 		static SamplerHandle							EncodeSamplerHandle(unsigned int samplerID, unsigned int freelistID);
 
 		static std::pair<uint16_t, uint16_t>			DecodeSamplerHandle(SamplerHandle handleToDecode);
@@ -240,10 +317,15 @@ namespace moe
 
 	private:
 
-		OpenGLBuddyAllocator			m_vertexBufferPool;
-		OpenGLBuddyAllocator			m_indexBufferPool;
-		OpenGLBuddyAllocator			m_uniformBufferPool;
+		static constexpr uint32_t	ms_BUFFER_ID_MASK = 0xFFFFFF;
+
+		OpenGLBufferPool				m_vertexBufferPool;
+		OpenGLBufferPool				m_indexBufferPool;
+		OpenGLBufferPool				m_uniformBufferPool;
 		HashMap<DeviceBufferHandle, std::uint32_t> m_uniformBufferSizes;
+		HashMap<DeviceBufferHandle, std::uint32_t> m_storageBufferSizes;
+
+		OpenGLStreamingRingBuffer		m_uniformStreamBuffer;
 
 		OpenGLShaderManager				m_shaderManager;
 
@@ -259,7 +341,7 @@ namespace moe
 		Freelist<ViewportDescriptor>	m_viewports;
 
 		// Same for pipelines - doesn't exist in OpenGL. Just keep the descriptors.
-		Freelist<PipelineDescriptor>	m_pipelines;
+		Freelist<OpenGLPipelineState>	m_pipelines;
 
 		OpenGLSwapchain	m_swapChain;
 
@@ -269,6 +351,10 @@ namespace moe
 		Vector<OpenGLSampler>	m_samplers;
 
 		GLenum	m_primitiveTopology = GL_TRIANGLES;	// Current topology used to draw geometry. Modified by SetPipeline
+
+		OpenGLStateCache	m_stateCache;
+
+		OpenGLTextureStreamer	m_textureStreamer;
 	};
 
 }
@@ -0,0 +1,353 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#ifdef MOE_OPENGL
+
+#include "OpenGLStateCache.h"
+
+namespace moe
+{
+	void OpenGLStateCache::Invalidate()
+	{
+		m_program = ms_UNKNOWN;
+		m_vertexArray = ms_UNKNOWN;
+
+		m_vertexArrayStates.Clear();
+		m_lastVertexArrayStateID = ms_UNKNOWN;
+		m_lastVertexArrayState = nullptr;
+
+		m_textures.Fill(ms_UNKNOWN);
+		m_samplers.Fill(ms_UNKNOWN);
+		m_uniformBufferRanges.Fill(BufferRange());
+		m_storageBufferRanges.Fill(BufferRange());
+
+		m_capabilities.Fill(-1);
+
+		m_blendSrcFactor = ms_UNKNOWN;
+		m_blendDestFactor = ms_UNKNOWN;
+		m_blendEquation = ms_UNKNOWN;
+
+		m_depthMask = ms_UNKNOWN;
+		m_depthFunc = ms_UNKNOWN;
+
+		m_stencilWriteMask.reset();
+		m_frontStencil.m_func = ms_UNKNOWN;
+		m_backStencil.m_func = ms_UNKNOWN;
+
+		m_cullFace = ms_UNKNOWN;
+		m_frontFace = ms_UNKNOWN;
+		m_polygonMode = ms_UNKNOWN;
+	}
+
+
+	void OpenGLStateCache::UseProgram(GLuint program)
+	{
+		if (Update(m_program, program))
+		{
+			glUseProgram(program);
+		}
+	}
+
+
+	void OpenGLStateCache::BindVertexArray(GLuint vao)
+	{
+		if (Update(m_vertexArray, vao))
+		{
+			glBindVertexArray(vao);
+		}
+	}
+
+
+	void OpenGLStateCache::VertexArrayVertexBuffer(GLuint vao, GLuint bindingIndex, GLuint buffer, GLintptr offset, GLsizei stride)
+	{
+		if (bindingIndex < ms_MAX_TRACKED_VERTEX_BINDINGS)
+		{
+			VertexBufferBinding& binding = MutVertexArrayState(vao).m_vertexBuffers[bindingIndex];
+			if (binding.m_buffer == buffer && binding.m_offset == offset && binding.m_stride == stride)
+			{
+				m_stats.m_elidedCalls++;
+				return;
+			}
+
+			binding.m_buffer = buffer;
+			binding.m_offset = offset;
+			binding.m_stride = stride;
+		}
+
+		m_stats.m_issuedCalls++;
+		glVertexArrayVertexBuffer(vao, bindingIndex, buffer, offset, stride);
+	}
+
+
+	void OpenGLStateCache::VertexArrayElementBuffer(GLuint vao, GLuint buffer)
+	{
+		if (Update(MutVertexArrayState(vao).m_elementBuffer, buffer))
+		{
+			glVertexArrayElementBuffer(vao, buffer);
+		}
+	}
+
+
+	void OpenGLStateCache::BindTextureUnit(GLuint unit, GLuint texture)
+	{
+		if (unit >= ms_MAX_TRACKED_TEXTURE_UNITS || Update(m_textures[unit], texture))
+		{
+			glBindTextureUnit(unit, texture);
+		}
+	}
+
+
+	void OpenGLStateCache::BindSampler(GLuint unit, GLuint sampler)
+	{
+		if (unit >= ms_MAX_TRACKED_TEXTURE_UNITS || Update(m_samplers[unit], sampler))
+		{
+			glBindSampler(unit, sampler);
+		}
+	}
+
+
+	void OpenGLStateCache::BindUniformBufferRange(GLuint bindingPoint, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		if (bindingPoint < ms_MAX_TRACKED_UBO_BINDINGS)
+		{
+			BufferRange& range = m_uniformBufferRanges[bindingPoint];
+			if (range.m_buffer == buffer && range.m_offset == offset && range.m_size == size)
+			{
+				m_stats.m_elidedCalls++;
+				return;
+			}
+
+			range.m_buffer = buffer;
+			range.m_offset = offset;
+			range.m_size = size;
+		}
+
+		m_stats.m_issuedCalls++;
+		glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer, offset, size);
+	}
+
+
+	void OpenGLStateCache::BindStorageBufferRange(GLuint bindingPoint, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		if (bindingPoint < ms_MAX_TRACKED_SSBO_BINDINGS)
+		{
+			BufferRange& range = m_storageBufferRanges[bindingPoint];
+			if (range.m_buffer == buffer && range.m_offset == offset && range.m_size == size)
+			{
+				m_stats.m_elidedCalls++;
+				return;
+			}
+
+			range.m_buffer = buffer;
+			range.m_offset = offset;
+			range.m_size = size;
+		}
+
+		m_stats.m_issuedCalls++;
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, bindingPoint, buffer, offset, size);
+	}
+
+
+	void OpenGLStateCache::SetPipelineState(const OpenGLPipelineState& pipelineState)
+	{
+		SetBlendState(pipelineState.m_blendState);
+		SetDepthStencilState(pipelineState.m_depthStencilState);
+		SetRasterizerState(pipelineState.m_rasterizerState);
+	}
+
+
+	void OpenGLStateCache::SetBlendState(const OpenGLBlendState& blendState)
+	{
+		SetCapability(Blend, GL_BLEND, blendState.m_enabled);
+
+		// Compare both factors at once as they are set by the same call
+		if (m_blendSrcFactor != blendState.m_srcFactor || m_blendDestFactor != blendState.m_destFactor)
+		{
+			m_blendSrcFactor = blendState.m_srcFactor;
+			m_blendDestFactor = blendState.m_destFactor;
+			m_stats.m_issuedCalls++;
+			glBlendFunc(blendState.m_srcFactor, blendState.m_destFactor);
+		}
+		else
+		{
+			m_stats.m_elidedCalls++;
+		}
+
+		if (Update(m_blendEquation, blendState.m_equation))
+		{
+			glBlendEquation(blendState.m_equation);
+		}
+	}
+
+
+	void OpenGLStateCache::SetDepthStencilState(const OpenGLDepthStencilState& dsState)
+	{
+		SetCapability(DepthTest, GL_DEPTH_TEST, dsState.m_depthTest);
+
+		if (Update(m_depthMask, (GLenum)dsState.m_depthWrite))
+		{
+			glDepthMask(dsState.m_depthWrite);
+		}
+
+		if (Update(m_depthFunc, dsState.m_depthFunc))
+		{
+			glDepthFunc(dsState.m_depthFunc);
+		}
+
+		SetCapability(StencilTest, GL_STENCIL_TEST, dsState.m_stencilTest);
+
+		if (Update(m_stencilWriteMask, dsState.m_stencilWriteMask))
+		{
+			glStencilMask(dsState.m_stencilWriteMask);
+		}
+
+		if (Update(m_frontStencil, dsState.m_front))
+		{
+			glStencilOpSeparate(GL_FRONT, dsState.m_front.m_stencilFail, dsState.m_front.m_depthFail, dsState.m_front.m_allPass);
+			glStencilFuncSeparate(GL_FRONT, dsState.m_front.m_func, dsState.m_front.m_ref, dsState.m_front.m_readMask);
+		}
+
+		if (Update(m_backStencil, dsState.m_back))
+		{
+			glStencilOpSeparate(GL_BACK, dsState.m_back.m_stencilFail, dsState.m_back.m_depthFail, dsState.m_back.m_allPass);
+			glStencilFuncSeparate(GL_BACK, dsState.m_back.m_func, dsState.m_back.m_ref, dsState.m_back.m_readMask);
+		}
+	}
+
+
+	void OpenGLStateCache::SetRasterizerState(const OpenGLRasterizerState& rsState)
+	{
+		SetCapability(CullFace, GL_CULL_FACE, rsState.m_cullEnabled);
+
+		if (rsState.m_cullEnabled && Update(m_cullFace, rsState.m_cullFace))
+		{
+			glCullFace(rsState.m_cullFace);
+		}
+
+		if (Update(m_frontFace, rsState.m_frontFace))
+		{
+			glFrontFace(rsState.m_frontFace);
+		}
+
+		if (Update(m_polygonMode, rsState.m_polygonMode))
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, rsState.m_polygonMode);
+		}
+
+		SetCapability(DepthClamp, GL_DEPTH_CLAMP, rsState.m_depthClamp);
+
+		SetCapability(ScissorTest, GL_SCISSOR_TEST, rsState.m_scissorTest);
+	}
+
+
+	void OpenGLStateCache::ForgetProgram(GLuint program)
+	{
+		if (m_program == program)
+		{
+			m_program = ms_UNKNOWN;
+		}
+	}
+
+
+	void OpenGLStateCache::ForgetVertexArray(GLuint vao)
+	{
+		if (m_vertexArray == vao)
+		{
+			m_vertexArray = ms_UNKNOWN;
+		}
+
+		if (m_lastVertexArrayStateID == vao)
+		{
+			m_lastVertexArrayStateID = ms_UNKNOWN;
+			m_lastVertexArrayState = nullptr;
+		}
+
+		m_vertexArrayStates.Erase(vao);
+	}
+
+
+	void OpenGLStateCache::ForgetBuffer(GLuint buffer)
+	{
+		for (auto& [vao, vaoState] : m_vertexArrayStates)
+		{
+			if (vaoState.m_elementBuffer == buffer)
+			{
+				vaoState.m_elementBuffer = ms_UNKNOWN;
+			}
+
+			for (VertexBufferBinding& binding : vaoState.m_vertexBuffers)
+			{
+				if (binding.m_buffer == buffer)
+				{
+					binding.m_buffer = ms_UNKNOWN;
+				}
+			}
+		}
+
+		for (BufferRange& range : m_uniformBufferRanges)
+		{
+			if (range.m_buffer == buffer)
+			{
+				range.m_buffer = ms_UNKNOWN;
+			}
+		}
+
+		for (BufferRange& range : m_storageBufferRanges)
+		{
+			if (range.m_buffer == buffer)
+			{
+				range.m_buffer = ms_UNKNOWN;
+			}
+		}
+	}
+
+
+	void OpenGLStateCache::ForgetTexture(GLuint texture)
+	{
+		for (GLuint& unitTexture : m_textures)
+		{
+			if (unitTexture == texture)
+			{
+				unitTexture = ms_UNKNOWN;
+			}
+		}
+	}
+
+
+	void OpenGLStateCache::ForgetSampler(GLuint sampler)
+	{
+		for (GLuint& unitSampler : m_samplers)
+		{
+			if (unitSampler == sampler)
+			{
+				unitSampler = ms_UNKNOWN;
+			}
+		}
+	}
+
+
+	void OpenGLStateCache::SetCapability(Capability capIdx, GLenum glCap, bool enabled)
+	{
+		if (Update(m_capabilities[capIdx], (int8_t)enabled))
+		{
+			enabled ? glEnable(glCap) : glDisable(glCap);
+		}
+	}
+
+
+	OpenGLStateCache::VertexArrayState& OpenGLStateCache::MutVertexArrayState(GLuint vao)
+	{
+		if (m_lastVertexArrayStateID == vao)
+		{
+			return *m_lastVertexArrayState;
+		}
+
+		// Inserting may rehash the map : only the pointer we are about to refresh was kept around.
+		auto vaoStateIt = m_vertexArrayStates.TryEmplace(vao).first;
+		m_lastVertexArrayStateID = vao;
+		m_lastVertexArrayState = &vaoStateIt->second;
+
+		return vaoStateIt->second;
+	}
+}
+
+#endif // MOE_OPENGL
@@ -0,0 +1,198 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_OPENGL
+
+#include "Core/Containers/Array/Array.h"
+#include "Core/Containers/HashMap/HashMap.h"
+
+#include "Graphics/Pipeline/OpenGL/OpenGLPipeline.h"
+
+#include "Monocle_Graphics_Export.h"
+
+#include <glad/glad.h>
+
+#include <optional>
+
+namespace moe
+{
+	/**
+	 * \brief Counts the state updates that went through the state cache (an update is usually one GL call,
+	 * but can be a couple, like the stencil op and function of a face).
+	 * "Elided" updates are the ones that were skipped because they would not have changed anything.
+	 */
+	struct OpenGLStateCacheStats
+	{
+		uint64_t	m_issuedCalls = 0;
+		uint64_t	m_elidedCalls = 0;
+	};
+
+
+	/**
+	 * \brief A shadow copy of the OpenGL context state, used to filter out redundant state changes.
+	 * It tracks the bound program, VAO, vertex and element buffers of each VAO, texture units, samplers,
+	 * uniform buffer ranges and the fixed-function state set by pipelines.
+	 * Everything starts as "unknown", so the first call always reaches the driver.
+	 * This only works if all the state changes go through it : any GL call made behind its back must be followed by Invalidate.
+	 */
+	class OpenGLStateCache
+	{
+	public:
+
+		OpenGLStateCache()
+		{
+			Invalidate();
+		}
+
+		/**
+		 * \brief Forgets everything : next calls will all be issued.
+		 */
+		Monocle_Graphics_API void	Invalidate();
+
+
+		void	UseProgram(GLuint program);
+
+		void	BindVertexArray(GLuint vao);
+
+		void	VertexArrayVertexBuffer(GLuint vao, GLuint bindingIndex, GLuint buffer, GLintptr offset, GLsizei stride);
+
+		void	VertexArrayElementBuffer(GLuint vao, GLuint buffer);
+
+		void	BindTextureUnit(GLuint unit, GLuint texture);
+
+		void	BindSampler(GLuint unit, GLuint sampler);
+
+		void	BindUniformBufferRange(GLuint bindingPoint, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+		void	BindStorageBufferRange(GLuint bindingPoint, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+
+		/**
+		 * \brief Applies a pipeline state, only issuing the calls for what differs from the current state.
+		 */
+		void	SetPipelineState(const OpenGLPipelineState& pipelineState);
+
+		void	SetBlendState(const OpenGLBlendState& blendState);
+
+		void	SetDepthStencilState(const OpenGLDepthStencilState& dsState);
+
+		void	SetRasterizerState(const OpenGLRasterizerState& rsState);
+
+
+		/**
+		 * \brief To call when deleting GL objects, so that a recycled name never gets mistaken for a bound one.
+		 */
+		void	ForgetProgram(GLuint program);
+		void	ForgetVertexArray(GLuint vao);
+		void	ForgetBuffer(GLuint buffer);
+		void	ForgetTexture(GLuint texture);
+		void	ForgetSampler(GLuint sampler);
+
+
+		[[nodiscard]] const OpenGLStateCacheStats&	GetStats() const { return m_stats; }
+
+		void	ResetStats() { m_stats = OpenGLStateCacheStats(); }
+
+
+	private:
+
+		// 0 is a valid name in OpenGL (it means "unbound") so we need another value for unknown state.
+		// OpenGL never uses it as a name or an enum : values that can really take it (like masks) are std::optionals instead.
+		static constexpr GLuint	ms_UNKNOWN = UINT32_MAX;
+
+		// Bindings past these limits are not tracked and always issued.
+		static const uint32_t	ms_MAX_TRACKED_TEXTURE_UNITS = 32;
+		static const uint32_t	ms_MAX_TRACKED_UBO_BINDINGS = 64;
+		static const uint32_t	ms_MAX_TRACKED_SSBO_BINDINGS = 16;
+		static const uint32_t	ms_MAX_TRACKED_VERTEX_BINDINGS = 16;
+
+		enum Capability : uint8_t
+		{
+			Blend = 0,
+			DepthTest,
+			StencilTest,
+			CullFace,
+			DepthClamp,
+			ScissorTest,
+			CapabilityCount
+		};
+
+		struct VertexBufferBinding
+		{
+			GLuint		m_buffer = ms_UNKNOWN;
+			GLintptr	m_offset = 0;
+			GLsizei		m_stride = 0;
+		};
+
+		struct VertexArrayState
+		{
+			GLuint	m_elementBuffer = ms_UNKNOWN;
+			Array<VertexBufferBinding, ms_MAX_TRACKED_VERTEX_BINDINGS>	m_vertexBuffers;
+		};
+
+		struct BufferRange
+		{
+			GLuint		m_buffer = ms_UNKNOWN;
+			GLintptr	m_offset = 0;
+			GLsizeiptr	m_size = 0;
+		};
+
+		/**
+		 * \brief Updates a tracked value and tells whether the GL call has to be issued. Keeps the stats up to date.
+		 * The tracked value can be a std::optional, for values where empty means unknown.
+		 */
+		template <typename Tracked, typename T>
+		bool	Update(Tracked& tracked, const T& newValue)
+		{
+			if (tracked == newValue)
+			{
+				m_stats.m_elidedCalls++;
+				return false;
+			}
+
+			tracked = newValue;
+			m_stats.m_issuedCalls++;
+			return true;
+		}
+
+		void	SetCapability(Capability capIdx, GLenum glCap, bool enabled);
+
+		VertexArrayState&	MutVertexArrayState(GLuint vao);
+
+
+		OpenGLStateCacheStats	m_stats;
+
+		GLuint	m_program = ms_UNKNOWN;
+		GLuint	m_vertexArray = ms_UNKNOWN;
+
+		HashMap<GLuint, VertexArrayState>	m_vertexArrayStates;
+		GLuint								m_lastVertexArrayStateID = ms_UNKNOWN;
+		VertexArrayState*					m_lastVertexArrayState = nullptr;
+
+		Array<GLuint, ms_MAX_TRACKED_TEXTURE_UNITS>	m_textures;
+		Array<GLuint, ms_MAX_TRACKED_TEXTURE_UNITS>	m_samplers;
+		Array<BufferRange, ms_MAX_TRACKED_UBO_BINDINGS>	m_uniformBufferRanges;
+		Array<BufferRange, ms_MAX_TRACKED_SSBO_BINDINGS>	m_storageBufferRanges;
+
+		// Fixed-function state. -1 means unknown for capabilities.
+		Array<int8_t, CapabilityCount>	m_capabilities;
+
+		GLenum		m_blendSrcFactor = ms_UNKNOWN;
+		GLenum		m_blendDestFactor = ms_UNKNOWN;
+		GLenum		m_blendEquation = ms_UNKNOWN;
+
+		GLenum		m_depthMask = ms_UNKNOWN;
+		GLenum		m_depthFunc = ms_UNKNOWN;
+
+		std::optional<GLuint>	m_stencilWriteMask;	// Any mask is valid, ms_UNKNOWN included
+		OpenGLStencilFaceState	m_frontStencil;
+		OpenGLStencilFaceState	m_backStencil;
+
+		GLenum		m_cullFace = ms_UNKNOWN;
+		GLenum		m_frontFace = ms_UNKNOWN;
+		GLenum		m_polygonMode = ms_UNKNOWN;
+	};
+}
+
+#endif // MOE_OPENGL
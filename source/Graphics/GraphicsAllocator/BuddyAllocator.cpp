@@ -0,0 +1,201 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "BuddyAllocator.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Core/Misc/moeBits.h"
+
+#include <algorithm> // min
+#include <cstring> // memset
+
+
+namespace moe
+{
+	BuddyAllocator::BuddyAllocator(uint32_t poolSize)
+	{
+		Reset(poolSize);
+	}
+
+
+	void BuddyAllocator::Reset(uint32_t poolSize)
+	{
+		MOE_ASSERT(poolSize <= ms_MAX_POOL_SIZE);
+		const uint32_t numLeaves = (poolSize + ms_LEAF_SIZE - 1) / ms_LEAF_SIZE;
+		m_numLevels = std::min(CeilLog2(numLeaves) + 1, ms_MAX_LEVELS);
+		m_allocatedSize = ms_LEAF_SIZE << (m_numLevels - 1);
+		m_numAllocations = 0;
+
+		// At first, only the largest block is in the free list.
+		ResetFreeLists();
+		PushFreeBlock(0, 0);
+	}
+
+
+	void BuddyAllocator::Clear()
+	{
+		m_allocatedSize = 0;
+		m_numLevels = 0;
+		m_numAllocations = 0;
+
+		ResetFreeLists();
+	}
+
+
+	uint32_t BuddyAllocator::TryAllocate(uint32_t size)
+	{
+		// Find in which level we should search a free block
+		const uint32_t wantedLevel = GetDataBlockLevel(size);
+
+		// Lower levels have bigger blocks : look for the deepest level, up to the wanted one, that has a free block.
+		const uint32_t candidateLevels = (wantedLevel < m_numLevels ? m_freeLevelsMask & ((2u << wantedLevel) - 1) : 0);
+		if (candidateLevels == 0)
+		{
+			return ms_INVALID_OFFSET;
+		}
+
+		uint32_t level = FindLastSet64(candidateLevels);
+		uint32_t blockUniqueIdx = PopFreeBlock(level);
+
+		// Cut this block in half on all levels until we reach destination level, keeping the left half and freeing the right one.
+		while (level < wantedLevel)
+		{
+			blockUniqueIdx = 2 * blockUniqueIdx + 1;
+			level++;
+			PushFreeBlock(level, blockUniqueIdx + 1);
+		}
+
+		const uint32_t offset = GetLevelIndexFromUniqueIdx(level, blockUniqueIdx) * GetLevelBlockSize(level);
+
+		m_allocatedLevels[offset / ms_LEAF_SIZE] = (uint8_t)level;
+		m_numAllocations++;
+
+		return offset;
+	}
+
+
+	bool BuddyAllocator::Free(uint32_t offset)
+	{
+		if (!MOE_ASSERT(offset < m_allocatedSize && offset % ms_LEAF_SIZE == 0))
+		{
+			return false;
+		}
+
+		// We stored the level of the block when allocating it.
+		uint8_t& allocatedLevel = m_allocatedLevels[offset / ms_LEAF_SIZE];
+		if (allocatedLevel == ms_NOT_ALLOCATED)
+		{
+			return false;
+		}
+
+		uint32_t level = allocatedLevel;
+		allocatedLevel = ms_NOT_ALLOCATED;
+		m_numAllocations--;
+
+		uint32_t blockUniqueIdx = GetUniqueIndexForLevel(level, offset / GetLevelBlockSize(level));
+
+		// Merge with the buddy as long as it's free too. Level 0 is the "root" block, the only one without a buddy.
+		while (level != 0)
+		{
+			const uint32_t buddyUniqueIdx = GetBuddyIndex(blockUniqueIdx);
+			if (!IsBlockFree(buddyUniqueIdx))
+				break;
+
+			RemoveFreeBlock(level, buddyUniqueIdx);
+
+			blockUniqueIdx = (blockUniqueIdx - 1) / 2; // go up to the parent
+			level--;
+		}
+
+		PushFreeBlock(level, blockUniqueIdx);
+		return true;
+	}
+
+
+	uint32_t BuddyAllocator::GetDataBlockLevel(uint32_t dataBlockSize) const
+	{
+		// How many times we have to double the leaf size to fit the data.
+		const uint32_t numLeaves = (dataBlockSize / ms_LEAF_SIZE) + (dataBlockSize % ms_LEAF_SIZE != 0);
+		const uint32_t levelsAboveLeaves = CeilLog2(numLeaves);
+
+		if (levelsAboveLeaves >= m_numLevels)
+		{
+			return m_numLevels;
+		}
+
+		// return m_numLevels-1 - computed level because the index is "reversed" - first level is "root" block, the biggest !
+		return (m_numLevels-1 - levelsAboveLeaves);
+	}
+
+
+	void BuddyAllocator::PushFreeBlock(uint32_t level, uint32_t uniqueBlockIdx)
+	{
+		const uint16_t oldHead = m_freeListHeads[level];
+
+		m_freePrev[uniqueBlockIdx] = ms_NULL_BLOCK;
+		m_freeNext[uniqueBlockIdx] = oldHead;
+
+		if (oldHead != ms_NULL_BLOCK)
+		{
+			m_freePrev[oldHead] = (uint16_t)uniqueBlockIdx;
+		}
+
+		m_freeListHeads[level] = (uint16_t)uniqueBlockIdx;
+		m_freeLevelsMask |= (1u << level);
+		m_freeBlockBits[uniqueBlockIdx / 64] |= (1ull << (uniqueBlockIdx % 64));
+	}
+
+
+	uint32_t BuddyAllocator::PopFreeBlock(uint32_t level)
+	{
+		const uint32_t head = m_freeListHeads[level];
+		MOE_DEBUG_ASSERT(head != ms_NULL_BLOCK);
+
+		RemoveFreeBlock(level, head);
+		return head;
+	}
+
+
+	void BuddyAllocator::RemoveFreeBlock(uint32_t level, uint32_t uniqueBlockIdx)
+	{
+		MOE_DEBUG_ASSERT(IsBlockFree(uniqueBlockIdx));
+
+		const uint16_t prev = m_freePrev[uniqueBlockIdx];
+		const uint16_t next = m_freeNext[uniqueBlockIdx];
+
+		if (prev != ms_NULL_BLOCK)
+		{
+			m_freeNext[prev] = next;
+		}
+		else
+		{
+			m_freeListHeads[level] = next;
+			if (next == ms_NULL_BLOCK)
+			{
+				m_freeLevelsMask &= ~(1u << level);
+			}
+		}
+
+		if (next != ms_NULL_BLOCK)
+		{
+			m_freePrev[next] = prev;
+		}
+
+		m_freeBlockBits[uniqueBlockIdx / 64] &= ~(1ull << (uniqueBlockIdx % 64));
+	}
+
+
+	void BuddyAllocator::ResetFreeLists()
+	{
+		m_freeLevelsMask = 0;
+
+		for (uint16_t& head : m_freeListHeads)
+		{
+			head = ms_NULL_BLOCK;
+		}
+
+		std::memset(m_freeBlockBits, 0, sizeof(m_freeBlockBits));
+		std::memset(m_allocatedLevels, ms_NOT_ALLOCATED, sizeof(m_allocatedLevels));
+	}
+
+}
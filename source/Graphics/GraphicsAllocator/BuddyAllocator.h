@@ -0,0 +1,124 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+#include "Monocle_Graphics_Export.h"
+
+
+namespace moe
+{
+	/**
+	 * \brief The bookkeeping of a buddy allocator : it only hands out offsets in a pool of memory it does not own.
+		It is graphics API agnostic, so that it can be tested and measured without a rendering context :
+		graphics allocators (like OpenGLBuddyAllocator) pair it with the actual buffer.
+		Free blocks of each level are kept in intrusive doubly-linked lists (the links are stored in arrays indexed by block),
+		and a bitmask tells which levels have free blocks : finding, splitting and merging blocks never needs a search.
+	 */
+	class BuddyAllocator
+	{
+
+	public:
+
+		BuddyAllocator() = default;
+
+		Monocle_Graphics_API explicit BuddyAllocator(uint32_t poolSize);
+
+		/**
+		 * \brief Frees everything and sets the size of the pool.
+		 * \param poolSize Rounded up to a power of two between ms_MIN_POOL_SIZE and ms_MAX_POOL_SIZE.
+		 */
+		Monocle_Graphics_API void	Reset(uint32_t poolSize = ms_MAX_POOL_SIZE);
+
+		/**
+		 * \brief Forgets the pool : nothing can be allocated anymore until the next Reset.
+		 */
+		Monocle_Graphics_API void	Clear();
+
+		/**
+		 * \return The offset of the allocated block, or ms_INVALID_OFFSET if there is not enough memory
+		 */
+		Monocle_Graphics_API [[nodiscard]] uint32_t	TryAllocate(uint32_t size);
+
+		/**
+		 * \return false if this offset was not allocated
+		 */
+		Monocle_Graphics_API bool	Free(uint32_t offset);
+
+		[[nodiscard]] uint32_t	GetPoolSize() const { return m_allocatedSize; }
+
+		[[nodiscard]] uint32_t	GetNumAllocations() const { return m_numAllocations; }
+
+
+		static constexpr uint32_t	ms_INVALID_OFFSET = (uint32_t)-1;
+
+		static constexpr uint32_t	ms_MIN_POOL_SIZE = 4096;
+		static constexpr uint32_t	ms_MAX_POOL_SIZE = 4096 << 12;
+
+	private:
+
+		static const uint32_t	ms_LEAF_SIZE = 4096; // The size of the smallest possible block allocated.
+		static constexpr uint32_t	ms_MAX_LEVELS = 13; // The maximum number of levels the buddy allocator can subdivide into.
+
+		static const uint32_t	ms_NUM_BLOCKS = (1 << ms_MAX_LEVELS) - 1; // Total number of blocks in the tree, all levels included.
+		static const uint32_t	ms_NUM_LEAVES = 1 << (ms_MAX_LEVELS - 1);
+
+		static const uint16_t	ms_NULL_BLOCK = UINT16_MAX;
+		static const uint8_t	ms_NOT_ALLOCATED = UINT8_MAX;
+
+		static_assert(ms_NUM_BLOCKS < ms_NULL_BLOCK, "Block indices are stored on 16 bits");
+		static_assert(ms_MIN_POOL_SIZE == ms_LEAF_SIZE && ms_MAX_POOL_SIZE == ms_LEAF_SIZE << (ms_MAX_LEVELS - 1), "Pool size bounds out of sync with the tree");
+
+		/**
+		 * \brief Returns the level of the smallest block that can hold this size, or m_numLevels if it's too big for the pool.
+		 */
+		uint32_t	GetDataBlockLevel(uint32_t dataBlockSize) const;
+
+		/**
+		 * \brief Blocks are numbered in breadth-first order : the children of block i are 2i+1 and 2i+2, its buddy is the other child of its parent.
+		 */
+		static uint32_t	GetUniqueIndexForLevel(uint32_t level, uint32_t levelBlockIdx)	{ return (1u << level) - 1 + levelBlockIdx; }
+
+		static uint32_t	GetLevelIndexFromUniqueIdx(uint32_t level, uint32_t uniqueBlockIdx)	{ return uniqueBlockIdx - ((1u << level) - 1); }
+
+		uint32_t	GetLevelBlockSize(uint32_t level) const	{ return m_allocatedSize >> level; }
+
+		static uint32_t	GetBuddyIndex(uint32_t uniqueBlockIdx)	{ return (uniqueBlockIdx & 1) ? uniqueBlockIdx + 1 : uniqueBlockIdx - 1; }
+
+
+		void		PushFreeBlock(uint32_t level, uint32_t uniqueBlockIdx);
+
+		uint32_t	PopFreeBlock(uint32_t level);
+
+		void		RemoveFreeBlock(uint32_t level, uint32_t uniqueBlockIdx);
+
+		bool		IsBlockFree(uint32_t uniqueBlockIdx) const	{ return (m_freeBlockBits[uniqueBlockIdx / 64] >> (uniqueBlockIdx % 64)) & 1; }
+
+		void		ResetFreeLists();
+
+
+		// Total size of the pool
+		uint32_t	m_allocatedSize = 0;
+
+		// Number of levels actually used, depending on the pool size (the leaves are always ms_LEAF_SIZE)
+		uint32_t	m_numLevels = 0;
+
+		uint32_t	m_numAllocations = 0;
+
+		// Bit N is set when there is at least one free block in level N.
+		uint32_t	m_freeLevelsMask = 0;
+
+		uint16_t	m_freeListHeads[ms_MAX_LEVELS];
+
+		// One bit per block, set when the block is in a free list. Allows to check if a buddy can be merged in O(1).
+		uint64_t	m_freeBlockBits[(ms_NUM_BLOCKS + 63) / 64];
+
+		// Free list links, indexed by unique block index. Only meaningful for free blocks.
+		uint16_t	m_freePrev[ms_NUM_BLOCKS];
+		uint16_t	m_freeNext[ms_NUM_BLOCKS];
+
+		// The level of the block allocated at each leaf-sized offset (only set on the first leaf of each allocated block).
+		uint8_t		m_allocatedLevels[ms_NUM_LEAVES];
+	};
+
+}
@@ -0,0 +1,185 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#ifdef MOE_OPENGL
+
+#include "OpenGLBufferPool.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Core/Log/moeLog.h"
+
+#include <algorithm> // min, find
+
+
+namespace moe
+{
+	OpenGLBufferPool::~OpenGLBufferPool()
+	{
+		DeleteMemory();
+	}
+
+
+	void OpenGLBufferPool::Initialize(GLbitfield storageFlags, uint32_t arenaSize, uint32_t dedicatedThreshold)
+	{
+		MOE_ASSERT(m_numArenas == 0);
+
+		m_storageFlags = storageFlags;
+		m_arenaSize = std::min(arenaSize, OpenGLBuddyAllocator::ms_MAX_POOL_SIZE);
+		m_dedicatedThreshold = std::min(dedicatedThreshold, m_arenaSize);
+
+		AddArena();
+	}
+
+
+	OpenGLPoolAllocation OpenGLBufferPool::Allocate(const void* data, uint32_t size)
+	{
+		if (size >= m_dedicatedThreshold)
+		{
+			return AllocateDedicated(data, size);
+		}
+
+		// Favor the oldest arenas, so that the newest ones have a chance to become empty and be freed.
+		for (uint32_t iArena = 0; iArena < m_arenas.Size(); ++iArena)
+		{
+			if (m_arenas[iArena] == nullptr)
+				continue;
+
+			const uint32_t offset = m_arenas[iArena]->TryAllocate(data, size);
+			if (offset != OpenGLBuddyAllocator::ms_INVALID_OFFSET)
+			{
+				return { m_arenas[iArena]->GetBufferHandle(), offset, iArena };
+			}
+		}
+
+		// All arenas are full : we need a new one.
+		const uint32_t newArenaIdx = AddArena();
+		if (newArenaIdx == ms_MAX_ARENAS)
+		{
+			MOE_ERROR(ChanGraphics, "Buffer pool cannot create more than %u arenas : allocation of %u bytes failed.", ms_MAX_ARENAS, size);
+			MOE_DEBUG_ASSERT(false);
+			return {};
+		}
+
+		const uint32_t offset = m_arenas[newArenaIdx]->TryAllocate(data, size);
+		MOE_ASSERT(offset != OpenGLBuddyAllocator::ms_INVALID_OFFSET); // cannot fail, as size is lower than the dedicated threshold
+
+		return { m_arenas[newArenaIdx]->GetBufferHandle(), offset, newArenaIdx };
+	}
+
+
+	void OpenGLBufferPool::Free(const OpenGLPoolAllocation& allocation)
+	{
+		if (allocation.m_arenaIdx == ms_DEDICATED_ARENA)
+		{
+			auto bufferIt = std::find(m_dedicatedBuffers.begin(), m_dedicatedBuffers.end(), allocation.m_buffer);
+			if (!MOE_ASSERT(bufferIt != m_dedicatedBuffers.end()))
+			{
+				return;
+			}
+
+			NotifyBufferDeleted(allocation.m_buffer);
+			glDeleteBuffers(1, &allocation.m_buffer);
+			m_dedicatedBuffers.EraseBySwap(bufferIt);
+			return;
+		}
+
+		if (!MOE_ASSERT(allocation.m_arenaIdx < m_arenas.Size() && m_arenas[allocation.m_arenaIdx] != nullptr))
+		{
+			return;
+		}
+
+		std::unique_ptr<OpenGLBuddyAllocator>& arena = m_arenas[allocation.m_arenaIdx];
+		MOE_DEBUG_ASSERT(arena->GetBufferHandle() == allocation.m_buffer);
+
+		arena->Free(allocation.m_offset);
+
+		// Give empty arenas back, but keep the first one around : there's a good chance it will be needed again soon.
+		if (arena->GetNumAllocations() == 0 && allocation.m_arenaIdx != 0)
+		{
+			NotifyBufferDeleted(arena->GetBufferHandle());
+			arena.reset();
+			m_numArenas--;
+		}
+	}
+
+
+	void OpenGLBufferPool::DeleteMemory()
+	{
+		for (const std::unique_ptr<OpenGLBuddyAllocator>& arena : m_arenas)
+		{
+			if (arena != nullptr)
+			{
+				NotifyBufferDeleted(arena->GetBufferHandle());
+			}
+		}
+
+		m_arenas.Clear();
+		m_numArenas = 0;
+
+		if (false == m_dedicatedBuffers.Empty())
+		{
+			for (GLuint dedicatedBuffer : m_dedicatedBuffers)
+			{
+				NotifyBufferDeleted(dedicatedBuffer);
+			}
+
+			glDeleteBuffers((GLsizei)m_dedicatedBuffers.Size(), m_dedicatedBuffers.Data());
+			m_dedicatedBuffers.Clear();
+		}
+	}
+
+
+	OpenGLPoolAllocation OpenGLBufferPool::AllocateDedicated(const void* data, uint32_t size)
+	{
+		GLuint bufferID = 0;
+		glCreateBuffers(1, &bufferID);
+
+		if (!MOE_ASSERT(bufferID != 0))
+		{
+			return {};
+		}
+
+		glNamedBufferStorage(bufferID, size, data, m_storageFlags);
+
+		m_dedicatedBuffers.PushBack(bufferID);
+
+		return { bufferID, 0, ms_DEDICATED_ARENA };
+	}
+
+
+	uint32_t OpenGLBufferPool::AddArena()
+	{
+		// Reuse the slot of a freed arena first.
+		uint32_t arenaIdx = 0;
+		while (arenaIdx < m_arenas.Size() && m_arenas[arenaIdx] != nullptr)
+		{
+			arenaIdx++;
+		}
+
+		if (arenaIdx == ms_MAX_ARENAS)
+		{
+			return ms_MAX_ARENAS;
+		}
+
+		if (arenaIdx == m_arenas.Size())
+		{
+			m_arenas.EmplaceBack();
+		}
+
+		m_arenas[arenaIdx] = std::make_unique<OpenGLBuddyAllocator>(m_storageFlags, m_arenaSize);
+		m_numArenas++;
+
+		return arenaIdx;
+	}
+
+
+	void OpenGLBufferPool::NotifyBufferDeleted(GLuint buffer) const
+	{
+		if (m_onBufferDeleted.IsSet())
+		{
+			m_onBufferDeleted(buffer);
+		}
+	}
+}
+
+#endif // MOE_OPENGL
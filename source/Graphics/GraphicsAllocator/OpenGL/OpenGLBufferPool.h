@@ -0,0 +1,123 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_OPENGL
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Delegates/Delegate.h"
+
+#include "Graphics/GraphicsAllocator/OpenGL/OpenGLBuddyAllocator.h"
+
+#include "Monocle_Graphics_Export.h"
+
+#ifdef MOE_STD_SUPPORT
+#include <memory> // unique_ptr
+#endif
+
+
+namespace moe
+{
+	/**
+	 * \brief Where an allocation of an OpenGLBufferPool lives : which buffer, where in it, and which arena it came from.
+	 */
+	struct OpenGLPoolAllocation
+	{
+		GLuint		m_buffer = 0;
+		uint32_t	m_offset = OpenGLBuddyAllocator::ms_INVALID_OFFSET;
+		uint32_t	m_arenaIdx = 0;
+
+		[[nodiscard]] bool	IsValid() const { return m_offset != OpenGLBuddyAllocator::ms_INVALID_OFFSET; }
+	};
+
+
+	/**
+	 * \brief A pool of buddy allocators ("arenas") that grows when all the existing arenas are full.
+	 * Allocations bigger than the dedicated threshold get a buffer of their own, so they don't waste half an arena (e.g. big instancing buffers).
+	 * Arenas that become empty are given back to the driver, except the first one, to avoid creating and destroying buffers in a loop.
+	 * The arena index has to be given back when freeing : it is meant to be stored in the buffer handles.
+	 * Every buffer the pool deletes is reported to the "buffer deleted" delegate first, e.g. so that a state cache can forget it.
+	 */
+	class OpenGLBufferPool
+	{
+	public:
+
+		static constexpr uint32_t	ms_DEDICATED_ARENA = 0xFF; // Arena index of dedicated allocations
+		static constexpr uint32_t	ms_MAX_ARENAS = ms_DEDICATED_ARENA; // So that arena indices fit in 8 bits
+
+		typedef Delegate<void(GLuint)>	BufferDeletedDelegate;
+
+		OpenGLBufferPool() = default;
+
+		Monocle_Graphics_API ~OpenGLBufferPool();
+
+		OpenGLBufferPool(const OpenGLBufferPool&) = delete;
+		OpenGLBufferPool& operator=(const OpenGLBufferPool&) = delete;
+
+
+		/**
+		 * \brief Creates the first arena.
+		 * \param storageFlags The flags used for glNamedBufferStorage of all arenas and dedicated buffers
+		 * \param arenaSize The size of each arena. Rounded up to a power of two, and at most OpenGLBuddyAllocator::ms_MAX_POOL_SIZE.
+		 * \param dedicatedThreshold Allocations of this size or bigger get their own buffer. Clamped to the arena size.
+		 */
+		Monocle_Graphics_API void	Initialize(GLbitfield storageFlags, uint32_t arenaSize = OpenGLBuddyAllocator::ms_MAX_POOL_SIZE, uint32_t dedicatedThreshold = OpenGLBuddyAllocator::ms_MAX_POOL_SIZE / 4);
+
+		/**
+		 * \brief Allocates memory in the first arena that has room, creating a new arena if none has.
+		 * \return The allocation, invalid if the arena limit was reached or the data is too big
+		 */
+		Monocle_Graphics_API [[nodiscard]] OpenGLPoolAllocation	Allocate(const void* data, uint32_t size);
+
+		Monocle_Graphics_API void	Free(const OpenGLPoolAllocation& allocation);
+
+		/**
+		 * \brief Deletes all the arenas and dedicated buffers.
+		 */
+		Monocle_Graphics_API void	DeleteMemory();
+
+
+		/**
+		 * \brief Sets the function called with the name of each arena or dedicated buffer right before it gets deleted.
+		 */
+		void	SetBufferDeletedDelegate(const BufferDeletedDelegate& onBufferDeleted) { m_onBufferDeleted = onBufferDeleted; }
+
+
+		/**
+		 * \brief The number of arenas currently alive.
+		 */
+		[[nodiscard]] uint32_t	GetNumArenas() const { return m_numArenas; }
+
+		[[nodiscard]] uint32_t	GetNumDedicatedBuffers() const { return (uint32_t)m_dedicatedBuffers.Size(); }
+
+		[[nodiscard]] uint32_t	GetArenaSize() const { return m_arenaSize; }
+
+		[[nodiscard]] uint32_t	GetDedicatedThreshold() const { return m_dedicatedThreshold; }
+
+
+	private:
+
+		OpenGLPoolAllocation	AllocateDedicated(const void* data, uint32_t size);
+
+		uint32_t	AddArena();
+
+		void	NotifyBufferDeleted(GLuint buffer) const;
+
+
+		// Freed arenas leave a null slot, reused by the next arena we need to create, so arena indices stay stable.
+		Vector<std::unique_ptr<OpenGLBuddyAllocator>>	m_arenas;
+
+		Vector<GLuint>	m_dedicatedBuffers;
+
+		BufferDeletedDelegate	m_onBufferDeleted = nullptr;
+
+		GLbitfield	m_storageFlags = 0;
+
+		uint32_t	m_arenaSize = 0;
+		uint32_t	m_dedicatedThreshold = 0;
+		uint32_t	m_numArenas = 0;
+	};
+
+}
+
+#endif // MOE_OPENGL
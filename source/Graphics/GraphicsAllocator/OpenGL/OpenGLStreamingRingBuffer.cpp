@@ -0,0 +1,162 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#ifdef MOE_OPENGL
+
+#include "OpenGLStreamingRingBuffer.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Core/Log/moeLog.h"
+
+#include <cstring> // memcpy
+
+
+namespace moe
+{
+	void OpenGLStreamingRingBuffer::Initialize(uint32_t regionSize, uint32_t alignment)
+	{
+		MOE_ASSERT(m_buffer == 0);
+		MOE_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+		// Keep every region start aligned, so offsets only have to be aligned relatively to the region.
+		m_alignment = alignment;
+		m_regionSize = (regionSize + alignment - 1) & ~(alignment - 1);
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glCreateBuffers(1, &m_buffer);
+		glNamedBufferStorage(m_buffer, (GLsizeiptr)m_regionSize * ms_NUM_REGIONS, nullptr, flags);
+
+		m_mappedMemory = static_cast<byte_t*>(glMapNamedBufferRange(m_buffer, 0, (GLsizeiptr)m_regionSize * ms_NUM_REGIONS, flags));
+		if (!MOE_ASSERT(m_mappedMemory != nullptr))
+		{
+			MOE_ERROR(ChanGraphics, "Unable to persistently map streaming buffer %u.", m_buffer);
+			Destroy();
+			return;
+		}
+
+		m_currentRegion = 0;
+		m_regionHead = 0;
+		m_regionAvailable = false;
+	}
+
+
+	void OpenGLStreamingRingBuffer::Destroy()
+	{
+		for (GLsync& fence : m_regionFences)
+		{
+			if (fence != nullptr)
+			{
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (m_buffer != 0)
+		{
+			if (m_mappedMemory != nullptr)
+			{
+				glUnmapNamedBuffer(m_buffer);
+				m_mappedMemory = nullptr;
+			}
+
+			glDeleteBuffers(1, &m_buffer);
+			m_buffer = 0;
+		}
+
+		m_regionSize = 0;
+		m_regionHead = 0;
+	}
+
+
+	uint32_t OpenGLStreamingRingBuffer::Allocate(uint32_t size, void*& mappedMemory)
+	{
+		if (!MOE_ASSERT(IsInitialized()))
+		{
+			return ms_INVALID_OFFSET;
+		}
+
+		const uint32_t alignedHead = (m_regionHead + m_alignment - 1) & ~(m_alignment - 1);
+		if (alignedHead + size > m_regionSize)
+		{
+			// Only report it once, or it would flood the log every frame.
+			if (!m_reportedFull)
+			{
+				MOE_WARNING(ChanGraphics, "Streaming buffer region full (%u bytes per frame) : consider increasing its size.", m_regionSize);
+				m_reportedFull = true;
+			}
+
+			return ms_INVALID_OFFSET;
+		}
+
+		if (!m_regionAvailable)
+		{
+			WaitForCurrentRegion();
+		}
+
+		m_regionHead = alignedHead + size;
+
+		const uint32_t bufferOffset = m_currentRegion * m_regionSize + alignedHead;
+		mappedMemory = m_mappedMemory + bufferOffset;
+
+		return bufferOffset;
+	}
+
+
+	uint32_t OpenGLStreamingRingBuffer::Push(const void* data, uint32_t size)
+	{
+		void* mappedMemory = nullptr;
+		const uint32_t offset = Allocate(size, mappedMemory);
+
+		if (offset != ms_INVALID_OFFSET)
+		{
+			std::memcpy(mappedMemory, data, size);
+		}
+
+		return offset;
+	}
+
+
+	void OpenGLStreamingRingBuffer::EndFrame()
+	{
+		if (!m_regionAvailable)
+		{
+			return; // Nothing was allocated this frame : keep using the same region.
+		}
+
+		m_regionFences[m_currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_currentRegion = (m_currentRegion + 1) % ms_NUM_REGIONS;
+		m_regionHead = 0;
+		m_regionAvailable = false;
+	}
+
+
+	void OpenGLStreamingRingBuffer::WaitForCurrentRegion()
+	{
+		GLsync& fence = m_regionFences[m_currentRegion];
+
+		if (fence != nullptr)
+		{
+			// Flush on the first try so the fence is sure to be signaled eventually.
+			GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+			const GLuint64 timeoutNs = 1'000'000'000; // 1 second
+
+			GLenum waitResult = glClientWaitSync(fence, waitFlags, timeoutNs);
+			while (waitResult == GL_TIMEOUT_EXPIRED)
+			{
+				waitFlags = 0;
+				waitResult = glClientWaitSync(fence, waitFlags, timeoutNs);
+			}
+
+			MOE_ASSERT(waitResult != GL_WAIT_FAILED);
+
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		m_regionAvailable = true;
+	}
+}
+
+#endif // MOE_OPENGL
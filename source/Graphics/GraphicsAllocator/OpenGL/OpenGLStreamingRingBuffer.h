@@ -0,0 +1,110 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_OPENGL
+
+#include "Core/Misc/Types.h"
+#include "Monocle_Graphics_Export.h"
+
+#include <glad/glad.h>
+
+
+namespace moe
+{
+	/**
+	 * \brief A buffer for data that gets rewritten every frame (per-object matrices, etc.).
+	 * The buffer is persistently mapped and split in several frame regions, used in turn like a ring.
+	 * Allocating is just bumping an offset in the region of the current frame and writing through the mapped pointer :
+	 * there is no driver call per allocation. At the end of the frame, a fence is inserted to know when the GPU is done with the region,
+	 * and we only wait for it when the ring comes back to this region (usually never, as there are more regions than frames in flight).
+	 */
+	class OpenGLStreamingRingBuffer
+	{
+	public:
+
+		static constexpr uint32_t	ms_INVALID_OFFSET = (uint32_t)-1;
+		static constexpr uint32_t	ms_NUM_REGIONS = 3;
+		static constexpr uint32_t	ms_DEFAULT_REGION_SIZE = 1 << 20; // 1 MB per frame : enough for more than 4000 objects' matrices.
+
+		OpenGLStreamingRingBuffer() = default;
+
+		OpenGLStreamingRingBuffer(const OpenGLStreamingRingBuffer&) = delete;
+		OpenGLStreamingRingBuffer& operator=(const OpenGLStreamingRingBuffer&) = delete;
+
+		/**
+		 * \brief Creates and maps the buffer.
+		 * \param regionSize The maximum number of bytes that can be allocated during one frame
+		 * \param alignment The alignment of all offsets returned by Allocate. Usually GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+		 */
+		Monocle_Graphics_API void	Initialize(uint32_t regionSize, uint32_t alignment);
+
+		/**
+		 * \brief Unmaps and deletes the buffer. Like other GL objects, this is not done in the destructor because the context may already be gone by then.
+		 */
+		Monocle_Graphics_API void	Destroy();
+
+
+		/**
+		 * \brief Reserves memory in the region of the current frame.
+		 * \param size The size of the allocation in bytes
+		 * \param mappedMemory Receives a pointer to write the data to
+		 * \return The offset of the allocation in the buffer, or ms_INVALID_OFFSET if this frame's region is full.
+		 */
+		Monocle_Graphics_API [[nodiscard]] uint32_t	Allocate(uint32_t size, void*& mappedMemory);
+
+		/**
+		 * \brief Allocates memory in the region of the current frame and copies data into it.
+		 * \return The offset of the data in the buffer, or ms_INVALID_OFFSET if this frame's region is full.
+		 */
+		Monocle_Graphics_API [[nodiscard]] uint32_t	Push(const void* data, uint32_t size);
+
+
+		/**
+		 * \brief Fences the region used this frame and moves on to the next one.
+		 * Must be called once per frame, after the last draw call that reads from this frame's data.
+		 */
+		Monocle_Graphics_API void	EndFrame();
+
+
+		[[nodiscard]] GLuint	GetBufferHandle() const { return m_buffer; }
+
+		[[nodiscard]] bool		IsInitialized() const { return m_mappedMemory != nullptr; }
+
+		[[nodiscard]] uint32_t	GetAlignment() const { return m_alignment; }
+
+		[[nodiscard]] uint32_t	GetRegionSize() const { return m_regionSize; }
+
+		/**
+		 * \brief How many bytes were allocated during the current frame (including alignment padding).
+		 */
+		[[nodiscard]] uint32_t	GetFrameUsedBytes() const { return m_regionHead; }
+
+
+	private:
+
+		/**
+		 * \brief Blocks until the GPU is done reading the current region, if it has been used before.
+		 */
+		void	WaitForCurrentRegion();
+
+
+		GLuint		m_buffer = 0;
+
+		byte_t*		m_mappedMemory = nullptr;
+
+		GLsync		m_regionFences[ms_NUM_REGIONS]{};
+
+		uint32_t	m_regionSize = 0;
+		uint32_t	m_alignment = 1;
+
+		uint32_t	m_currentRegion = 0;
+		uint32_t	m_regionHead = 0;	// Next free offset, relative to the start of the current region
+
+		bool		m_regionAvailable = false; // Whether we already waited for the fence of the current region this frame
+		bool		m_reportedFull = false;
+	};
+
+}
+
+#endif // MOE_OPENGL
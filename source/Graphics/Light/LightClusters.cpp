@@ -0,0 +1,280 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "LightClusters.h"
+
+#include "LightSystem.h"
+
+#include "Core/Jobs/JobSystem.h"
+
+#include <algorithm> // max
+#include <cfloat> // FLT_MAX
+#include <cmath>
+
+
+namespace moe
+{
+	namespace
+	{
+		// Squared distance from a point to a box, 0 if the point is inside.
+		float	SquaredDistanceToBox(const Vec3& point, const Vec3& boxMin, const Vec3& boxMax)
+		{
+			float sqDist = 0.f;
+			for (int iAxis = 0; iAxis < 3; ++iAxis)
+			{
+				const float clamped = std::max(boxMin[iAxis], std::min(point[iAxis], boxMax[iAxis]));
+				const float delta = point[iAxis] - clamped;
+				sqDist += delta * delta;
+			}
+
+			return sqDist;
+		}
+	}
+
+
+	void LightClusters::Build(const Mat4& view, const Mat4& projection, float zNear, float zFar, const Vec2& viewportSize,
+		const LightData* lights, uint32_t numLights, JobSystem* jobSystem)
+	{
+		if (!MOE_ASSERT(zNear > 0.f && zFar > zNear))
+		{
+			return;
+		}
+
+		if (m_clusterBounds.Empty() || projection != m_boundsProjection || zNear != m_boundsNear || zFar != m_boundsFar)
+		{
+			ComputeClusterBounds(projection, zNear, zFar);
+		}
+
+		const float logDepthRatio = std::log(zFar / zNear);
+
+		m_params.m_numTilesX = ms_NUM_TILES_X;
+		m_params.m_numTilesY = ms_NUM_TILES_Y;
+		m_params.m_numSlices = ms_NUM_SLICES;
+		m_params.m_viewportWidth = viewportSize.x();
+		m_params.m_viewportHeight = viewportSize.y();
+		m_params.m_sliceScale = ms_NUM_SLICES / logDepthRatio;
+		m_params.m_sliceBias = -(ms_NUM_SLICES * std::log(zNear)) / logDepthRatio;
+
+		// First sort out the lights that reach everything from the ones that can be culled, moved to view space.
+		m_lightIndices.Clear();
+		m_localLights.Clear();
+
+		Mat4 viewMatrix = view;
+
+		for (uint32_t iLight = 0; iLight < numLights; ++iLight)
+		{
+			const LightData& light = lights[iLight];
+
+			const float range = ComputeLightRange(light);
+			if (light.m_position.w() == 0.f || range < 0.f)
+			{
+				m_lightIndices.PushBack(iLight);
+			}
+			else if (range > 0.f)
+			{
+				const Vec4 viewPos = viewMatrix * light.m_position;
+				m_localLights.PushBack({ viewPos.xyz(), range, iLight });
+			}
+		}
+
+		m_params.m_numGlobalLights = (uint32_t)m_lightIndices.Size();
+
+		// Then each slice can be culled independently from the others...
+		m_clusters.Resize(ms_NUM_CLUSTERS);
+		m_slices.Resize(ms_NUM_SLICES);
+
+		auto cullSliceRange = [this](uint32_t beginSlice, uint32_t endSlice)
+		{
+			for (uint32_t iSlice = beginSlice; iSlice < endSlice; ++iSlice)
+			{
+				CullSlice(iSlice);
+			}
+		};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor(ms_NUM_SLICES, ms_SLICES_PER_JOB, cullSliceRange);
+		}
+		else
+		{
+			cullSliceRange(0, ms_NUM_SLICES);
+		}
+
+		// ... and the per-slice lists are merged in one, after the global lights.
+		const uint32_t clustersPerSlice = ms_NUM_TILES_X * ms_NUM_TILES_Y;
+
+		for (uint32_t iSlice = 0; iSlice < ms_NUM_SLICES; ++iSlice)
+		{
+			const Vector<uint32_t>& sliceIndices = m_slices[iSlice].m_lightIndices;
+			const uint32_t sliceOffset = (uint32_t)m_lightIndices.Size();
+
+			for (uint32_t iCluster = iSlice * clustersPerSlice; iCluster < (iSlice + 1) * clustersPerSlice; ++iCluster)
+			{
+				m_clusters[iCluster].m_offset += sliceOffset;
+			}
+
+			for (uint32_t lightIdx : sliceIndices)
+			{
+				m_lightIndices.PushBack(lightIdx);
+			}
+		}
+	}
+
+
+	float LightClusters::ComputeLightRange(const LightData& light)
+	{
+		// The light is negligible when its brightest color channel, once attenuated, goes under the cutoff.
+		float maxIntensity = 0.f;
+		for (const Vec4* color : { &light.m_ambientColor, &light.m_diffuseColor, &light.m_specularColor })
+		{
+			maxIntensity = std::max({ maxIntensity, color->x(), color->y(), color->z() });
+		}
+
+		if (maxIntensity <= 0.f)
+		{
+			return 0.f;
+		}
+
+		// Solve constant + linear * d + quadratic * d^2 = maxIntensity / cutoff
+		const float targetAttenuation = maxIntensity / ms_ATTENUATION_CUTOFF;
+		const float constant = light.m_constantAttenuation - targetAttenuation;
+		if (constant >= 0.f)
+		{
+			return 0.f; // never bright enough to be seen
+		}
+
+		const float linear = light.m_linearAttenuation;
+		const float quadratic = light.m_quadraticAttenuation;
+
+		if (quadratic > 0.f)
+		{
+			return (-linear + std::sqrt(linear * linear - 4.f * quadratic * constant)) / (2.f * quadratic);
+		}
+
+		if (linear > 0.f)
+		{
+			return -constant / linear;
+		}
+
+		return -1.f; // not attenuated : infinite range
+	}
+
+
+	void LightClusters::ComputeClusterBounds(const Mat4& projection, float zNear, float zFar)
+	{
+		m_boundsProjection = projection;
+		m_boundsNear = zNear;
+		m_boundsFar = zFar;
+
+		m_clusterBounds.Resize(ms_NUM_CLUSTERS);
+
+		Mat4 invProjection = projection.GetInverse();
+
+		auto unproject = [&invProjection](float ndcX, float ndcY, float ndcZ)
+		{
+			const Vec4 viewPos = invProjection * Vec4(ndcX, ndcY, ndcZ, 1.f);
+			return Vec3(viewPos.x() / viewPos.w(), viewPos.y() / viewPos.w(), viewPos.z() / viewPos.w());
+		};
+
+		// The point of a line going from the near plane to the far plane at a given view depth.
+		// Interpolating between the unprojected near and far points works for both perspective and orthographic projections.
+		auto pointAtDepth = [](const Vec3& nearPoint, const Vec3& farPoint, float depth)
+		{
+			const float t = (depth + nearPoint.z()) / (nearPoint.z() - farPoint.z());
+			return nearPoint + (farPoint - nearPoint) * t;
+		};
+
+		for (uint32_t tileY = 0; tileY < ms_NUM_TILES_Y; ++tileY)
+		{
+			const float ndcMinY = -1.f + 2.f * tileY / ms_NUM_TILES_Y;
+			const float ndcMaxY = -1.f + 2.f * (tileY + 1) / ms_NUM_TILES_Y;
+
+			for (uint32_t tileX = 0; tileX < ms_NUM_TILES_X; ++tileX)
+			{
+				const float ndcMinX = -1.f + 2.f * tileX / ms_NUM_TILES_X;
+				const float ndcMaxX = -1.f + 2.f * (tileX + 1) / ms_NUM_TILES_X;
+
+				const Vec3 nearCorners[4] = {
+					unproject(ndcMinX, ndcMinY, -1.f), unproject(ndcMaxX, ndcMinY, -1.f),
+					unproject(ndcMinX, ndcMaxY, -1.f), unproject(ndcMaxX, ndcMaxY, -1.f)
+				};
+
+				const Vec3 farCorners[4] = {
+					unproject(ndcMinX, ndcMinY, 1.f), unproject(ndcMaxX, ndcMinY, 1.f),
+					unproject(ndcMinX, ndcMaxY, 1.f), unproject(ndcMaxX, ndcMaxY, 1.f)
+				};
+
+				for (uint32_t iSlice = 0; iSlice < ms_NUM_SLICES; ++iSlice)
+				{
+					const float sliceNear = GetSliceDepth(iSlice);
+					const float sliceFar = GetSliceDepth(iSlice + 1);
+
+					ClusterBounds& bounds = m_clusterBounds[GetClusterIndex(tileX, tileY, iSlice)];
+					bounds.m_min = Vec3(FLT_MAX);
+					bounds.m_max = Vec3(-FLT_MAX);
+
+					for (int iCorner = 0; iCorner < 4; ++iCorner)
+					{
+						for (float depth : { sliceNear, sliceFar })
+						{
+							const Vec3 corner = pointAtDepth(nearCorners[iCorner], farCorners[iCorner], depth);
+							for (int iAxis = 0; iAxis < 3; ++iAxis)
+							{
+								bounds.m_min[iAxis] = std::min(bounds.m_min[iAxis], corner[iAxis]);
+								bounds.m_max[iAxis] = std::max(bounds.m_max[iAxis], corner[iAxis]);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+
+	float LightClusters::GetSliceDepth(uint32_t slice) const
+	{
+		return m_boundsNear * std::pow(m_boundsFar / m_boundsNear, (float)slice / ms_NUM_SLICES);
+	}
+
+
+	void LightClusters::CullSlice(uint32_t slice)
+	{
+		SliceLights& sliceLights = m_slices[slice];
+		sliceLights.m_lightIndices.Clear();
+		sliceLights.m_sliceSpheres.Clear();
+
+		// Only keep the lights that overlap the slice depth range : most lights are rejected here for cheap.
+		// View space looks down -Z.
+		const float sliceMinZ = -GetSliceDepth(slice + 1);
+		const float sliceMaxZ = -GetSliceDepth(slice);
+
+		for (const LightSphere& sphere : m_localLights)
+		{
+			if (sphere.m_center.z() - sphere.m_radius <= sliceMaxZ && sphere.m_center.z() + sphere.m_radius >= sliceMinZ)
+			{
+				sliceLights.m_sliceSpheres.PushBack(sphere);
+			}
+		}
+
+		for (uint32_t tileY = 0; tileY < ms_NUM_TILES_Y; ++tileY)
+		{
+			for (uint32_t tileX = 0; tileX < ms_NUM_TILES_X; ++tileX)
+			{
+				const uint32_t clusterIdx = GetClusterIndex(tileX, tileY, slice);
+				const ClusterBounds& bounds = m_clusterBounds[clusterIdx];
+
+				LightCluster& cluster = m_clusters[clusterIdx];
+				cluster.m_offset = (uint32_t)sliceLights.m_lightIndices.Size();
+
+				for (const LightSphere& sphere : sliceLights.m_sliceSpheres)
+				{
+					if (SquaredDistanceToBox(sphere.m_center, bounds.m_min, bounds.m_max) <= sphere.m_radius * sphere.m_radius)
+					{
+						sliceLights.m_lightIndices.PushBack(sphere.m_lightIndex);
+					}
+				}
+
+				cluster.m_count = (uint32_t)sliceLights.m_lightIndices.Size() - cluster.m_offset;
+			}
+		}
+	}
+}
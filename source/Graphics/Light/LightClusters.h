@@ -0,0 +1,143 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Math/Matrix.h"
+#include "Math/Vec2.h"
+#include "Math/Vec3.h"
+
+#include "Monocle_Graphics_Export.h"
+
+
+namespace moe
+{
+	class JobSystem;
+	struct LightData;
+
+
+	/**
+	 * \brief The parameters shaders need to find the cluster of a fragment (std140 layout).
+	 * The cluster of a fragment is (gl_FragCoord.xy / viewport size * number of tiles, log(view depth) * slice scale + slice bias).
+	 */
+	struct LightClustersParams
+	{
+		uint32_t	m_numTilesX = 0;
+		uint32_t	m_numTilesY = 0;
+		uint32_t	m_numSlices = 0;
+		uint32_t	m_numGlobalLights = 0;	// Lights that affect every cluster : they are at the beginning of the index list
+		float		m_viewportWidth = 0.f;
+		float		m_viewportHeight = 0.f;
+		float		m_sliceScale = 0.f;
+		float		m_sliceBias = 0.f;
+	};
+
+
+	/**
+	 * \brief Where the lights of a cluster are in the light index list (std430 layout).
+	 */
+	struct LightCluster
+	{
+		uint32_t	m_offset = 0;
+		uint32_t	m_count = 0;
+	};
+
+
+	/**
+	 * \brief Assigns lights to the clusters of a view frustum split in 16x9 screen tiles and 24 depth slices (froxels),
+	 * so that fragment shaders only have to go through the lights that can reach them.
+	 * Slices are exponentially distributed in depth, for clusters to keep about the same shape along the frustum.
+	 * The range of a light is where its attenuation makes it negligible : lights without attenuation (like directional lights)
+	 * reach every cluster, and are stored once in a global list instead.
+	 * The cluster bounds only depend on the projection : they are cached and only recomputed when it changes.
+	 */
+	class LightClusters
+	{
+	public:
+
+		static constexpr uint32_t	ms_NUM_TILES_X = 16;
+		static constexpr uint32_t	ms_NUM_TILES_Y = 9;
+		static constexpr uint32_t	ms_NUM_SLICES = 24;
+		static constexpr uint32_t	ms_NUM_CLUSTERS = ms_NUM_TILES_X * ms_NUM_TILES_Y * ms_NUM_SLICES;
+
+		/* The light intensity under which a light is considered to have no effect anymore. */
+		static constexpr float	ms_ATTENUATION_CUTOFF = 1.f / 256.f;
+
+		/* How many depth slices a job culls when building in parallel : a slice alone is too little work for a job. */
+		static constexpr uint32_t	ms_SLICES_PER_JOB = 4;
+
+
+		/**
+		 * \brief Assigns the lights to the clusters of a view.
+		 * \param zNear The near plane distance of the projection
+		 * \param zFar The far plane distance of the projection
+		 * \param jobSystem Optional : if given, slices are processed in parallel
+		 */
+		Monocle_Graphics_API void	Build(const Mat4& view, const Mat4& projection, float zNear, float zFar, const Vec2& viewportSize,
+										const LightData* lights, uint32_t numLights, JobSystem* jobSystem = nullptr);
+
+
+		[[nodiscard]] const LightClustersParams&	GetParams() const { return m_params; }
+
+		[[nodiscard]] const Vector<LightCluster>&	GetClusters() const { return m_clusters; }
+
+		[[nodiscard]] const Vector<uint32_t>&	GetLightIndices() const { return m_lightIndices; }
+
+		[[nodiscard]] static uint32_t	GetClusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice)
+		{
+			return (slice * ms_NUM_TILES_Y + tileY) * ms_NUM_TILES_X + tileX;
+		}
+
+		/**
+		 * \return The distance after which the light has no visible effect, or a negative number if its range is infinite.
+		 */
+		Monocle_Graphics_API [[nodiscard]] static float	ComputeLightRange(const LightData& light);
+
+
+	private:
+
+		struct ClusterBounds
+		{
+			Vec3	m_min{ 0 };
+			Vec3	m_max{ 0 };
+		};
+
+		/* A light as seen by the culling : a sphere in view space. */
+		struct LightSphere
+		{
+			Vec3		m_center{ 0 };
+			float		m_radius = 0.f;
+			uint32_t	m_lightIndex = 0;
+		};
+
+		/* What the job of a slice produces : the cluster offsets are relative to the slice index list until all slices are merged. */
+		struct SliceLights
+		{
+			Vector<uint32_t>	m_lightIndices;
+			Vector<LightSphere>	m_sliceSpheres;
+		};
+
+		void	ComputeClusterBounds(const Mat4& projection, float zNear, float zFar);
+
+		/* The view distance at which a slice starts : slices are exponentially distributed between the near and far planes. */
+		[[nodiscard]] float	GetSliceDepth(uint32_t slice) const;
+
+		void	CullSlice(uint32_t slice);
+
+
+		LightClustersParams		m_params;
+
+		Mat4					m_boundsProjection{ Mat4::Identity() };
+		float					m_boundsNear = 0.f;
+		float					m_boundsFar = 0.f;
+		Vector<ClusterBounds>	m_clusterBounds;
+
+		Vector<LightSphere>		m_localLights;
+		Vector<SliceLights>		m_slices;
+
+		Vector<LightCluster>	m_clusters;
+		Vector<uint32_t>		m_lightIndices;
+	};
+
+}
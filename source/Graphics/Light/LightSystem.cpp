@@ -5,15 +5,16 @@
 #include "Graphics/Resources/ResourceLayout/ResourceLayoutDescriptor.h"
 #include "Graphics/Resources/ResourceSet/ResourceSetDescriptor.h"
 
+#include "Graphics/Camera/Camera.h"
+
+#include <algorithm> // min, max
+
 
 namespace moe
 {
 	LightSystem::LightSystem(IGraphicsDevice& device) :
 		m_device(device)
 	{
-		//m_lightDataBuffer.Resize(MAX_LIGHTS);
-		m_lightObjects.Reserve(MAX_LIGHTS);
-
 		/* TODO : Creating layout here is probably bad and what happens if we need lights in vertex shaders for Gouraud shading ? */
 		ResourceLayoutDescriptor lightLayoutDesc{
 			{{ "LightCastersData", ResourceKind::UniformBuffer, ShaderStage::Fragment }}
@@ -38,7 +39,21 @@ namespace moe
 
 	LightSystem::~LightSystem()
 	{
-		/* TODO : free uniform buffer */
+		for (DeviceBufferHandle uboHandle : { m_lightsUniformBlock, m_clustersParamsUniformBlock })
+		{
+			if (uboHandle.IsNotNull())
+			{
+				m_device.DeleteUniformBuffer(uboHandle);
+			}
+		}
+
+		for (DeviceBufferHandle ssboHandle : { m_lightsStorageBuffer, m_clustersStorageBuffer, m_lightIndicesStorageBuffer })
+		{
+			if (ssboHandle.IsNotNull())
+			{
+				m_device.DeleteStorageBuffer(ssboHandle);
+			}
+		}
 	}
 
 
@@ -47,15 +62,22 @@ namespace moe
 		if (!NeedsUpdate())
 			return; // nothing to do
 
-		// Don't update the full buffer but only up to the number of lights currently in flight.
-		//m_device.UpdateBuffer(m_lightsUniformBlock, m_lightDataBuffer.Data(), LightsNumber() * GetLightDataSizeBytes());
+		// The uniform block only has room for the first lights.
+		m_lightCastersData.m_numLights = std::min(LightsNumber(), (uint32_t)MAX_LIGHTS);
+		for (uint32_t iLight = 0; iLight < m_lightCastersData.m_numLights; ++iLight)
+		{
+			m_lightCastersData.m_lightDataBuffer[iLight] = m_lights[iLight];
+		}
 
 		// Don't update the full buffer but only up to the number of lights currently in flight.
 		// Send sizeof(uint32_t) first to also send the updated number of lights !
-		m_device.UpdateBuffer(m_lightsUniformBlock, &m_lightCastersData, sizeof(uint32_t) + LightsNumber() * GetLightDataSizeBytes());
+		m_device.UpdateBuffer(m_lightsUniformBlock, &m_lightCastersData, sizeof(uint32_t) + m_lightCastersData.m_numLights * GetLightDataSizeBytes());
 
 		// buffer is updated
 		m_needBufferUpdateFlag = false;
+
+		// The storage buffer of all lights is only used by clustered lighting : it will be sent by UpdateClusters.
+		m_needLightsStorageUpdate = true;
 	}
 
 
@@ -67,41 +89,113 @@ namespace moe
 
 	LightObject* LightSystem::AddNewLight(LightData newLightData)
 	{
-		MOE_ASSERT(m_lightCastersData.m_numLights != MAX_LIGHTS);
+		if (LightsNumber() == MAX_LIGHTS)
+		{
+			MOE_INFO(ChanGraphics, "More than %u lights : only shaders using light clusters will see the new ones.", (uint32_t)MAX_LIGHTS);
+		}
 
-		m_lightCastersData.m_lightDataBuffer[m_lightCastersData.m_numLights] = std::move(newLightData);
+		m_lights.PushBack(std::move(newLightData));
 
-		m_lightObjects.EmplaceBack(this, m_lightCastersData.m_numLights);
+		m_lightObjects.PushBack(std::make_unique<LightObject>(this, LightsNumber() - 1));
 
 		m_needBufferUpdateFlag = true; // Will resend lights buffer.
 
-		return &m_lightObjects[m_lightCastersData.m_numLights++];
+		return m_lightObjects.Back().get();
 	}
 
 
 	void LightSystem::RemoveLight(LightObject* light)
 	{
-		auto swappedLightIt = m_lightObjects.EraseBySwapAt(light->GetLightIndex());
+		// The light object is destroyed by the erase : keep its index.
+		const uint32_t removedIdx = light->GetLightIndex();
+
+		auto swappedLightIt = m_lightObjects.EraseBySwapAt(removedIdx);
 
 		if (swappedLightIt != m_lightObjects.End())
 		{
 			// Put the swapped light data inside the removed light slot
-			m_lightCastersData.m_lightDataBuffer[light->GetLightIndex()] = m_lightCastersData.m_lightDataBuffer[swappedLightIt->GetLightIndex()];
+			m_lights[removedIdx] = m_lights[(*swappedLightIt)->GetLightIndex()];
 
 			// Don't forget to update the swapped light index !
-			swappedLightIt->SetLightIndex(light->GetLightIndex());
+			(*swappedLightIt)->SetLightIndex(removedIdx);
 		}
 
-		// One light has been removed : decrease the next index.
-		m_lightCastersData.m_numLights--;
+		// One light has been removed : the last one is now unused.
+		m_lights.PopBack();
 
 		m_needBufferUpdateFlag = true; // Will resend lights buffer.
 	}
 
 
+	void LightSystem::UpdateClusters(const Camera& camera, const Vec2& viewportSize, JobSystem* jobSystem)
+	{
+		UpdateLights();
+
+		if (m_needLightsStorageUpdate || m_lightsStorageBuffer.IsNull())
+		{
+			UploadStorageBuffer(m_lightsStorageBuffer, m_lightsStorageCapacity, m_lights.Data(), m_lights.Size() * sizeof(LightData));
+			m_needLightsStorageUpdate = false;
+		}
+
+		m_clusters.Build(camera.GetViewMatrix(), camera.GetProjectionMatrix(), camera.GetNear(), camera.GetFar(), viewportSize,
+			m_lights.Data(), LightsNumber(), jobSystem);
+
+		const Vector<LightCluster>& clusters = m_clusters.GetClusters();
+		UploadStorageBuffer(m_clustersStorageBuffer, m_clustersStorageCapacity, clusters.Data(), clusters.Size() * sizeof(LightCluster));
+
+		const Vector<uint32_t>& lightIndices = m_clusters.GetLightIndices();
+		UploadStorageBuffer(m_lightIndicesStorageBuffer, m_lightIndicesStorageCapacity, lightIndices.Data(), lightIndices.Size() * sizeof(uint32_t));
+
+		if (m_clustersParamsUniformBlock.IsNull())
+		{
+			m_clustersParamsUniformBlock = m_device.CreateUniformBuffer(&m_clusters.GetParams(), sizeof(LightClustersParams));
+		}
+		else
+		{
+			m_device.UpdateBuffer(m_clustersParamsUniformBlock, &m_clusters.GetParams(), sizeof(LightClustersParams));
+		}
+	}
+
+
+	void LightSystem::BindClusterBuffers()
+	{
+		if (!MOE_ASSERT(m_clustersParamsUniformBlock.IsNotNull()))
+		{
+			return; // UpdateClusters was never called
+		}
+
+		m_device.BindUniformBlock(MaterialBlockBinding::FRAME_LIGHT_CLUSTERS, m_clustersParamsUniformBlock);
+		m_device.BindStorageBuffer(MaterialStorageBinding::CLUSTERED_LIGHTS, m_lightsStorageBuffer);
+		m_device.BindStorageBuffer(MaterialStorageBinding::LIGHT_CLUSTERS, m_clustersStorageBuffer);
+		m_device.BindStorageBuffer(MaterialStorageBinding::LIGHT_INDICES, m_lightIndicesStorageBuffer);
+	}
+
+
+	void LightSystem::UploadStorageBuffer(DeviceBufferHandle& ssboHandle, size_t& capacityBytes, const void* data, size_t dataSizeBytes)
+	{
+		if (ssboHandle.IsNull() || dataSizeBytes > capacityBytes)
+		{
+			if (ssboHandle.IsNotNull())
+			{
+				m_device.DeleteStorageBuffer(ssboHandle);
+			}
+
+			// Grow geometrically, so that adding lights one by one doesn't recreate the buffer every frame.
+			// Never create an empty buffer : it couldn't be bound.
+			capacityBytes = std::max({ dataSizeBytes, capacityBytes * 2, ms_MIN_STORAGE_BUFFER_SIZE });
+			ssboHandle = m_device.CreateStorageBuffer(nullptr, capacityBytes);
+		}
+
+		if (dataSizeBytes != 0)
+		{
+			m_device.UpdateBuffer(ssboHandle, data, dataSizeBytes);
+		}
+	}
+
+
 	void LightSystem::SetLightPosition(uint32_t lightIdx, const Vec4& pos)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_position = pos;
+		m_lights[lightIdx].m_position = pos;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -109,7 +203,7 @@ namespace moe
 
 	void LightSystem::SetLightDirection(uint32_t lightIdx, const Vec3& dir)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_direction = Vec4(dir, 0);
+		m_lights[lightIdx].m_direction = Vec4(dir, 0);
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -117,7 +211,7 @@ namespace moe
 
 	void LightSystem::SetLightAmbientColor(uint32_t lightIdx, const ColorRGBAf& ambient)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_ambientColor = ambient.ToVec();
+		m_lights[lightIdx].m_ambientColor = ambient.ToVec();
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -125,7 +219,7 @@ namespace moe
 
 	void LightSystem::SetLightDiffuseColor(uint32_t lightIdx, const ColorRGBAf& diffuse)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_diffuseColor = diffuse.ToVec();
+		m_lights[lightIdx].m_diffuseColor = diffuse.ToVec();
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -133,7 +227,7 @@ namespace moe
 
 	void LightSystem::SetLightSpecularColor(uint32_t lightIdx, const ColorRGBAf& specular)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_specularColor = specular.ToVec();
+		m_lights[lightIdx].m_specularColor = specular.ToVec();
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -141,8 +235,8 @@ namespace moe
 
 	void LightSystem::MakeDirectionalLight(uint32_t lightIdx, const Vec3& direction)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_position = Vec4::ZeroVector();
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_direction = Vec4(direction, 0); // Put 0 in w because this is a direction, not a position
+		m_lights[lightIdx].m_position = Vec4::ZeroVector();
+		m_lights[lightIdx].m_direction = Vec4(direction, 0); // Put 0 in w because this is a direction, not a position
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -150,7 +244,7 @@ namespace moe
 
 	void LightSystem::SetConstantAttenuation(uint32_t lightIdx, float cstAtten)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_constantAttenuation = cstAtten;
+		m_lights[lightIdx].m_constantAttenuation = cstAtten;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -158,7 +252,7 @@ namespace moe
 
 	void LightSystem::SetLinearAttenuation(uint32_t lightIdx, float linAtten)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_linearAttenuation = linAtten;
+		m_lights[lightIdx].m_linearAttenuation = linAtten;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -166,7 +260,7 @@ namespace moe
 
 	void LightSystem::SetQuadraticAttenuation(uint32_t lightIdx, float quadAtten)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_quadraticAttenuation = quadAtten;
+		m_lights[lightIdx].m_quadraticAttenuation = quadAtten;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -174,9 +268,9 @@ namespace moe
 
 	void LightSystem::SetAttenuationFactors(uint32_t lightIdx, float constant, float linear, float quadratic)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_constantAttenuation = constant;
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_linearAttenuation = linear;
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_quadraticAttenuation = quadratic;
+		m_lights[lightIdx].m_constantAttenuation = constant;
+		m_lights[lightIdx].m_linearAttenuation = linear;
+		m_lights[lightIdx].m_quadraticAttenuation = quadratic;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 
@@ -185,7 +279,7 @@ namespace moe
 
 	void LightSystem::SetLightSpotInnerCutoff(uint32_t lightIdx, float cutoff)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_spotLightInnerCutoff = cutoff;
+		m_lights[lightIdx].m_spotLightInnerCutoff = cutoff;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 
@@ -194,7 +288,7 @@ namespace moe
 
 	void LightSystem::SetLightSpotOuterCutoff(uint32_t lightIdx, float cutoff)
 	{
-		m_lightCastersData.m_lightDataBuffer[lightIdx].m_spotLightOuterCutoff = cutoff;
+		m_lights[lightIdx].m_spotLightOuterCutoff = cutoff;
 
 		m_needBufferUpdateFlag = true; // light data buffer has changed: reupload lights.
 	}
@@ -9,13 +9,20 @@
 #include "Math/Vec4.h"
 
 #include "LightObject.h"
+#include "LightClusters.h"
 
 #include "Graphics/Material/MaterialBindings.h"
 
 #include "Graphics/OpenGL/Std140.h"
 
+#include <memory>
+
 namespace moe
 {
+	class Camera;
+
+	/* The number of lights shaders using the LightCastersData uniform block can see.
+	 * The light system itself has no limit : shaders using light clusters can see all of them. */
 	enum
 	{
 		MAX_LIGHTS = 32
@@ -47,6 +54,12 @@ namespace moe
 	};
 	#pragma warning (pop)
 
+	/**
+	 * \brief Owns the lights of a scene and sends them to shaders, in two possible ways :
+	 * - the LightCastersData uniform block, that contains the first MAX_LIGHTS lights, and that shaders go through entirely
+	 * - clustered lighting, enabled by calling UpdateClusters every frame : every light is sent in a storage buffer,
+	 * and each cluster of the view frustum has the list of lights that can reach it, so that shaders only go through those.
+	 */
 	class LightSystem
 	{
 
@@ -59,13 +72,25 @@ namespace moe
 
 		Monocle_Graphics_API void	BindLightBuffer();
 
+		/**
+		 * \brief Assigns the lights to the clusters of the camera view, and sends everything to the GPU.
+		 * Must be called once the camera has moved for the frame. Also updates the lights if needed.
+		 * \param jobSystem Optional : if given, the light assignment is done in parallel
+		 */
+		Monocle_Graphics_API void	UpdateClusters(const Camera& camera, const Vec2& viewportSize, JobSystem* jobSystem = nullptr);
+
+		/**
+		 * \brief Binds the buffers of clustered lighting (see MaterialStorageBinding and FRAME_LIGHT_CLUSTERS).
+		 */
+		Monocle_Graphics_API void	BindClusterBuffers();
+
 		Monocle_Graphics_API LightObject*	AddNewLight(LightData newLightData);
 
 		Monocle_Graphics_API void			RemoveLight(LightObject* light);
 
 		bool			NeedsUpdate() const { return m_needBufferUpdateFlag; }
 
-		uint32_t		LightsNumber() const { return m_lightCastersData.m_numLights; }
+		uint32_t		LightsNumber() const { return (uint32_t)m_lights.Size(); }
 
 		size_t			GetLightsBufferSizeBytes() const { return sizeof(m_lightCastersData); }
 
@@ -100,8 +125,13 @@ namespace moe
 
 		DeviceBufferHandle	GetLightsBufferHandle() const { return m_lightsUniformBlock; }
 
+		const LightClusters&	GetLightClusters() const { return m_clusters; }
+
 	private:
 
+		/* Makes sure a storage buffer can hold the given size, recreating it bigger if needed, and updates its contents. */
+		void	UploadStorageBuffer(DeviceBufferHandle& ssboHandle, size_t& capacityBytes, const void* data, size_t dataSizeBytes);
+
 		IGraphicsDevice&	m_device;
 
 		DeviceBufferHandle	m_lightsUniformBlock;
@@ -110,10 +140,12 @@ namespace moe
 
 		ResourceSetHandle		m_lightsResourceSet;
 
-		//Vector<LightData>	m_lightDataBuffer;
+		Vector<LightData>	m_lights;
+
 		LightCastersData	m_lightCastersData;
 
-		Vector<LightObject>		m_lightObjects;
+		// Light objects are handed out as pointers : allocate them separately so they don't move when the vector grows.
+		Vector<std::unique_ptr<LightObject>>	m_lightObjects;
 
 		Vector<LightObject*>	m_lightsToUpdate;
 
@@ -121,6 +153,21 @@ namespace moe
 
 		bool		m_needBufferUpdateFlag = false;
 
+		LightClusters	m_clusters;
+
+		DeviceBufferHandle	m_lightsStorageBuffer;
+		DeviceBufferHandle	m_clustersStorageBuffer;
+		DeviceBufferHandle	m_lightIndicesStorageBuffer;
+		DeviceBufferHandle	m_clustersParamsUniformBlock;
+
+		static constexpr size_t	ms_MIN_STORAGE_BUFFER_SIZE = 256;
+
+		size_t	m_lightsStorageCapacity = 0;
+		size_t	m_clustersStorageCapacity = 0;
+		size_t	m_lightIndicesStorageCapacity = 0;
+
+		bool	m_needLightsStorageUpdate = false;
+
 	};
 
 }
@@ -6,19 +6,29 @@
 
 #include "Graphics/RenderWorld/RenderWorld.h"
 
+#include <atomic>
+
 
 namespace moe
 {
 
-	void Material::UpdateObjectMatrices(AGraphicObject& object, DeviceBufferHandle ubHandle)
+	uint32_t Material::NewSortID()
+	{
+		// Materials may be created from several threads
+		static std::atomic<uint32_t> nextSortID{ 0 };
+		return nextSortID.fetch_add(1, std::memory_order_relaxed);
+	}
+
+
+	DeviceBufferHandle Material::UpdateObjectMatrices(AGraphicObject& object, DeviceBufferHandle ubHandle)
 	{
 		RenderWorld* objWorld = object.GetRenderWorld();
 		if (objWorld == nullptr)
-			return;
+			return ubHandle;
 
 		const Camera* cam = objWorld->GetCurrentCamera();
 		if (!MOE_ASSERT(cam != nullptr))
-			return;
+			return ubHandle;
 
 		const Mat4& model = object.GetTransform().Matrix();
 
@@ -28,7 +38,14 @@ namespace moe
 
 		ObjectMatrices matrices{ model, modelView, vp * model, Mat3(modelView).GetInverseTransposed() };
 
-		objWorld->MutRenderer().UpdateSubBufferRange(ubHandle, 0, &matrices, sizeof ObjectMatrices);
+		const DeviceBufferHandle streamedHandle = objWorld->MutRenderer().MutGraphicsDevice().StreamUniformData(&matrices, sizeof(ObjectMatrices));
+		if (streamedHandle.IsNotNull())
+		{
+			return streamedHandle;
+		}
+
+		objWorld->MutRenderer().UpdateSubBufferRange(ubHandle, 0, &matrices, sizeof(ObjectMatrices));
+		return ubHandle;
 	}
 
 
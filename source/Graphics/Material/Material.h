@@ -48,7 +48,7 @@ namespace moe
 	public:
 
 		Material(IGraphicsRenderer& renderer, ShaderProgramHandle shaderHandle) :
-			m_renderer(renderer), m_programHandle(shaderHandle)
+			m_renderer(renderer), m_programHandle(shaderHandle), m_sortID(NewSortID())
 		{}
 
 		void	AddPerMaterialResourceSet(ResourceSetHandle setHandle)
@@ -63,6 +63,11 @@ namespace moe
 
 		[[nodiscard]] ShaderProgramHandle	GetShaderProgramHandle() const { return m_programHandle; }
 
+		/**
+		 * \brief A small unique number identifying this material in render queue sort keys.
+		 */
+		[[nodiscard]] uint32_t	GetSortID() const { return m_sortID; }
+
 		[[nodiscard]] const Vector<ResourceSetHandle>&	GetPerMaterialResourceSets() const { return m_perMaterialResources; }
 		[[nodiscard]] const Vector<ResourceSetHandle>&	GetPerObjectResourceSets() const { return m_perObjectResources; }
 
@@ -74,7 +79,11 @@ namespace moe
 		[[nodiscard]] uint32_t	GetFrameUniformBlockCounter() const	{ return m_frameUniformBindingCounter; }
 
 
-		static void	UpdateObjectMatrices(AGraphicObject& object, DeviceBufferHandle ubHandle);
+		/**
+		 * \brief Computes the matrices of an object for the current camera and streams them to the GPU.
+		 * \return The handle of the memory holding the matrices : transient streamed memory, or ubHandle if the frame ran out of streaming memory.
+		 */
+		static DeviceBufferHandle	UpdateObjectMatrices(AGraphicObject& object, DeviceBufferHandle ubHandle);
 
 	private:
 
@@ -86,6 +95,10 @@ namespace moe
 		Vector<ResourceSetHandle>	m_perObjectResources;
 
 		uint32_t	m_frameUniformBindingCounter = 0;
+
+		uint32_t	m_sortID = 0;
+
+		static uint32_t	NewSortID();
 	};
 
 }
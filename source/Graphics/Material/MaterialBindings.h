@@ -19,7 +19,15 @@ namespace moe
 		FRAME_TONE_MAPPING,
 		FRAME_GAUSSIAN_BLUR,
 		FRAME_SSAO_PARAMS,
-		MATERIAL_PBR
+		MATERIAL_PBR,
+		FRAME_LIGHT_CLUSTERS
+	};
+
+	enum MaterialStorageBinding : uint8_t
+	{
+		CLUSTERED_LIGHTS = 0,
+		LIGHT_CLUSTERS,
+		LIGHT_INDICES
 	};
 
 	enum  MaterialTextureBinding : uint8_t
@@ -8,7 +8,9 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include "Core/Jobs/JobSystem.h"
 #include "Core/Misc/moeCountof.h"
+#include "Core/Misc/moeMappedFile.h"
 
 #include "Graphics/Material/MaterialBindings.h"
 #include "Graphics/Material/MaterialInterface.h"
@@ -16,14 +18,6 @@
 
 namespace moe
 {
-	// TODO: refactor out of here
-	struct VertexPositionNormalTexture
-	{
-		Vec3	m_position;
-		Vec3	m_normal;
-		Vec2	m_texcoords;
-	};
-
 	struct PhongMaterial
 	{
 		Vec4	m_ambientColor{ 1.f };
@@ -33,33 +27,144 @@ namespace moe
 	};
 
 
-	void	Model::ProcessNode(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle, aiNode* node, const aiScene* scene)
+	namespace
 	{
-		// process all the node's meshes (if any)
-		m_meshes.Reserve(m_meshes.Size() + node->mNumMeshes);
+		// Must be kept in the order of ModelTextureType.
+		const aiTextureType	SUPPORTED_TEXTURE_TYPES[] = {
+			aiTextureType_DIFFUSE,
+			aiTextureType_SPECULAR,
+			aiTextureType_EMISSIVE,
+			aiTextureType_HEIGHT,
+			aiTextureType_NORMALS,
+			aiTextureType_SHININESS
+		};
+
+		const MaterialTextureBinding	MONOCLE_TEXTURE_TYPES[] = {
+			DIFFUSE,
+			SPECULAR,
+			EMISSION,
+			HEIGHT,
+			NORMAL,
+			GLOSS
+		};
+
+		// It's not a code smell, it's a whole code trashcan !! It reeks !!!
+		const char*	MONOCLE_TEXTURE_DESCRIPTORS[] = {
+			"Material_DiffuseMap",
+			"Material_SpecularMap",
+			"Material_EmissionMap",
+			"Material_HeightMap",
+			"Material_NormalMap",
+			"Material_GlossMap"
+		};
+
+		static_assert(Countof(SUPPORTED_TEXTURE_TYPES) == (size_t)ModelTextureType::Count
+			&& Countof(MONOCLE_TEXTURE_TYPES) == (size_t)ModelTextureType::Count
+			&& Countof(MONOCLE_TEXTURE_DESCRIPTORS) == (size_t)ModelTextureType::Count);
+	}
+
+
+	bool Model::ImportWithAssimp(const std::string& modelFilename, ModelCacheWriter& writer, JobSystem* jobSystem)
+	{
+		Assimp::Importer importer;
+
+		// aiProcess_Triangulate means that if the model does not (entirely) consist of triangles,
+		// it should transform all the model's primitive shapes to triangles first.
+		// Don't flip UVs: stb_image already does
+		const aiScene* scene = importer.ReadFile(modelFilename,
+		aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+
+		if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
+		{
+			MOE_ERROR(ChanGraphics, "Assimp could not import file %s : '%s'.",
+			modelFilename, importer.GetErrorString());
+			return false;
+		}
+
+		// Try to retrieve the types of texture we know.
+		// So far, we only support one texture map per type of texture.
+		for (unsigned int iMat = 0; iMat < scene->mNumMaterials; iMat++)
+		{
+			const uint32_t matIndex = writer.AddMaterial();
+
+			const aiMaterial* material = scene->mMaterials[iMat];
+
+			for (size_t iTexType = 0; iTexType < Countof(SUPPORTED_TEXTURE_TYPES); iTexType++)
+			{
+				aiString str;
+				aiReturn texExists = material->GetTexture(SUPPORTED_TEXTURE_TYPES[iTexType], 0, &str);
+
+				if (texExists == AI_SUCCESS)
+				{
+					writer.SetMaterialTexture(matIndex, (ModelTextureType)iTexType, str.C_Str());
+				}
+			}
+		}
+
+		// Meshes are converted independently from each other : first list them in the node tree order...
+		Vector<const aiMesh*> meshes;
+		GatherMeshes(scene->mRootNode, scene, meshes);
+
+		struct ConvertedMesh
+		{
+			Vector<VertexPositionNormalTexture>	m_vertices;
+			Vector<uint32_t>					m_indices;
+		};
+
+		Vector<ConvertedMesh> convertedMeshes;
+		convertedMeshes.Resize(meshes.Size());
+
+		// ... then convert them, in parallel if we can...
+		auto convertMeshRange = [&meshes, &convertedMeshes](uint32_t beginMesh, uint32_t endMesh)
+		{
+			for (uint32_t iMesh = beginMesh; iMesh < endMesh; ++iMesh)
+			{
+				ProcessMesh(meshes[iMesh], convertedMeshes[iMesh].m_vertices, convertedMeshes[iMesh].m_indices);
+			}
+		};
+
+		if (jobSystem != nullptr)
+		{
+			// Mesh sizes vary a lot : let the job system make a few batches per thread, for them to balance out.
+			jobSystem->ParallelFor((uint32_t)meshes.Size(), 0, convertMeshRange);
+		}
+		else
+		{
+			convertMeshRange(0, (uint32_t)meshes.Size());
+		}
+
+		// ... and add them in order, so that the meshes are always created in the same order.
+		for (uint32_t iMesh = 0; iMesh < meshes.Size(); ++iMesh)
+		{
+			writer.AddMesh(std::move(convertedMeshes[iMesh].m_vertices), std::move(convertedMeshes[iMesh].m_indices), meshes[iMesh]->mMaterialIndex);
+		}
+
+		return true;
+	}
+
+
+	void	Model::GatherMeshes(const aiNode* node, const aiScene* scene, Vector<const aiMesh*>& meshes)
+	{
+		// gather all the node's meshes (if any)
+		meshes.Reserve(meshes.Size() + node->mNumMeshes);
 		for (unsigned int iMesh = 0; iMesh < node->mNumMeshes; iMesh++)
 		{
-			const aiMesh* mesh = scene->mMeshes[node->mMeshes[iMesh]];
-			m_meshes.PushBack(ProcessMesh(renderWorld, matLib, modelDir, textureCache, shaderHandle, mesh, scene));
+			meshes.PushBack(scene->mMeshes[node->mMeshes[iMesh]]);
 		}
 
 		// then do the same for each of its children
 		for (unsigned int iChild = 0; iChild < node->mNumChildren; iChild++)
 		{
-			ProcessNode(renderWorld, matLib, modelDir, textureCache, shaderHandle, node->mChildren[iChild], scene);
+			GatherMeshes(node->mChildren[iChild], scene, meshes);
 		}
 	}
 
 
-	Mesh* Model::ProcessMesh(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle, const aiMesh* mesh, const aiScene* scene)
+	void Model::ProcessMesh(const aiMesh* mesh, Vector<VertexPositionNormalTexture>& vertices, Vector<uint32_t>& indices)
 	{
 		// For now, assume a model always has at least position, normal, texture coordinates.
-		Vector<VertexPositionNormalTexture> vertices;
 		vertices.Resize(mesh->mNumVertices);
 
-		MeshDataDescriptor vtxData{ vertices.Data(),
-			vertices.Size() * sizeof(VertexPositionNormalTexture), vertices.Size()};
-
 		// process each vertex position, normal and texture coordinates
 		for (unsigned int iVert = 0; iVert < mesh->mNumVertices; iVert++)
 		{
@@ -90,13 +195,8 @@ namespace moe
 		// Assimp defines a mesh as having an array of faces, where each face represents a single primitive.
 		// In our case, due to the aiProcess_Triangulate option are always triangles.
 		// A face contains the indices of the vertices we need to draw in what order for its primitive.
-		Vector<uint32_t> indices;
 		indices.Resize(mesh->mNumFaces * 3);
 
-		MeshDataDescriptor idxData{
-			indices.Data(), indices.Size() * sizeof(uint32_t), indices.Size()
-		};
-
 		unsigned int index = 0;
 
 		for (unsigned int iFace = 0; iFace < mesh->mNumFaces; iFace++)
@@ -109,122 +209,129 @@ namespace moe
 				index++;
 			}
 		}
+	}
 
-		// create the mesh geometry...
-		Mesh * newMesh = renderWorld.CreateStaticMeshFromBuffer(vtxData, idxData);
 
-		// ... then process the material
-		// TODO: this should be done in some kind of Resource Manager context to reuse multiple instances of the same texture instead of duplicating it.
-		// ANd heavily refactored! supportedTextureTypes does not respect open/closed principle...
+	void Model::CreateMeshes(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, ShaderProgramHandle shaderHandle, const ModelCacheReader& cookedModel)
+	{
+		// Textures used by several meshes are only looked up once per import.
+		TextureCache textureCache;
+
+		const uint32_t numMeshes = cookedModel.GetNumMeshes();
+		m_meshes.Reserve(m_meshes.Size() + numMeshes);
 
-		if (mesh->mMaterialIndex >= 0)
+		for (uint32_t iMesh = 0; iMesh < numMeshes; ++iMesh)
 		{
-			// Create a Monocle Material Descriptor and fill it as necessary.
-			MaterialDescriptor matDesc(
-				{
-					{"Material_Phong", ShaderStage::Fragment},
-					{"Material_Sampler", ShaderStage::Fragment}
-				}
-			);
-
-			// Try to retrieve the types of texture we know.
-			// So far, we only support one texture map per type of texture.
-			const aiTextureType supportedTextureTypes[] = {
-				aiTextureType_DIFFUSE,
-				aiTextureType_SPECULAR,
-				aiTextureType_EMISSIVE,
-				aiTextureType_HEIGHT,
-				aiTextureType_NORMALS,
-				aiTextureType_SHININESS
-			};
+			const ModelCacheMesh& cookedMesh = cookedModel.GetMesh(iMesh);
 
-			constexpr auto numSupportedTexTypes = Countof(supportedTextureTypes);
+			// create the mesh geometry...
+			Mesh* newMesh = renderWorld.CreateStaticMeshFromBuffer(cookedModel.GetVertexData(cookedMesh), cookedModel.GetIndexData(cookedMesh));
+			if (newMesh == nullptr)
+			{
+				continue;
+			}
 
-			const MaterialTextureBinding monocleTextureTypes[numSupportedTexTypes] = {
-				DIFFUSE,
-				SPECULAR,
-				EMISSION,
-				HEIGHT,
-				NORMAL,
-				GLOSS
-			};
+			newMesh->SetLocalBounds(ModelCacheReader::GetBounds(cookedMesh));
 
-			// It's not a code smell, it's a whole code trashcan !! It reeks !!!
-			const char* monocleTextureDescriptors[numSupportedTexTypes] = {
-				"Material_DiffuseMap",
-				"Material_SpecularMap",
-				"Material_EmissionMap",
-				"Material_HeightMap",
-				"Material_NormalMap",
-				"Material_GlossMap"
-			};
+			// ... then process the material
+			const ModelCacheMaterial* material = cookedModel.GetMaterial(cookedMesh);
+			if (material != nullptr)
+			{
+				BindMaterial(renderWorld, matLib, modelDir, textureCache, shaderHandle, cookedModel, *material, *newMesh);
+			}
 
-			Texture2DHandle textureHandles[numSupportedTexTypes]{0};
+			m_meshes.PushBack(newMesh);
+		}
+	}
 
-			aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
-			for (int iTexType = 0; iTexType < numSupportedTexTypes; iTexType++)
+	void Model::BindMaterial(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle,
+							const ModelCacheReader& cookedModel, const ModelCacheMaterial& material, Mesh& mesh)
+	{
+		// TODO: this should be heavily refactored! SUPPORTED_TEXTURE_TYPES does not respect open/closed principle...
+
+		// Create a Monocle Material Descriptor and fill it as necessary.
+		MaterialDescriptor matDesc(
 			{
-				aiString str;
-				aiReturn texExists = material->GetTexture(supportedTextureTypes[iTexType], 0, &str);
+				{"Material_Phong", ShaderStage::Fragment},
+				{"Material_Sampler", ShaderStage::Fragment}
+			}
+		);
 
-				if (texExists == AI_SUCCESS)
-				{
-					matDesc.AddBinding(monocleTextureDescriptors[iTexType], ShaderStage::Fragment); // assume all textures are used in fragment shader for now...
-
-					// Load the texture while we're at it.
-					Texture2DFileDescriptor texFileDesc;
-					StringFormat(texFileDesc.m_filename, "%s/%s", modelDir, str.C_Str());
-
-					auto texIt = textureCache.Find(texFileDesc.m_filename);
-					if (texIt == textureCache.End())
-					{
-						texFileDesc.m_targetFormat = TextureFormat::SRGB_RGBA8; // for HDR
-						textureHandles[iTexType] = renderWorld.MutRenderer().MutGraphicsDevice().CreateTexture2D(texFileDesc);
-						textureCache.Insert({ texFileDesc.m_filename , textureHandles[iTexType] });
-					}
-					else
-					{
-						textureHandles[iTexType] = texIt->second;
-					}
-				}
+		constexpr auto numSupportedTexTypes = (size_t)ModelTextureType::Count;
+
+		Texture2DHandle textureHandles[numSupportedTexTypes]{0};
+
+		for (size_t iTexType = 0; iTexType < numSupportedTexTypes; iTexType++)
+		{
+			const std::string_view texName = cookedModel.GetTextureName(material, (ModelTextureType)iTexType);
+			if (texName.empty())
+			{
+				continue;
 			}
 
-			// Now create Material Interface and Instance
-			MaterialInterface matInterface = matLib.CreateMaterialInterface(shaderHandle, matDesc);
-			MaterialInstance matInstance = matLib.CreateMaterialInstance(matInterface);
+			matDesc.AddBinding(MONOCLE_TEXTURE_DESCRIPTORS[iTexType], ShaderStage::Fragment); // assume all textures are used in fragment shader for now...
+
+			// Load the texture while we're at it.
+			Texture2DFileDescriptor texFileDesc;
+			StringFormat(texFileDesc.m_filename, "%s/%s", modelDir, std::string(texName));
 
-			for (int iTexType = 0; iTexType < numSupportedTexTypes; iTexType++)
+			auto texIt = textureCache.Find(texFileDesc.m_filename);
+			if (texIt == textureCache.End())
 			{
-				if (textureHandles[iTexType].IsNotNull())
+				texFileDesc.m_targetFormat = TextureFormat::SRGB_RGBA8; // for HDR
+
+				if (m_resourceManager != nullptr)
+				{
+					TextureRef texRef = m_resourceManager->AcquireTexture2D(texFileDesc);
+					textureHandles[iTexType].m_handle = texRef.Get().Get();
+					m_textures.PushBack(std::move(texRef));
+				}
+				else
 				{
-					matInstance.BindTexture(monocleTextureTypes[iTexType], textureHandles[iTexType]);
+					textureHandles[iTexType] = renderWorld.MutRenderer().MutGraphicsDevice().CreateTexture2DAsync(texFileDesc);
 				}
+
+				textureCache.Insert({ texFileDesc.m_filename , textureHandles[iTexType] });
+			}
+			else
+			{
+				textureHandles[iTexType] = texIt->second;
 			}
+		}
 
-			// TODO : refactor
-			matInstance.UpdateUniformBlock(MaterialBlockBinding::MATERIAL_PHONG,
-				PhongMaterial{ ColorRGBAf::White().ToVec(),
-								ColorRGBAf::White().ToVec(),
-								ColorRGBAf::White().ToVec(),
-								32 });
+		// Now create Material Interface and Instance
+		MaterialInterface matInterface = matLib.CreateMaterialInterface(shaderHandle, matDesc);
+		MaterialInstance matInstance = matLib.CreateMaterialInstance(matInterface);
 
-			SamplerDescriptor mySamplerDesc;
-			mySamplerDesc.m_magFilter = SamplerFilter::Linear;
-			mySamplerDesc.m_minFilter = SamplerFilter::LinearMipmapLinear;
-			mySamplerDesc.m_wrap_S = SamplerWrapping::Repeat;
-			mySamplerDesc.m_wrap_T = SamplerWrapping::Repeat;
+		for (size_t iTexType = 0; iTexType < numSupportedTexTypes; iTexType++)
+		{
+			if (textureHandles[iTexType].IsNotNull())
+			{
+				matInstance.BindTexture(MONOCLE_TEXTURE_TYPES[iTexType], textureHandles[iTexType]);
+			}
+		}
 
-			SamplerHandle mySampler = renderWorld.MutRenderer().MutGraphicsDevice().CreateSampler(mySamplerDesc);
+		// TODO : refactor
+		matInstance.UpdateUniformBlock(MaterialBlockBinding::MATERIAL_PHONG,
+			PhongMaterial{ ColorRGBAf::White().ToVec(),
+							ColorRGBAf::White().ToVec(),
+							ColorRGBAf::White().ToVec(),
+							32 });
 
-			matInstance.BindSampler(MaterialSamplerBinding::SAMPLER_0, mySampler);
+		SamplerDescriptor mySamplerDesc;
+		mySamplerDesc.m_magFilter = SamplerFilter::Linear;
+		mySamplerDesc.m_minFilter = SamplerFilter::LinearMipmapLinear;
+		mySamplerDesc.m_wrap_S = SamplerWrapping::Repeat;
+		mySamplerDesc.m_wrap_T = SamplerWrapping::Repeat;
 
-			matInstance.CreateMaterialResourceSet();
+		SamplerHandle mySampler = renderWorld.MutRenderer().MutGraphicsDevice().CreateSampler(mySamplerDesc);
 
-			newMesh->BindMaterial(std::move(matInstance));
-		}
+		matInstance.BindSampler(MaterialSamplerBinding::SAMPLER_0, mySampler);
 
-		return newMesh;
+		matInstance.CreateMaterialResourceSet();
+
+		mesh.BindMaterial(std::move(matInstance));
 	}
 
 
@@ -248,29 +355,64 @@ namespace moe
 
 	Model::Model(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc)
 	{
-		Assimp::Importer importer;
+		Import(renderWorld, matLib, modelDesc);
+	}
 
-		// aiProcess_Triangulate means that if the model does not (entirely) consist of triangles,
-		// it should transform all the model's primitive shapes to triangles first.
-		// Don't flip UVs: stb_image already does
-		const aiScene* scene = importer.ReadFile(modelDesc.m_modelFilename,
-		aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
 
+	Model::Model(RenderWorld& renderWorld, MaterialLibrary& matLib, GraphicsResourceManager& resourceManager, const ModelDescriptor& modelDesc) :
+		m_resourceManager(&resourceManager)
+	{
+		Import(renderWorld, matLib, modelDesc);
+	}
+
+
+	void Model::Import(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc)
+	{
 		/* Extract the directory from the model file path. It will help us to retrieve textures, assuming they are stored next to the model. */
 		// TODO: use C++17 filesystem parent_path() instead.
 		const std::string modelDirectory = modelDesc.m_modelFilename.substr(0, modelDesc.m_modelFilename.find_last_of('/'));
 
-		if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
+		const std::string cacheFilename = modelDesc.m_modelFilename + ModelCacheReader::ms_FILE_EXTENSION;
+
+		// A missing source file is not an error if the cooked model is there : it can be shipped alone.
+		const std::optional<ModelSourceStamp> sourceStamp = ModelSourceStamp::Of(modelDesc.m_modelFilename);
+
+		if (modelDesc.m_useCache)
+		{
+			MappedFile cacheFile;
+			if (cacheFile.Open(cacheFilename))
+			{
+				const ModelCacheReader cookedModel(cacheFile.Data(), cacheFile.Size());
+				if (cookedModel.IsValid() && (!sourceStamp.has_value() || cookedModel.MatchesSource(*sourceStamp)))
+				{
+					CreateMeshes(renderWorld, matLib, modelDirectory, modelDesc.m_shaderProgram, cookedModel);
+					return;
+				}
+			}
+		}
+
+		// The cooked model is missing or stale : go the slow way, and cook it for next time.
+		ModelCacheWriter writer;
+		if (!ImportWithAssimp(modelDesc.m_modelFilename, writer, modelDesc.m_jobSystem))
 		{
-			MOE_ERROR(ChanGraphics, "Assimp could not import file %s : '%s'.",
-			modelDesc.m_modelFilename, importer.GetErrorString());
 			return;
 		}
 
-		// TODO: this should be implemented in a resource manager.
-		HashMap<std::string, Texture2DHandle> textureCache;
+		const Vector<std::byte> cookedBlob = writer.Cook(sourceStamp.value_or(ModelSourceStamp{}), modelDesc.m_jobSystem);
+
+		if (modelDesc.m_useCache && sourceStamp.has_value())
+		{
+			if (!ModelCacheWriter::WriteFile(cacheFilename, cookedBlob))
+			{
+				MOE_WARNING(ChanGraphics, "Could not write the model cache file %s.", cacheFilename);
+			}
+		}
 
-		ProcessNode(renderWorld, matLib, modelDirectory, textureCache, modelDesc.m_shaderProgram, scene->mRootNode, scene);
+		const ModelCacheReader cookedModel(cookedBlob.Data(), cookedBlob.Size());
+		if (MOE_ASSERT(cookedModel.IsValid()))
+		{
+			CreateMeshes(renderWorld, matLib, modelDirectory, modelDesc.m_shaderProgram, cookedModel);
+		}
 	}
 
 
@@ -12,6 +12,10 @@
 
 #include "Graphics/Sampler/SamplerDescriptor.h"
 
+#include "Graphics/ResourceManager/GraphicsResourceManager.h"
+
+#include "Graphics/Model/ModelCache.h"
+
 struct aiNode;
 struct aiMesh;
 struct aiScene;
@@ -19,12 +23,15 @@ struct aiScene;
 
 namespace moe
 {
+	class JobSystem;
 	class MaterialLibrary;
 
 	struct ModelDescriptor
 	{
 		std::string	m_modelFilename{""};
 		ShaderProgramHandle	m_shaderProgram;
+		bool		m_useCache{ true }; // Load the cooked model next to the model file if it is up to date, (re)write it otherwise
+		JobSystem*	m_jobSystem{ nullptr }; // Optional : if given, meshes imported with Assimp are converted in parallel
 	};
 
 
@@ -40,6 +47,18 @@ namespace moe
 
 		Model(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc);
 
+		/**
+		 * \brief Imports the model, acquiring its textures from the resource manager so that they are shared with other models.
+		 * The model keeps a reference to its textures for as long as it lives.
+		 */
+		Model(RenderWorld& renderWorld, MaterialLibrary& matLib, GraphicsResourceManager& resourceManager, const ModelDescriptor& modelDesc);
+
+
+		[[nodiscard]] const MeshStorage&	GetMeshes() const
+		{
+			return m_meshes;
+		}
+
 
 		MeshStorage::Iterator	begin()
 		{
@@ -65,10 +84,31 @@ namespace moe
 
 		using TextureCache = HashMap<std::string, Texture2DHandle>;
 
-		void	ProcessNode(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle, aiNode* node, const aiScene* scene);
-		Mesh*	ProcessMesh(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle, const aiMesh* mesh, const aiScene* scene);
+		void	Import(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc);
+
+		/**
+		 * \brief Runs the Assimp import of the model file and gathers its meshes and materials in the writer.
+		 * Meshes are converted in parallel if there is a job system, and added to the writer in the order of the node tree.
+		 * \return false if Assimp could not import the file
+		 */
+		static bool	ImportWithAssimp(const std::string& modelFilename, ModelCacheWriter& writer, JobSystem* jobSystem);
+
+		static void	GatherMeshes(const aiNode* node, const aiScene* scene, Vector<const aiMesh*>& meshes);
+		static void	ProcessMesh(const aiMesh* mesh, Vector<VertexPositionNormalTexture>& vertices, Vector<uint32_t>& indices);
+
+		/**
+		 * \brief Creates the meshes of a cooked model. Vertex and index data are uploaded straight from the cooked blob.
+		 */
+		void	CreateMeshes(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, ShaderProgramHandle shaderHandle, const ModelCacheReader& cookedModel);
+
+		void	BindMaterial(RenderWorld& renderWorld, MaterialLibrary& matLib, const std::string& modelDir, TextureCache& textureCache, ShaderProgramHandle shaderHandle,
+							const ModelCacheReader& cookedModel, const ModelCacheMaterial& material, Mesh& mesh);
 
 		MeshStorage	m_meshes;
+
+		GraphicsResourceManager*	m_resourceManager = nullptr;
+
+		Vector<TextureRef>			m_textures;
 	};
 
 }
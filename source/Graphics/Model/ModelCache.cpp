@@ -0,0 +1,298 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "ModelCache.h"
+
+#include <cstdio> // remove
+#include <cstring> // memcpy
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "Core/Jobs/JobSystem.h"
+
+namespace moe
+{
+	namespace
+	{
+		size_t	AlignUp(size_t offset, size_t alignment)
+		{
+			return (offset + alignment - 1) & ~(alignment - 1);
+		}
+
+
+		// Checks that an array of count elements of given size fits in the blob, without overflowing.
+		bool	IsInBounds(uint64_t offset, uint64_t count, uint64_t elemSize, uint64_t blobSize)
+		{
+			return (offset <= blobSize && count <= (blobSize - offset) / elemSize);
+		}
+	}
+
+
+	std::optional<ModelSourceStamp> ModelSourceStamp::Of(const std::string& sourceFilename)
+	{
+		std::error_code error;
+
+		const uintmax_t size = std::filesystem::file_size(sourceFilename, error);
+		if (error)
+		{
+			return std::nullopt;
+		}
+
+		const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(sourceFilename, error);
+		if (error)
+		{
+			return std::nullopt;
+		}
+
+		ModelSourceStamp stamp;
+		stamp.m_size = (uint64_t)size;
+		stamp.m_writeTime = (int64_t)writeTime.time_since_epoch().count();
+		return stamp;
+	}
+
+
+	uint32_t ModelCacheWriter::AddMaterial()
+	{
+		m_materials.EmplaceBack();
+
+		ModelCacheMaterial& newMat = m_materials.Back();
+		for (uint32_t& texName : newMat.m_textureNames)
+		{
+			texName = ModelCacheReader::ms_NO_TEXTURE;
+		}
+
+		return (uint32_t)m_materials.Size() - 1;
+	}
+
+
+	void ModelCacheWriter::SetMaterialTexture(uint32_t materialIndex, ModelTextureType texType, std::string_view textureName)
+	{
+		if (!MOE_ASSERT(materialIndex < m_materials.Size() && texType < ModelTextureType::Count))
+		{
+			return;
+		}
+
+		m_materials[materialIndex].m_textureNames[(size_t)texType] = (uint32_t)m_strings.size();
+		m_strings.append(textureName);
+		m_strings.push_back('\0');
+	}
+
+
+	void ModelCacheWriter::AddMesh(Vector<VertexPositionNormalTexture>&& vertices, Vector<uint32_t>&& indices, uint32_t materialIndex)
+	{
+		if (vertices.Empty())
+		{
+			return;
+		}
+
+		MOE_ASSERT(materialIndex == ModelCacheReader::ms_NO_MATERIAL || materialIndex < m_materials.Size());
+
+		m_meshes.PushBack({ std::move(vertices), std::move(indices), materialIndex });
+	}
+
+
+	Vector<std::byte> ModelCacheWriter::Cook(const ModelSourceStamp& sourceStamp, JobSystem* jobSystem) const
+	{
+		// First compute the layout of the blob...
+		const size_t meshesOffset = sizeof(ModelCacheHeader);
+		const size_t materialsOffset = meshesOffset + m_meshes.Size() * sizeof(ModelCacheMesh);
+		const size_t stringsOffset = materialsOffset + m_materials.Size() * sizeof(ModelCacheMaterial);
+
+		Vector<ModelCacheMesh> meshRecords;
+		meshRecords.Resize(m_meshes.Size());
+
+		size_t dataOffset = stringsOffset + m_strings.size();
+
+		for (uint32_t iMesh = 0; iMesh < m_meshes.Size(); ++iMesh)
+		{
+			const PendingMesh& mesh = m_meshes[iMesh];
+			ModelCacheMesh& record = meshRecords[iMesh];
+
+			dataOffset = AlignUp(dataOffset, ModelCacheReader::ms_DATA_ALIGNMENT);
+			record.m_verticesOffset = dataOffset;
+			record.m_numVertices = (uint32_t)mesh.m_vertices.Size();
+			dataOffset += mesh.m_vertices.Size() * sizeof(VertexPositionNormalTexture);
+
+			dataOffset = AlignUp(dataOffset, ModelCacheReader::ms_DATA_ALIGNMENT);
+			record.m_indicesOffset = dataOffset;
+			record.m_numIndices = (uint32_t)mesh.m_indices.Size();
+			dataOffset += mesh.m_indices.Size() * sizeof(uint32_t);
+
+			record.m_materialIndex = mesh.m_materialIndex;
+		}
+
+		// ... then fill it. Meshes are independent from each other : their bounds and data can be done in parallel.
+		Vector<std::byte> blob;
+		blob.Resize(dataOffset, std::byte{ 0 });
+
+		auto cookMeshRange = [this, &meshRecords, &blob](uint32_t beginMesh, uint32_t endMesh)
+		{
+			for (uint32_t iMesh = beginMesh; iMesh < endMesh; ++iMesh)
+			{
+				const PendingMesh& mesh = m_meshes[iMesh];
+				ModelCacheMesh& record = meshRecords[iMesh];
+
+				const AABB bounds = AABB::FromPoints(mesh.m_vertices[0].m_position.Ptr(), mesh.m_vertices.Size(), sizeof(VertexPositionNormalTexture));
+				for (int iAxis = 0; iAxis < 3; ++iAxis)
+				{
+					record.m_boundsMin[iAxis] = bounds.m_min[iAxis];
+					record.m_boundsMax[iAxis] = bounds.m_max[iAxis];
+				}
+
+				std::memcpy(blob.Data() + record.m_verticesOffset, mesh.m_vertices.Data(), mesh.m_vertices.Size() * sizeof(VertexPositionNormalTexture));
+				if (!mesh.m_indices.Empty())
+				{
+					std::memcpy(blob.Data() + record.m_indicesOffset, mesh.m_indices.Data(), mesh.m_indices.Size() * sizeof(uint32_t));
+				}
+			}
+		};
+
+		if (jobSystem != nullptr)
+		{
+			jobSystem->ParallelFor((uint32_t)m_meshes.Size(), 0, cookMeshRange);
+		}
+		else
+		{
+			cookMeshRange(0, (uint32_t)m_meshes.Size());
+		}
+
+		ModelCacheHeader header;
+		header.m_magic = ModelCacheReader::ms_MAGIC;
+		header.m_version = ModelCacheReader::ms_VERSION;
+		header.m_totalSize = dataOffset;
+		header.m_sourceSize = sourceStamp.m_size;
+		header.m_sourceWriteTime = sourceStamp.m_writeTime;
+		header.m_vertexStride = sizeof(VertexPositionNormalTexture);
+		header.m_numMeshes = (uint32_t)m_meshes.Size();
+		header.m_numMaterials = (uint32_t)m_materials.Size();
+		header.m_stringsSize = (uint32_t)m_strings.size();
+
+		std::memcpy(blob.Data(), &header, sizeof(header));
+
+		if (!meshRecords.Empty())
+		{
+			std::memcpy(blob.Data() + meshesOffset, meshRecords.Data(), meshRecords.Size() * sizeof(ModelCacheMesh));
+		}
+
+		if (!m_materials.Empty())
+		{
+			std::memcpy(blob.Data() + materialsOffset, m_materials.Data(), m_materials.Size() * sizeof(ModelCacheMaterial));
+		}
+
+		std::memcpy(blob.Data() + stringsOffset, m_strings.data(), m_strings.size());
+
+		return blob;
+	}
+
+
+	bool ModelCacheWriter::WriteFile(const std::string& cacheFilename, const Vector<std::byte>& cookedModel)
+	{
+		const std::string tempFilename = cacheFilename + ".tmp";
+
+		{
+			std::ofstream cacheFile(tempFilename, std::ios::binary | std::ios::trunc);
+			if (!cacheFile)
+			{
+				return false;
+			}
+
+			cacheFile.write(reinterpret_cast<const char*>(cookedModel.Data()), cookedModel.Size());
+			if (!cacheFile)
+			{
+				cacheFile.close();
+				std::remove(tempFilename.c_str());
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempFilename, cacheFilename, error);
+		if (error)
+		{
+			std::remove(tempFilename.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+
+	ModelCacheReader::ModelCacheReader(const std::byte* data, size_t size)
+	{
+		if (data == nullptr || size < sizeof(ModelCacheHeader))
+		{
+			return;
+		}
+
+		// Everything in the blob is naturally aligned if the blob is : mappings and allocations always are.
+		MOE_DEBUG_ASSERT(reinterpret_cast<uintptr_t>(data) % alignof(ModelCacheHeader) == 0);
+
+		const ModelCacheHeader* header = reinterpret_cast<const ModelCacheHeader*>(data);
+		if (header->m_magic != ms_MAGIC || header->m_version != ms_VERSION || header->m_totalSize != size
+			|| header->m_vertexStride != sizeof(VertexPositionNormalTexture))
+		{
+			return;
+		}
+
+		const uint64_t meshesOffset = sizeof(ModelCacheHeader);
+		const uint64_t materialsOffset = meshesOffset + (uint64_t)header->m_numMeshes * sizeof(ModelCacheMesh);
+		const uint64_t stringsOffset = materialsOffset + (uint64_t)header->m_numMaterials * sizeof(ModelCacheMaterial);
+
+		if (!IsInBounds(meshesOffset, header->m_numMeshes, sizeof(ModelCacheMesh), size)
+			|| !IsInBounds(materialsOffset, header->m_numMaterials, sizeof(ModelCacheMaterial), size)
+			|| !IsInBounds(stringsOffset, header->m_stringsSize, 1, size))
+		{
+			return;
+		}
+
+		const ModelCacheMesh* meshes = reinterpret_cast<const ModelCacheMesh*>(data + meshesOffset);
+		for (uint32_t iMesh = 0; iMesh < header->m_numMeshes; ++iMesh)
+		{
+			const ModelCacheMesh& mesh = meshes[iMesh];
+			if (mesh.m_verticesOffset % ms_DATA_ALIGNMENT != 0 || mesh.m_indicesOffset % ms_DATA_ALIGNMENT != 0
+				|| !IsInBounds(mesh.m_verticesOffset, mesh.m_numVertices, sizeof(VertexPositionNormalTexture), size)
+				|| !IsInBounds(mesh.m_indicesOffset, mesh.m_numIndices, sizeof(uint32_t), size)
+				|| (mesh.m_materialIndex != ms_NO_MATERIAL && mesh.m_materialIndex >= header->m_numMaterials))
+			{
+				return;
+			}
+		}
+
+		// Every texture name must be a null-terminated string of the string table.
+		const char* strings = reinterpret_cast<const char*>(data + stringsOffset);
+		if (header->m_stringsSize != 0 && strings[header->m_stringsSize - 1] != '\0')
+		{
+			return;
+		}
+
+		const ModelCacheMaterial* materials = reinterpret_cast<const ModelCacheMaterial*>(data + materialsOffset);
+		for (uint32_t iMat = 0; iMat < header->m_numMaterials; ++iMat)
+		{
+			for (uint32_t texName : materials[iMat].m_textureNames)
+			{
+				if (texName != ms_NO_TEXTURE && texName >= header->m_stringsSize)
+				{
+					return;
+				}
+			}
+		}
+
+		m_data = data;
+		m_header = header;
+		m_meshes = meshes;
+		m_materials = materials;
+		m_strings = strings;
+	}
+
+
+	std::string_view ModelCacheReader::GetTextureName(const ModelCacheMaterial& material, ModelTextureType texType) const
+	{
+		const uint32_t nameOffset = material.m_textureNames[(size_t)texType];
+		if (nameOffset == ms_NO_TEXTURE)
+		{
+			return {};
+		}
+
+		return std::string_view(m_strings + nameOffset);
+	}
+}
@@ -0,0 +1,236 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_STD_SUPPORT
+#include <optional>
+#include <string>
+#include <string_view>
+#endif
+
+#include <cstddef>
+
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Math/Vec2.h"
+#include "Math/Vec3.h"
+#include "Math/Bounds/Bounds.h"
+
+#include "Graphics/Mesh/MeshDataDescriptor.h"
+
+#include "Monocle_Graphics_Export.h"
+
+
+namespace moe
+{
+	class JobSystem;
+
+
+	/**
+	 * \brief The vertex format of imported models.
+	 */
+	struct VertexPositionNormalTexture
+	{
+		Vec3	m_position;
+		Vec3	m_normal;
+		Vec2	m_texcoords;
+	};
+
+
+	/**
+	 * \brief The texture maps a model material can have, at most one per type.
+	 */
+	enum class ModelTextureType : uint8_t
+	{
+		Diffuse,
+		Specular,
+		Emission,
+		Height,
+		Normal,
+		Gloss,
+		Count
+	};
+
+
+	/*
+	 * The cooked model format is a single binary blob, meant to be memory mapped and uploaded as is :
+	 * - a ModelCacheHeader
+	 * - the ModelCacheMesh table
+	 * - the ModelCacheMaterial table
+	 * - the string table (null-terminated texture file names, relative to the model directory)
+	 * - the vertex and index data of each mesh, each 16-byte aligned.
+	 * All offsets are relative to the start of the blob. The format is not portable across endianness :
+	 * it is a cache, not a distribution format.
+	 */
+
+	struct ModelCacheHeader
+	{
+		uint32_t	m_magic = 0;
+		uint32_t	m_version = 0;
+		uint64_t	m_totalSize = 0;
+		uint64_t	m_sourceSize = 0;		// Used to tell if the cache is stale
+		int64_t		m_sourceWriteTime = 0;
+		uint32_t	m_vertexStride = 0;
+		uint32_t	m_numMeshes = 0;
+		uint32_t	m_numMaterials = 0;
+		uint32_t	m_stringsSize = 0;
+	};
+
+
+	struct ModelCacheMesh
+	{
+		uint64_t	m_verticesOffset = 0;
+		uint64_t	m_indicesOffset = 0;
+		uint32_t	m_numVertices = 0;
+		uint32_t	m_numIndices = 0;
+		float		m_boundsMin[3]{};
+		float		m_boundsMax[3]{};
+		uint32_t	m_materialIndex = 0;	// ms_NO_MATERIAL if the mesh has none
+		uint32_t	m_padding = 0;
+	};
+
+
+	struct ModelCacheMaterial
+	{
+		uint32_t	m_textureNames[(size_t)ModelTextureType::Count]; // Offsets in the string table, or ms_NO_TEXTURE
+	};
+
+
+	/**
+	 * \brief The size and modification time of a model source file : if any of them changes, the cooked file is stale.
+	 */
+	struct ModelSourceStamp
+	{
+		Monocle_Graphics_API [[nodiscard]] static std::optional<ModelSourceStamp>	Of(const std::string& sourceFilename);
+
+		uint64_t	m_size = 0;
+		int64_t		m_writeTime = 0;
+	};
+
+
+	/**
+	 * \brief Gathers the meshes and materials of an imported model and cooks them in the model cache format.
+	 */
+	class ModelCacheWriter
+	{
+	public:
+
+		/**
+		 * \return The index of the new material
+		 */
+		Monocle_Graphics_API uint32_t	AddMaterial();
+
+		/**
+		 * \param textureName The name of the texture file, relative to the model directory
+		 */
+		Monocle_Graphics_API void	SetMaterialTexture(uint32_t materialIndex, ModelTextureType texType, std::string_view textureName);
+
+		/**
+		 * \brief Empty meshes are ignored.
+		 * \param materialIndex An index returned by AddMaterial, or ms_NO_MATERIAL
+		 */
+		Monocle_Graphics_API void	AddMesh(Vector<VertexPositionNormalTexture>&& vertices, Vector<uint32_t>&& indices, uint32_t materialIndex);
+
+		[[nodiscard]] uint32_t	GetNumMeshes() const { return (uint32_t)m_meshes.Size(); }
+
+		/**
+		 * \brief Cooks everything that was added into a blob that can be read by a ModelCacheReader or written to a file.
+		 * \param jobSystem Optional : if given, meshes are cooked in parallel
+		 */
+		Monocle_Graphics_API [[nodiscard]] Vector<std::byte>	Cook(const ModelSourceStamp& sourceStamp, JobSystem* jobSystem = nullptr) const;
+
+		/**
+		 * \brief Writes to a temporary file that is then renamed, so that a reader never sees a partially written file.
+		 */
+		Monocle_Graphics_API static bool	WriteFile(const std::string& cacheFilename, const Vector<std::byte>& cookedModel);
+
+
+	private:
+
+		struct PendingMesh
+		{
+			Vector<VertexPositionNormalTexture>	m_vertices;
+			Vector<uint32_t>					m_indices;
+			uint32_t							m_materialIndex = 0;
+		};
+
+		Vector<PendingMesh>			m_meshes;
+		Vector<ModelCacheMaterial>	m_materials;
+		std::string					m_strings;
+	};
+
+
+	/**
+	 * \brief Reads a cooked model straight from memory (typically a memory mapped file) : nothing is copied.
+	 * The whole blob is validated when the reader is created, so that a corrupted or truncated file is simply treated as missing.
+	 */
+	class ModelCacheReader
+	{
+	public:
+
+		Monocle_Graphics_API ModelCacheReader(const std::byte* data, size_t size);
+
+
+		[[nodiscard]] bool	IsValid() const { return m_header != nullptr; }
+
+		/**
+		 * \brief Tells if the model was cooked from this version of its source file.
+		 */
+		[[nodiscard]] bool	MatchesSource(const ModelSourceStamp& sourceStamp) const
+		{
+			return (m_header->m_sourceSize == sourceStamp.m_size && m_header->m_sourceWriteTime == sourceStamp.m_writeTime);
+		}
+
+
+		[[nodiscard]] uint32_t	GetNumMeshes() const { return m_header->m_numMeshes; }
+
+		[[nodiscard]] const ModelCacheMesh&	GetMesh(uint32_t iMesh) const { return m_meshes[iMesh]; }
+
+		[[nodiscard]] MeshDataDescriptor	GetVertexData(const ModelCacheMesh& mesh) const
+		{
+			return { m_data + mesh.m_verticesOffset, mesh.m_numVertices * sizeof(VertexPositionNormalTexture), mesh.m_numVertices };
+		}
+
+		[[nodiscard]] MeshDataDescriptor	GetIndexData(const ModelCacheMesh& mesh) const
+		{
+			return { m_data + mesh.m_indicesOffset, mesh.m_numIndices * sizeof(uint32_t), mesh.m_numIndices };
+		}
+
+		[[nodiscard]] static AABB	GetBounds(const ModelCacheMesh& mesh)
+		{
+			return AABB(Vec3(mesh.m_boundsMin[0], mesh.m_boundsMin[1], mesh.m_boundsMin[2]),
+						Vec3(mesh.m_boundsMax[0], mesh.m_boundsMax[1], mesh.m_boundsMax[2]));
+		}
+
+		/**
+		 * \return null if the mesh has no material
+		 */
+		[[nodiscard]] const ModelCacheMaterial*	GetMaterial(const ModelCacheMesh& mesh) const
+		{
+			return (mesh.m_materialIndex < m_header->m_numMaterials ? &m_materials[mesh.m_materialIndex] : nullptr);
+		}
+
+		/**
+		 * \return An empty string if the material has no texture of this type
+		 */
+		[[nodiscard]] std::string_view	GetTextureName(const ModelCacheMaterial& material, ModelTextureType texType) const;
+
+
+		static constexpr uint32_t	ms_MAGIC = 0x4D454F4D; // "MOEM"
+		static constexpr uint32_t	ms_VERSION = 1;
+		static constexpr uint32_t	ms_NO_MATERIAL = UINT32_MAX;
+		static constexpr uint32_t	ms_NO_TEXTURE = UINT32_MAX;
+		static constexpr size_t		ms_DATA_ALIGNMENT = 16;
+		static constexpr const char*	ms_FILE_EXTENSION = ".moemodel";
+
+
+	private:
+
+		const std::byte*			m_data = nullptr;
+		const ModelCacheHeader*		m_header = nullptr;
+		const ModelCacheMesh*		m_meshes = nullptr;
+		const ModelCacheMaterial*	m_materials = nullptr;
+		const char*					m_strings = nullptr;
+	};
+
+}
@@ -7,16 +7,25 @@
 namespace moe
 {
 
-	void OpenGLPipeline::SetBlendState(const BlendStateDescriptor& bsDesc)
+	OpenGLPipelineState OpenGLPipeline::Translate(const PipelineDescriptor& pipelineDesc)
 	{
-		bsDesc.m_enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+		OpenGLPipelineState pipelineState;
+		pipelineState.m_blendState = TranslateBlendState(pipelineDesc.m_blendStateDesc);
+		pipelineState.m_depthStencilState = TranslateDepthStencilState(pipelineDesc.m_depthStencilStateDesc);
+		pipelineState.m_rasterizerState = TranslateRasterizerState(pipelineDesc.m_rasterizerStateDesc);
+		pipelineState.m_topology = GetOpenGLPrimitiveTopology(pipelineDesc.m_topology);
+		return pipelineState;
+	}
 
-		GLenum blendSrc = GetOpenGLBlendEnum(bsDesc.m_srcFactor);
-		GLenum blendDest = GetOpenGLBlendEnum(bsDesc.m_destFactor);
-		glBlendFunc(blendSrc, blendDest);
 
-		GLenum equationMode = GetOpenGLBlendEquation(bsDesc.m_equation);
-		glBlendEquation(equationMode);
+	OpenGLBlendState OpenGLPipeline::TranslateBlendState(const BlendStateDescriptor& bsDesc)
+	{
+		OpenGLBlendState blendState;
+		blendState.m_enabled = (bsDesc.m_enabled == BlendStateDescriptor::Enabled);
+		blendState.m_srcFactor = GetOpenGLBlendEnum(bsDesc.m_srcFactor);
+		blendState.m_destFactor = GetOpenGLBlendEnum(bsDesc.m_destFactor);
+		blendState.m_equation = GetOpenGLBlendEquation(bsDesc.m_equation);
+		return blendState;
 	}
 
 
@@ -64,56 +73,58 @@ namespace moe
 	}
 
 
-	void OpenGLPipeline::SetDepthStencilState(const DepthStencilStateDescriptor& dsDesc)
+	OpenGLDepthStencilState OpenGLPipeline::TranslateDepthStencilState(const DepthStencilStateDescriptor& dsDesc)
 	{
-		dsDesc.m_depthTest == DepthTest::Enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+		OpenGLDepthStencilState dsState;
+
+		dsState.m_depthTest = (dsDesc.m_depthTest == DepthTest::Enabled);
 
 		// OpenGL allows us to disable writing to the depth buffer by setting its depth mask to GL_FALSE:
 		// Basically, you're (temporarily) using a read-only depth buffer.
-		glDepthMask(dsDesc.m_depthWriting == DepthWriting::Enabled);
+		dsState.m_depthWrite = (dsDesc.m_depthWriting == DepthWriting::Enabled ? GL_TRUE : GL_FALSE);
 
-		GLenum depthFunc = GetOpenGLDSComparisonFunc(dsDesc.m_depthFunc);
-		glDepthFunc(depthFunc);
+		dsState.m_depthFunc = GetOpenGLDSComparisonFunc(dsDesc.m_depthFunc);
 
-		dsDesc.m_stencilTest == StencilTest::Enabled ? glEnable(GL_STENCIL_TEST) : glDisable(GL_STENCIL_TEST);
+		dsState.m_stencilTest = (dsDesc.m_stencilTest == StencilTest::Enabled);
 
 		// allows us to set a bitmask that is ANDed with the stencil value about to be written to the buffer.
 		// By default this is set to a bitmask of all 1s unaffecting the output, but if we were to set this to 0x00 all the stencil values written to the buffer end up as 0s.
-		glStencilMask(dsDesc.m_stencilWriteMask);
+		dsState.m_stencilWriteMask = dsDesc.m_stencilWriteMask;
 
 		auto [frontSfail, frontDpFail, frontBothPass] = GetOpenGLStencilOps(dsDesc.m_frontFaceOps);
-		glStencilOpSeparate(GL_FRONT, frontSfail, frontDpFail, frontBothPass);
+		dsState.m_front.m_stencilFail = frontSfail;
+		dsState.m_front.m_depthFail = frontDpFail;
+		dsState.m_front.m_allPass = frontBothPass;
+		dsState.m_front.m_func = GetOpenGLDSComparisonFunc(dsDesc.m_frontFaceOps.m_comparisonFunc);
+		dsState.m_front.m_ref = dsDesc.m_stencilRefVal;
+		dsState.m_front.m_readMask = dsDesc.m_stencilReadMask;
 
 		auto[backSfail, backDpFail, backBothPass] = GetOpenGLStencilOps(dsDesc.m_backFaceOps);
-		glStencilOpSeparate(GL_BACK, backSfail, backDpFail, backBothPass);
-
-		GLenum frontStencilFunc = GetOpenGLDSComparisonFunc(dsDesc.m_frontFaceOps.m_comparisonFunc);
-		glStencilFuncSeparate(GL_FRONT, frontStencilFunc, dsDesc.m_stencilRefVal, dsDesc.m_stencilReadMask);
-
-		GLenum backStencilFunc = GetOpenGLDSComparisonFunc(dsDesc.m_backFaceOps.m_comparisonFunc);
-		glStencilFuncSeparate(GL_BACK, backStencilFunc, dsDesc.m_stencilRefVal, dsDesc.m_stencilReadMask);
+		dsState.m_back.m_stencilFail = backSfail;
+		dsState.m_back.m_depthFail = backDpFail;
+		dsState.m_back.m_allPass = backBothPass;
+		dsState.m_back.m_func = GetOpenGLDSComparisonFunc(dsDesc.m_backFaceOps.m_comparisonFunc);
+		dsState.m_back.m_ref = dsDesc.m_stencilRefVal;
+		dsState.m_back.m_readMask = dsDesc.m_stencilReadMask;
+
+		return dsState;
 	}
 
 
-	void OpenGLPipeline::SetRasterizerState(const RasterizerStateDescriptor& rsDesc)
+	OpenGLRasterizerState OpenGLPipeline::TranslateRasterizerState(const RasterizerStateDescriptor& rsDesc)
 	{
-		if (rsDesc.m_cullMode == CullFace::None)
-		{
-			glDisable(GL_CULL_FACE);
-		}
-		else
-		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(rsDesc.m_cullMode == CullFace::Front ? GL_FRONT : GL_BACK);
-		}
+		OpenGLRasterizerState rsState;
 
-		glFrontFace(rsDesc.m_frontFace == FrontFace::Clockwise ? GL_CW : GL_CCW);
+		rsState.m_cullEnabled = (rsDesc.m_cullMode != CullFace::None);
+		rsState.m_cullFace = (rsDesc.m_cullMode == CullFace::Front ? GL_FRONT : GL_BACK);
+
+		rsState.m_frontFace = (rsDesc.m_frontFace == FrontFace::Clockwise ? GL_CW : GL_CCW);
 
 		switch (rsDesc.m_polyMode)
 		{
-			case PolygonMode::Points:		glPolygonMode(GL_FRONT_AND_BACK, GL_POINT); break;
-			case PolygonMode::Wireframe:	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); break;
-			case PolygonMode::Fill:			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL); break;
+			case PolygonMode::Points:		rsState.m_polygonMode = GL_POINT; break;
+			case PolygonMode::Wireframe:	rsState.m_polygonMode = GL_LINE; break;
+			case PolygonMode::Fill:			rsState.m_polygonMode = GL_FILL; break;
 			default:
 				MOE_ASSERT(false);
 				MOE_ERROR(ChanGraphics, "Unmanaged value for OpenGL PolygonMode: %i.", rsDesc.m_polyMode);
@@ -125,9 +136,11 @@ namespace moe
 		// This will cause the clip - space Z to remain unclipped by the front and rear viewing volume.
 		// The Z value computations will proceed as normal through the pipeline.
 		// After computing the window-space position, the resulting Z value will be clamped to the glDepthRange (provided by viewport).
-		rsDesc.m_depthClip == RasterizerStateDescriptor::Enabled ? glDisable(GL_DEPTH_CLAMP) : glEnable(GL_DEPTH_CLAMP);
+		rsState.m_depthClamp = (rsDesc.m_depthClip != RasterizerStateDescriptor::Enabled);
+
+		rsState.m_scissorTest = (rsDesc.m_scissorTest == RasterizerStateDescriptor::Enabled);
 
-		rsDesc.m_scissorTest == RasterizerStateDescriptor::Enabled ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
+		return rsState;
 	}
 
 
@@ -4,16 +4,81 @@
 
 #include "Graphics/Pipeline/PipelineDescriptor.h"
 
+#include <glad/glad.h>
+
 namespace moe
 {
+	/**
+	 * The OpenGL translation of the pipeline descriptors, made once at pipeline creation so SetPipeline only has GL enums to compare and apply.
+	 */
+	struct OpenGLBlendState
+	{
+		bool	m_enabled = false;
+		GLenum	m_srcFactor = GL_ONE;
+		GLenum	m_destFactor = GL_ZERO;
+		GLenum	m_equation = GL_FUNC_ADD;
+	};
+
+
+	struct OpenGLStencilFaceState
+	{
+		bool operator==(const OpenGLStencilFaceState& rhs) const
+		{
+			return m_stencilFail == rhs.m_stencilFail && m_depthFail == rhs.m_depthFail && m_allPass == rhs.m_allPass
+				&& m_func == rhs.m_func && m_ref == rhs.m_ref && m_readMask == rhs.m_readMask;
+		}
+
+		GLenum	m_stencilFail = GL_KEEP;
+		GLenum	m_depthFail = GL_KEEP;
+		GLenum	m_allPass = GL_KEEP;
+		GLenum	m_func = GL_ALWAYS;
+		GLint	m_ref = 0;
+		GLuint	m_readMask = 0xFF;
+	};
+
+
+	struct OpenGLDepthStencilState
+	{
+		bool		m_depthTest = true;
+		GLboolean	m_depthWrite = GL_TRUE;
+		GLenum		m_depthFunc = GL_LESS;
+		bool		m_stencilTest = false;
+		GLuint		m_stencilWriteMask = 0xFF;
+		OpenGLStencilFaceState	m_front;
+		OpenGLStencilFaceState	m_back;
+	};
+
+
+	struct OpenGLRasterizerState
+	{
+		bool	m_cullEnabled = true;
+		GLenum	m_cullFace = GL_BACK;
+		GLenum	m_frontFace = GL_CCW;
+		GLenum	m_polygonMode = GL_FILL;
+		bool	m_depthClamp = false;
+		bool	m_scissorTest = false;
+	};
+
+
+	struct OpenGLPipelineState
+	{
+		OpenGLBlendState		m_blendState;
+		OpenGLDepthStencilState	m_depthStencilState;
+		OpenGLRasterizerState	m_rasterizerState;
+		GLenum					m_topology = GL_TRIANGLES;
+	};
+
+
 	class OpenGLPipeline
 	{
 	public:
-		static void	SetBlendState(const BlendStateDescriptor& bsDesc);
+		static OpenGLPipelineState		Translate(const PipelineDescriptor& pipelineDesc);
+
+		static OpenGLBlendState			TranslateBlendState(const BlendStateDescriptor& bsDesc);
 
-		static void	SetDepthStencilState(const DepthStencilStateDescriptor& dsDesc);
+		static OpenGLDepthStencilState	TranslateDepthStencilState(const DepthStencilStateDescriptor& dsDesc);
 
-		static void	SetRasterizerState(const RasterizerStateDescriptor& rsDesc);
+		static OpenGLRasterizerState	TranslateRasterizerState(const RasterizerStateDescriptor& rsDesc);
 
 		static int	GetOpenGLPrimitiveTopology(PrimitiveTopology topo);
 
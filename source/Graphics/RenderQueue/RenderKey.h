@@ -0,0 +1,86 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Misc/Types.h"
+
+namespace moe
+{
+	/**
+	 * \brief Builds the 64-bit keys used to sort the draws of a RenderQueue.
+	 * The most significant bits are sorted first. For opaque draws, the layout is :
+	 * | pass (6) | pipeline (10) | material (14) | mesh (14) | depth (20) |
+	 * so that draws get grouped by state, and drawn front to back inside a group (helps early-z).
+	 * Translucent draws have to be drawn back to front above all, so the depth comes right after the pass :
+	 * | pass (6) | inverted depth (20) | pipeline (10) | material (14) | mesh (14) |
+	 * Values too big for their field are wrapped : it only degrades the batching, never the correctness,
+	 * as the render queue compares the actual states before changing them.
+	 */
+	struct RenderKey
+	{
+		static constexpr uint32_t	ms_PASS_BITS = 6;
+		static constexpr uint32_t	ms_PIPELINE_BITS = 10;
+		static constexpr uint32_t	ms_MATERIAL_BITS = 14;
+		static constexpr uint32_t	ms_MESH_BITS = 14;
+		static constexpr uint32_t	ms_DEPTH_BITS = 20;
+
+		static_assert(ms_PASS_BITS + ms_PIPELINE_BITS + ms_MATERIAL_BITS + ms_MESH_BITS + ms_DEPTH_BITS == 64, "Render keys must use exactly 64 bits");
+
+		static constexpr uint32_t	ms_MAX_DEPTH = (1u << ms_DEPTH_BITS) - 1;
+
+
+		/**
+		 * \brief Converts a depth in [0, 1] (e.g. view depth divided by the far plane distance) to a key depth. Values out of range are clamped.
+		 */
+		static uint32_t	QuantizeDepth(float normalizedDepth)
+		{
+			if (!(normalizedDepth > 0.f)) // also catches NaN
+			{
+				return 0;
+			}
+
+			if (normalizedDepth >= 1.f)
+			{
+				return ms_MAX_DEPTH;
+			}
+
+			return (uint32_t)(normalizedDepth * (float)ms_MAX_DEPTH);
+		}
+
+
+		static uint64_t	Opaque(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth)
+		{
+			uint64_t key = Field(pass, ms_PASS_BITS);
+			key = (key << ms_PIPELINE_BITS) | Field(pipeline, ms_PIPELINE_BITS);
+			key = (key << ms_MATERIAL_BITS) | Field(material, ms_MATERIAL_BITS);
+			key = (key << ms_MESH_BITS) | Field(mesh, ms_MESH_BITS);
+			key = (key << ms_DEPTH_BITS) | Field(depth, ms_DEPTH_BITS);
+			return key;
+		}
+
+
+		static uint64_t	Translucent(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth)
+		{
+			uint64_t key = Field(pass, ms_PASS_BITS);
+			key = (key << ms_DEPTH_BITS) | (ms_MAX_DEPTH - Field(depth, ms_DEPTH_BITS));
+			key = (key << ms_PIPELINE_BITS) | Field(pipeline, ms_PIPELINE_BITS);
+			key = (key << ms_MATERIAL_BITS) | Field(material, ms_MATERIAL_BITS);
+			key = (key << ms_MESH_BITS) | Field(mesh, ms_MESH_BITS);
+			return key;
+		}
+
+
+		static uint32_t	GetPass(uint64_t key)
+		{
+			return (uint32_t)(key >> (64 - ms_PASS_BITS));
+		}
+
+
+	private:
+
+		static uint64_t	Field(uint32_t value, uint32_t numBits)
+		{
+			return (uint64_t)(value & ((1u << numBits) - 1));
+		}
+	};
+}
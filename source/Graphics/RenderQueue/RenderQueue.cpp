@@ -0,0 +1,125 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "RenderQueue.h"
+
+#include "Core/Misc/moeRadixSort.h"
+
+#include "Graphics/Device/GraphicsDevice.h"
+#include "Graphics/Material/Material.h"
+#include "Graphics/Mesh/InstancedMesh.h"
+#include "Graphics/Renderer/Renderer.h"
+
+namespace moe
+{
+	RenderQueue::RenderQueue(uint32_t numBuckets)
+	{
+		SetBucketCount(numBuckets);
+	}
+
+
+	void RenderQueue::SetBucketCount(uint32_t numBuckets)
+	{
+		MOE_ASSERT(numBuckets != 0);
+
+		m_buckets.Clear();
+		m_buckets.Resize(numBuckets != 0 ? numBuckets : 1);
+		m_sortedEntries.Clear();
+	}
+
+
+	void RenderQueue::Sort()
+	{
+		m_sortedEntries.Clear();
+
+		size_t totalCount = 0;
+		for (const Bucket& bucket : m_buckets)
+		{
+			totalCount += bucket.m_keys.Size();
+		}
+
+		m_sortedEntries.Reserve(totalCount);
+
+		for (uint32_t iBucket = 0; iBucket < m_buckets.Size(); ++iBucket)
+		{
+			const Vector<uint64_t>& bucketKeys = m_buckets[iBucket].m_keys;
+			for (uint32_t iCmd = 0; iCmd < bucketKeys.Size(); ++iCmd)
+			{
+				m_sortedEntries.PushBack({ bucketKeys[iCmd], iBucket, iCmd });
+			}
+		}
+
+		m_sortScratch.Resize(totalCount);
+
+		RadixSort64(m_sortedEntries.Data(), m_sortScratch.Data(), totalCount, [](const SortEntry& entry) { return entry.m_key; });
+	}
+
+
+	void RenderQueue::Execute(IGraphicsRenderer& renderer)
+	{
+		Sort();
+
+		IGraphicsDevice& device = renderer.MutGraphicsDevice();
+
+		RenderQueueStats stats;
+		PipelineHandle currentPipeline{ 0 };
+		Material* currentMaterial = nullptr;
+
+		for (uint32_t iSorted = 0; iSorted < m_sortedEntries.Size(); ++iSorted)
+		{
+			const DrawCommand& command = GetSortedCommand(iSorted);
+
+			if (command.m_pipeline.IsNotNull() && command.m_pipeline != currentPipeline)
+			{
+				device.SetPipeline(command.m_pipeline);
+				currentPipeline = command.m_pipeline;
+				stats.m_numPipelineChanges++;
+			}
+
+			if (command.m_material != nullptr)
+			{
+				if (command.m_material != currentMaterial)
+				{
+					renderer.UseMaterial(command.m_material);
+					currentMaterial = command.m_material;
+					stats.m_numMaterialChanges++;
+				}
+
+				renderer.UseMaterialPerObject(command.m_material, *command.m_mesh);
+			}
+
+			renderer.UseResourceSet(command.m_mesh->GetPerObjectResourceSet());
+
+			const Mesh& mesh = *command.m_mesh;
+
+			if (command.m_instanced)
+			{
+				const InstancedMesh& instancedMesh = static_cast<const InstancedMesh&>(mesh);
+
+				device.DrawInstancedMesh(command.m_layout, mesh.GetVertexBufferHandle(), mesh.NumVertices(), mesh.GetIndexBufferHandle(), mesh.NumIndices(),
+					instancedMesh.GetInstancingBuffer(), instancedMesh.GetInstancesAmount());
+			}
+			else
+			{
+				device.DrawVertexBuffer(command.m_layout, mesh.GetVertexBufferHandle(), mesh.NumVertices(), mesh.GetIndexBufferHandle(), mesh.NumIndices());
+			}
+
+			stats.m_numDraws++;
+		}
+
+		m_lastStats = stats;
+
+		Clear();
+	}
+
+
+	void RenderQueue::Clear()
+	{
+		for (Bucket& bucket : m_buckets)
+		{
+			bucket.m_keys.Clear();
+			bucket.m_commands.Clear();
+		}
+
+		m_sortedEntries.Clear();
+	}
+}
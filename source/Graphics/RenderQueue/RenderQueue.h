@@ -0,0 +1,140 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Graphics/RenderQueue/RenderKey.h"
+
+#include "Graphics/Pipeline/PipelineHandle.h"
+#include "Graphics/VertexLayout/VertexLayoutHandle.h"
+
+#include "Monocle_Graphics_Export.h"
+
+namespace moe
+{
+	class IGraphicsRenderer;
+	class Material;
+	class Mesh;
+
+
+	/**
+	 * \brief The payload of a recorded draw : everything needed to issue it once the queue is sorted.
+	 */
+	struct DrawCommand
+	{
+		Mesh*				m_mesh = nullptr;		// An InstancedMesh if m_instanced is true
+		Material*			m_material = nullptr;	// Optional
+		VertexLayoutHandle	m_layout{ 0 };
+		PipelineHandle		m_pipeline{ 0 };		// Optional : a null pipeline keeps the current one
+		bool				m_instanced = false;
+	};
+
+
+	struct RenderQueueStats
+	{
+		uint32_t	m_numDraws = 0;
+		uint32_t	m_numPipelineChanges = 0;
+		uint32_t	m_numMaterialChanges = 0;
+	};
+
+
+	/**
+	 * \brief A deferred command buffer of draws.
+	 * Draws are recorded with a RenderKey, sorted by key (radix sort), then executed in one go,
+	 * only changing pipelines and materials when they differ from the previous draw.
+	 * Recording can happen from several threads at once, as long as each thread records in its own bucket
+	 * (e.g. the JobSystem thread index). Sorting and executing must be done from a single thread once recording is over.
+	 * Draws with equal keys are executed in the order they were recorded in, bucket by bucket.
+	 */
+	class RenderQueue
+	{
+	public:
+
+		Monocle_Graphics_API RenderQueue(uint32_t numBuckets = 1);
+
+
+		/**
+		 * \brief Changes the number of recording buckets. Drops all the recorded draws.
+		 */
+		Monocle_Graphics_API void	SetBucketCount(uint32_t numBuckets);
+
+		[[nodiscard]] uint32_t	GetBucketCount() const { return (uint32_t)m_buckets.Size(); }
+
+
+		/**
+		 * \brief Records a draw. Only the thread owning the bucket may record in it.
+		 */
+		void	Submit(uint64_t sortKey, const DrawCommand& command, uint32_t bucketIdx = 0)
+		{
+			MOE_DEBUG_ASSERT(bucketIdx < m_buckets.Size());
+			Bucket& bucket = m_buckets[bucketIdx];
+			bucket.m_keys.PushBack(sortKey);
+			bucket.m_commands.PushBack(command);
+		}
+
+
+		/**
+		 * \brief Gathers the draws of all the buckets, and sorts them by key.
+		 */
+		Monocle_Graphics_API void	Sort();
+
+
+		/**
+		 * \brief Sorts the draws, issues them to the renderer and clears the queue.
+		 */
+		Monocle_Graphics_API void	Execute(IGraphicsRenderer& renderer);
+
+
+		/**
+		 * \brief Drops all the recorded draws, but keeps the memory for the next frame.
+		 */
+		Monocle_Graphics_API void	Clear();
+
+
+		/**
+		 * \brief Number of draws in the sorted order (only valid after Sort).
+		 */
+		[[nodiscard]] uint32_t	GetSortedCount() const { return (uint32_t)m_sortedEntries.Size(); }
+
+		[[nodiscard]] uint64_t	GetSortedKey(uint32_t sortedIdx) const { return m_sortedEntries[sortedIdx].m_key; }
+
+		[[nodiscard]] const DrawCommand&	GetSortedCommand(uint32_t sortedIdx) const
+		{
+			const SortEntry& entry = m_sortedEntries[sortedIdx];
+			return m_buckets[entry.m_bucket].m_commands[entry.m_index];
+		}
+
+
+		/**
+		 * \brief What the last Execute did.
+		 */
+		[[nodiscard]] const RenderQueueStats&	GetLastStats() const { return m_lastStats; }
+
+
+	private:
+
+		// Keep buckets on separate cache lines, since they are written by different threads.
+		struct alignas(64) Bucket
+		{
+			Vector<uint64_t>	m_keys;
+			Vector<DrawCommand>	m_commands;
+		};
+
+		// We sort these small entries rather than moving whole commands around.
+		struct SortEntry
+		{
+			uint64_t	m_key;
+			uint32_t	m_bucket;
+			uint32_t	m_index;
+		};
+
+		Vector<Bucket>		m_buckets;
+
+		Vector<SortEntry>	m_sortedEntries;
+		Vector<SortEntry>	m_sortScratch;
+
+		RenderQueueStats	m_lastStats;
+	};
+}
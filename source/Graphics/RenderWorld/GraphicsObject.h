@@ -13,6 +13,8 @@
 
 #include "Graphics/Transform/Transform.h"
 
+#include "Math/Bounds/Bounds.h"
+
 #include "Graphics/DeviceBuffer/VertexBufferHandle.h"
 #include "Graphics/DeviceBuffer/IndexBufferHandle.h"
 
@@ -55,6 +57,25 @@ namespace moe
 		}
 
 
+		/**
+		 * \brief Sets the bounds of the object in its own space, used for visibility culling.
+		 * Objects with invalid (e.g. default) bounds are considered always visible.
+		 */
+		void	SetLocalBounds(const AABB& bounds)
+		{
+			m_localBounds = bounds;
+		}
+
+		[[nodiscard]] const AABB&	GetLocalBounds() const { return m_localBounds; }
+
+		[[nodiscard]] bool	HasBounds() const { return m_localBounds.IsValid(); }
+
+		[[nodiscard]] AABB	GetWorldBounds() const
+		{
+			return m_localBounds.Transformed(m_transform.Matrix());
+		}
+
+
 		bool	IsTransformUpToDate() const { return m_transformIsUpToDate; }
 		void	SetTransformUpToDate() { m_transformIsUpToDate = true; }
 
@@ -97,6 +118,8 @@ namespace moe
 		Transform		m_transform;
 		bool			m_transformIsUpToDate{true};
 
+		AABB			m_localBounds;
+
 		HashMap<std::string, uint32_t>	m_uniformBlockDataIndex;
 
 		GraphicObjectData	m_graphicData;
@@ -3,6 +3,7 @@
 #include "RenderWorld.h"
 
 #include "Graphics/Device/GraphicsDevice.h"
+#include "Graphics/Material/Material.h"
 
 namespace moe
 {
@@ -41,9 +42,10 @@ namespace moe
 
 		Mesh* newMesh = &m_meshFreelist.Lookup(newMeshID);
 
+		newMesh->SetID(newMeshID);
 		newMesh->SetObjectID(newMeshID);
 
-		m_activeObjects.PushBack(newMeshID);
+		m_activeObjects.PushBack(newMesh);
 
 		return newMesh;
 	}
@@ -82,9 +84,10 @@ namespace moe
 
 		InstancedMesh* newMesh = &m_instancedMeshFreelist.Lookup(newMeshID);
 
+		newMesh->SetID(newMeshID);
 		newMesh->SetObjectID(newMeshID);
 
-		m_activeObjects.PushBack(newMeshID);
+		m_activeObjects.PushBack(newMesh);
 
 		return newMesh;
 	}
@@ -96,6 +99,12 @@ namespace moe
 		if (mesh == nullptr)
 			return;
 
+		// A stale mesh (already deleted, or not created by this world) must not free buffers a new mesh may be using now
+		const bool isLiveMesh = m_meshFreelist.IsValid(mesh->GetID());
+		MOE_ASSERT(isLiveMesh);
+		if (false == isLiveMesh)
+			return;
+
 		m_renderer.MutGraphicsDevice().DeleteStaticVertexBuffer(mesh->GetVertexBufferHandle());
 
 		if (mesh->GetIndexBufferHandle().IsNotNull())
@@ -103,6 +112,16 @@ namespace moe
 			m_renderer.MutGraphicsDevice().DeleteIndexBuffer(mesh->GetIndexBufferHandle());
 		}
 
+		for (uint32_t iObj = 0; iObj < m_activeObjects.Size(); ++iObj)
+		{
+			if (m_activeObjects[iObj] == mesh)
+			{
+				// Keep the creation order : visible lists come out in that order
+				m_activeObjects.Erase(m_activeObjects.Begin() + iObj);
+				break;
+			}
+		}
+
 		m_meshFreelist.Remove(mesh->GetID());
 	}
 
@@ -223,22 +242,111 @@ namespace moe
 	}
 
 
-	void RenderWorld::BeginDraw()
+	void RenderWorld::SubmitMesh(Mesh* drawnMesh, VertexLayoutHandle layoutHandle, Material* material, PipelineHandle pipeline,
+		uint32_t pass, float normalizedDepth, bool translucent, uint32_t bucketIdx)
+	{
+		if (drawnMesh == nullptr)
+			return;
+
+		const uint64_t sortKey = ComputeSortKey(*drawnMesh, material, pipeline, pass, normalizedDepth, translucent);
+
+		m_renderQueue.Submit(sortKey, DrawCommand{ drawnMesh, material, layoutHandle, pipeline, false }, bucketIdx);
+	}
+
+
+	void RenderWorld::SubmitInstancedMesh(InstancedMesh* drawnInstancedMesh, VertexLayoutHandle layoutHandle, Material* material,
+		PipelineHandle pipeline, uint32_t pass, float normalizedDepth, bool translucent, uint32_t bucketIdx)
+	{
+		if (drawnInstancedMesh == nullptr)
+			return;
+
+		const uint64_t sortKey = ComputeSortKey(*drawnInstancedMesh, material, pipeline, pass, normalizedDepth, translucent);
+
+		m_renderQueue.Submit(sortKey, DrawCommand{ drawnInstancedMesh, material, layoutHandle, pipeline, true }, bucketIdx);
+	}
+
+
+	void RenderWorld::FlushRenderQueue()
+	{
+		m_renderQueue.Execute(m_renderer);
+	}
+
+
+	uint64_t RenderWorld::ComputeSortKey(const Mesh& mesh, const Material* material, PipelineHandle pipeline, uint32_t pass, float normalizedDepth, bool translucent)
 	{
-		for (CameraManager::CameraID camID : m_activeCameras)
+		const uint32_t materialID = (material != nullptr ? material->GetSortID() : 0);
+
+		// Draws sharing a vertex buffer handle draw the same geometry : fold the handle so they end up next to each other.
+		const uint64_t vtxBufferHandle = mesh.GetVertexBufferHandle().Get();
+		const uint32_t meshID = (uint32_t)(vtxBufferHandle ^ (vtxBufferHandle >> 32));
+
+		const uint32_t depth = RenderKey::QuantizeDepth(normalizedDepth);
+
+		if (translucent)
 		{
-			Camera* camera = &m_cameraManager.MutCamera(camID);
+			return RenderKey::Translucent(pass, pipeline.Get(), materialID, meshID, depth);
+		}
+
+		return RenderKey::Opaque(pass, pipeline.Get(), materialID, meshID, depth);
+	}
+
+
+	void RenderWorld::BeginDraw()
+	{
+		UpdateCullingBounds();
+
+		m_visibleObjects.Resize(m_activeCameras.Size());
 
+		for (uint32_t iCam = 0; iCam < m_activeCameras.Size(); ++iCam)
+		{
+			Camera* camera = &m_cameraManager.MutCamera(m_activeCameras[iCam]);
 
 			// Activate the camera viewport
 			UseCamera(camera);
 
-			// Draw all objects
-			for (FreelistID objID : m_activeObjects)
+			const Frustum cameraFrustum(camera->GetViewProjectionMatrix());
+
+			m_visibleBoundsIdx.Clear();
+			cameraFrustum.Cull(m_cullingBounds, m_visibleBoundsIdx);
+
+			// Merge the culled objects with the ones without bounds, that are always visible.
+			// Both lists are sorted by object index, so this keeps the creation order.
+			Vector<Mesh*>& visibleObjects = m_visibleObjects[iCam];
+			visibleObjects.Clear();
+
+			uint32_t iVisible = 0;
+			for (uint32_t iObj = 0; iObj < m_activeObjects.Size(); ++iObj)
 			{
-				//Mesh& drawnMesh = m_meshFreelist.Lookup(objID);
+				Mesh* object = m_activeObjects[iObj];
+				if (false == object->HasBounds())
+				{
+					visibleObjects.PushBack(object);
+				}
+				else if (iVisible < m_visibleBoundsIdx.Size() && m_cullingBoundsObjectIdx[m_visibleBoundsIdx[iVisible]] == iObj)
+				{
+					visibleObjects.PushBack(object);
+					iVisible++;
+				}
+			}
+		}
+	}
 
-				//drawnMesh.SetMaterial()
+
+	void RenderWorld::UpdateCullingBounds()
+	{
+		m_cullingBounds.Clear();
+		m_cullingBoundsObjectIdx.Clear();
+
+		m_cullingBounds.Reserve(m_activeObjects.Size());
+		m_cullingBoundsObjectIdx.Reserve(m_activeObjects.Size());
+
+		for (uint32_t iObj = 0; iObj < m_activeObjects.Size(); ++iObj)
+		{
+			const Mesh* object = m_activeObjects[iObj];
+			if (object->HasBounds())
+			{
+				m_cullingBounds.PushBack(object->GetWorldBounds());
+				m_cullingBoundsObjectIdx.PushBack(iObj);
 			}
 		}
 	}
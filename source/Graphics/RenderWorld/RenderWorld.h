@@ -16,12 +16,16 @@
 #include "Graphics/Camera/ViewportDescriptor.h"
 #include "Graphics/Camera/CameraManager.h"
 
-#include "Core/Containers/FreeList/Freelist.h"
+#include "Core/Containers/FreeList/PagedFreelist.h"
 
 #include "Core/Containers/FreeList/PolymorphicFreelist.h"
 
+#include "Math/Bounds/Frustum.h"
+
 #include "Graphics/Renderer/Renderer.h"
 
+#include "Graphics/RenderQueue/RenderQueue.h"
+
 
 namespace moe
 {
@@ -30,9 +34,7 @@ namespace moe
 	public:
 		RenderWorld(class IGraphicsRenderer& renderer) :
 			m_renderer(renderer)
-		{
-			m_meshFreelist.Reserve(1024); // TODO: temporary solution to avoid invalidating pointers
-		}
+		{}
 
 		~RenderWorld() = default;
 
@@ -125,20 +127,69 @@ namespace moe
 		Monocle_Graphics_API void	DrawInstancedMesh(InstancedMesh* drawnInstancedMesh, VertexLayoutHandle layoutHandle, Material* material = nullptr);
 
 
+		/**
+		 * \brief Records a mesh draw in the render queue instead of drawing it right away.
+		 * The recorded draws are sorted by pass, state and depth, and issued by FlushRenderQueue.
+		 * The mesh is recorded by pointer : its per-object data is only read at flush time, so a mesh drawn several times
+		 * with different object matrices in the same frame still has to go through DrawMesh.
+		 * \param pass Passes are drawn in increasing order.
+		 * \param normalizedDepth The distance to the camera, in [0, 1]. Used to sort draws front to back (or back to front if translucent).
+		 * \param bucketIdx The bucket of the render queue to record in : threads recording at the same time must use different buckets.
+		 */
+		Monocle_Graphics_API void	SubmitMesh(Mesh* drawnMesh, VertexLayoutHandle layoutHandle, Material* material, PipelineHandle pipeline,
+			uint32_t pass = 0, float normalizedDepth = 0.f, bool translucent = false, uint32_t bucketIdx = 0);
+
+		Monocle_Graphics_API void	SubmitInstancedMesh(InstancedMesh* drawnInstancedMesh, VertexLayoutHandle layoutHandle, Material* material, PipelineHandle pipeline,
+			uint32_t pass = 0, float normalizedDepth = 0.f, bool translucent = false, uint32_t bucketIdx = 0);
+
+		/**
+		 * \brief Sorts and issues all the draws recorded since the last flush.
+		 */
+		Monocle_Graphics_API void	FlushRenderQueue();
+
+		[[nodiscard]] RenderQueue&	MutRenderQueue() { return m_renderQueue; }
+
+
+		/**
+		 * \brief Culls the objects of the world against the frustum of every active camera.
+		 * The objects found visible by each camera are then available through GetVisibleObjects.
+		 */
 		Monocle_Graphics_API void	BeginDraw();
 
 
+		/**
+		 * \brief The objects intersecting the frustum of an active camera during the last BeginDraw, in creation order.
+		 * \param activeCameraIdx Index of the camera, in creation order.
+		 */
+		[[nodiscard]] const Vector<Mesh*>&	GetVisibleObjects(uint32_t activeCameraIdx) const
+		{
+			MOE_ASSERT(activeCameraIdx < m_visibleObjects.Size());
+			return m_visibleObjects[activeCameraIdx];
+		}
+
+
 		[[nodiscard]] GraphicObjectData	ReallocObjectUniformGraphicData(const GraphicObjectData& oldData, uint32_t newNeededSize);
 
 	protected:
 
+		/**
+		 * \brief Computes the bounds of the vertices if they have a Vec3 m_position, otherwise returns invalid bounds.
+		 */
+		template <typename VertexType>
+		static AABB	ComputeVertexBounds(const VertexType* vertices, size_t numVertices);
+
+		void	UpdateCullingBounds();
+
+		static uint64_t	ComputeSortKey(const Mesh& mesh, const Material* material, PipelineHandle pipeline, uint32_t pass, float normalizedDepth, bool translucent);
+
+
 		IGraphicsRenderer&	m_renderer;
 
 		CameraManager		m_cameraManager;
 
-		Freelist<Mesh>		m_meshFreelist;
+		PagedFreelist<Mesh>		m_meshFreelist;
 
-		Freelist<InstancedMesh>		m_instancedMeshFreelist; // TODO: rework that (merge the two mesh freelist together ?)
+		PagedFreelist<InstancedMesh>		m_instancedMeshFreelist; // TODO: rework that (merge the two mesh freelist together ?)
 
 		PolymorphicFreelist<AGraphicObject*>	m_objects;
 
@@ -146,54 +197,127 @@ namespace moe
 
 		Vector<char>		m_objectsDataBuffer;
 
-		Vector<FreelistID>	m_activeObjects;
+		Vector<Mesh*>		m_activeObjects;
+
+		// World bounds of the active objects that have some, and the index of their object.
+		AABBSoA				m_cullingBounds;
+		Vector<uint32_t>	m_cullingBoundsObjectIdx;
+		Vector<uint32_t>	m_visibleBoundsIdx;
+
+		Vector<Vector<Mesh*>>	m_visibleObjects;
 
 		Vector<CameraManager::CameraID>	m_activeCameras;
 
+		RenderQueue			m_renderQueue;
+
 	};
 
+	namespace detail
+	{
+		template <typename VertexType, typename = void>
+		struct HasVec3Position : std::false_type {};
+
+		template <typename VertexType>
+		struct HasVec3Position<VertexType, std::void_t<decltype(std::declval<VertexType>().m_position)>> :
+			std::is_same<std::decay_t<decltype(std::declval<VertexType>().m_position)>, Vec3>
+		{};
+	}
+
+
+	template <typename VertexType>
+	AABB RenderWorld::ComputeVertexBounds(const VertexType* vertices, size_t numVertices)
+	{
+		if constexpr (detail::HasVec3Position<VertexType>::value)
+		{
+			if (numVertices != 0)
+			{
+				return AABB::FromPoints(vertices[0].m_position.Ptr(), numVertices, sizeof(VertexType));
+			}
+		}
+
+		return AABB();
+	}
+
+
 	template <typename VertexType, typename IndexType>
 	Mesh* RenderWorld::CreateStaticMesh(const Vector<VertexType>& vertexData, const Vector<IndexType> & indexData)
 	{
-		return CreateStaticMeshFromBuffer(
+		Mesh* newMesh = CreateStaticMeshFromBuffer(
 			MeshDataDescriptor{ vertexData.Data(), vertexData.Size() * sizeof(VertexType), vertexData.Size() },
 			MeshDataDescriptor{ indexData.Data(), indexData.Size() * sizeof(IndexType), indexData.Size() }
 		);
+
+		if (newMesh != nullptr)
+		{
+			newMesh->SetLocalBounds(ComputeVertexBounds(vertexData.Data(), vertexData.Size()));
+		}
+
+		return newMesh;
 	}
 
 	template <typename VertexType, size_t N, size_t IndN>
 	Mesh* RenderWorld::CreateStaticMesh(const Array<VertexType, N>& vertexData, const Array<uint32_t, IndN>& indexData)
 	{
-		return CreateStaticMeshFromBuffer(
+		Mesh* newMesh = CreateStaticMeshFromBuffer(
 			MeshDataDescriptor{ vertexData.Data(), vertexData.Size() * sizeof(VertexType), N },
 			MeshDataDescriptor{ indexData.Data(), indexData.Size() * sizeof(uint32_t), IndN }
 		);
+
+		if (newMesh != nullptr)
+		{
+			newMesh->SetLocalBounds(ComputeVertexBounds(vertexData.Data(), N));
+		}
+
+		return newMesh;
 	}
 
 	template <typename VertexType, size_t N>
 	Mesh* RenderWorld::CreateStaticMesh(VertexType(& vertexData)[N])
 	{
-		return CreateStaticMeshFromBuffer(
+		Mesh* newMesh = CreateStaticMeshFromBuffer(
 			MeshDataDescriptor{ vertexData, sizeof(vertexData), N },
 			MeshDataDescriptor {}
 		);
+
+		if (newMesh != nullptr)
+		{
+			newMesh->SetLocalBounds(ComputeVertexBounds(vertexData, N));
+		}
+
+		return newMesh;
 	}
 
+	// The bounds of an instanced mesh are the bounds of one instance : the user has to grow them to cover all the instances
+	// (or reset them to make the instanced mesh always visible).
 	template <typename VertexType, size_t N, size_t IndN>
 	InstancedMesh* RenderWorld::CreateInstancedMesh(const Array<VertexType, N>& vertexData, const Array<uint32_t, IndN>& indexData)
 	{
-		return CreateInstancedMeshFromBuffer(
+		InstancedMesh* newMesh = CreateInstancedMeshFromBuffer(
 			MeshDataDescriptor{ vertexData.Data(), vertexData.Size() * sizeof(VertexType), N },
 			MeshDataDescriptor{ indexData.Data(), indexData.Size() * sizeof(uint32_t), IndN }
 		);
+
+		if (newMesh != nullptr)
+		{
+			newMesh->SetLocalBounds(ComputeVertexBounds(vertexData.Data(), N));
+		}
+
+		return newMesh;
 	}
 
 	template <typename VertexType, size_t N>
 	InstancedMesh* RenderWorld::CreateInstancedMesh(VertexType(& vertexData)[N])
 	{
-		return CreateInstancedMeshFromBuffer(
+		InstancedMesh* newMesh = CreateInstancedMeshFromBuffer(
 			MeshDataDescriptor{ vertexData, sizeof(vertexData), N },
 			MeshDataDescriptor{}
 		);
+
+		if (newMesh != nullptr)
+		{
+			newMesh->SetLocalBounds(ComputeVertexBounds(vertexData, N));
+		}
+
+		return newMesh;
 	}
 }
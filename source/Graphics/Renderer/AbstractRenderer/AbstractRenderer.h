@@ -56,7 +56,7 @@ namespace moe
 
 	private:
 
-		Freelist<RenderWorld>	m_renderWorlds;
+		PagedFreelist<RenderWorld>	m_renderWorlds;
 
 		static std::optional<ShaderProgramDescriptor>	BuildProgramDescriptorFromFileList(const ShaderFileList& fileList);
 
@@ -0,0 +1,195 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "NullRenderer.h"
+
+#include "Graphics/Material/MaterialInstance.h"
+
+namespace moe
+{
+	bool NullRenderer::Initialize(IGraphicsRenderer::GraphicsContextSetup /*setupFunction*/)
+	{
+		m_device.Initialize();
+		return true;
+	}
+
+
+	void NullRenderer::Shutdown()
+	{
+		m_device.Destroy();
+	}
+
+
+	void NullRenderer::Clear(const ColorRGBAf& /*clearColor*/)
+	{
+	}
+
+
+	void NullRenderer::ClearDepth()
+	{
+	}
+
+
+	void NullRenderer::UseMaterial(ShaderProgramHandle progHandle, ResourceSetHandle rscSetHandle)
+	{
+		m_device.UseShaderProgram(progHandle);
+
+		UseResourceSet(rscSetHandle);
+	}
+
+
+	void NullRenderer::UseMaterial(Material* material)
+	{
+		if (material == nullptr)
+			return;
+
+		m_device.UseShaderProgram(material->GetShaderProgramHandle());
+
+		for (ResourceSetHandle rscSetHandle : material->GetPerMaterialResourceSets())
+		{
+			UseResourceSet(rscSetHandle);
+		}
+	}
+
+
+	void NullRenderer::UseMaterialPerObject(Material* material, AGraphicObject& object)
+	{
+		if (material == nullptr)
+			return;
+
+		for (ResourceSetHandle rscSetHandle : material->GetPerObjectResourceSets())
+		{
+			if (rscSetHandle.IsNull())
+				return;
+
+			const auto& rscSetDesc = m_device.GetResourceSetDescriptor(rscSetHandle);
+
+			const auto& rscLayoutDesc = m_device.GetResourceLayoutDescriptor(rscSetDesc.GetResourceLayoutHandle());
+
+			int iBinding = 0;
+
+			for (const ResourceLayoutBindingDescriptor& rscBindingDesc : rscLayoutDesc)
+			{
+				switch (rscBindingDesc.m_kind)
+				{
+				case ResourceKind::UniformBuffer:
+				{
+					DeviceBufferHandle ubHandle = rscSetDesc.Get<DeviceBufferHandle>(iBinding);
+					uint32_t ubSize = 0;
+
+					// Same as the OpenGL renderer : object matrices are streamed.
+					if (rscBindingDesc.m_name == "ObjectMatrices")
+					{
+						ubHandle = Material::UpdateObjectMatrices(object, ubHandle);
+						ubSize = sizeof(ObjectMatrices);
+					}
+
+					m_device.BindUniformBlock(rscBindingDesc.m_bindingPoint, ubHandle, ubSize);
+				}
+				break;
+				case ResourceKind::TextureReadOnly:
+				{
+					TextureHandle texHandle = rscSetDesc.Get<TextureHandle>(iBinding);
+					m_device.BindTextureUnit(rscBindingDesc.m_bindingPoint, texHandle);
+				}
+				break;
+				case ResourceKind::Sampler:
+
+					break;
+				default:
+					MOE_ASSERT(false);
+					MOE_ERROR(ChanGraphics, "Unmanaged ResourceKind value.");
+				}
+
+				iBinding++;
+			}
+		}
+	}
+
+
+	void NullRenderer::UseMaterialInstance(const MaterialInstance* material)
+	{
+		if (material == nullptr)
+			return;
+
+		m_device.UseShaderProgram(material->GetShaderHandle());
+
+		UseResourceSet(material->GetResourceSetHandle());
+	}
+
+
+	DeviceBufferHandle NullRenderer::AllocateObjectMemory(const uint32_t size)
+	{
+		// There is no need to sub-allocate a big buffer here : each object gets a buffer of its own.
+		return m_device.CreateMultiUsageBuffer(size);
+	}
+
+
+	void NullRenderer::CopyObjectMemory(DeviceBufferHandle from, uint32_t fromSizeBytes, DeviceBufferHandle to)
+	{
+		m_device.CopyBuffer(from, fromSizeBytes, to);
+	}
+
+
+	void NullRenderer::ReleaseObjectMemory(DeviceBufferHandle freedHandle)
+	{
+		m_device.DeleteBuffer(freedHandle);
+	}
+
+
+	GraphicObjectData NullRenderer::ReallocObjectUniformGraphicData(const GraphicObjectData& oldData, uint32_t newNeededSize)
+	{
+		DeviceBufferHandle newMemHandle = AllocateObjectMemory(newNeededSize);
+
+		CopyObjectMemory(oldData.m_objectDataHandle, oldData.TotalGraphicSize(), newMemHandle);
+
+		ReleaseObjectMemory(oldData.m_objectDataHandle);
+
+		// Like with OpenGL, null device handles are a buffer index and an offset : just move the offsets to the new buffer.
+		auto [newBuf, newBufOffset] = NullGraphicsDevice::DecodeBufferHandle(newMemHandle);
+
+		auto [oldbuf, oldBufOffset] = NullGraphicsDevice::DecodeBufferHandle(oldData.m_objectDataHandle);
+		auto [vtxbuf, vtxBufOffset] = NullGraphicsDevice::DecodeBufferHandle(oldData.m_vtxDataHandle);
+		auto [idxbuf, idxBufOffset] = NullGraphicsDevice::DecodeBufferHandle(oldData.m_idxDataHandle);
+		auto [unibuf, uniBufOffset] = NullGraphicsDevice::DecodeBufferHandle(oldData.m_uniformDataHandle);
+
+		GraphicObjectData newData = oldData;
+
+		newData.m_objectDataHandle = newMemHandle;
+		newData.m_vtxDataHandle = NullGraphicsDevice::EncodeBufferHandle(newBuf, newBufOffset + (vtxBufOffset - oldBufOffset));
+		newData.m_idxDataHandle = NullGraphicsDevice::EncodeBufferHandle(newBuf, newBufOffset + (idxBufOffset - oldBufOffset));
+		newData.m_uniformDataHandle = NullGraphicsDevice::EncodeBufferHandle(newBuf, newBufOffset + (uniBufOffset - oldBufOffset));
+
+		newData.m_uniformDataSize += (newNeededSize - newData.TotalGraphicSize());
+
+		return newData;
+	}
+
+
+	void NullRenderer::UpdateSubBufferRange(DeviceBufferHandle handle, uint32_t offset, void* data, uint32_t dataSize)
+	{
+		auto [bufID, bufOffset] = NullGraphicsDevice::DecodeBufferHandle(handle);
+		DeviceBufferHandle offsetHandle = NullGraphicsDevice::EncodeBufferHandle(bufID, bufOffset + offset);
+
+		m_device.UpdateBuffer(offsetHandle, data, dataSize);
+	}
+
+
+	void NullRenderer::BindFramebuffer(FramebufferHandle fbHandle)
+	{
+		AFramebuffer* fb = m_device.MutFramebuffer(fbHandle);
+		if (MOE_ASSERT(fb != nullptr))
+		{
+			fb->Bind();
+		}
+	}
+
+
+	void NullRenderer::UnbindFramebuffer(FramebufferHandle fbHandle)
+	{
+		AFramebuffer* fb = m_device.MutFramebuffer(fbHandle);
+		if (MOE_ASSERT(fb != nullptr))
+		{
+			fb->Unbind();
+		}
+	}
+}
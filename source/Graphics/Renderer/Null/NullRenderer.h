@@ -0,0 +1,145 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Graphics/Renderer/AbstractRenderer/AbstractRenderer.h"
+
+#include "Graphics/Device/Null/NullGraphicsDevice.h"
+
+#include "Monocle_Graphics_Export.h"
+
+namespace moe
+{
+
+	/**
+	 * \brief A renderer running on top of the null graphics device : it goes through the same render world, render queue
+	 * and material binding code as the other renderers, but never needs a graphics context.
+	 * Resources are bound through the binding points of their resource layouts, as there is no shader program to query.
+	 */
+	class NullRenderer final : public AbstractRenderer
+	{
+	public:
+
+		NullRenderer() = default;
+		virtual ~NullRenderer() = default;
+
+
+		/**
+		 * \brief Initializes the null device. The context setup function is not used and can be null.
+		 */
+		Monocle_Graphics_API bool	Initialize(IGraphicsRenderer::GraphicsContextSetup setupFunction) override;
+
+		Monocle_Graphics_API void	Shutdown() override;
+
+
+		Monocle_Graphics_API ShaderProgramHandle	CreateShaderProgramFromSource(const ShaderProgramDescriptor& shaProDesc) override
+		{
+			return m_device.CreateShaderProgramFromSource(shaProDesc);
+		}
+
+		Monocle_Graphics_API ShaderProgramHandle	CreateShaderProgramFromBinary(const ShaderProgramDescriptor& shaProDesc) override
+		{
+			return m_device.CreateShaderProgramFromBinary(shaProDesc);
+		}
+
+		Monocle_Graphics_API bool	RemoveShaderProgram(ShaderProgramHandle programHandle) override
+		{
+			return m_device.RemoveShaderProgram(programHandle);
+		}
+
+		void	UseShaderProgram(ShaderProgramHandle shaderProgram) override
+		{
+			m_device.UseShaderProgram(shaderProgram);
+		}
+
+
+		Monocle_Graphics_API [[nodiscard]] VertexLayoutHandle	CreateVertexLayout(const VertexLayoutDescriptor& vertexLayoutDesc) override
+		{
+			return m_device.CreateVertexLayout(vertexLayoutDesc);
+		}
+
+		[[nodiscard]] VertexLayoutHandle	CreateInstancedVertexLayout(const InstancedVertexLayoutDescriptor& vertexLayoutDesc) override
+		{
+			return m_device.CreateVertexLayout(vertexLayoutDesc);
+		}
+
+
+		Monocle_Graphics_API [[nodiscard]] DeviceBufferHandle	CreateUniformBuffer(const void* data, uint32_t dataSizeBytes) override
+		{
+			return m_device.CreateUniformBuffer(data, dataSizeBytes);
+		}
+
+
+		Monocle_Graphics_API [[nodiscard]] ResourceLayoutHandle	CreateResourceLayout(const ResourceLayoutDescriptor& desc) override
+		{
+			return m_device.CreateResourceLayout(desc);
+		}
+
+		Monocle_Graphics_API [[nodiscard]] ResourceSetHandle	CreateResourceSet(const ResourceSetDescriptor& desc) override
+		{
+			return m_device.CreateResourceSet(desc);
+		}
+
+
+		[[nodiscard]] const IGraphicsDevice&	GetGraphicsDevice() const override final
+		{
+			return m_device;
+		}
+
+		[[nodiscard]] IGraphicsDevice&	MutGraphicsDevice() override
+		{
+			return m_device;
+		}
+
+		/**
+		 * \brief Gives access to the statistics and the command stream of the null device.
+		 */
+		[[nodiscard]] NullGraphicsDevice&	MutNullDevice()
+		{
+			return m_device;
+		}
+
+
+		Monocle_Graphics_API void	Clear(const ColorRGBAf& clearColor) override;
+		Monocle_Graphics_API void	ClearDepth() override;
+
+		Monocle_Graphics_API void	UseMaterial(ShaderProgramHandle progHandle, ResourceSetHandle rscSetHandle) override;
+
+		Monocle_Graphics_API void	UseMaterial(Material* material) override;
+
+		Monocle_Graphics_API void	UseMaterialPerObject(Material* material, AGraphicObject& object) override;
+
+		Monocle_Graphics_API void	UseMaterialInstance(const MaterialInstance* material) override;
+
+
+		Monocle_Graphics_API [[nodiscard]] DeviceBufferHandle	AllocateObjectMemory(const uint32_t size) override final;
+		Monocle_Graphics_API void								CopyObjectMemory(DeviceBufferHandle from, uint32_t fromSizeBytes, DeviceBufferHandle to) override final;
+		Monocle_Graphics_API void								ReleaseObjectMemory(DeviceBufferHandle freedHandle) override final;
+
+		Monocle_Graphics_API GraphicObjectData					ReallocObjectUniformGraphicData(const GraphicObjectData& oldData, uint32_t newNeededSize) override;
+
+		Monocle_Graphics_API void	UpdateSubBufferRange(DeviceBufferHandle handle, uint32_t offset, void* data, uint32_t dataSize) override;
+
+
+		Monocle_Graphics_API void	BindFramebuffer(FramebufferHandle fbHandle)  override;
+		Monocle_Graphics_API void	UnbindFramebuffer(FramebufferHandle fbHandle) override;
+
+	protected:
+
+		[[nodiscard]] const IGraphicsDevice&	GetDevice() const override
+		{
+			return m_device;
+		}
+
+		[[nodiscard]] IGraphicsDevice&	MutDevice() override
+		{
+			return m_device;
+		}
+
+	private:
+
+		NullGraphicsDevice	m_device;
+
+	};
+
+}
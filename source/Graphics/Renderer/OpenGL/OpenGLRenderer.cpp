@@ -95,15 +95,22 @@ namespace moe
 
 	void OpenGLRenderer::UseMaterial(ShaderProgramHandle progHandle, ResourceSetHandle rscSetHandle)
 	{
-		const GLuint shaderProgramID = m_device.UseShaderProgram(progHandle);
+		m_device.UseShaderProgram(progHandle);
 
 		if (rscSetHandle.IsNull())
 			return;
 
+		const OpenGLShaderProgram* program = m_device.GetShaderProgram(progHandle);
+		if (program == nullptr)
+			return;
+
 		const auto& rscSetDesc = m_device.GetResourceSetDescriptor(rscSetHandle);
 
 		const auto& rscLayoutDesc = m_device.GetResourceLayoutDescriptor(rscSetDesc.GetResourceLayoutHandle());
 
+		// Bindings go through program slots resolved once per layout, not through per-draw name lookups
+		const Vector<uint32_t>& bindingSlots = program->GetResourceLayoutSlots(rscSetDesc.GetResourceLayoutHandle(), rscLayoutDesc);
+
 		int iBinding = 0;
 
 		int	uniformBlockBinding = 0;
@@ -115,14 +122,14 @@ namespace moe
 			case ResourceKind::UniformBuffer:
 				{
 					DeviceBufferHandle ubHandle = rscSetDesc.Get<DeviceBufferHandle>(iBinding);
-					m_device.BindProgramUniformBlock(shaderProgramID, rscBindingDesc.m_name.c_str(), uniformBlockBinding, ubHandle);
+					m_device.BindProgramUniformBlock(*program, bindingSlots[iBinding], uniformBlockBinding, ubHandle);
 					uniformBlockBinding++;
 				}
 				break;
 			case ResourceKind::TextureReadOnly:
 				{
 					TextureHandle texHandle = rscSetDesc.Get<TextureHandle>(iBinding);
-					m_device.BindTextureUnitToProgramUniform(shaderProgramID, textureUnitIndex, texHandle, rscBindingDesc.m_name.c_str());
+					m_device.BindTextureUnitToProgramSampler(*program, bindingSlots[iBinding], textureUnitIndex, texHandle);
 					textureUnitIndex++;
 				}
 
@@ -148,7 +155,11 @@ namespace moe
 		material->ResetFrameUniformBlockCounter();
 
 		// Process per-material resource sets.
-		const GLuint shaderProgramID = m_device.UseShaderProgram(material->GetShaderProgramHandle());
+		m_device.UseShaderProgram(material->GetShaderProgramHandle());
+
+		const OpenGLShaderProgram* program = m_device.GetShaderProgram(material->GetShaderProgramHandle());
+		if (program == nullptr)
+			return;
 
 		int	uniformBlockBinding = 0;
 
@@ -161,6 +172,8 @@ namespace moe
 
 			const auto& rscLayoutDesc = m_device.GetResourceLayoutDescriptor(rscSetDesc.GetResourceLayoutHandle());
 
+			const Vector<uint32_t>& bindingSlots = program->GetResourceLayoutSlots(rscSetDesc.GetResourceLayoutHandle(), rscLayoutDesc);
+
 			int iBinding = 0;
 
 
@@ -172,14 +185,14 @@ namespace moe
 				case ResourceKind::UniformBuffer:
 				{
 					DeviceBufferHandle ubHandle = rscSetDesc.Get<DeviceBufferHandle>(iBinding);
-					m_device.BindProgramUniformBlock(shaderProgramID, rscBindingDesc.m_name.c_str(), uniformBlockBinding, ubHandle);
+					m_device.BindProgramUniformBlock(*program, bindingSlots[iBinding], uniformBlockBinding, ubHandle);
 					uniformBlockBinding++;
 				}
 				break;
 				case ResourceKind::TextureReadOnly:
 				{
 					TextureHandle texHandle = rscSetDesc.Get<TextureHandle>(iBinding);
-					m_device.BindTextureUnitToProgramUniform(shaderProgramID, textureUnitIndex, texHandle, rscBindingDesc.m_name.c_str());
+					m_device.BindTextureUnitToProgramSampler(*program, bindingSlots[iBinding], textureUnitIndex, texHandle);
 					textureUnitIndex++;
 				}
 
@@ -208,7 +221,9 @@ namespace moe
 		// As we may have already set up per-material uniform blocks, start the uniform block binding counting at the block counter for this frame.
 		int	uniformBlockBinding = material->GetFrameUniformBlockCounter();
 
-		const GLuint shaderProgramID = m_device.GetShaderProgramID(material->GetShaderProgramHandle());
+		const OpenGLShaderProgram* program = m_device.GetShaderProgram(material->GetShaderProgramHandle());
+		if (program == nullptr)
+			return;
 
 		for (ResourceSetHandle rscSetHandle : material->GetPerObjectResourceSets())
 		{
@@ -219,6 +234,8 @@ namespace moe
 
 			const auto& rscLayoutDesc = m_device.GetResourceLayoutDescriptor(rscSetDesc.GetResourceLayoutHandle());
 
+			const Vector<uint32_t>& bindingSlots = program->GetResourceLayoutSlots(rscSetDesc.GetResourceLayoutHandle(), rscLayoutDesc);
+
 			int iBinding = 0;
 
 			int	textureUnitIndex = 0;
@@ -229,13 +246,16 @@ namespace moe
 				case ResourceKind::UniformBuffer:
 				{
 					DeviceBufferHandle ubHandle = rscSetDesc.Get<DeviceBufferHandle>(iBinding);
+					uint32_t ubSize = 0;
 
 					if (rscBindingDesc.m_name == "ObjectMatrices")
 					{
-						Material::UpdateObjectMatrices(object, ubHandle);
+						// The matrices usually end up in streamed memory, which has no registered size.
+						ubHandle = Material::UpdateObjectMatrices(object, ubHandle);
+						ubSize = sizeof(ObjectMatrices);
 					}
 
-					m_device.BindProgramUniformBlock(shaderProgramID, rscBindingDesc.m_name.c_str(), uniformBlockBinding, ubHandle);
+					m_device.BindProgramUniformBlock(*program, bindingSlots[iBinding], uniformBlockBinding, ubHandle, ubSize);
 
 					uniformBlockBinding++;
 				}
@@ -243,7 +263,7 @@ namespace moe
 				case ResourceKind::TextureReadOnly:
 				{
 					TextureHandle texHandle = rscSetDesc.Get<TextureHandle>(textureUnitIndex);
-					m_device.BindTextureUnitToProgramUniform(shaderProgramID, textureUnitIndex, texHandle, rscBindingDesc.m_name.c_str());
+					m_device.BindTextureUnitToProgramSampler(*program, bindingSlots[iBinding], textureUnitIndex, texHandle);
 					textureUnitIndex++;
 				}
 
@@ -0,0 +1,375 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "GraphicsResourceManager.h"
+
+#include "Graphics/Model/Model.h"
+#include "Graphics/RenderWorld/RenderWorld.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Core/Log/moeLog.h"
+
+#include <filesystem>
+
+
+namespace moe
+{
+	GraphicsResourceManager::GraphicsResourceManager(IGraphicsRenderer& renderer) :
+		m_renderer(renderer)
+	{
+	}
+
+
+	GraphicsResourceManager::~GraphicsResourceManager()
+	{
+		// The remaining references would point to a dead manager.
+		if (!MOE_ASSERT(GetNumResources() == 0))
+		{
+			MOE_WARNING(ChanGraphics, "Resource manager destroyed while %u resources are still referenced.", GetNumResources());
+		}
+	}
+
+
+	template <typename CreateFunc>
+	TextureRef GraphicsResourceManager::AcquireTexture(HashID key, const std::string& name, TextureLoadCallback&& onLoaded, CreateFunc&& createTexture)
+	{
+		uint32_t slot = FindAndAddRef(key);
+		if (slot != ms_INVALID_SLOT)
+		{
+			ResourceEntry& entry = m_entries[slot];
+			const TextureHandle texHandle{ (TextureHandle::Underlying) entry.m_handle };
+
+			if (onLoaded)
+			{
+				if (entry.m_loadState == TextureLoadState::Pending)
+				{
+					// Still loading : wait for it with everyone else.
+					entry.m_waiters.PushBack(std::move(onLoaded));
+				}
+				else
+				{
+					onLoaded(texHandle, entry.m_loadState);
+				}
+			}
+
+			return TextureRef(this, slot, texHandle);
+		}
+
+		slot = CreateEntry(key, ResourceType::Texture, name);
+		m_entries[slot].m_loadState = TextureLoadState::Pending;
+
+		// The key tells whether the slot still holds the same texture when the device calls back.
+		TextureHandle texHandle = createTexture([this, slot, key](TextureHandle, TextureLoadState state)
+		{
+			OnTextureLoaded(slot, key, state);
+		});
+
+		if (texHandle.IsNull())
+		{
+			DestroyEntry(slot);
+			return TextureRef();
+		}
+
+		ResourceEntry& entry = m_entries[slot];
+		entry.m_handle = texHandle.Get();
+
+		if (onLoaded)
+		{
+			if (entry.m_loadState == TextureLoadState::Pending)
+				entry.m_waiters.PushBack(std::move(onLoaded));
+			else
+				onLoaded(texHandle, entry.m_loadState);
+		}
+
+		return TextureRef(this, slot, texHandle);
+	}
+
+
+	TextureRef GraphicsResourceManager::AcquireTexture2D(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded)
+	{
+		Texture2DFileDescriptor normalizedDesc = tex2DFileDesc;
+		normalizedDesc.m_filename = NormalizePath(tex2DFileDesc.m_filename);
+
+		HashID key = HashString(normalizedDesc.m_filename)();
+		key = HashCombine(key, (HashID)ResourceType::Texture);
+		key = HashCombine(key, (HashID)normalizedDesc.m_targetFormat);
+		key = HashCombine(key, (HashID)normalizedDesc.m_requiredFormat);
+		key = HashCombine(key, (HashID)normalizedDesc.m_texUsage);
+		key = HashCombine(key, (HashID)normalizedDesc.m_wantedMipmapLevels);
+
+		return AcquireTexture(key, normalizedDesc.m_filename, std::move(onLoaded),
+			[this, &normalizedDesc](TextureLoadCallback&& deviceCallback)
+			{
+				return TextureHandle{ m_renderer.MutGraphicsDevice().CreateTexture2DAsync(normalizedDesc, std::move(deviceCallback)).Get() };
+			});
+	}
+
+
+	TextureRef GraphicsResourceManager::AcquireCubemapTexture(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded)
+	{
+		CubeMapTextureFilesDescriptor normalizedDesc = cubemapFilesDesc;
+
+		// The faces are hashed in order : the same files in another order make another cube map.
+		HashID key = (HashID)ResourceType::Texture;
+		for (std::string& faceFile : normalizedDesc.m_rightLeftTopBottomFrontBackTexFiles)
+		{
+			faceFile = NormalizePath(faceFile);
+			key = HashCombine(key, HashString(faceFile)());
+		}
+
+		key = HashCombine(key, (HashID)normalizedDesc.m_targetFormat);
+		key = HashCombine(key, (HashID)normalizedDesc.m_requiredFormat);
+		key = HashCombine(key, (HashID)normalizedDesc.m_texUsage);
+		key = HashCombine(key, (HashID)normalizedDesc.m_wantedMipmapLevels);
+
+		return AcquireTexture(key, normalizedDesc.m_rightLeftTopBottomFrontBackTexFiles[0], std::move(onLoaded),
+			[this, &normalizedDesc](TextureLoadCallback&& deviceCallback)
+			{
+				return m_renderer.MutGraphicsDevice().CreateCubemapTextureAsync(normalizedDesc, std::move(deviceCallback));
+			});
+	}
+
+
+	ShaderProgramRef GraphicsResourceManager::AcquireShaderProgramFromSourceFiles(const IGraphicsRenderer::ShaderFileList& fileList)
+	{
+		IGraphicsRenderer::ShaderFileList normalizedList;
+		normalizedList.Reserve(fileList.Size());
+
+		Vector<std::string> normalizedPaths;
+		normalizedPaths.Reserve(fileList.Size());
+
+		HashID key = (HashID)ResourceType::ShaderProgram;
+		for (const auto& [stage, path] : fileList)
+		{
+			normalizedPaths.PushBack(NormalizePath(path));
+			key = HashCombine(key, (HashID)stage);
+			key = HashCombine(key, HashString(normalizedPaths.Back())());
+		}
+
+		// The strings won't move anymore : the string views can point to them.
+		for (uint32_t iFile = 0; iFile < fileList.Size(); ++iFile)
+		{
+			normalizedList.PushBack({ fileList[iFile].first, normalizedPaths[iFile] });
+		}
+
+		uint32_t slot = FindAndAddRef(key);
+		if (slot == ms_INVALID_SLOT)
+		{
+			ShaderProgramHandle programHandle = m_renderer.CreateShaderProgramFromSourceFiles(normalizedList);
+			if (programHandle.IsNull())
+			{
+				return ShaderProgramRef();
+			}
+
+			slot = CreateEntry(key, ResourceType::ShaderProgram, (normalizedPaths.Empty() ? std::string() : normalizedPaths[0]));
+			m_entries[slot].m_handle = programHandle.Get();
+		}
+
+		ShaderProgramHandle programHandle{ m_entries[slot].m_handle };
+		return ShaderProgramRef(this, slot, programHandle);
+	}
+
+
+	ModelRef GraphicsResourceManager::AcquireModel(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc)
+	{
+		ModelDescriptor normalizedDesc = modelDesc;
+		normalizedDesc.m_modelFilename = NormalizePath(modelDesc.m_modelFilename);
+
+		HashID key = HashString(normalizedDesc.m_modelFilename)();
+		key = HashCombine(key, (HashID)ResourceType::Model);
+		key = HashCombine(key, (HashID)normalizedDesc.m_shaderProgram.Get());
+		key = HashCombine(key, reinterpret_cast<HashID>(&renderWorld));
+
+		uint32_t slot = FindAndAddRef(key);
+		if (slot == ms_INVALID_SLOT)
+		{
+			Model* newModel = new Model(renderWorld, matLib, *this, normalizedDesc);
+			if (newModel->GetMeshes().Empty())
+			{
+				// The import failed (and was already reported).
+				delete newModel;
+				return ModelRef();
+			}
+
+			slot = CreateEntry(key, ResourceType::Model, normalizedDesc.m_modelFilename);
+			m_entries[slot].m_model = newModel;
+			m_entries[slot].m_renderWorld = &renderWorld;
+		}
+
+		return ModelRef(this, slot, m_entries[slot].m_model);
+	}
+
+
+	TextureLoadState GraphicsResourceManager::GetLoadState(const TextureRef& texRef) const
+	{
+		if (texRef.IsNull())
+		{
+			return TextureLoadState::Failed;
+		}
+
+		return m_entries[texRef.m_slot].m_loadState;
+	}
+
+
+	uint32_t GraphicsResourceManager::GetRefCount(uint32_t slot) const
+	{
+		if (!MOE_ASSERT(slot < m_entries.Size()))
+		{
+			return 0;
+		}
+
+		return m_entries[slot].m_refCount;
+	}
+
+
+	void GraphicsResourceManager::OnTextureLoaded(uint32_t slot, HashID key, TextureLoadState state)
+	{
+		if (slot >= m_entries.Size() || m_entries[slot].m_refCount == 0 || m_entries[slot].m_key != key)
+		{
+			return; // Released in the meantime
+		}
+
+		ResourceEntry& entry = m_entries[slot];
+		entry.m_loadState = state;
+
+		// Callbacks may acquire other resources : don't keep references into the entries.
+		const TextureHandle texHandle{ (TextureHandle::Underlying) entry.m_handle };
+
+		Vector<TextureLoadCallback> waiters;
+		std::swap(waiters, entry.m_waiters);
+
+		for (TextureLoadCallback& onLoaded : waiters)
+		{
+			onLoaded(texHandle, state);
+		}
+	}
+
+
+	uint32_t GraphicsResourceManager::FindAndAddRef(HashID key)
+	{
+		auto slotIt = m_slotsByKey.Find(key);
+		if (slotIt == m_slotsByKey.End())
+		{
+			return ms_INVALID_SLOT;
+		}
+
+		const uint32_t slot = slotIt->second;
+		AddRef(slot);
+		m_stats.m_hits++;
+
+		return slot;
+	}
+
+
+	uint32_t GraphicsResourceManager::CreateEntry(HashID key, ResourceType type, const std::string& name)
+	{
+		uint32_t slot;
+		if (m_freeSlots.Empty())
+		{
+			slot = (uint32_t)m_entries.Size();
+			m_entries.EmplaceBack();
+		}
+		else
+		{
+			slot = m_freeSlots.Back();
+			m_freeSlots.PopBack();
+		}
+
+		ResourceEntry& entry = m_entries[slot];
+		entry.m_key = key;
+		entry.m_type = type;
+		entry.m_refCount = 1;
+		entry.m_loadState = TextureLoadState::Ready;
+
+		#ifndef MOE_SHIPPING
+		entry.m_name = name;
+		#else
+		(void)name;
+		#endif
+
+		m_slotsByKey.Insert({ key, slot });
+		m_stats.m_loads++;
+
+		return slot;
+	}
+
+
+	void GraphicsResourceManager::DestroyEntry(uint32_t slot)
+	{
+		m_slotsByKey.Erase(m_entries[slot].m_key);
+		m_entries[slot] = ResourceEntry();
+		m_freeSlots.PushBack(slot);
+	}
+
+
+	void GraphicsResourceManager::AddRef(uint32_t slot)
+	{
+		MOE_DEBUG_ASSERT(slot < m_entries.Size() && m_entries[slot].m_refCount != 0);
+		m_entries[slot].m_refCount++;
+	}
+
+
+	void GraphicsResourceManager::Release(uint32_t slot)
+	{
+		if (!MOE_ASSERT(slot < m_entries.Size() && m_entries[slot].m_refCount != 0))
+		{
+			return;
+		}
+
+		ResourceEntry& entry = m_entries[slot];
+		entry.m_refCount--;
+
+		if (entry.m_refCount != 0)
+		{
+			return;
+		}
+
+		// Free the slot before unloading : deleting a model releases its textures, which modifies other entries.
+		const ResourceType type = entry.m_type;
+		const uint64_t handle = entry.m_handle;
+		Model* model = entry.m_model;
+		RenderWorld* renderWorld = entry.m_renderWorld;
+
+		DestroyEntry(slot);
+		m_stats.m_unloads++;
+
+		switch (type)
+		{
+		case ResourceType::Texture:
+		{
+			// Also cancels the load if the texture was still loading.
+			Texture2DHandle texHandle;
+			texHandle.m_handle = (Texture2DHandle::Underlying) handle;
+			m_renderer.MutGraphicsDevice().DestroyTexture2D(texHandle);
+		}
+		break;
+		case ResourceType::ShaderProgram:
+			m_renderer.RemoveShaderProgram(ShaderProgramHandle{ handle });
+			break;
+		case ResourceType::Model:
+			for (Mesh* mesh : model->GetMeshes())
+			{
+				renderWorld->DeleteStaticMesh(mesh);
+			}
+			delete model;
+			break;
+		default:
+			MOE_ASSERT(false);
+			MOE_ERROR(ChanGraphics, "Unmanaged resource type value.");
+		}
+	}
+
+
+	std::string GraphicsResourceManager::NormalizePath(std::string_view path)
+	{
+		// Purely lexical : the file doesn't have to exist, and symbolic links are not resolved.
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+
+	HashID GraphicsResourceManager::HashCombine(HashID seed, HashID value)
+	{
+		// Same mixing as boost::hash_combine.
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+}
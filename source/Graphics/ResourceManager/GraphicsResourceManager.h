@@ -0,0 +1,300 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_STD_SUPPORT
+#include <string>
+#endif
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Containers/HashMap/HashMap.h"
+#include "Core/HashString/HashString.h"
+
+#include "Graphics/Renderer/Renderer.h"
+
+#include "Graphics/Texture/TextureDescription.h"
+#include "Graphics/Texture/TextureHandle.h"
+#include "Graphics/Texture/TextureLoadState.h"
+
+#include "Monocle_Graphics_Export.h"
+
+
+namespace moe
+{
+	class GraphicsResourceManager;
+	class MaterialLibrary;
+	class Model;
+	class RenderWorld;
+	struct ModelDescriptor;
+
+
+	/**
+	 * \brief A counted reference to a resource of the resource manager.
+	 * Copying it adds a reference, destroying (or resetting) it releases one : the resource gets unloaded with its last reference.
+	 * References must not outlive the resource manager that gave them.
+	 */
+	template <typename T>
+	class ResourceRef
+	{
+	public:
+
+		ResourceRef() = default;
+
+		ResourceRef(const ResourceRef& other);
+		ResourceRef& operator=(const ResourceRef& other);
+
+		ResourceRef(ResourceRef&& other) noexcept;
+		ResourceRef& operator=(ResourceRef&& other) noexcept;
+
+		~ResourceRef()
+		{
+			Reset();
+		}
+
+		/**
+		 * \brief Releases the reference : this ref becomes null.
+		 */
+		void	Reset();
+
+
+		[[nodiscard]] T		Get() const { return m_resource; }
+
+		[[nodiscard]] bool	IsNull() const { return m_manager == nullptr; }
+
+		[[nodiscard]] bool	IsNotNull() const { return m_manager != nullptr; }
+
+		bool	operator==(const ResourceRef& other) const { return m_manager == other.m_manager && m_slot == other.m_slot; }
+		bool	operator!=(const ResourceRef& other) const { return !(*this == other); }
+
+
+	private:
+
+		friend class GraphicsResourceManager;
+
+		ResourceRef(GraphicsResourceManager* manager, uint32_t slot, T resource) :
+			m_manager(manager), m_slot(slot), m_resource(resource)
+		{}
+
+		GraphicsResourceManager*	m_manager = nullptr;
+		uint32_t					m_slot = 0;
+		T							m_resource{};
+	};
+
+
+	using TextureRef = ResourceRef<TextureHandle>;
+	using ShaderProgramRef = ResourceRef<ShaderProgramHandle>;
+	using ModelRef = ResourceRef<Model*>;
+
+
+	struct GraphicsResourceManagerStats
+	{
+		uint64_t	m_hits = 0;		// Acquisitions of an already loaded (or loading) resource
+		uint64_t	m_loads = 0;
+		uint64_t	m_unloads = 0;
+	};
+
+
+	/**
+	 * \brief Makes sure each asset is only loaded (and kept in VRAM) once, however many users it has.
+	 * Resources are keyed by their hashed path(s) and the import parameters that change the result of the import
+	 * (e.g. the same file loaded with two different texture formats gives two different resources).
+	 * Acquiring a resource that is already loaded, or still being loaded, only adds a reference to it.
+	 * Like the graphics device, the resource manager must only be used from the render thread.
+	 */
+	class GraphicsResourceManager
+	{
+	public:
+
+		Monocle_Graphics_API GraphicsResourceManager(IGraphicsRenderer& renderer);
+		Monocle_Graphics_API ~GraphicsResourceManager();
+
+		GraphicsResourceManager(const GraphicsResourceManager&) = delete;
+		GraphicsResourceManager& operator=(const GraphicsResourceManager&) = delete;
+
+
+		/**
+		 * \brief Textures are loaded asynchronously : the handle is usable right away.
+		 * \param onLoaded Optional, called when the texture is ready (right away if it already is)
+		 */
+		Monocle_Graphics_API [[nodiscard]] TextureRef	AcquireTexture2D(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded = nullptr);
+
+		Monocle_Graphics_API [[nodiscard]] TextureRef	AcquireCubemapTexture(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded = nullptr);
+
+		/**
+		 * \return A null ref if the program could not be compiled
+		 */
+		Monocle_Graphics_API [[nodiscard]] ShaderProgramRef	AcquireShaderProgramFromSourceFiles(const IGraphicsRenderer::ShaderFileList& fileList);
+
+		/**
+		 * \brief Models are specific to the render world their meshes are created in : the same file used in two worlds is imported twice.
+		 * The textures of the model are acquired from this manager too, so they are shared with other models.
+		 * The meshes of the model are deleted from the world when the model is unloaded.
+		 */
+		Monocle_Graphics_API [[nodiscard]] ModelRef	AcquireModel(RenderWorld& renderWorld, MaterialLibrary& matLib, const ModelDescriptor& modelDesc);
+
+
+		/**
+		 * \brief The load state of a texture loaded through this manager. Shaders and models are always Ready once acquired.
+		 */
+		[[nodiscard]] TextureLoadState	GetLoadState(const TextureRef& texRef) const;
+
+		[[nodiscard]] uint32_t	GetRefCount(uint32_t slot) const;
+
+		template <typename T>
+		[[nodiscard]] uint32_t	GetRefCount(const ResourceRef<T>& ref) const
+		{
+			return (ref.IsNull() ? 0 : GetRefCount(ref.m_slot));
+		}
+
+		/**
+		 * \brief How many resources are currently loaded (or loading).
+		 */
+		[[nodiscard]] uint32_t	GetNumResources() const { return (uint32_t)m_slotsByKey.Size(); }
+
+		[[nodiscard]] const GraphicsResourceManagerStats&	GetStats() const { return m_stats; }
+
+
+	private:
+
+		template <typename T>
+		friend class ResourceRef;
+
+		enum class ResourceType : uint8_t
+		{
+			Texture,
+			ShaderProgram,
+			Model
+		};
+
+		struct ResourceEntry
+		{
+			Vector<TextureLoadCallback>	m_waiters;	// Callbacks of everyone who acquired a texture that is still loading
+			Model*				m_model = nullptr;
+			RenderWorld*		m_renderWorld = nullptr;
+			HashID				m_key = 0;
+			uint64_t			m_handle = 0;	// The raw texture or shader program handle
+			uint32_t			m_refCount = 0;
+			ResourceType		m_type = ResourceType::Texture;
+			TextureLoadState	m_loadState = TextureLoadState::Ready;
+			#ifndef MOE_SHIPPING
+			std::string			m_name;		// For debugging only
+			#endif
+		};
+
+
+		/**
+		 * \brief Finds the resource with the given key and adds a reference to it.
+		 * \return The slot of the resource, or ms_INVALID_SLOT if it is not loaded.
+		 */
+		uint32_t	FindAndAddRef(HashID key);
+
+		uint32_t	CreateEntry(HashID key, ResourceType type, const std::string& name);
+
+		/**
+		 * \brief Frees the slot of a resource that could not be loaded.
+		 */
+		void		DestroyEntry(uint32_t slot);
+
+		void		AddRef(uint32_t slot);
+
+		void		Release(uint32_t slot);
+
+		/**
+		 * \brief Shared by all the texture types : references the texture if it is already there, or creates it with the creation function.
+		 */
+		template <typename CreateFunc>
+		[[nodiscard]] TextureRef	AcquireTexture(HashID key, const std::string& name, TextureLoadCallback&& onLoaded, CreateFunc&& createTexture);
+
+		void		OnTextureLoaded(uint32_t slot, HashID key, TextureLoadState state);
+
+		/**
+		 * \brief Paths are normalized before hashing, so that different spellings of the same path give the same resource.
+		 */
+		static std::string	NormalizePath(std::string_view path);
+
+		static HashID		HashCombine(HashID seed, HashID value);
+
+
+		static constexpr uint32_t	ms_INVALID_SLOT = UINT32_MAX;
+
+		IGraphicsRenderer&				m_renderer;
+
+		Vector<ResourceEntry>			m_entries;
+		Vector<uint32_t>				m_freeSlots;
+		HashMap<HashID, uint32_t>		m_slotsByKey;
+
+		GraphicsResourceManagerStats	m_stats;
+	};
+
+
+	template <typename T>
+	ResourceRef<T>::ResourceRef(const ResourceRef& other) :
+		m_manager(other.m_manager), m_slot(other.m_slot), m_resource(other.m_resource)
+	{
+		if (m_manager != nullptr)
+		{
+			m_manager->AddRef(m_slot);
+		}
+	}
+
+
+	template <typename T>
+	ResourceRef<T>& ResourceRef<T>::operator=(const ResourceRef& other)
+	{
+		if (this != &other)
+		{
+			// Add the new reference first : releasing ours may be the last reference of the same resource.
+			if (other.m_manager != nullptr)
+			{
+				other.m_manager->AddRef(other.m_slot);
+			}
+
+			Reset();
+
+			m_manager = other.m_manager;
+			m_slot = other.m_slot;
+			m_resource = other.m_resource;
+		}
+
+		return *this;
+	}
+
+
+	template <typename T>
+	ResourceRef<T>::ResourceRef(ResourceRef&& other) noexcept :
+		m_manager(other.m_manager), m_slot(other.m_slot), m_resource(other.m_resource)
+	{
+		other.m_manager = nullptr;
+	}
+
+
+	template <typename T>
+	ResourceRef<T>& ResourceRef<T>::operator=(ResourceRef&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+
+			m_manager = other.m_manager;
+			m_slot = other.m_slot;
+			m_resource = other.m_resource;
+
+			other.m_manager = nullptr;
+		}
+
+		return *this;
+	}
+
+
+	template <typename T>
+	void ResourceRef<T>::Reset()
+	{
+		if (m_manager != nullptr)
+		{
+			m_manager->Release(m_slot);
+			m_manager = nullptr;
+		}
+
+		m_resource = T{};
+	}
+}
@@ -0,0 +1,207 @@
+#version 430 core
+// Require version 430 to be able to use shader storage buffers.
+// Same as blinn_phong.frag, but only goes through the lights of the fragment cluster (use with blinn_phong.vert).
+
+struct LightData
+{
+	vec4	lightPosition;
+	vec4	lightDirection;
+	vec4	lightAmbient;
+	vec4	lightDiffuse;
+	vec4	lightSpecular;
+	float	lightConstantAttenuation;
+	float	lightLinearAttenuation;
+	float	lightQuadraticAttenuation;
+	float	lightSpotInnerCutoff;
+	float	lightSpotOuterCutoff;
+};
+
+layout (std140, binding = 2) uniform CameraMatrices
+{
+	mat4	view;
+	mat4	projection;
+	mat4	viewProjection;
+};
+
+layout (std140, binding = 3) uniform PhongMaterial
+{
+	vec4	materialAmbient;
+	vec4	materialDiffuse;
+	vec4	materialSpecular;
+	float	shininess;
+};
+
+layout (std140, binding = 14) uniform LightClustersParams
+{
+	uvec3	numClusters;
+	uint	numGlobalLights; // The global lights are at the start of the index list
+	vec2	viewportSize;
+	float	sliceScale;
+	float	sliceBias;
+};
+
+layout (std430, binding = 0) readonly buffer ClusteredLights
+{
+	LightData	lightsData[];
+};
+
+layout (std430, binding = 1) readonly buffer LightClusters
+{
+	uvec2	clusters[]; // offset and count in the light index list
+};
+
+layout (std430, binding = 2) readonly buffer LightIndices
+{
+	uint	lightIndices[];
+};
+
+layout(binding = 0) uniform sampler2D diffuseMap;
+
+in vec3	vs_normal;
+
+in vec2 vs_texCoords;
+
+in vec3	vs_fragPosEye;
+
+out vec4	FragColor;
+
+
+
+vec4	ComputeDirectionalLight(uint iLight)
+{
+	// First compute ambient because it will be used no matter what
+	vec4 diffuseMapVal = texture(diffuseMap, vs_texCoords);
+	vec4 ambient  = lightsData[iLight].lightAmbient * diffuseMapVal;
+
+	// Negate direction vector because we specify the light direction as pointing from the light source.
+	// Therefore we negate the light direction to get a direction vector pointing towards the light source.
+	vec4 lightDirEye = normalize(view * -lightsData[iLight].lightDirection);
+
+	// Diffuse
+	vec3 normalizedNorm = normalize(vs_normal); // just to be sure
+	float diffuseStrength = max(dot(normalizedNorm, lightDirEye.xyz), 0.0);
+	vec4 diffuse = lightsData[iLight].lightDiffuse * diffuseStrength * diffuseMapVal;
+
+	// Specular
+	float specularStrength = 0.0;
+	if (diffuse != 0) // Do not produce a specular highlight if the object is back lit.
+	{
+		vec3 vertToEyeDir = normalize(-vs_fragPosEye); // formula is eye pos - vertex pos but in eye space, eye is at (0, 0, 0) !
+		// Compute Blinn-Phong half vector
+		vec3 halfwayDir = normalize(lightDirEye.xyz + vertToEyeDir.xyz);
+		specularStrength = pow(max(dot(normalizedNorm, halfwayDir), 0.0), shininess);
+	}
+
+	vec4 specular = lightsData[iLight].lightSpecular * specularStrength;
+	return ambient + diffuse + specular;
+}
+
+
+vec4	ComputePointLight(uint iLight, vec4 lightDirEye, float attenuation)
+{
+	// First compute ambient because it will be used no matter what
+	vec4 diffuseMapVal = texture(diffuseMap, vs_texCoords);
+	vec4 ambient  = lightsData[iLight].lightAmbient * diffuseMapVal;
+
+	// Diffuse
+	vec3 normalizedNorm = normalize(vs_normal); // just to be sure
+	float diffuseStrength = max(dot(normalizedNorm, lightDirEye.xyz), 0.0);
+	vec4 diffuse = lightsData[iLight].lightDiffuse * diffuseStrength * diffuseMapVal;
+
+	// Specular
+	float specularStrength = 0.0;
+	if (diffuse != 0) // Do not produce a specular highlight if the object is back lit.
+	{
+		vec3 vertToEyeDir = normalize(-vs_fragPosEye); // formula is eye pos - vertex pos but in eye space, eye is at (0, 0, 0) !
+		// Compute Blinn-Phong half vector
+		vec3 halfwayDir = normalize(lightDirEye.xyz + vertToEyeDir.xyz);
+		specularStrength = pow(max(dot(normalizedNorm, halfwayDir), 0.0), shininess);
+	}
+	vec4 specular = lightsData[iLight].lightSpecular * specularStrength;
+
+	return ((ambient + diffuse + specular) * attenuation);
+}
+
+
+vec4	ComputeSpotLight(uint iLight, vec4 lightDirEye, float attenuation)
+{
+	// First compute ambient because it will be used no matter what
+	vec4 diffuseMapVal = texture(diffuseMap, vs_texCoords);
+	vec4 ambient  = lightsData[iLight].lightAmbient * diffuseMapVal;
+
+	float theta = dot(lightDirEye, normalize(view * -lightsData[iLight].lightDirection)); // -lightDirection : same as above
+	float epsilon = lightsData[iLight].lightSpotInnerCutoff - lightsData[iLight].lightSpotOuterCutoff;
+	float intensity = clamp((theta - lightsData[iLight].lightSpotOuterCutoff) / epsilon, 0.0, 1.0);
+
+	// Diffuse
+	vec3 normalizedNorm = normalize(vs_normal); // just to be sure
+	float diffuseStrength = max(dot(normalizedNorm, lightDirEye.xyz), 0.0);
+	vec4 diffuse = lightsData[iLight].lightDiffuse * diffuseStrength * diffuseMapVal;
+
+	// Specular
+	vec3 vertToEyeDir = normalize(-vs_fragPosEye); // formula is eye pos - vertex pos but in eye space, eye is at (0, 0, 0) !
+	vec3 reflectDir = reflect(-lightDirEye.xyz, normalizedNorm);
+	float specularStrength = pow(max(dot(vertToEyeDir, reflectDir), 0.0), shininess);
+	vec4 specular = lightsData[iLight].lightSpecular * specularStrength;
+
+	return ((ambient + diffuse + specular) * attenuation * intensity);
+}
+
+
+vec4	ComputeLight(uint iLight)
+{
+	if (lightsData[iLight].lightPosition.w == 0) // it's a directional light
+	{
+		return ComputeDirectionalLight(iLight);
+	}
+
+	// it's a position light (point or spot) : start calculations
+	vec4 lightPosEye = (view * lightsData[iLight].lightPosition);
+	vec4 lightDirEye = lightPosEye - vec4(vs_fragPosEye, 1.0);
+
+	float distance = length(lightDirEye);
+	float attenuation = 1.0 /
+	 (lightsData[iLight].lightConstantAttenuation + (lightsData[iLight].lightLinearAttenuation * distance) + (lightsData[iLight].lightQuadraticAttenuation * distance * distance));
+
+	lightDirEye = normalize(lightDirEye);
+
+	if (lightsData[iLight].lightDirection != vec4(0)) // it has position and direction : it's a spot light
+	{
+		return ComputeSpotLight(iLight, lightDirEye, attenuation);
+	}
+
+	return ComputePointLight(iLight, lightDirEye, attenuation);
+}
+
+
+uint	FindCluster()
+{
+	uvec2 tile = uvec2(gl_FragCoord.xy / viewportSize * vec2(numClusters.xy));
+	tile = min(tile, numClusters.xy - 1);
+
+	// Slices are exponentially distributed in depth : log(depth) maps linearly to the slice index.
+	float depth = max(-vs_fragPosEye.z, 1e-6);
+	uint slice = uint(clamp(log(depth) * sliceScale + sliceBias, 0.0, float(numClusters.z - 1)));
+
+	return (slice * numClusters.y + tile.y) * numClusters.x + tile.x;
+}
+
+
+void main()
+{
+	FragColor = vec4(0.0);
+
+	for (uint iGlobal = 0; iGlobal < numGlobalLights; iGlobal++)
+	{
+		FragColor += ComputeLight(lightIndices[iGlobal]);
+	}
+
+	uvec2 cluster = clusters[FindCluster()];
+
+	for (uint iLight = cluster.x; iLight < cluster.x + cluster.y; iLight++)
+	{
+		FragColor += ComputeLight(lightIndices[iLight]);
+	}
+
+	FragColor.w = 1.0;
+}
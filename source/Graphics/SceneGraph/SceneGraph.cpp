@@ -9,27 +9,63 @@ namespace moe
 	SceneGraph::SceneGraph()
 	{
 		// Create the root
-		m_nodes.Add<ASceneNode>(*this);
+		const FreelistID rootID = m_nodes.Add<ASceneNode>(*this);
+		m_nodes.Lookup(rootID).m_handle = GetRootHandle();
+
+		m_transforms.AddNode(NodeIndex(GetRootHandle()), SceneTransforms::ms_INVALID_NODE, Transform::Identity());
 	}
 
 
 	void SceneGraph::AddChild(SceneNodeHandle parentHandle, SceneNodeHandle childHandle)
 	{
-		// First detach the child from its potential current parent
 		ASceneNode* newChildNode = MutSceneNode(childHandle);
 
-		if (newChildNode->HasParent())
+		if (newChildNode->m_parentHandle == parentHandle)
+		{
+			return; // We are already its parent
+		}
+
+		// Making a node the child of one of its descendants would create a cycle
+		for (uint32_t ancestorIdx = NodeIndex(parentHandle); ancestorIdx != SceneTransforms::ms_INVALID_NODE; ancestorIdx = m_transforms.GetParent(ancestorIdx))
 		{
-			ASceneNode* oldParentNode = newChildNode->MutParent();
-			oldParentNode->DetachChild(childHandle);
+			if (!MOE_ASSERT(ancestorIdx != NodeIndex(childHandle)))
+			{
+				return;
+			}
 		}
 
-		ASceneNode* newParentNode = MutSceneNode(parentHandle);
+		// The child doesn't move : we just attach it to a new parent. So only its local transform changes.
+		m_transforms.UpdateWorldTransforms();
+		const Mat4 parentInverseWorld = m_transforms.GetWorldTransform(NodeIndex(parentHandle)).Matrix().GetInverse();
+		const Transform newChildLocalTransform(parentInverseWorld * m_transforms.GetWorldTransform(NodeIndex(childHandle)).Matrix());
 
-		newParentNode->AttachChild(childHandle);
+		// First detach the child from its potential current parent
+		if (newChildNode->HasParent())
+		{
+			newChildNode->MutParent()->UnlinkChild(childHandle);
+		}
 
+		MutSceneNode(parentHandle)->LinkChild(childHandle);
 		newChildNode->SetParentHandle(parentHandle);
 
+		m_transforms.SetParent(NodeIndex(childHandle), NodeIndex(parentHandle));
+		m_transforms.SetLocalTransform(NodeIndex(childHandle), newChildLocalTransform);
+	}
+
+
+	void SceneGraph::SetWorldTransform(SceneNodeHandle nodeHandle, const Transform& worldTransform)
+	{
+		const uint32_t parentIdx = m_transforms.GetParent(NodeIndex(nodeHandle));
+		if (parentIdx == SceneTransforms::ms_INVALID_NODE)
+		{
+			// Root node : world transform = local transform.
+			m_transforms.SetLocalTransform(NodeIndex(nodeHandle), worldTransform);
+			return;
+		}
+
+		m_transforms.UpdateWorldTransforms();
+		const Mat4 parentInverseWorld = m_transforms.GetWorldTransform(parentIdx).Matrix().GetInverse();
+		m_transforms.SetLocalTransform(NodeIndex(nodeHandle), Transform(parentInverseWorld * worldTransform.Matrix()));
 	}
 
 
@@ -40,7 +76,7 @@ namespace moe
 		if (deletedNode->HasParent())
 		{
 			ASceneNode* parentNode = deletedNode->MutParent();
-			parentNode->DetachChild(handleToRemove);
+			parentNode->UnlinkChild(handleToRemove);
 		}
 
 		if (deletedNode->m_leftChildHandle.IsNotNull())
@@ -58,12 +94,21 @@ namespace moe
 			}
 			else
 			{
-				// Just attach all the orphaned children to root.
+				// Just attach all the orphaned children to root, keeping their world transform.
 				// We need to change the parent handle for all of them...
+				m_transforms.UpdateWorldTransforms();
+				const Mat4 rootInverseWorld = m_transforms.GetWorldTransform(NodeIndex(GetRootHandle())).Matrix().GetInverse();
+
 				for (SceneNodeHandle deletedNodeChildHandle = deletedNode->m_leftChildHandle; deletedNodeChildHandle.IsNotNull();)
 				{
 					ASceneNode* const deletedNodeChild = MutSceneNode(deletedNodeChildHandle);
 					deletedNodeChild->SetParentHandle(GetRootHandle());
+
+					// World transforms stay readable until the next update, even after a parent change.
+					const Transform childLocalTransform(rootInverseWorld * m_transforms.GetWorldTransform(NodeIndex(deletedNodeChildHandle)).Matrix());
+					m_transforms.SetParent(NodeIndex(deletedNodeChildHandle), NodeIndex(GetRootHandle()));
+					m_transforms.SetLocalTransform(NodeIndex(deletedNodeChildHandle), childLocalTransform);
+
 					deletedNodeChildHandle = deletedNodeChild->m_rightSiblingHandle;
 				}
 
@@ -87,6 +132,8 @@ namespace moe
 			}
 		}
 
+		m_transforms.RemoveNode(NodeIndex(handleToRemove));
+
 		m_nodes.Remove(handleToRemove.Get() - 1);
 	}
 }
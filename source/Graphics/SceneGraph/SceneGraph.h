@@ -5,6 +5,7 @@
 #include <Core/Containers/FreeList/PolymorphicFreelist.h>
 
 #include "SceneNode.h"
+#include "SceneTransforms.h"
 
 
 #include "Monocle_Graphics_Export.h"
@@ -21,6 +22,7 @@ namespace moe
 			SceneGraph()
 		{
 			m_nodes.Reserve(reservedSize);
+			m_transforms.Reserve(reservedSize);
 		}
 
 		~SceneGraph()
@@ -36,9 +38,18 @@ namespace moe
 
 			SceneNodeHandle newNodeHandle{ newNodeID.ToHandle<SceneNodeHandle>() };
 
-			AddChild(parentHandle, newNodeHandle);
+			if (parentHandle.IsNull())
+			{
+				parentHandle = GetRootHandle();
+			}
 
-			MutSceneNode(newNodeHandle)->SetLocalTransform(localTransform);
+			ASceneNode* newNode = MutSceneNode(newNodeHandle);
+			newNode->m_handle = newNodeHandle;
+			newNode->SetParentHandle(parentHandle);
+
+			MutSceneNode(parentHandle)->LinkChild(newNodeHandle);
+
+			m_transforms.AddNode(NodeIndex(newNodeHandle), NodeIndex(parentHandle), localTransform);
 
 			return newNodeHandle;
 		}
@@ -55,12 +66,54 @@ namespace moe
 		}
 
 
+		/**
+		 * \brief Makes a node the child of another one. The node keeps its world transform : only its local transform changes.
+		 */
 		Monocle_Graphics_API void	AddChild(SceneNodeHandle parentHandle, SceneNodeHandle childHandle);
 
 
 		Monocle_Graphics_API void	RemoveNode(SceneNodeHandle handleToRemove, bool removeChildren = true);
 
 
+		void	SetLocalTransform(SceneNodeHandle nodeHandle, const Transform& localTransform)
+		{
+			m_transforms.SetLocalTransform(NodeIndex(nodeHandle), localTransform);
+		}
+
+		Monocle_Graphics_API void	SetWorldTransform(SceneNodeHandle nodeHandle, const Transform& worldTransform);
+
+
+		[[nodiscard]] const Transform&	GetLocalTransform(SceneNodeHandle nodeHandle) const
+		{
+			return m_transforms.GetLocalTransform(NodeIndex(nodeHandle));
+		}
+
+		/**
+		 * \brief Returns the up-to-date world transform of a node, updating the world transforms first if needed.
+		 */
+		[[nodiscard]] const Transform&	GetWorldTransform(SceneNodeHandle nodeHandle)
+		{
+			m_transforms.UpdateWorldTransforms();
+			return m_transforms.GetWorldTransform(NodeIndex(nodeHandle));
+		}
+
+
+		/**
+		 * \brief Recomputes the world transforms of all the nodes that moved since the last update, in one pass.
+		 * Meant to be called once per frame, after gameplay code moved things around.
+		 */
+		void	UpdateWorldTransforms()
+		{
+			m_transforms.UpdateWorldTransforms();
+		}
+
+		void	UpdateWorldTransforms(JobSystem& jobSystem)
+		{
+			m_transforms.UpdateWorldTransforms(jobSystem);
+		}
+
+		[[nodiscard]] const SceneTransforms&	GetTransforms() const { return m_transforms; }
+
 
 		ASceneNode*	MutRoot()
 		{
@@ -85,9 +138,15 @@ namespace moe
 
 	private:
 
+		static uint32_t	NodeIndex(SceneNodeHandle nodeHandle)
+		{
+			return nodeHandle.Get() - 1;
+		}
 
 
 		PolymorphicFreelist<ASceneNode>	m_nodes;
+
+		SceneTransforms	m_transforms;
 	};
 
-}
\ No newline at end of file
+}
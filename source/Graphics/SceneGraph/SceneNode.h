@@ -15,12 +15,13 @@ namespace moe
 	 * It uses a LCRS (Left Child - Right Sibling) system to try to optimize memory usage and access patterns.
 	 * I believe it's more efficient than having a vector of children Node pointers per Scene node.
 	 * The runtime inefficiency penalty of traversing sibling nodes is mitigated by the assumption the scene graph is using a contiguous data structure to store all nodes.
+	 * Transforms are not stored in the nodes, but in the SceneTransforms of the graph : setting a transform is cheap,
+	 * and world transforms get recomputed the next time they are read (or when the graph gets updated).
 	 */
 	class ASceneNode
 	{
 	public:
-		Monocle_Graphics_API ASceneNode(class SceneGraph& graph, SceneNodeHandle parentHandle = SceneNodeHandle::Null(),
-		           const Transform& localTransf = Transform());
+		Monocle_Graphics_API ASceneNode(class SceneGraph& graph);
 
 		virtual ~ASceneNode() {}
 
@@ -30,10 +31,12 @@ namespace moe
 			return nullptr;
 		}
 
-		[[nodiscard]] const Transform&	GetWorldTransform() const { return m_worldTransform; }
-		[[nodiscard]] const Transform&	GetLocalTransform() const { return m_worldTransform; }
+		[[nodiscard]] SceneNodeHandle	GetHandle() const { return m_handle; }
 
-		[[nodiscard]] Transform	GetInverseWorldTransform() const { return Transform(m_worldTransform.Matrix().GetInverse()); }
+		[[nodiscard]] Monocle_Graphics_API const Transform&	GetWorldTransform() const;
+		[[nodiscard]] Monocle_Graphics_API const Transform&	GetLocalTransform() const;
+
+		[[nodiscard]] Transform	GetInverseWorldTransform() const { return Transform(GetWorldTransform().Matrix().GetInverse()); }
 
 		Monocle_Graphics_API void	SetLocalTransform(const Transform& newLocalTransf);
 		Monocle_Graphics_API void	SetWorldTransform(const Transform& newWorldTransf);
@@ -50,29 +53,28 @@ namespace moe
 
 	protected:
 
-		void	SetLocalTransformNoChildrenUpdate(const Transform& newLocalTransf);
-		void	SetWorldTransformNoChildrenUpdate(const Transform& newWorldTransf);
-
-		void	UpdateChildrenTransforms();
-
 		void	SetParentHandle(SceneNodeHandle handle)
 		{
 			m_parentHandle = handle;
 		}
 
-		void	DetachChild(SceneNodeHandle childToBeDetachedHandle);
+		/**
+		 * \brief Unlinks a child from our children list. Does not touch its transforms.
+		 */
+		void	UnlinkChild(SceneNodeHandle childHandle);
+
+		/**
+		 * \brief Links a child at the end of our children list. Does not touch its transforms.
+		 */
+		void	LinkChild(SceneNodeHandle childHandle);
 
 
 		SceneGraph&		m_graph;
 
+		SceneNodeHandle		m_handle;
 		SceneNodeHandle		m_parentHandle;
 		SceneNodeHandle		m_leftChildHandle;
 		SceneNodeHandle		m_rightSiblingHandle;
-
-		Transform	m_localTransform;
-
-		Transform	m_worldTransform;
-
 	};
 
 
@@ -0,0 +1,287 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "SceneTransforms.h"
+
+#include "Core/Jobs/JobSystem.h"
+
+#include <cstring> // memset
+
+namespace moe
+{
+	void SceneTransforms::Reserve(uint32_t numNodes)
+	{
+		m_nodeSlot.Reserve(numNodes);
+		m_nodeParent.Reserve(numNodes);
+		m_slotNode.Reserve(numNodes);
+		m_slotParent.Reserve(numNodes);
+		m_localTransforms.Reserve(numNodes);
+		m_worldTransforms.Reserve(numNodes);
+		m_dirty.Reserve(numNodes);
+	}
+
+
+	void SceneTransforms::AddNode(uint32_t nodeIdx, uint32_t parentIdx, const Transform& localTransform)
+	{
+		if (!MOE_ASSERT(nodeIdx != ms_INVALID_NODE && false == IsValidNode(nodeIdx)))
+		{
+			return;
+		}
+
+		MOE_ASSERT(parentIdx == ms_INVALID_NODE || IsValidNode(parentIdx));
+
+		if (nodeIdx >= m_nodeSlot.Size())
+		{
+			m_nodeSlot.Resize(nodeIdx + 1, ms_INVALID_NODE);
+			m_nodeParent.Resize(nodeIdx + 1, ms_INVALID_NODE);
+		}
+
+		// Appending keeps parents before children, but the new node is not at its depth level anymore.
+		const uint32_t newSlot = (uint32_t)m_slotNode.Size();
+		m_nodeSlot[nodeIdx] = newSlot;
+		m_nodeParent[nodeIdx] = parentIdx;
+
+		m_slotNode.PushBack(nodeIdx);
+		m_slotParent.PushBack(parentIdx != ms_INVALID_NODE ? m_nodeSlot[parentIdx] : ms_INVALID_NODE);
+		m_localTransforms.PushBack(localTransform);
+		m_worldTransforms.PushBack(localTransform);
+		m_dirty.PushBack(true);
+
+		m_isSorted = false;
+		m_needsUpdate = true;
+	}
+
+
+	void SceneTransforms::RemoveNode(uint32_t nodeIdx)
+	{
+		if (!MOE_ASSERT(IsValidNode(nodeIdx)))
+		{
+			return;
+		}
+
+		// Leave a hole : the next sort will get rid of it.
+		const uint32_t slot = m_nodeSlot[nodeIdx];
+		m_slotNode[slot] = ms_INVALID_NODE;
+		m_nodeSlot[nodeIdx] = ms_INVALID_NODE;
+		m_nodeParent[nodeIdx] = ms_INVALID_NODE;
+
+		m_isSorted = false;
+		m_needsUpdate = true;
+	}
+
+
+	void SceneTransforms::SetParent(uint32_t nodeIdx, uint32_t parentIdx)
+	{
+		if (!MOE_ASSERT(IsValidNode(nodeIdx)) || !MOE_ASSERT(parentIdx == ms_INVALID_NODE || IsValidNode(parentIdx)))
+		{
+			return;
+		}
+
+		// Refuse to create a cycle by making a node the child of one of its descendants
+		for (uint32_t ancestorIdx = parentIdx; ancestorIdx != ms_INVALID_NODE; ancestorIdx = m_nodeParent[ancestorIdx])
+		{
+			if (!MOE_ASSERT(ancestorIdx != nodeIdx))
+			{
+				return;
+			}
+		}
+
+		if (m_nodeParent[nodeIdx] == parentIdx)
+		{
+			return;
+		}
+
+		const uint32_t slot = m_nodeSlot[nodeIdx];
+		m_nodeParent[nodeIdx] = parentIdx;
+		m_slotParent[slot] = (parentIdx != ms_INVALID_NODE ? m_nodeSlot[parentIdx] : ms_INVALID_NODE);
+		m_dirty[slot] = true;
+
+		m_isSorted = false;
+		m_needsUpdate = true;
+	}
+
+
+	void SceneTransforms::UpdateWorldTransforms()
+	{
+		if (false == m_needsUpdate)
+		{
+			return;
+		}
+
+		if (false == m_isSorted)
+		{
+			SortByDepth();
+		}
+
+		UpdateSlotRange(0, (uint32_t)m_slotNode.Size());
+
+		ClearDirtyFlags();
+	}
+
+
+	void SceneTransforms::UpdateWorldTransforms(JobSystem& jobSystem, uint32_t minBatchSize)
+	{
+		if (false == m_needsUpdate)
+		{
+			return;
+		}
+
+		if (false == m_isSorted)
+		{
+			SortByDepth();
+		}
+
+		// A level only reads the world transforms and dirty flags of the previous one : levels are processed one after the other,
+		// but the nodes inside a level can be processed in any order.
+		for (uint32_t iLevel = 0; iLevel < GetNumLevels(); ++iLevel)
+		{
+			const uint32_t levelBegin = m_levelStarts[iLevel];
+			const uint32_t levelSize = m_levelStarts[iLevel + 1] - levelBegin;
+
+			if (levelSize < minBatchSize * 2)
+			{
+				UpdateSlotRange(levelBegin, levelBegin + levelSize);
+			}
+			else
+			{
+				jobSystem.ParallelFor(levelSize, minBatchSize, [this, levelBegin](uint32_t begin, uint32_t end)
+				{
+					UpdateSlotRange(levelBegin + begin, levelBegin + end);
+				});
+			}
+		}
+
+		ClearDirtyFlags();
+	}
+
+
+	void SceneTransforms::UpdateSlotRange(uint32_t beginSlot, uint32_t endSlot)
+	{
+		for (uint32_t iSlot = beginSlot; iSlot < endSlot; ++iSlot)
+		{
+			const uint32_t parentSlot = m_slotParent[iSlot];
+
+			if (parentSlot == ms_INVALID_NODE)
+			{
+				if (m_dirty[iSlot])
+				{
+					m_worldTransforms[iSlot] = m_localTransforms[iSlot];
+				}
+			}
+			else
+			{
+				// A moved parent moves the whole subtree
+				m_dirty[iSlot] |= m_dirty[parentSlot];
+
+				if (m_dirty[iSlot])
+				{
+					m_worldTransforms[iSlot] = m_worldTransforms[parentSlot] * m_localTransforms[iSlot];
+				}
+			}
+		}
+	}
+
+
+	void SceneTransforms::ClearDirtyFlags()
+	{
+		if (m_dirty.Size() != 0)
+		{
+			memset(m_dirty.Data(), 0, m_dirty.Size() * sizeof(uint8_t));
+		}
+
+		m_needsUpdate = false;
+	}
+
+
+	void SceneTransforms::SortByDepth()
+	{
+		const uint32_t numSlots = (uint32_t)m_slotNode.Size();
+
+		// First compute the depth of every node, walking up the parents until a node of known depth.
+		m_nodeDepth.Clear();
+		m_nodeDepth.Resize(m_nodeSlot.Size(), ms_INVALID_NODE);
+
+		Vector<uint32_t> levelSizes;
+
+		for (uint32_t iSlot = 0; iSlot < numSlots; ++iSlot)
+		{
+			const uint32_t nodeIdx = m_slotNode[iSlot];
+			if (nodeIdx == ms_INVALID_NODE)
+			{
+				continue;
+			}
+
+			m_depthStack.Clear();
+
+			uint32_t ancestorIdx = nodeIdx;
+			while (ancestorIdx != ms_INVALID_NODE && m_nodeDepth[ancestorIdx] == ms_INVALID_NODE)
+			{
+				m_depthStack.PushBack(ancestorIdx);
+				ancestorIdx = m_nodeParent[ancestorIdx];
+			}
+
+			uint32_t depth = (ancestorIdx == ms_INVALID_NODE ? 0 : m_nodeDepth[ancestorIdx] + 1);
+			for (uint32_t iStack = (uint32_t)m_depthStack.Size(); iStack-- > 0; ++depth)
+			{
+				m_nodeDepth[m_depthStack[iStack]] = depth;
+			}
+
+			const uint32_t nodeDepth = m_nodeDepth[nodeIdx];
+			if (nodeDepth >= levelSizes.Size())
+			{
+				levelSizes.Resize(nodeDepth + 1, 0);
+			}
+			levelSizes[nodeDepth]++;
+		}
+
+		// Then counting sort the slots by depth. Going through the old slots in order keeps the sort stable.
+		m_levelStarts.Resize(levelSizes.Size() + 1);
+		m_levelStarts[0] = 0;
+		for (uint32_t iLevel = 0; iLevel < levelSizes.Size(); ++iLevel)
+		{
+			m_levelStarts[iLevel + 1] = m_levelStarts[iLevel] + levelSizes[iLevel];
+		}
+
+		const uint32_t numNodes = m_levelStarts.Back();
+
+		Vector<uint32_t> levelCursors(levelSizes.Size());
+		for (uint32_t iLevel = 0; iLevel < levelSizes.Size(); ++iLevel)
+		{
+			levelCursors[iLevel] = m_levelStarts[iLevel];
+		}
+
+		Vector<uint32_t> sortedSlotNode(numNodes);
+		Vector<Transform> sortedLocal(numNodes);
+		Vector<Transform> sortedWorld(numNodes);
+		Vector<uint8_t> sortedDirty(numNodes);
+
+		for (uint32_t iSlot = 0; iSlot < numSlots; ++iSlot)
+		{
+			const uint32_t nodeIdx = m_slotNode[iSlot];
+			if (nodeIdx == ms_INVALID_NODE)
+			{
+				continue;
+			}
+
+			const uint32_t newSlot = levelCursors[m_nodeDepth[nodeIdx]]++;
+			sortedSlotNode[newSlot] = nodeIdx;
+			sortedLocal[newSlot] = m_localTransforms[iSlot];
+			sortedWorld[newSlot] = m_worldTransforms[iSlot];
+			sortedDirty[newSlot] = m_dirty[iSlot];
+			m_nodeSlot[nodeIdx] = newSlot;
+		}
+
+		m_slotParent.Resize(numNodes);
+		for (uint32_t iSlot = 0; iSlot < numNodes; ++iSlot)
+		{
+			const uint32_t parentIdx = m_nodeParent[sortedSlotNode[iSlot]];
+			m_slotParent[iSlot] = (parentIdx != ms_INVALID_NODE ? m_nodeSlot[parentIdx] : ms_INVALID_NODE);
+		}
+
+		m_slotNode = std::move(sortedSlotNode);
+		m_localTransforms = std::move(sortedLocal);
+		m_worldTransforms = std::move(sortedWorld);
+		m_dirty = std::move(sortedDirty);
+
+		m_isSorted = true;
+	}
+}
@@ -0,0 +1,148 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Graphics/Transform/Transform.h"
+
+#include "Monocle_Graphics_Export.h"
+
+namespace moe
+{
+	class JobSystem;
+
+
+	/**
+	 * \brief Stores the local and world transforms of a hierarchy of nodes as arrays, sorted by depth in the hierarchy
+	 * (the root first, then its children, then their children...), so that every parent comes before its children.
+	 * Editing a transform only marks it dirty : world transforms are recomputed later, all at once, by a single linear pass
+	 * that only touches the dirty nodes and their descendants. Each depth level only depends on the previous one,
+	 * so levels can be processed in parallel.
+	 * Nodes are identified by an index chosen by the user (e.g. a free list index). Changing the structure of the hierarchy
+	 * (adding, removing or reparenting nodes) re-sorts the arrays on the next update.
+	 */
+	class SceneTransforms
+	{
+	public:
+
+		static constexpr uint32_t	ms_INVALID_NODE = UINT32_MAX;
+
+
+		Monocle_Graphics_API void	Reserve(uint32_t numNodes);
+
+
+		/**
+		 * \brief Adds a node to the hierarchy.
+		 * \param nodeIdx The user index of the new node
+		 * \param parentIdx The user index of the parent node, or ms_INVALID_NODE for a root
+		 * \param localTransform The transform of the node, relative to its parent
+		 */
+		Monocle_Graphics_API void	AddNode(uint32_t nodeIdx, uint32_t parentIdx, const Transform& localTransform);
+
+		/**
+		 * \brief Removes a node. Its children, if any, must have been removed or given another parent first.
+		 */
+		Monocle_Graphics_API void	RemoveNode(uint32_t nodeIdx);
+
+		/**
+		 * \brief Changes the parent of a node. Its local transform is kept, so the node (and its subtree) will move in the world.
+		 */
+		Monocle_Graphics_API void	SetParent(uint32_t nodeIdx, uint32_t parentIdx);
+
+		[[nodiscard]] uint32_t	GetParent(uint32_t nodeIdx) const
+		{
+			MOE_DEBUG_ASSERT(IsValidNode(nodeIdx));
+			return m_nodeParent[nodeIdx];
+		}
+
+
+		void	SetLocalTransform(uint32_t nodeIdx, const Transform& localTransform)
+		{
+			MOE_DEBUG_ASSERT(IsValidNode(nodeIdx));
+			const uint32_t slot = m_nodeSlot[nodeIdx];
+			m_localTransforms[slot] = localTransform;
+			m_dirty[slot] = true;
+			m_needsUpdate = true;
+		}
+
+		[[nodiscard]] const Transform&	GetLocalTransform(uint32_t nodeIdx) const
+		{
+			MOE_DEBUG_ASSERT(IsValidNode(nodeIdx));
+			return m_localTransforms[m_nodeSlot[nodeIdx]];
+		}
+
+
+		/**
+		 * \brief Returns the world transform computed by the last update : it does not account for the edits made since.
+		 * The reference is only valid until the structure of the hierarchy changes.
+		 */
+		[[nodiscard]] const Transform&	GetWorldTransform(uint32_t nodeIdx) const
+		{
+			MOE_DEBUG_ASSERT(IsValidNode(nodeIdx));
+			return m_worldTransforms[m_nodeSlot[nodeIdx]];
+		}
+
+
+		/**
+		 * \brief Whether some transforms were edited, or the structure changed, since the last update.
+		 */
+		[[nodiscard]] bool	NeedsUpdate() const { return m_needsUpdate; }
+
+
+		/**
+		 * \brief Recomputes the world transforms of the dirty nodes and all their descendants.
+		 */
+		Monocle_Graphics_API void	UpdateWorldTransforms();
+
+		/**
+		 * \brief Same as UpdateWorldTransforms, but each depth level of the hierarchy gets split in batches processed by the job system.
+		 * \param minBatchSize Levels smaller than this are processed on the calling thread.
+		 */
+		Monocle_Graphics_API void	UpdateWorldTransforms(JobSystem& jobSystem, uint32_t minBatchSize = 256);
+
+
+		[[nodiscard]] bool	IsValidNode(uint32_t nodeIdx) const
+		{
+			return (nodeIdx < m_nodeSlot.Size() && m_nodeSlot[nodeIdx] != ms_INVALID_NODE);
+		}
+
+		[[nodiscard]] uint32_t	GetNumLevels() const { return (uint32_t)m_levelStarts.Size() - 1; }
+
+
+	private:
+
+		/**
+		 * \brief Re-sorts the slots by depth after a structure change, dropping the removed nodes.
+		 */
+		void	SortByDepth();
+
+		void	UpdateSlotRange(uint32_t beginSlot, uint32_t endSlot);
+
+		void	ClearDirtyFlags();
+
+
+		// Per node index
+		Vector<uint32_t>	m_nodeSlot;
+		Vector<uint32_t>	m_nodeParent;
+
+		// Per slot, sorted by depth
+		Vector<uint32_t>	m_slotNode;		// ms_INVALID_NODE for the slots of removed nodes
+		Vector<uint32_t>	m_slotParent;	// Slot of the parent, ms_INVALID_NODE for roots
+		Vector<Transform>	m_localTransforms;
+		Vector<Transform>	m_worldTransforms;
+		Vector<uint8_t>		m_dirty;
+
+		// m_levelStarts[depth] is the first slot of this depth (with an extra end slot at the back). Only valid when m_isSorted.
+		Vector<uint32_t>	m_levelStarts{ 0 };
+
+		// Scratch buffers for sorting
+		Vector<uint32_t>	m_nodeDepth;
+		Vector<uint32_t>	m_depthStack;
+
+		bool	m_isSorted = true;
+		bool	m_needsUpdate = false;
+	};
+
+}
@@ -0,0 +1,230 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#ifdef MOE_OPENGL
+
+#include "OpenGLProgramBinaryCache.h"
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/StringFormat/moeStringFormat.h"
+
+#include <cstdio> // remove
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+
+namespace moe
+{
+	namespace
+	{
+		// The keys are written to disk : they need a hash function that gives the same result on every run and platform (which std::hash does not guarantee).
+		constexpr uint64_t	FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+		constexpr uint64_t	FNV_PRIME = 0x100000001b3ull;
+
+		uint64_t	HashBytes(uint64_t hash, const void* data, size_t size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t iByte = 0; iByte < size; ++iByte)
+			{
+				hash = (hash ^ bytes[iByte]) * FNV_PRIME;
+			}
+
+			return hash;
+		}
+
+
+		// Hashes the size too, so that moving characters from a string to the next one changes the hash.
+		uint64_t	HashString(uint64_t hash, std::string_view str)
+		{
+			const uint64_t size = str.size();
+			hash = HashBytes(hash, &size, sizeof(size));
+			return HashBytes(hash, str.data(), str.size());
+		}
+
+
+		std::string_view	GetGLString(GLenum name)
+		{
+			const GLubyte* str = glGetString(name);
+			return (str != nullptr ? std::string_view(reinterpret_cast<const char*>(str)) : std::string_view());
+		}
+	}
+
+
+	void OpenGLProgramBinaryCache::Initialize(const std::string& cacheDirectory)
+	{
+		m_enabled = false;
+
+		GLint numBinaryFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+		if (numBinaryFormats == 0)
+		{
+			MOE_INFO(ChanGraphics, "The driver does not support any program binary format : shader programs will not be cached.");
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(cacheDirectory, error);
+		if (error)
+		{
+			MOE_WARNING(ChanGraphics, "Could not create the shader cache directory %s : shader programs will not be cached.", cacheDirectory);
+			return;
+		}
+
+		m_directory = cacheDirectory;
+
+		m_driverHash = FNV_OFFSET_BASIS;
+		m_driverHash = HashString(m_driverHash, GetGLString(GL_VENDOR));
+		m_driverHash = HashString(m_driverHash, GetGLString(GL_RENDERER));
+		m_driverHash = HashString(m_driverHash, GetGLString(GL_VERSION));
+
+		m_enabled = true;
+	}
+
+
+	void OpenGLProgramBinaryCache::Disable()
+	{
+		m_enabled = false;
+	}
+
+
+	uint64_t OpenGLProgramBinaryCache::ComputeProgramKey(const ShaderProgramDescriptor& shaProDesc, bool isSPIRV, uint64_t driverHash)
+	{
+		uint64_t key = HashBytes(FNV_OFFSET_BASIS, &driverHash, sizeof(driverHash));
+		key = HashBytes(key, &isSPIRV, sizeof(isSPIRV));
+
+		for (const ShaderModuleDescriptor& shaderModDesc : shaProDesc)
+		{
+			const uint32_t stage = (uint32_t)shaderModDesc.m_moduleStage;
+			key = HashBytes(key, &stage, sizeof(stage));
+			key = HashString(key, shaderModDesc.m_shaderCode);
+			key = HashString(key, shaderModDesc.m_entryPoint);
+		}
+
+		return key;
+	}
+
+
+	bool OpenGLProgramBinaryCache::Load(uint64_t programKey, GLuint program)
+	{
+		if (!m_enabled)
+		{
+			return false;
+		}
+
+		const std::string entryFilename = GetEntryFilename(programKey);
+
+		std::ifstream entryFile(entryFilename, std::ios::binary);
+		if (!entryFile)
+		{
+			m_numMisses++;
+			return false;
+		}
+
+		EntryHeader header;
+		entryFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+		// A different program (or driver) hashing to the same file, however unlikely : recompile, it will overwrite the entry.
+		if (!entryFile || header.m_magic != ms_MAGIC || header.m_version != ms_VERSION
+			|| header.m_driverHash != m_driverHash || header.m_programKey != programKey)
+		{
+			m_numMisses++;
+			return false;
+		}
+
+		Vector<char> binary;
+		binary.Resize(header.m_binarySize);
+		entryFile.read(binary.Data(), binary.Size());
+		if (!entryFile)
+		{
+			m_numMisses++;
+			return false;
+		}
+
+		glProgramBinary(program, header.m_binaryFormat, binary.Data(), (GLsizei)binary.Size());
+
+		// Drivers are allowed to reject a binary they produced themselves (e.g. after an update that did not change the version string).
+		GLint linkStatus = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+		if (linkStatus == GL_FALSE)
+		{
+			entryFile.close();
+			std::remove(entryFilename.c_str());
+
+			m_numMisses++;
+			return false;
+		}
+
+		m_numHits++;
+		return true;
+	}
+
+
+	void OpenGLProgramBinaryCache::Store(uint64_t programKey, GLuint program) const
+	{
+		if (!m_enabled)
+		{
+			return;
+		}
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+		{
+			return;
+		}
+
+		Vector<char> binary;
+		binary.Resize(binarySize);
+
+		GLenum binaryFormat = 0;
+		GLsizei writtenSize = 0;
+		glGetProgramBinary(program, binarySize, &writtenSize, &binaryFormat, binary.Data());
+		if (writtenSize <= 0)
+		{
+			return;
+		}
+
+		EntryHeader header;
+		header.m_magic = ms_MAGIC;
+		header.m_version = ms_VERSION;
+		header.m_driverHash = m_driverHash;
+		header.m_programKey = programKey;
+		header.m_binaryFormat = binaryFormat;
+		header.m_binarySize = (uint32_t)writtenSize;
+
+		// Write to a temporary file first, so that a crash never leaves a truncated entry behind.
+		const std::string entryFilename = GetEntryFilename(programKey);
+		const std::string tempFilename = entryFilename + ".tmp";
+
+		{
+			std::ofstream entryFile(tempFilename, std::ios::binary | std::ios::trunc);
+			entryFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			entryFile.write(binary.Data(), writtenSize);
+
+			if (!entryFile)
+			{
+				MOE_WARNING(ChanGraphics, "Could not write the shader cache entry %s.", tempFilename);
+				entryFile.close();
+				std::remove(tempFilename.c_str());
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempFilename, entryFilename, error);
+		if (error)
+		{
+			std::remove(tempFilename.c_str());
+		}
+	}
+
+
+	std::string OpenGLProgramBinaryCache::GetEntryFilename(uint64_t programKey) const
+	{
+		std::string filename;
+		StringFormat(filename, "%s/%016llx.glbin", m_directory, (unsigned long long)programKey);
+		return filename;
+	}
+}
+
+#endif // MOE_OPENGL
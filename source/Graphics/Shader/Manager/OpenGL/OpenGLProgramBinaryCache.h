@@ -0,0 +1,113 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_OPENGL
+
+#ifdef MOE_STD_SUPPORT
+#include <string>
+#endif
+
+#include "Graphics/Shader/Program/ShaderProgramDescriptor.h"
+
+#include "Monocle_Graphics_Export.h"
+
+#include <glad/glad.h>
+
+
+namespace moe
+{
+	/**
+	 * \brief Stores linked shader programs on disk (with glGetProgramBinary), so that the next launches can skip compiling and linking them.
+	 * Programs are keyed by a hash of their modules (stage, code and entry point) : any change in the code gives a new entry.
+	 * Binaries are only valid for the driver that produced them, so the key also hashes the GL vendor, renderer and version :
+	 * a driver update simply turns all entries into cache misses (the entries of the old driver are never read again).
+	 * The driver can also reject a binary for its own reasons : it is then treated as a miss as well.
+	 */
+	class OpenGLProgramBinaryCache
+	{
+	public:
+
+		static constexpr const char*	ms_DEFAULT_DIRECTORY = "ShaderCache";
+
+		/**
+		 * \brief Must be called with a current GL context. Creates the cache directory if needed.
+		 * The cache stays disabled if the driver does not support any program binary format, or if the directory cannot be created.
+		 */
+		Monocle_Graphics_API void	Initialize(const std::string& cacheDirectory = ms_DEFAULT_DIRECTORY);
+
+		Monocle_Graphics_API void	Disable();
+
+		[[nodiscard]] bool	IsEnabled() const { return m_enabled; }
+
+
+		/**
+		 * \param isSPIRV Whether the module codes are SPIR-V binaries or GLSL sources : the same text gives a different program in each case
+		 */
+		[[nodiscard]] uint64_t	ComputeProgramKey(const ShaderProgramDescriptor& shaProDesc, bool isSPIRV) const
+		{
+			return ComputeProgramKey(shaProDesc, isSPIRV, m_driverHash);
+		}
+
+		/**
+		 * \param driverHash The hash of the GL vendor, renderer and version strings computed by Initialize
+		 */
+		Monocle_Graphics_API [[nodiscard]] static uint64_t	ComputeProgramKey(const ShaderProgramDescriptor& shaProDesc, bool isSPIRV, uint64_t driverHash);
+
+		/**
+		 * \brief Tries to load the cached binary of a program.
+		 * \param program A freshly created program, with nothing attached
+		 * \return true if the program is now linked and ready to use
+		 */
+		Monocle_Graphics_API bool	Load(uint64_t programKey, GLuint program);
+
+		/**
+		 * \brief Should be called before linking a program that is going to be stored, so the driver keeps its binary around.
+		 */
+		void	PrepareForStore(GLuint program) const
+		{
+			if (m_enabled)
+			{
+				glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+			}
+		}
+
+		/**
+		 * \brief Stores the binary of a successfully linked program.
+		 */
+		Monocle_Graphics_API void	Store(uint64_t programKey, GLuint program) const;
+
+
+		[[nodiscard]] uint32_t	GetNumHits() const { return m_numHits; }
+
+		[[nodiscard]] uint32_t	GetNumMisses() const { return m_numMisses; }
+
+
+	private:
+
+		struct EntryHeader
+		{
+			uint32_t	m_magic = 0;
+			uint32_t	m_version = 0;
+			uint64_t	m_driverHash = 0;
+			uint64_t	m_programKey = 0;
+			uint32_t	m_binaryFormat = 0;
+			uint32_t	m_binarySize = 0;
+		};
+
+		[[nodiscard]] std::string	GetEntryFilename(uint64_t programKey) const;
+
+
+		static constexpr uint32_t	ms_MAGIC = 0x42504F4D; // "MOPB"
+		static constexpr uint32_t	ms_VERSION = 1;
+
+		std::string	m_directory;
+		uint64_t	m_driverHash = 0;
+		uint32_t	m_numHits = 0;
+		uint32_t	m_numMisses = 0;
+		bool		m_enabled = false;
+	};
+
+}
+
+#endif // MOE_OPENGL
@@ -55,6 +55,15 @@ namespace moe
 		// First create a program
 		OpenGLShaderProgram program{ glCreateProgram() };
 
+		// Skip the whole compilation if the linked program is in the cache
+		const uint64_t programKey = (m_binaryCache.IsEnabled() ? m_binaryCache.ComputeProgramKey(shaProDesc, false) : 0);
+		if (m_binaryCache.Load(programKey, program))
+		{
+			return RegisterProgram(std::move(program));
+		}
+
+		m_binaryCache.PrepareForStore(program);
+
 		// Then attach all our shaders
 		for (const ShaderModuleDescriptor& shaderModDesc : shaProDesc)
 		{
@@ -93,6 +102,8 @@ namespace moe
 		GL_PROGRAM_CHECK_MESSAGE(program, GL_LINK_STATUS,
 			"Linking failed for shader program : '%s' (program ID : '%u'). Aborting shader program creation.", (GLuint)program);
 
+		m_binaryCache.Store(programKey, program);
+
 		return RegisterProgram(std::move(program));
 	}
 
@@ -102,6 +113,15 @@ namespace moe
 		// First create a program
 		OpenGLShaderProgram program{ glCreateProgram() };
 
+		// Skip the whole compilation if the linked program is in the cache
+		const uint64_t programKey = (m_binaryCache.IsEnabled() ? m_binaryCache.ComputeProgramKey(shaProDesc, true) : 0);
+		if (m_binaryCache.Load(programKey, program))
+		{
+			return RegisterProgram(std::move(program));
+		}
+
+		m_binaryCache.PrepareForStore(program);
+
 		// Then attach all our shaders
 		for (const ShaderModuleDescriptor& shaderModDesc : shaProDesc)
 		{
@@ -142,14 +162,16 @@ namespace moe
 		GL_PROGRAM_CHECK_MESSAGE(program, GL_LINK_STATUS,
 			"Linking failed for shader program : '%s' (program ID : '%u'). Aborting shader program creation.", (GLuint)program);
 
+		m_binaryCache.Store(programKey, program);
+
 		return RegisterProgram(std::move(program));
 	}
 
 
 	ShaderProgramHandle OpenGLShaderManager::RegisterProgram(OpenGLShaderProgram&& shader)
 	{
-		// Build shader uniform block cache for fast retrieval
-		shader.BuildUniformBlockAccessCache();
+		// Gather the program reflection once, so binding resources never has to query the driver by name
+		shader.BuildReflection();
 
 		auto [programIt, alreadyIn] = m_programs.insert(std::move(shader));
 
@@ -10,6 +10,8 @@
 
 #include "Graphics/Shader/Program/OpenGL/OpenGLShaderProgramComparator.h" // for std::set
 
+#include "Graphics/Shader/Manager/OpenGL/OpenGLProgramBinaryCache.h"
+
 #include "Monocle_Graphics_Export.h"
 
 #ifdef MOE_STD_SUPPORT
@@ -26,6 +28,7 @@ namespace moe
 	 * You pass it compiled shader programs, and it stores them for you.
 	 * When you register a new shader, it hands you out a shader handle that you can reuse to get back to that shader.
 	 * It technically takes ownership of your shader program. When the manager is destroyed, all the shader programs inside get destroyed.
+	 * Once its binary cache is initialized, programs are first looked up in the cache, and only compiled if they are not there.
 	 */
 	class OpenGLShaderManager
 	{
@@ -87,11 +90,19 @@ namespace moe
 		Monocle_Graphics_API void	Clear();
 
 
+		[[nodiscard]] OpenGLProgramBinaryCache&	MutBinaryCache()
+		{
+			return m_binaryCache;
+		}
+
+
 	private:
 		// TODO: I suspect OpenGL always hands you shader program IDs starting from 0,
 		// so we could maybe use a more optimized data structure like a freelist to speed things up.
 		std::set< OpenGLShaderProgram, OpenGLShaderProgramComparator >	m_programs;
 
+		OpenGLProgramBinaryCache	m_binaryCache;
+
 
 	};
 
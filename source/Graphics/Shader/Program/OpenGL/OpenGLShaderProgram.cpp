@@ -5,14 +5,60 @@
 
 #include "OpenGLShaderProgram.h"
 
+#include <climits> // INT_MAX
+
 namespace moe
 {
+	namespace
+	{
+		bool	IsSamplerType(GLenum uniformType)
+		{
+			switch (uniformType)
+			{
+			case GL_SAMPLER_1D:
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_3D:
+			case GL_SAMPLER_CUBE:
+			case GL_SAMPLER_1D_SHADOW:
+			case GL_SAMPLER_2D_SHADOW:
+			case GL_SAMPLER_1D_ARRAY:
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_SAMPLER_1D_ARRAY_SHADOW:
+			case GL_SAMPLER_2D_ARRAY_SHADOW:
+			case GL_SAMPLER_2D_MULTISAMPLE:
+			case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+			case GL_SAMPLER_CUBE_SHADOW:
+			case GL_SAMPLER_CUBE_MAP_ARRAY:
+			case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW:
+			case GL_SAMPLER_BUFFER:
+			case GL_SAMPLER_2D_RECT:
+			case GL_SAMPLER_2D_RECT_SHADOW:
+			case GL_INT_SAMPLER_2D:
+			case GL_INT_SAMPLER_3D:
+			case GL_INT_SAMPLER_CUBE:
+			case GL_INT_SAMPLER_2D_ARRAY:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_3D:
+			case GL_UNSIGNED_INT_SAMPLER_CUBE:
+			case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+				return true;
+			default:
+				return false;
+			}
+		}
+	}
+
+
 	OpenGLShaderProgram::OpenGLShaderProgram(OpenGLShaderProgram&& other) noexcept
 	{
 		m_program = other.m_program;
 		other.m_program = ms_nullProgram;
-		m_blockBindingToBlockIdx = std::move(other.m_blockBindingToBlockIdx);
+		m_uniformBlocks = std::move(other.m_uniformBlocks);
+		m_samplers = std::move(other.m_samplers);
+		m_blockNameToSlot = std::move(other.m_blockNameToSlot);
+		m_samplerNameToSlot = std::move(other.m_samplerNameToSlot);
 		m_blockMemberNameToOffset = std::move(other.m_blockMemberNameToOffset);
+		m_layoutSlots = std::move(other.m_layoutSlots);
 	}
 
 
@@ -22,23 +68,29 @@ namespace moe
 		{
 			m_program = rhs.m_program;
 			rhs.m_program = ms_nullProgram;
-			m_blockBindingToBlockIdx = std::move(rhs.m_blockBindingToBlockIdx);
+			m_uniformBlocks = std::move(rhs.m_uniformBlocks);
+			m_samplers = std::move(rhs.m_samplers);
+			m_blockNameToSlot = std::move(rhs.m_blockNameToSlot);
+			m_samplerNameToSlot = std::move(rhs.m_samplerNameToSlot);
 			m_blockMemberNameToOffset = std::move(rhs.m_blockMemberNameToOffset);
+			m_layoutSlots = std::move(rhs.m_layoutSlots);
 		}
 
 		return *this;
 	}
 
 
-	void OpenGLShaderProgram::BuildUniformBlockAccessCache()
+	void OpenGLShaderProgram::BuildReflection()
 	{
 		GLint numBlocks = 0;
 		glGetProgramInterfaceiv(m_program, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &numBlocks);
-		const GLenum blockProperties[1] = { GL_NUM_ACTIVE_VARIABLES };
+		const GLenum blockProperties[3] = { GL_NUM_ACTIVE_VARIABLES, GL_BUFFER_DATA_SIZE, GL_BUFFER_BINDING };
 		const GLenum activeUnifProp[1] = { GL_ACTIVE_VARIABLES };
-		const GLenum unifProperties[3] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION };
+		const GLenum unifProperties[2] = { GL_NAME_LENGTH, GL_OFFSET };
 
-		m_blockBindingToBlockIdx.Reserve(numBlocks);
+		m_uniformBlocks.Clear();
+		m_uniformBlocks.Reserve(numBlocks);
+		m_blockNameToSlot.Reserve(numBlocks);
 
 		for (int blockIx = 0; blockIx < numBlocks; ++blockIx)
 		{
@@ -50,16 +102,19 @@ namespace moe
 			glGetActiveUniformBlockName(m_program, blockIx, nameLen, nullptr, &blockName[0]);
 			blockName.pop_back(); // strip the '\0'
 
-			// Then get block binding and index.
-			const unsigned int blockIndex = glGetUniformBlockIndex(m_program, blockName.c_str());
-
-			GLint blockBinding;
-			glGetActiveUniformBlockiv(m_program, blockIx, GL_UNIFORM_BLOCK_BINDING, &blockBinding);
+			// Then the block variable count, size and current binding (the one specified in the shader, if any).
+			GLint blockValues[3];
+			glGetProgramResourceiv(m_program, GL_UNIFORM_BLOCK, blockIx, 3, blockProperties, 3, NULL, blockValues);
+			const GLint numActiveUnifs = blockValues[0];
 
-			m_blockBindingToBlockIdx.Insert({blockBinding, blockIndex});
+			m_uniformBlocks.EmplaceBack();
+			UniformBlockReflection& block = m_uniformBlocks.Back();
+			block.m_name = blockName;
+			block.m_blockIndex = (GLuint)blockIx; // active resource indices are the uniform block indices
+			block.m_dataSize = blockValues[1];
+			block.m_binding = blockValues[2];
 
-			GLint numActiveUnifs = 0;
-			glGetProgramResourceiv(m_program, GL_UNIFORM_BLOCK, blockIx, 1, blockProperties, 1, NULL, &numActiveUnifs);
+			m_blockNameToSlot.Insert({ blockName, (uint32_t)blockIx });
 
 			if (!numActiveUnifs)
 				continue;
@@ -67,38 +122,60 @@ namespace moe
 			std::vector<GLint> blockUnifs(numActiveUnifs);
 			glGetProgramResourceiv(m_program, GL_UNIFORM_BLOCK, blockIx, 1, activeUnifProp, numActiveUnifs, NULL, &blockUnifs[0]);
 
-			m_blockBindingToBlockIdx.Reserve(m_blockBindingToBlockIdx.Size() + numActiveUnifs);
+			m_blockMemberNameToOffset.Reserve(m_blockMemberNameToOffset.Size() + numActiveUnifs);
 
 			for (int unifIx = 0; unifIx < numActiveUnifs; ++unifIx)
 			{
-				GLint values[3];
-				glGetProgramResourceiv(m_program, GL_UNIFORM, blockUnifs[unifIx], 3, unifProperties, 3, NULL, values);
-
-				// Get the name. Must use a std::vector rather than a std::string for C++03 standards issues.
-				// C++11 would let you use a std::string directly.
-				std::vector<char> nameData(values[0]);
-				glGetProgramResourceName(m_program, GL_UNIFORM, blockUnifs[unifIx], (GLsizei)nameData.size(), NULL, &nameData[0]);
-				std::string memberName(nameData.begin(), nameData.end() - 1);
-				const char* nameStr = memberName.c_str();
-				unsigned int indices[1];
-				GLint offsets[1];
-
-				glGetUniformIndices(m_program, 1, &nameStr, indices);
-				glGetActiveUniformsiv(m_program, 1, indices, GL_UNIFORM_OFFSET, offsets);
-
-				std::string blockMemberName;
-				blockMemberName.reserve(blockName.size() + memberName.size() + 1);
-				blockMemberName += blockName;
-				blockMemberName += '.';
-				blockMemberName += memberName;
-
-				m_blockMemberNameToOffset.Insert({ blockMemberName, offsets[0]});
+				GLint values[2];
+				glGetProgramResourceiv(m_program, GL_UNIFORM, blockUnifs[unifIx], 2, unifProperties, 2, NULL, values);
+
+				// Read the member name right after the "Block." prefix
+				std::string blockMemberName = blockName + '.';
+				blockMemberName.resize(blockName.size() + 1 + values[0]);
+				glGetProgramResourceName(m_program, GL_UNIFORM, blockUnifs[unifIx], values[0], NULL, &blockMemberName[blockName.size() + 1]);
+				blockMemberName.pop_back(); // strip the '\0'
+
+				m_blockMemberNameToOffset.Insert({ blockMemberName, values[1] });
+			}
+		}
+
+		// Now look for the samplers : they are the uniforms of sampler type outside of any block.
+		GLint numUniforms = 0;
+		glGetProgramInterfaceiv(m_program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms);
+		const GLenum samplerProperties[4] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_BLOCK_INDEX };
+
+		m_samplers.Clear();
+
+		for (int unifIx = 0; unifIx < numUniforms; ++unifIx)
+		{
+			GLint values[4];
+			glGetProgramResourceiv(m_program, GL_UNIFORM, unifIx, 4, samplerProperties, 4, NULL, values);
+
+			if (values[3] != -1 || values[2] == -1 || !IsSamplerType((GLenum)values[1]))
+				continue;
+
+			m_samplers.EmplaceBack();
+			SamplerReflection& sampler = m_samplers.Back();
+			sampler.m_name.resize(values[0]);
+			glGetProgramResourceName(m_program, GL_UNIFORM, unifIx, values[0], NULL, &sampler.m_name[0]);
+			sampler.m_name.pop_back(); // strip the '\0'
+			sampler.m_location = values[2];
+			glGetUniformiv(m_program, sampler.m_location, &sampler.m_textureUnit);
+
+			const uint32_t samplerSlot = (uint32_t)m_samplers.Size() - 1;
+			m_samplerNameToSlot.Insert({ sampler.m_name, samplerSlot });
+
+			// Sampler arrays are reported as "name[0]" : also make them reachable by their plain name.
+			const size_t arraySuffixPos = sampler.m_name.rfind("[0]");
+			if (arraySuffixPos != std::string::npos && arraySuffixPos + 3 == sampler.m_name.size())
+			{
+				m_samplerNameToSlot.Insert({ sampler.m_name.substr(0, arraySuffixPos), samplerSlot });
 			}
 		}
 	}
 
 
-	int OpenGLShaderProgram::GetBlockMemberOffset(const std::string& memberVariableName) const
+	int OpenGLShaderProgram::GetBlockMemberOffset(std::string_view memberVariableName) const
 	{
 		auto memberVarIt = m_blockMemberNameToOffset.Find(memberVariableName);
 		if (memberVarIt == m_blockMemberNameToOffset.End())
@@ -109,6 +186,83 @@ namespace moe
 
 		return memberVarIt->second;
 	}
+
+	bool OpenGLShaderProgram::HasBlockMember(std::string_view blockName, std::string_view memberName) const
+	{
+		std::string blockMemberName;
+		blockMemberName.reserve(blockName.size() + memberName.size() + 1);
+		blockMemberName += blockName;
+		blockMemberName += '.';
+		blockMemberName += memberName;
+
+		return m_blockMemberNameToOffset.Find(std::string_view(blockMemberName)) != m_blockMemberNameToOffset.End();
+	}
+
+
+	uint32_t OpenGLShaderProgram::FindUniformBlockSlot(std::string_view blockName) const
+	{
+		auto slotIt = m_blockNameToSlot.Find(blockName);
+		return (slotIt != m_blockNameToSlot.End() ? slotIt->second : ms_INVALID_SLOT);
+	}
+
+
+	uint32_t OpenGLShaderProgram::FindSamplerSlot(std::string_view samplerName) const
+	{
+		auto slotIt = m_samplerNameToSlot.Find(samplerName);
+		return (slotIt != m_samplerNameToSlot.End() ? slotIt->second : ms_INVALID_SLOT);
+	}
+
+
+	const Vector<uint32_t>& OpenGLShaderProgram::GetResourceLayoutSlots(ResourceLayoutHandle layoutHandle, const ResourceLayoutDescriptor& layoutDesc) const
+	{
+		auto slotsIt = m_layoutSlots.Find(layoutHandle.Get());
+		if (slotsIt != m_layoutSlots.End())
+		{
+			return slotsIt->second;
+		}
+
+		Vector<uint32_t> layoutSlots;
+		layoutSlots.Reserve(layoutDesc.NumBindings());
+
+		for (const ResourceLayoutBindingDescriptor& bindingDesc : layoutDesc)
+		{
+			switch (bindingDesc.m_kind)
+			{
+			case ResourceKind::UniformBuffer:
+				layoutSlots.PushBack(FindUniformBlockSlot(bindingDesc.m_name));
+				break;
+			case ResourceKind::TextureReadOnly:
+				layoutSlots.PushBack(FindSamplerSlot(bindingDesc.m_name));
+				break;
+			default:
+				layoutSlots.PushBack(ms_INVALID_SLOT);
+			}
+		}
+
+		return m_layoutSlots.Insert({ layoutHandle.Get(), std::move(layoutSlots) }).first->second;
+	}
+
+
+	void OpenGLShaderProgram::SetUniformBlockBinding(uint32_t blockSlot, GLint binding) const
+	{
+		const UniformBlockReflection& block = m_uniformBlocks[blockSlot];
+		if (block.m_binding != binding)
+		{
+			glUniformBlockBinding(m_program, block.m_blockIndex, binding);
+			block.m_binding = binding;
+		}
+	}
+
+
+	void OpenGLShaderProgram::SetSamplerTextureUnit(uint32_t samplerSlot, GLint textureUnit) const
+	{
+		const SamplerReflection& sampler = m_samplers[samplerSlot];
+		if (sampler.m_textureUnit != textureUnit)
+		{
+			glProgramUniform1i(m_program, sampler.m_location, textureUnit);
+			sampler.m_textureUnit = textureUnit;
+		}
+	}
 }
 
-#endif // #ifdef MOE_OPENGL
\ No newline at end of file
+#endif // #ifdef MOE_OPENGL
@@ -5,6 +5,10 @@
 #ifdef MOE_OPENGL
 
 #include <Core/Containers/HashMap/HashMap.h>
+#include <Core/Containers/Vector/Vector.h>
+
+#include "Graphics/Resources/ResourceLayout/ResourceLayoutDescriptor.h"
+#include "Graphics/Resources/ResourceLayout/ResourceLayoutHandle.h"
 
 #include <glad/glad.h>
 
@@ -20,6 +24,26 @@ namespace moe
 
 	public:
 
+		/**
+		 * \brief Slot IDs are indices in the reflection tables of a program. They stay valid for the whole program lifetime.
+		 */
+		static const uint32_t ms_INVALID_SLOT = UINT32_MAX;
+
+		struct UniformBlockReflection
+		{
+			std::string		m_name;
+			GLuint			m_blockIndex = GL_INVALID_INDEX;
+			GLint			m_dataSize = 0;
+			mutable GLint	m_binding = -1; // Last binding point set in the program, to skip redundant glUniformBlockBinding's
+		};
+
+		struct SamplerReflection
+		{
+			std::string		m_name;
+			GLint			m_location = -1;
+			mutable GLint	m_textureUnit = -1; // Last texture unit set in the program, to skip redundant glProgramUniform1i's
+		};
+
 		OpenGLShaderProgram(GLuint shaderProgram) :
 			m_program(shaderProgram)
 		{}
@@ -55,13 +79,57 @@ namespace moe
 
 
 		/**
-		 * \brief Builds a cache of uniform block binding point -> block index for faster access,
-		 * and also the offset of every variable in uniform blocks to make their modification easier.
+		 * \brief Gathers the program reflection once, right after linking : uniform block indices and sizes, sampler locations,
+		 * and the offset of every variable in uniform blocks to make their modification easier.
+		 * Everything is then accessed through integer slots, to keep GL introspection calls out of the draw loop.
+		 */
+		void	BuildReflection();
+
+
+		int		GetBlockMemberOffset(std::string_view memberVariableName) const;
+
+		[[nodiscard]] bool	HasBlockMember(std::string_view blockName, std::string_view memberName) const;
+
+
+		/**
+		 * \brief Finds the slot of a uniform block by name. Meant to be called once, at setup time.
+		 * \return The slot ID or ms_INVALID_SLOT if this program has no such block
+		 */
+		[[nodiscard]] uint32_t	FindUniformBlockSlot(std::string_view blockName) const;
+
+		/**
+		 * \brief Finds the slot of a sampler uniform by name. Meant to be called once, at setup time.
+		 * \return The slot ID or ms_INVALID_SLOT if this program has no such sampler
+		 */
+		[[nodiscard]] uint32_t	FindSamplerSlot(std::string_view samplerName) const;
+
+		[[nodiscard]] const UniformBlockReflection&	GetUniformBlock(uint32_t blockSlot) const
+		{
+			return m_uniformBlocks[blockSlot];
+		}
+
+		[[nodiscard]] const SamplerReflection&	GetSampler(uint32_t samplerSlot) const
+		{
+			return m_samplers[samplerSlot];
+		}
+
+		/**
+		 * \brief Resolves the slot of every binding of a resource layout in this program, in binding order.
+		 * Uniform buffers map to uniform block slots, read-only textures to sampler slots, and other kinds to ms_INVALID_SLOT.
+		 * Names are only resolved the first time a layout is used with this program : next calls are a single lookup.
+		 * The returned reference is only valid until the next call.
 		 */
-		void	BuildUniformBlockAccessCache();
+		const Vector<uint32_t>&	GetResourceLayoutSlots(ResourceLayoutHandle layoutHandle, const ResourceLayoutDescriptor& layoutDesc) const;
 
+		/**
+		 * \brief Assigns a binding point to a uniform block. Does nothing if the block already uses this binding.
+		 */
+		void	SetUniformBlockBinding(uint32_t blockSlot, GLint binding) const;
 
-		int		GetBlockMemberOffset(const std::string& memberVariableName) const;
+		/**
+		 * \brief Makes a sampler uniform read from a texture unit. Does nothing if the sampler already uses this unit.
+		 */
+		void	SetSamplerTextureUnit(uint32_t samplerSlot, GLint textureUnit) const;
 
 
 		operator GLuint() const
@@ -82,8 +150,13 @@ namespace moe
 
 
 	private:
-		HashMap<int, unsigned>	m_blockBindingToBlockIdx;
-		HashMap<std::string, int>	m_blockMemberNameToOffset;
+		Vector<UniformBlockReflection>	m_uniformBlocks;
+		Vector<SamplerReflection>		m_samplers;
+		HashMap<std::string, uint32_t>	m_blockNameToSlot;
+		HashMap<std::string, uint32_t>	m_samplerNameToSlot;
+		HashMap<std::string, int>		m_blockMemberNameToOffset;
+
+		mutable HashMap<uint32_t, Vector<uint32_t>>	m_layoutSlots;
 
 		GLuint	m_program{ ms_nullProgram };
 	};
@@ -0,0 +1,549 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#ifdef MOE_OPENGL
+
+#include "OpenGLTextureStreamer.h"
+
+#include "Graphics/Texture/OpenGL/OpenGLTextureFormat.h"
+
+#include "Core/Preprocessor/moeAssert.h"
+
+#include "Core/Log/moeLog.h"
+
+#include <STB/stb_image.h>
+
+#include <algorithm> // std::min
+#include <cstring> // memcpy
+
+
+namespace moe
+{
+	OpenGLTextureStreamer::~OpenGLTextureStreamer()
+	{
+		// GL objects may not be deleted here (the context may already be gone), but the threads have to be joined.
+		StopLoaderThreads();
+	}
+
+
+	void OpenGLTextureStreamer::Initialize(uint32_t frameUploadBudget, uint32_t numLoaderThreads)
+	{
+		MOE_ASSERT(m_loaderThreads.Empty());
+
+		m_placeholder2D = CreatePlaceholder(GL_TEXTURE_2D);
+		m_placeholderCubemap = CreatePlaceholder(GL_TEXTURE_CUBE_MAP);
+
+		// Offsets into a pixel unpack buffer must be a multiple of the size of the pixel components (at most a float).
+		m_stagingBuffer.Initialize(frameUploadBudget, sizeof(float));
+
+		m_stopping = false;
+
+		numLoaderThreads = std::max(numLoaderThreads, 1u);
+		m_loaderThreads.Reserve(numLoaderThreads);
+		for (uint32_t iThread = 0; iThread < numLoaderThreads; ++iThread)
+		{
+			m_loaderThreads.EmplaceBack(&OpenGLTextureStreamer::LoaderThreadLoop, this);
+		}
+	}
+
+
+	void OpenGLTextureStreamer::Destroy()
+	{
+		StopLoaderThreads();
+
+		for (DecodedImage& image : m_decodedImages)
+		{
+			if (image.m_pixels != nullptr)
+				stbi_image_free(image.m_pixels);
+		}
+		m_decodedImages.Clear();
+
+		for (auto& loadPair : m_loads)
+		{
+			ReleasePixels(loadPair.second);
+		}
+		m_loads.Clear();
+		m_failedTextures.Clear();
+		m_uploadQueue.clear();
+		m_endedLoads.Clear();
+
+		GLuint placeholders[] = { m_placeholder2D, m_placeholderCubemap };
+		glDeleteTextures(2, placeholders);
+		m_placeholder2D = m_placeholderCubemap = 0;
+
+		m_stagingBuffer.Destroy();
+	}
+
+
+	GLuint OpenGLTextureStreamer::LoadTexture2D(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded)
+	{
+		const GLenum storageFormat = TranslateToOpenGLSizedFormat(tex2DFileDesc.m_targetFormat);
+		if (storageFormat == 0)
+		{
+			return 0;
+		}
+
+		const bool isRadianceHDRFormat = (tex2DFileDesc.m_targetFormat == TextureFormat::RGBE);
+
+		// OpenGL expects the first row of the image at the bottom : have stb_image flip it.
+		return CreateTextureLoad(GL_TEXTURE_2D, storageFormat, tex2DFileDesc.m_requiredFormat, tex2DFileDesc.m_wantedMipmapLevels,
+			&tex2DFileDesc.m_filename, 1, isRadianceHDRFormat, true, std::move(onLoaded));
+	}
+
+
+	GLuint OpenGLTextureStreamer::LoadCubemap(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded)
+	{
+		const GLenum storageFormat = TranslateToOpenGLSizedFormat(cubemapFilesDesc.m_targetFormat);
+		if (storageFormat == 0)
+		{
+			MOE_DEBUG_ASSERT(false); // not supposed to happen
+			return 0;
+		}
+
+		// Cube maps' specification is that the images' origin is in the upper left : don't flip the faces.
+		return CreateTextureLoad(GL_TEXTURE_CUBE_MAP, storageFormat, cubemapFilesDesc.m_requiredFormat, cubemapFilesDesc.m_wantedMipmapLevels,
+			cubemapFilesDesc.m_rightLeftTopBottomFrontBackTexFiles, ms_MAX_FACES, false, false, std::move(onLoaded));
+	}
+
+
+	void OpenGLTextureStreamer::Update()
+	{
+		// Collect what the loader threads decoded since last frame.
+		Vector<DecodedImage> decodedImages;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::swap(decodedImages, m_decodedImages);
+		}
+
+		for (DecodedImage& image : decodedImages)
+		{
+			ReceiveDecodedImage(image);
+		}
+
+		if (!m_uploadQueue.empty())
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer.GetBufferHandle());
+
+			// Rows are tightly packed in the staging buffer.
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+			while (!m_uploadQueue.empty())
+			{
+				auto [textureID, loadID] = m_uploadQueue.front();
+
+				auto loadIt = m_loads.Find(textureID);
+				if (loadIt == m_loads.End() || loadIt->second.m_loadID != loadID)
+				{
+					// This load was cancelled.
+					m_uploadQueue.pop_front();
+					continue;
+				}
+
+				TextureLoad& load = loadIt->second;
+				if (!UploadNextRows(load))
+				{
+					break; // Out of budget : resume next frame
+				}
+
+				if (load.m_uploadFace == load.m_numFaces)
+				{
+					FinishLoad(load);
+					m_uploadQueue.pop_front();
+				}
+			}
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		m_stagingBuffer.EndFrame();
+
+		if (!m_endedLoads.Empty())
+		{
+			Vector<EndedLoad> endedLoads;
+			std::swap(endedLoads, m_endedLoads);
+
+			for (EndedLoad& endedLoad : endedLoads)
+			{
+				if (endedLoad.m_onLoaded)
+				{
+					endedLoad.m_onLoaded(TextureHandle{ endedLoad.m_textureID }, endedLoad.m_state);
+				}
+			}
+		}
+	}
+
+
+	TextureLoadState OpenGLTextureStreamer::GetLoadState(GLuint textureID) const
+	{
+		if (m_loads.Find(textureID) != m_loads.End())
+		{
+			return TextureLoadState::Pending;
+		}
+
+		if (std::find(m_failedTextures.begin(), m_failedTextures.end(), textureID) != m_failedTextures.end())
+		{
+			return TextureLoadState::Failed;
+		}
+
+		return TextureLoadState::Ready;
+	}
+
+
+	void OpenGLTextureStreamer::Forget(GLuint textureID)
+	{
+		auto failedIt = std::find(m_failedTextures.begin(), m_failedTextures.end(), textureID);
+		if (failedIt != m_failedTextures.end())
+		{
+			// The texture name may be recycled by a texture that loads fine.
+			*failedIt = m_failedTextures.Back();
+			m_failedTextures.PopBack();
+			return;
+		}
+
+		auto loadIt = m_loads.Find(textureID);
+		if (loadIt == m_loads.End())
+		{
+			return;
+		}
+
+		const uint64_t loadID = loadIt->second.m_loadID;
+
+		// Don't bother decoding the files that were not picked up yet.
+		// Images being decoded right now will be thrown away when they are received.
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_decodeRequests.erase(std::remove_if(m_decodeRequests.begin(), m_decodeRequests.end(),
+				[loadID](const DecodeRequest& request) { return request.m_loadID == loadID; }),
+				m_decodeRequests.end());
+		}
+
+		ReleasePixels(loadIt->second);
+		m_loads.Erase(loadIt);
+	}
+
+
+	GLuint OpenGLTextureStreamer::CreateTextureLoad(GLenum target, GLenum storageFormat, TextureFormat requiredFormat, uint32_t mipmapLevels,
+		const std::string* filenames, uint32_t numFaces, bool isHDR, bool flipVertically, TextureLoadCallback&& onLoaded)
+	{
+		MOE_ASSERT(numFaces <= ms_MAX_FACES);
+
+		// The texture storage is only allocated once we know the size of the image.
+		GLuint textureID = 0;
+		glCreateTextures(target, 1, &textureID);
+
+		TextureLoad load;
+		load.m_onLoaded = std::move(onLoaded);
+		load.m_loadID = m_nextLoadID++;
+		load.m_textureID = textureID;
+		load.m_target = target;
+		load.m_storageFormat = storageFormat;
+		load.m_pixelType = (isHDR ? GL_FLOAT : GL_UNSIGNED_BYTE);
+		load.m_mipmapLevels = mipmapLevels;
+		load.m_numFaces = numFaces;
+
+		const uint64_t loadID = load.m_loadID;
+		m_loads.Insert({ textureID, std::move(load) });
+
+		const int requiredCompNum = GetTextureFormatChannelsNumber(requiredFormat);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (uint32_t iFace = 0; iFace < numFaces; ++iFace)
+			{
+				m_decodeRequests.push_back({ filenames[iFace], loadID, textureID, iFace, requiredCompNum, isHDR, flipVertically });
+			}
+		}
+
+		// Each face can be decoded by a different thread.
+		if (numFaces > 1)
+			m_requestAvailable.notify_all();
+		else
+			m_requestAvailable.notify_one();
+
+		return textureID;
+	}
+
+
+	GLuint OpenGLTextureStreamer::ResolveLoadingTexture(GLuint textureID) const
+	{
+		auto loadIt = m_loads.Find(textureID);
+		if (loadIt == m_loads.End())
+		{
+			return textureID;
+		}
+
+		return (loadIt->second.m_target == GL_TEXTURE_CUBE_MAP ? m_placeholderCubemap : m_placeholder2D);
+	}
+
+
+	void OpenGLTextureStreamer::LoaderThreadLoop()
+	{
+		while (true)
+		{
+			DecodeRequest request;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_requestAvailable.wait(lock, [this]() { return m_stopping || !m_decodeRequests.empty(); });
+
+				if (m_stopping)
+				{
+					return;
+				}
+
+				request = std::move(m_decodeRequests.front());
+				m_decodeRequests.pop_front();
+			}
+
+			// The global flip flag of stb_image is not thread-safe : use the thread-local one.
+			stbi_set_flip_vertically_on_load_thread(request.m_flipVertically ? 1 : 0);
+
+			DecodedImage image;
+			image.m_loadID = request.m_loadID;
+			image.m_textureID = request.m_textureID;
+			image.m_face = request.m_face;
+			image.m_pixels = (request.m_isHDR ?
+					(void*)stbi_loadf(request.m_filename.c_str(), &image.m_width, &image.m_height, &image.m_channels, request.m_requiredComponents)
+				:	(void*)stbi_load(request.m_filename.c_str(), &image.m_width, &image.m_height, &image.m_channels, request.m_requiredComponents));
+
+			// stb_image reports the channels of the file : what we get is the number of channels we asked for, if any.
+			if (request.m_requiredComponents != 0)
+			{
+				image.m_channels = request.m_requiredComponents;
+			}
+
+			image.m_filename = std::move(request.m_filename);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_decodedImages.PushBack(std::move(image));
+		}
+	}
+
+
+	void OpenGLTextureStreamer::StopLoaderThreads()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+			m_decodeRequests.clear();
+		}
+
+		m_requestAvailable.notify_all();
+
+		for (std::thread& loaderThread : m_loaderThreads)
+		{
+			loaderThread.join();
+		}
+
+		m_loaderThreads.Clear();
+	}
+
+
+	void OpenGLTextureStreamer::ReceiveDecodedImage(DecodedImage& image)
+	{
+		auto loadIt = m_loads.Find(image.m_textureID);
+		if (loadIt == m_loads.End() || loadIt->second.m_loadID != image.m_loadID)
+		{
+			// Cancelled (or already failed) load : nobody wants this image anymore.
+			if (image.m_pixels != nullptr)
+				stbi_image_free(image.m_pixels);
+			return;
+		}
+
+		TextureLoad& load = loadIt->second;
+
+		if (image.m_pixels == nullptr)
+		{
+			MOE_ERROR(ChanGraphics, "Image file %s could not be read.", image.m_filename);
+			FailLoad(load);
+			return;
+		}
+
+		load.m_faces[image.m_face] = image.m_pixels;
+		image.m_pixels = nullptr;
+
+		if (load.m_numDecodedFaces == 0)
+		{
+			load.m_width = image.m_width;
+			load.m_height = image.m_height;
+			load.m_channels = image.m_channels;
+		}
+		else if (image.m_width != load.m_width || image.m_height != load.m_height || image.m_channels != load.m_channels)
+		{
+			// Sanity check : make sure all cubemap images have the same width, height and channels number information (or something may be wrong)
+			MOE_ERROR(ChanGraphics, "Could not create cube map : image file %s data format differs from other cube map files !", image.m_filename);
+			FailLoad(load);
+			return;
+		}
+
+		load.m_numDecodedFaces++;
+
+		if (load.m_numDecodedFaces == load.m_numFaces)
+		{
+			glTextureStorage2D(load.m_textureID, load.m_mipmapLevels, load.m_storageFormat, load.m_width, load.m_height);
+			m_uploadQueue.push_back({ load.m_textureID, load.m_loadID });
+		}
+	}
+
+
+	bool OpenGLTextureStreamer::UploadNextRows(TextureLoad& load)
+	{
+		const uint32_t componentSize = (load.m_pixelType == GL_FLOAT ? sizeof(float) : sizeof(uint8_t));
+		const uint32_t rowSize = load.m_width * load.m_channels * componentSize;
+		const uint32_t faceHeight = (uint32_t)load.m_height;
+
+		const byte_t* facePixels = static_cast<const byte_t*>(load.m_faces[load.m_uploadFace]);
+		const byte_t* nextRows = facePixels + (size_t)load.m_uploadRow * rowSize;
+
+		const uint32_t alignment = m_stagingBuffer.GetAlignment();
+		const uint32_t usedBytes = (m_stagingBuffer.GetFrameUsedBytes() + alignment - 1) & ~(alignment - 1);
+		const uint32_t availableBytes = (usedBytes < m_stagingBuffer.GetRegionSize() ? m_stagingBuffer.GetRegionSize() - usedBytes : 0);
+
+		uint32_t numRows = std::min(availableBytes / rowSize, faceHeight - load.m_uploadRow);
+
+		if (numRows == 0)
+		{
+			if (rowSize <= m_stagingBuffer.GetRegionSize())
+			{
+				return false;
+			}
+
+			// A single row does not even fit in the staging buffer : fall back to a synchronous upload of the rest of the face.
+			MOE_WARNING(ChanGraphics, "Texture rows are larger than the texture upload budget (%u bytes per frame) : uploading without staging.", m_stagingBuffer.GetRegionSize());
+
+			numRows = faceHeight - load.m_uploadRow;
+
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			UploadRows(load, load.m_uploadRow, numRows, nextRows);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer.GetBufferHandle());
+		}
+		else
+		{
+			void* stagingMemory = nullptr;
+			const uint32_t stagingOffset = m_stagingBuffer.Allocate(numRows * rowSize, stagingMemory);
+			if (stagingOffset == OpenGLStreamingRingBuffer::ms_INVALID_OFFSET)
+			{
+				return false;
+			}
+
+			std::memcpy(stagingMemory, nextRows, (size_t)numRows * rowSize);
+
+			// With a pixel unpack buffer bound, the "pixels" pointer is an offset in the buffer.
+			UploadRows(load, load.m_uploadRow, numRows, reinterpret_cast<const void*>((uintptr_t)stagingOffset));
+		}
+
+		load.m_uploadRow += numRows;
+
+		if (load.m_uploadRow == faceHeight)
+		{
+			// The pixels were copied : the CPU copy of this face is not needed anymore.
+			stbi_image_free(load.m_faces[load.m_uploadFace]);
+			load.m_faces[load.m_uploadFace] = nullptr;
+
+			load.m_uploadFace++;
+			load.m_uploadRow = 0;
+		}
+
+		return true;
+	}
+
+
+	void OpenGLTextureStreamer::UploadRows(const TextureLoad& load, uint32_t firstRow, uint32_t numRows, const void* pixels) const
+	{
+		const GLenum inputBaseFormat = TranslateToOpenGLBaseFormat(load.m_channels);
+
+		if (load.m_target == GL_TEXTURE_CUBE_MAP)
+		{
+			glTextureSubImage3D(load.m_textureID, 0, 0, firstRow, load.m_uploadFace, load.m_width, numRows, 1, inputBaseFormat, load.m_pixelType, pixels);
+		}
+		else
+		{
+			glTextureSubImage2D(load.m_textureID, 0, 0, firstRow, load.m_width, numRows, inputBaseFormat, load.m_pixelType, pixels);
+		}
+	}
+
+
+	void OpenGLTextureStreamer::FinishLoad(TextureLoad& load)
+	{
+		if (load.m_mipmapLevels != 0)
+		{
+			glGenerateTextureMipmap(load.m_textureID);
+		}
+
+		if (load.m_target == GL_TEXTURE_CUBE_MAP)
+		{
+			// Same parameters as the cube maps created synchronously.
+			glTextureParameteri(load.m_textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(load.m_textureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(load.m_textureID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(load.m_textureID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(load.m_textureID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		}
+
+		m_endedLoads.PushBack({ std::move(load.m_onLoaded), load.m_textureID, TextureLoadState::Ready });
+
+		// From now on, the texture is bound as itself.
+		m_loads.Erase(load.m_textureID);
+	}
+
+
+	void OpenGLTextureStreamer::FailLoad(TextureLoad& load)
+	{
+		ReleasePixels(load);
+
+		// The storage is only allocated once all the faces are decoded, so a failed texture has none yet :
+		// give it the placeholder texel, so that it can still be bound safely without being tracked anymore.
+		FillWithPlaceholder(load.m_textureID, load.m_target);
+		m_failedTextures.PushBack(load.m_textureID);
+
+		m_endedLoads.PushBack({ std::move(load.m_onLoaded), load.m_textureID, TextureLoadState::Failed });
+
+		// Like finished loads, failed loads are not pending anymore. Erasing invalidates the load : do it last.
+		m_loads.Erase(load.m_textureID);
+	}
+
+
+	void OpenGLTextureStreamer::ReleasePixels(TextureLoad& load)
+	{
+		for (void*& facePixels : load.m_faces)
+		{
+			if (facePixels != nullptr)
+			{
+				stbi_image_free(facePixels);
+				facePixels = nullptr;
+			}
+		}
+	}
+
+
+	GLuint OpenGLTextureStreamer::CreatePlaceholder(GLenum target)
+	{
+		GLuint placeholderID = 0;
+		glCreateTextures(target, 1, &placeholderID);
+		FillWithPlaceholder(placeholderID, target);
+
+		return placeholderID;
+	}
+
+
+	void OpenGLTextureStreamer::FillWithPlaceholder(GLuint textureID, GLenum target)
+	{
+		// Mid-grey : neither black nor white, whatever the texture is used for.
+		const uint8_t greyTexel[4] = { 128, 128, 128, 255 };
+
+		glTextureStorage2D(textureID, 1, GL_RGBA8, 1, 1);
+
+		if (target == GL_TEXTURE_CUBE_MAP)
+		{
+			for (GLint face = 0; face < (GLint)ms_MAX_FACES; ++face)
+			{
+				glTextureSubImage3D(textureID, 0, 0, 0, face, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, greyTexel);
+			}
+		}
+		else
+		{
+			glTextureSubImage2D(textureID, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, greyTexel);
+		}
+	}
+}
+
+#endif // MOE_OPENGL
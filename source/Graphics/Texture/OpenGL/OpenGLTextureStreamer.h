@@ -0,0 +1,231 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_OPENGL
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Core/Containers/Vector/Vector.h"
+#include "Core/Containers/HashMap/HashMap.h"
+
+#include "Graphics/Texture/TextureDescription.h"
+#include "Graphics/Texture/TextureLoadState.h"
+
+#include "Graphics/GraphicsAllocator/OpenGL/OpenGLStreamingRingBuffer.h"
+
+#include "Monocle_Graphics_Export.h"
+
+#include <glad/glad.h>
+
+
+namespace moe
+{
+	/**
+	 * \brief Loads texture files without stalling the render thread.
+	 * The GL texture name is created right away, and a 1x1 placeholder gets bound in its stead until the texture is ready.
+	 * Image files are decoded by a small pool of loader threads (the faces of a cube map are decoded in parallel).
+	 * Decoded pixels are then copied into a persistently mapped pixel unpack buffer and uploaded a few rows at a time,
+	 * so that a frame never uploads more than the staging budget.
+	 * Apart from the decoding, everything happens on the thread owning the GL context.
+	 */
+	class OpenGLTextureStreamer
+	{
+	public:
+
+		static constexpr uint32_t	ms_DEFAULT_FRAME_UPLOAD_BUDGET = 4 << 20; // 4 MB per frame
+		static constexpr uint32_t	ms_DEFAULT_LOADER_THREADS = 2;
+
+		OpenGLTextureStreamer() = default;
+		~OpenGLTextureStreamer();
+
+		OpenGLTextureStreamer(const OpenGLTextureStreamer&) = delete;
+		OpenGLTextureStreamer& operator=(const OpenGLTextureStreamer&) = delete;
+
+
+		/**
+		 * \brief Creates the placeholder textures and the staging buffer, and starts the loader threads.
+		 * \param frameUploadBudget The maximum number of bytes uploaded to textures per frame
+		 * \param numLoaderThreads How many threads decode image files
+		 */
+		Monocle_Graphics_API void	Initialize(uint32_t frameUploadBudget = ms_DEFAULT_FRAME_UPLOAD_BUDGET, uint32_t numLoaderThreads = ms_DEFAULT_LOADER_THREADS);
+
+		/**
+		 * \brief Stops the loader threads (waiting for the images they are decoding) and cancels all the pending loads.
+		 * The textures themselves are not deleted : they belong to the device.
+		 */
+		Monocle_Graphics_API void	Destroy();
+
+
+		/**
+		 * \brief Creates a texture and queues its file for decoding.
+		 * \return The name of the new GL texture, or 0 if the target format is invalid
+		 */
+		Monocle_Graphics_API [[nodiscard]] GLuint	LoadTexture2D(const Texture2DFileDescriptor& tex2DFileDesc, TextureLoadCallback onLoaded);
+
+		/**
+		 * \brief Creates a cube map texture and queues its six face files for decoding.
+		 * \return The name of the new GL texture, or 0 if the target format is invalid
+		 */
+		Monocle_Graphics_API [[nodiscard]] GLuint	LoadCubemap(const CubeMapTextureFilesDescriptor& cubemapFilesDesc, TextureLoadCallback onLoaded);
+
+
+		/**
+		 * \brief Collects the images decoded since last time, and uploads as many rows as the frame budget allows.
+		 * Callbacks of the loads that ended are called from here. Must be called once per frame.
+		 */
+		Monocle_Graphics_API void	Update();
+
+
+		/**
+		 * \brief Gives the texture that should be bound in place of the given one : its placeholder if it is still loading, the texture itself otherwise.
+		 */
+		[[nodiscard]] GLuint	ResolveTexture(GLuint textureID) const
+		{
+			// Fast path for the usual case where nothing is loading.
+			if (m_loads.Empty())
+				return textureID;
+
+			return ResolveLoadingTexture(textureID);
+		}
+
+		/**
+		 * \brief Textures that were never loaded asynchronously are always Ready.
+		 */
+		Monocle_Graphics_API [[nodiscard]] TextureLoadState	GetLoadState(GLuint textureID) const;
+
+		/**
+		 * \brief Cancels the load of a texture that is about to be deleted. Does nothing if the texture is not loading.
+		 */
+		Monocle_Graphics_API void	Forget(GLuint textureID);
+
+
+		[[nodiscard]] uint32_t	GetNumLoadingTextures() const { return (uint32_t)m_loads.Size(); }
+
+
+	private:
+
+		static constexpr uint32_t	ms_MAX_FACES = 6;
+
+		struct DecodeRequest
+		{
+			std::string	m_filename;
+			uint64_t	m_loadID = 0;
+			GLuint		m_textureID = 0;
+			uint32_t	m_face = 0;
+			int			m_requiredComponents = 0;
+			bool		m_isHDR = false;
+			bool		m_flipVertically = true;
+		};
+
+		struct DecodedImage
+		{
+			std::string	m_filename; // Only kept for error messages
+			uint64_t	m_loadID = 0;
+			GLuint		m_textureID = 0;
+			uint32_t	m_face = 0;
+			void*		m_pixels = nullptr; // Allocated by stb_image, null if the file could not be decoded
+			int			m_width = 0;
+			int			m_height = 0;
+			int			m_channels = 0;
+		};
+
+		struct TextureLoad
+		{
+			TextureLoadCallback	m_onLoaded;
+			void*				m_faces[ms_MAX_FACES]{};
+			uint64_t			m_loadID = 0;
+			GLuint				m_textureID = 0;
+			GLenum				m_target = GL_TEXTURE_2D;
+			GLenum				m_storageFormat = 0;
+			GLenum				m_pixelType = GL_UNSIGNED_BYTE;
+			uint32_t			m_mipmapLevels = 1;
+			uint32_t			m_numFaces = 1;
+			uint32_t			m_numDecodedFaces = 0;
+			int					m_width = 0;
+			int					m_height = 0;
+			int					m_channels = 0;
+			uint32_t			m_uploadFace = 0;	// Next face and row to upload
+			uint32_t			m_uploadRow = 0;
+		};
+
+		struct EndedLoad
+		{
+			TextureLoadCallback	m_onLoaded;
+			GLuint				m_textureID = 0;
+			TextureLoadState	m_state = TextureLoadState::Ready;
+		};
+
+		// Texture names get recycled by GL : the load ID tells apart a cancelled load from a new one on the same texture name.
+		using QueuedUpload = std::pair<GLuint, uint64_t>;
+
+
+		[[nodiscard]] GLuint	CreateTextureLoad(GLenum target, GLenum storageFormat, TextureFormat requiredFormat, uint32_t mipmapLevels,
+											const std::string* filenames, uint32_t numFaces, bool isHDR, bool flipVertically, TextureLoadCallback&& onLoaded);
+
+		[[nodiscard]] GLuint	ResolveLoadingTexture(GLuint textureID) const;
+
+		void	LoaderThreadLoop();
+
+		void	StopLoaderThreads();
+
+		void	ReceiveDecodedImage(DecodedImage& image);
+
+		/**
+		 * \brief Uploads the next rows of a texture, as many as the remaining budget of this frame allows.
+		 * \return false if nothing could be uploaded because the budget is exhausted.
+		 */
+		bool	UploadNextRows(TextureLoad& load);
+
+		void	UploadRows(const TextureLoad& load, uint32_t firstRow, uint32_t numRows, const void* pixels) const;
+
+		void	FinishLoad(TextureLoad& load);
+
+		void	FailLoad(TextureLoad& load);
+
+		static void	ReleasePixels(TextureLoad& load);
+
+		[[nodiscard]] static GLuint	CreatePlaceholder(GLenum target);
+
+		/**
+		 * \brief Gives a texture without storage the 1x1 storage and texel of a placeholder.
+		 */
+		static void	FillWithPlaceholder(GLuint textureID, GLenum target);
+
+
+		// The state shared with the loader threads.
+		std::mutex					m_mutex;
+		std::condition_variable		m_requestAvailable;
+		std::deque<DecodeRequest>	m_decodeRequests;
+		Vector<DecodedImage>		m_decodedImages;
+		bool						m_stopping = false;
+
+		Vector<std::thread>			m_loaderThreads;
+
+		// Everything below is only touched by the render thread.
+		HashMap<GLuint, TextureLoad>	m_loads;
+
+		// Failed textures hold a placeholder texel of their own : they are only remembered for GetLoadState, until they get deleted.
+		Vector<GLuint>				m_failedTextures;
+
+		// The textures that have all their faces decoded, in the order they get uploaded.
+		std::deque<QueuedUpload>	m_uploadQueue;
+
+		// Callbacks are called at the end of Update, so that they can safely start new loads.
+		Vector<EndedLoad>			m_endedLoads;
+
+		OpenGLStreamingRingBuffer	m_stagingBuffer;
+
+		GLuint		m_placeholder2D = 0;
+		GLuint		m_placeholderCubemap = 0;
+
+		uint64_t	m_nextLoadID = 1;
+	};
+
+}
+
+#endif // MOE_OPENGL
@@ -0,0 +1,30 @@
+// Monocle Game Engine source files
+
+#pragma once
+
+#ifdef MOE_STD_SUPPORT
+#include <functional>
+#endif
+
+#include "Graphics/Texture/TextureHandle.h"
+
+
+namespace moe
+{
+	/**
+	 * \brief Where a texture created asynchronously is in its loading process.
+	 * A Pending texture can be used normally : the device binds a placeholder in its stead until it is Ready.
+	 */
+	enum class TextureLoadState : uint8_t
+	{
+		Pending = 0,
+		Ready,
+		Failed
+	};
+
+
+	/**
+	 * \brief Called on the render thread when an asynchronous texture load is over (either Ready or Failed).
+	 */
+	using TextureLoadCallback = std::function<void(TextureHandle, TextureLoadState)>;
+}
@@ -22,10 +22,11 @@ namespace moe
 
 	public:
 
-		OpenGLVertexLayout(const VertexLayoutDescriptor& desc, GLuint vaoID, uint32_t totalSizeBytes) :
+		OpenGLVertexLayout(const VertexLayoutDescriptor& desc, GLuint vaoID, uint32_t totalSizeBytes, Vector<uint32_t> packedElementSizes = Vector<uint32_t>()) :
 		VertexLayout(desc),
 		m_vaoId(vaoID),
-		m_strideInBytes(totalSizeBytes)
+		m_strideInBytes(totalSizeBytes),
+		m_packedElementSizes(std::move(packedElementSizes))
 		{}
 
 		OpenGLVertexLayout(InstancedVertexLayoutDescriptor&& desc, GLuint vaoID) :
@@ -50,6 +51,11 @@ namespace moe
 
 		uint32_t	GetStrideBytes() const { return m_strideInBytes; }
 
+		/**
+		 * \brief The size of each vertex element, in packed layouts (empty otherwise).
+		 */
+		const Vector<uint32_t>&	GetPackedElementSizes() const { return m_packedElementSizes; }
+
 
 	private:
 		GLuint	m_vaoId{ms_nullVao};
@@ -57,6 +63,8 @@ namespace moe
 		// Only really useful for Interleaved layouts, but it's a reasonable overhead even if unused.
 		uint32_t	m_strideInBytes = 0;
 
+		Vector<uint32_t>	m_packedElementSizes;
+
 
 	};
 }
@@ -0,0 +1,219 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_GLM
+
+#include "Math/Vec3.h"
+#include "Math/Matrix.h"
+
+#include <algorithm> // min, max
+#include <cfloat> // FLT_MAX
+#include <cmath> // fabs, sqrt
+
+namespace moe
+{
+	/**
+	 * \brief Axis-aligned bounding box.
+	 * A default-constructed AABB is empty (min > max) : growing it by a point makes it contain exactly that point.
+	 */
+	struct AABB
+	{
+		AABB() = default;
+
+		AABB(const Vec3& min, const Vec3& max) :
+			m_min(min), m_max(max)
+		{}
+
+
+		[[nodiscard]] static AABB	FromCenterExtents(const Vec3& center, const Vec3& extents)
+		{
+			return AABB(center - extents, center + extents);
+		}
+
+
+		/**
+		 * \brief Computes the bounds of an array of positions.
+		 * \param firstPosition Pointer to the first position (three floats).
+		 * \param count Number of positions
+		 * \param strideBytes Distance in bytes between two positions (e.g. the size of a vertex)
+		 */
+		[[nodiscard]] static AABB	FromPoints(const float* firstPosition, size_t count, size_t strideBytes = sizeof(float) * 3)
+		{
+			AABB bounds;
+
+			const char* posBytes = reinterpret_cast<const char*>(firstPosition);
+			for (size_t iPos = 0; iPos < count; ++iPos, posBytes += strideBytes)
+			{
+				const float* pos = reinterpret_cast<const float*>(posBytes);
+				bounds.Grow(Vec3(pos[0], pos[1], pos[2]));
+			}
+
+			return bounds;
+		}
+
+
+		[[nodiscard]] bool	IsValid() const
+		{
+			return (m_min.x() <= m_max.x() && m_min.y() <= m_max.y() && m_min.z() <= m_max.z());
+		}
+
+
+		void	Grow(const Vec3& point)
+		{
+			m_min = Vec3(std::min(m_min.x(), point.x()), std::min(m_min.y(), point.y()), std::min(m_min.z(), point.z()));
+			m_max = Vec3(std::max(m_max.x(), point.x()), std::max(m_max.y(), point.y()), std::max(m_max.z(), point.z()));
+		}
+
+
+		void	Grow(const AABB& other)
+		{
+			if (other.IsValid())
+			{
+				Grow(other.m_min);
+				Grow(other.m_max);
+			}
+		}
+
+
+		[[nodiscard]] Vec3	GetCenter() const
+		{
+			return (m_min + m_max) * 0.5f;
+		}
+
+
+		/**
+		 * \brief Half the size of the box on each axis.
+		 */
+		[[nodiscard]] Vec3	GetExtents() const
+		{
+			return (m_max - m_min) * 0.5f;
+		}
+
+
+		[[nodiscard]] bool	Contains(const Vec3& point) const
+		{
+			return (point.x() >= m_min.x() && point.x() <= m_max.x()
+				&& point.y() >= m_min.y() && point.y() <= m_max.y()
+				&& point.z() >= m_min.z() && point.z() <= m_max.z());
+		}
+
+
+		[[nodiscard]] bool	Intersects(const AABB& other) const
+		{
+			return (m_min.x() <= other.m_max.x() && m_max.x() >= other.m_min.x()
+				&& m_min.y() <= other.m_max.y() && m_max.y() >= other.m_min.y()
+				&& m_min.z() <= other.m_max.z() && m_max.z() >= other.m_min.z());
+		}
+
+
+		/**
+		 * \brief Computes the axis-aligned box enclosing this box once transformed (Arvo's method).
+		 * It is conservative : rotating a box makes the enclosing box bigger.
+		 */
+		[[nodiscard]] AABB	Transformed(const Mat4& transform) const
+		{
+			if (false == IsValid())
+			{
+				return *this;
+			}
+
+			const Vec3 center = GetCenter();
+			const Vec3 extents = GetExtents();
+
+			Vec3 newCenter, newExtents;
+			for (int iRow = 0; iRow < 3; ++iRow)
+			{
+				newCenter[iRow] = transform[3][iRow];
+				newExtents[iRow] = 0.f;
+				for (int iCol = 0; iCol < 3; ++iCol)
+				{
+					newCenter[iRow] += transform[iCol][iRow] * center[iCol];
+					newExtents[iRow] += std::fabs(transform[iCol][iRow]) * extents[iCol];
+				}
+			}
+
+			return FromCenterExtents(newCenter, newExtents);
+		}
+
+
+		Vec3	m_min{ FLT_MAX };
+		Vec3	m_max{ -FLT_MAX };
+	};
+
+
+	/**
+	 * \brief Bounding sphere. A negative radius means an empty sphere.
+	 */
+	struct BoundingSphere
+	{
+		BoundingSphere() = default;
+
+		BoundingSphere(const Vec3& center, float radius) :
+			m_center(center), m_radius(radius)
+		{}
+
+
+		/**
+		 * \brief The sphere passing by the corners of the box.
+		 */
+		[[nodiscard]] static BoundingSphere	FromAABB(const AABB& box)
+		{
+			if (false == box.IsValid())
+			{
+				return BoundingSphere();
+			}
+
+			return BoundingSphere(box.GetCenter(), box.GetExtents().Length());
+		}
+
+
+		[[nodiscard]] bool	IsValid() const
+		{
+			return m_radius >= 0.f;
+		}
+
+
+		[[nodiscard]] bool	Contains(const Vec3& point) const
+		{
+			return (point - m_center).SquaredLength() <= m_radius * m_radius;
+		}
+
+
+		[[nodiscard]] bool	Intersects(const BoundingSphere& other) const
+		{
+			const float radiusSum = m_radius + other.m_radius;
+			return (other.m_center - m_center).SquaredLength() <= radiusSum * radiusSum;
+		}
+
+
+		/**
+		 * \brief Transforms the sphere. With a non-uniform scale, the radius gets scaled by the biggest axis scale.
+		 */
+		[[nodiscard]] BoundingSphere	Transformed(const Mat4& transform) const
+		{
+			if (false == IsValid())
+			{
+				return *this;
+			}
+
+			Vec3 newCenter;
+			float maxSquaredScale = 0.f;
+			for (int iRow = 0; iRow < 3; ++iRow)
+			{
+				newCenter[iRow] = transform[3][iRow] + transform[0][iRow] * m_center.x() + transform[1][iRow] * m_center.y() + transform[2][iRow] * m_center.z();
+
+				const Vec3 axis(transform[iRow][0], transform[iRow][1], transform[iRow][2]);
+				maxSquaredScale = std::max(maxSquaredScale, axis.SquaredLength());
+			}
+
+			return BoundingSphere(newCenter, m_radius * std::sqrt(maxSquaredScale));
+		}
+
+
+		Vec3	m_center{ 0.f };
+		float	m_radius = -1.f;
+	};
+}
+
+#endif // MOE_GLM
@@ -0,0 +1,129 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#include "Frustum.h"
+
+#ifdef MOE_GLM
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MOE_FRUSTUM_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace moe
+{
+	Frustum::Frustum(const Mat4& viewProjection)
+	{
+		// GLM matrices are column-major : viewProjection[col][row].
+		auto row = [&viewProjection](int iRow, int iCol) { return viewProjection[iCol][iRow]; };
+
+		for (int iCoord = 0; iCoord < 4; ++iCoord)
+		{
+			const float w = row(3, iCoord);
+			m_planes[Left][iCoord] = w + row(0, iCoord);
+			m_planes[Right][iCoord] = w - row(0, iCoord);
+			m_planes[Bottom][iCoord] = w + row(1, iCoord);
+			m_planes[Top][iCoord] = w - row(1, iCoord);
+			m_planes[Near][iCoord] = w + row(2, iCoord);
+			m_planes[Far][iCoord] = w - row(2, iCoord);
+		}
+
+		for (float* plane : m_planes)
+		{
+			const float normalLength = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+			if (normalLength > 0.f)
+			{
+				for (int iCoord = 0; iCoord < 4; ++iCoord)
+				{
+					plane[iCoord] /= normalLength;
+				}
+			}
+		}
+	}
+
+
+	void Frustum::Cull(const AABBSoA& boxes, Vector<uint32_t>& visibleIndices) const
+	{
+		const uint32_t numBoxes = (uint32_t)boxes.Size();
+
+		const float* centerX = boxes.m_centerX.Data();
+		const float* centerY = boxes.m_centerY.Data();
+		const float* centerZ = boxes.m_centerZ.Data();
+		const float* extentX = boxes.m_extentX.Data();
+		const float* extentY = boxes.m_extentY.Data();
+		const float* extentZ = boxes.m_extentZ.Data();
+
+		uint32_t iBox = 0;
+
+#ifdef MOE_FRUSTUM_SSE
+		// Broadcast each plane coefficient once : the inner loop then tests 4 boxes against a plane in a handful of instructions.
+		__m128 planeX[PlaneCount], planeY[PlaneCount], planeZ[PlaneCount], planeW[PlaneCount];
+		__m128 absPlaneX[PlaneCount], absPlaneY[PlaneCount], absPlaneZ[PlaneCount];
+
+		for (int iPlane = 0; iPlane < PlaneCount; ++iPlane)
+		{
+			planeX[iPlane] = _mm_set1_ps(m_planes[iPlane][0]);
+			planeY[iPlane] = _mm_set1_ps(m_planes[iPlane][1]);
+			planeZ[iPlane] = _mm_set1_ps(m_planes[iPlane][2]);
+			planeW[iPlane] = _mm_set1_ps(m_planes[iPlane][3]);
+			absPlaneX[iPlane] = _mm_set1_ps(std::fabs(m_planes[iPlane][0]));
+			absPlaneY[iPlane] = _mm_set1_ps(std::fabs(m_planes[iPlane][1]));
+			absPlaneZ[iPlane] = _mm_set1_ps(std::fabs(m_planes[iPlane][2]));
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; iBox + 4 <= numBoxes; iBox += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX + iBox);
+			const __m128 cy = _mm_loadu_ps(centerY + iBox);
+			const __m128 cz = _mm_loadu_ps(centerZ + iBox);
+			const __m128 ex = _mm_loadu_ps(extentX + iBox);
+			const __m128 ey = _mm_loadu_ps(extentY + iBox);
+			const __m128 ez = _mm_loadu_ps(extentZ + iBox);
+
+			__m128 outside = _mm_setzero_ps();
+
+			for (int iPlane = 0; iPlane < PlaneCount; ++iPlane)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(planeX[iPlane], cx), _mm_mul_ps(planeY[iPlane], cy));
+				distance = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(planeZ[iPlane], cz)), planeW[iPlane]);
+
+				__m128 radius = _mm_add_ps(_mm_mul_ps(absPlaneX[iPlane], ex), _mm_mul_ps(absPlaneY[iPlane], ey));
+				radius = _mm_add_ps(radius, _mm_mul_ps(absPlaneZ[iPlane], ez));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+			}
+
+			int visibleMask = ~_mm_movemask_ps(outside) & 0xF;
+			while (visibleMask != 0)
+			{
+				// Lowest set bit first, so that indices stay sorted
+				const int lane = (visibleMask & 1) ? 0 : (visibleMask & 2) ? 1 : (visibleMask & 4) ? 2 : 3;
+				visibleIndices.PushBack(iBox + lane);
+				visibleMask &= visibleMask - 1;
+			}
+		}
+#endif // MOE_FRUSTUM_SSE
+
+		// Scalar path for the remaining boxes (or all of them, without SIMD)
+		for (; iBox < numBoxes; ++iBox)
+		{
+			bool isOutside = false;
+
+			for (int iPlane = 0; iPlane < PlaneCount && !isOutside; ++iPlane)
+			{
+				const float* plane = m_planes[iPlane];
+				const float distance = plane[0] * centerX[iBox] + plane[1] * centerY[iBox] + plane[2] * centerZ[iBox] + plane[3];
+				const float radius = std::fabs(plane[0]) * extentX[iBox] + std::fabs(plane[1]) * extentY[iBox] + std::fabs(plane[2]) * extentZ[iBox];
+				isOutside = (distance + radius < 0.f);
+			}
+
+			if (!isOutside)
+			{
+				visibleIndices.PushBack(iBox);
+			}
+		}
+	}
+}
+
+#endif // MOE_GLM
@@ -0,0 +1,136 @@
+// Monocle Game Engine source files - Alexandre Baron
+
+#pragma once
+
+#ifdef MOE_GLM
+
+#include "Core/Containers/Vector/Vector.h"
+
+#include "Math/Bounds/Bounds.h"
+#include "Math/Vec4.h"
+
+#include "Monocle_Math_Export.h"
+
+namespace moe
+{
+	/**
+	 * \brief A list of boxes stored as structure of arrays (centers and extents), the layout expected by batch frustum culling.
+	 */
+	struct AABBSoA
+	{
+		void	Clear()
+		{
+			m_centerX.Clear(); m_centerY.Clear(); m_centerZ.Clear();
+			m_extentX.Clear(); m_extentY.Clear(); m_extentZ.Clear();
+		}
+
+		void	Reserve(size_t capacity)
+		{
+			m_centerX.Reserve(capacity); m_centerY.Reserve(capacity); m_centerZ.Reserve(capacity);
+			m_extentX.Reserve(capacity); m_extentY.Reserve(capacity); m_extentZ.Reserve(capacity);
+		}
+
+		void	PushBack(const AABB& box)
+		{
+			const Vec3 center = box.GetCenter();
+			const Vec3 extents = box.GetExtents();
+			m_centerX.PushBack(center.x()); m_centerY.PushBack(center.y()); m_centerZ.PushBack(center.z());
+			m_extentX.PushBack(extents.x()); m_extentY.PushBack(extents.y()); m_extentZ.PushBack(extents.z());
+		}
+
+		[[nodiscard]] size_t	Size() const { return m_centerX.Size(); }
+
+		Vector<float>	m_centerX, m_centerY, m_centerZ;
+		Vector<float>	m_extentX, m_extentY, m_extentZ;
+	};
+
+
+	/**
+	 * \brief The six planes of a camera frustum, pointing inwards, with normalized normals.
+	 * The tests are conservative : a volume may be reported as intersecting while being just outside a corner of the frustum,
+	 * but a volume that is (even partly) inside is never reported as outside.
+	 */
+	class Frustum
+	{
+	public:
+
+		enum Plane : uint8_t
+		{
+			Left = 0,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+			PlaneCount
+		};
+
+
+		Frustum() = default;
+
+		/**
+		 * \brief Extracts the planes from a view-projection matrix (Gribb-Hartmann method), expecting an OpenGL [-1, 1] clip depth.
+		 * Planes are in world space when given a view-projection, in view space when given a projection only.
+		 */
+		Monocle_Math_API explicit Frustum(const Mat4& viewProjection);
+
+
+		/**
+		 * \brief Returns the plane as (normal.x, normal.y, normal.z, distance) : a point p is inside when dot(normal, p) + distance >= 0.
+		 */
+		[[nodiscard]] Vec4	GetPlane(Plane plane) const
+		{
+			return Vec4(m_planes[plane][0], m_planes[plane][1], m_planes[plane][2], m_planes[plane][3]);
+		}
+
+
+		[[nodiscard]] bool	Intersects(const AABB& box) const
+		{
+			const Vec3 center = box.GetCenter();
+			const Vec3 extents = box.GetExtents();
+
+			for (const float* plane : m_planes)
+			{
+				const float distance = plane[0] * center.x() + plane[1] * center.y() + plane[2] * center.z() + plane[3];
+				const float radius = std::fabs(plane[0]) * extents.x() + std::fabs(plane[1]) * extents.y() + std::fabs(plane[2]) * extents.z();
+				if (distance + radius < 0.f)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+
+		[[nodiscard]] bool	Intersects(const BoundingSphere& sphere) const
+		{
+			for (const float* plane : m_planes)
+			{
+				const float distance = plane[0] * sphere.m_center.x() + plane[1] * sphere.m_center.y() + plane[2] * sphere.m_center.z() + plane[3];
+				if (distance < -sphere.m_radius)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+
+		/**
+		 * \brief Tests a whole list of boxes against the frustum, four at a time when SIMD is available.
+		 * Gives the same results as calling Intersects on each box.
+		 * \param boxes The boxes to test
+		 * \param visibleIndices Receives the indices of the boxes intersecting the frustum, in increasing order. It is not cleared first.
+		 */
+		Monocle_Math_API void	Cull(const AABBSoA& boxes, Vector<uint32_t>& visibleIndices) const;
+
+
+	private:
+
+		alignas(16) float	m_planes[PlaneCount][4]{};
+	};
+}
+
+#endif // MOE_GLM
@@ -3,6 +3,9 @@
 set(Monocle_Math_SOURCES
 	./Angles/Angles.cpp
 ./Angles/Angles.h
+./Bounds/Bounds.h
+./Bounds/Frustum.cpp
+./Bounds/Frustum.h
 ./GLM/Angles_glm.h
 ./GLM/Matrix_glm.h
 ./GLM/Vector_glm.h